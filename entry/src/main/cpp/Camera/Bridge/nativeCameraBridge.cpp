@@ -51,12 +51,26 @@ static napi_value Init(napi_env env, napi_value exports) {
         
         // 原有其他接口（保持兼容）
         {"TakePhoto", nullptr, TakePhoto, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"StartTetherSession", nullptr, StartTetherSession, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"StopTetherSession", nullptr, StopTetherSession, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"TriggerCapture", nullptr, TriggerCapture, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"DownloadPhoto", nullptr, DownloadPhoto, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"SetCameraParameter", nullptr, SetCameraParameter, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SetCameraParameters", nullptr, SetCameraParameters, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"QueueCameraParameter", nullptr, QueueCameraParameter, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"RegisterParamAckCallback", nullptr, RegisterParamAckCallback, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"GetPreview", nullptr, GetPreviewNapi, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"GetCameraStatus", nullptr, GetCameraStatus, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"StartStatusMonitor", nullptr, StartStatusMonitor, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"StopStatusMonitor", nullptr, StopStatusMonitor, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"ParseExposureValue", nullptr, ParseExposureValue, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"NearestExposureStop", nullptr, NearestExposureStop, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"MatchExposureChoice", nullptr, MatchExposureChoice, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"GetEquivalentExposures", nullptr, GetEquivalentExposures, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"GetBracketingSet", nullptr, GetBracketingSet, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"GetCameraConfig", nullptr, GetCameraConfig, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"GetParamOptions", nullptr, GetParamOptions, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SetConfigCacheDir", nullptr, SetConfigCacheDir, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"RegisterParamCallback", nullptr, RegisterParamCallback, nullptr, nullptr, nullptr, napi_default, nullptr},
 
         {"GetPhotoTotalCount", nullptr, GetPhotoTotalCount, nullptr, nullptr, nullptr, napi_default, nullptr},
@@ -70,6 +84,26 @@ static napi_value Init(napi_env env, napi_value exports) {
         {"StartAsyncScan", nullptr, StartAsyncScan, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"IsScanComplete", nullptr, IsScanComplete, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"GetScanProgress", nullptr, GetScanProgress, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"StartExifHarvest", nullptr, StartExifHarvest, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"StopExifHarvest", nullptr, StopExifHarvest, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"GetExifHarvestProgress", nullptr, GetExifHarvestProgress, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SetPhotoSortOrder", nullptr, SetPhotoSortOrder, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"ListCameraFolder", nullptr, ListCameraFolder, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SetScanFolder", nullptr, SetScanFolder, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SetMultiStorageScan", nullptr, SetMultiStorageScan, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SetMediaTypeFilter", nullptr, SetMediaTypeFilter, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"GetTimelineBuckets", nullptr, GetTimelineBuckets, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"GetPageForDate", nullptr, GetPageForDate, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SearchPhotos", nullptr, SearchPhotos, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"ExtractRawPreview", nullptr, ExtractRawPreview, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"DownloadPhotoBatch", nullptr, DownloadPhotoBatch, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SetImportManifestDir", nullptr, SetImportManifestDir, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SetDownloadDirectIoThreshold", nullptr, SetDownloadDirectIoThreshold, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"SetPairImportPolicy", nullptr, SetPairImportPolicy, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"IsPhotoImported", nullptr, IsPhotoImported, nullptr, nullptr, nullptr, napi_default, nullptr},
+#ifdef PHOTOSEND_BENCHMARK
+        {"RunScanBenchmark", nullptr, RunScanBenchmark, nullptr, nullptr, nullptr, napi_default, nullptr},
+#endif
     };
 
     // 将接口映射表挂载到exports对象（ArkTS侧通过import获取这些函数）
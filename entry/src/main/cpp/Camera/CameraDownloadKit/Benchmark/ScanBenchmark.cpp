@@ -0,0 +1,296 @@
+// ScanBenchmark.cpp
+// Created on 2026/1/20.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "ScanBenchmark.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/CameraDownloadKit/PhotoScanner/PhotoScanner.h"
+#include <hilog/log.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+#include <Camera/Common/Constants.h>
+
+#define LOG_DOMAIN ModuleLogs::ScanBenchmark.domain
+#define LOG_TAG ModuleLogs::ScanBenchmark.tag
+
+// 分配计数：替换全局operator new（含对齐、nothrow版本），只在计数开启时累加（本文件仅在基准构建中编译）
+static std::atomic<bool> g_countAllocs(false);
+static std::atomic<uint64_t> g_allocCount(0);
+static std::atomic<uint64_t> g_allocBytes(0);
+
+static void* CountedAlloc(size_t size, size_t alignment) {
+    if (g_countAllocs.load(std::memory_order_relaxed)) {
+        g_allocCount.fetch_add(1, std::memory_order_relaxed);
+        g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment <= alignof(std::max_align_t)) {
+        return malloc(size);
+    }
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+}
+
+void* operator new(size_t size) {
+    void* ptr = CountedAlloc(size, 0);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    void* ptr = CountedAlloc(size, static_cast<size_t>(alignment));
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, 0);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, static_cast<size_t>(alignment));
+}
+
+// malloc与posix_memalign的内存都由free释放，所有delete版本统一转发
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    free(ptr);
+}
+
+static const int MIN_FILE_COUNT = 1;
+static const int MAX_FILE_COUNT = 1000000;
+static const int STEM_MODULO = 10000;  // 相机文件编号DSC_0000～DSC_9999
+
+// 按拍摄类型生成的扩展名
+static const char* const RAW_EXTENSIONS[] = {"NEF", "CR3", "ARW", "RAF"};
+static const char* const VIDEO_EXTENSIONS[] = {"MOV", "MP4"};
+static const char* const SIDECAR_EXTENSIONS[] = {"XMP", "THM"};
+
+long ScanBenchmark::ReadStatusKb(const char* field) {
+    FILE* file = fopen("/proc/self/status", "r");
+    if (!file) {
+        return 0;
+    }
+    char line[256];
+    long value = 0;
+    size_t fieldLen = strlen(field);
+    while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, field, fieldLen) == 0) {
+            value = strtol(line + fieldLen, nullptr, 10);
+            break;
+        }
+    }
+    fclose(file);
+    return value;
+}
+
+bool ScanBenchmark::Run(const ScanBenchmarkOptions& options, ScanBenchmarkReport& report) {
+    if (options.fileCount < MIN_FILE_COUNT || options.fileCount > MAX_FILE_COUNT ||
+        options.filesPerFolder <= 0 || options.pageSize <= 0) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "基准测试参数无效");
+        return false;
+    }
+    report = ScanBenchmarkReport();
+
+    // 1. 生成合成文件列表（固定种子，结果可复现）
+    std::vector<std::pair<std::string, CameraList*>> listings;
+    uint32_t seed = 12345;
+    int shot = 0;
+    int generated = 0;
+    char name[32];
+    std::vector<std::string> names;
+    names.reserve(options.fileCount);
+    while (generated < options.fileCount) {
+        int folderIndex = generated / options.filesPerFolder;
+        if (static_cast<size_t>(folderIndex) >= listings.size()) {
+            char folder[64];
+            snprintf(folder, sizeof(folder), "/store_00010001/DCIM/%03dNIKON", 100 + folderIndex);
+            CameraList* list = nullptr;
+            if (gp_list_new(&list) != GP_OK) {
+                break;
+            }
+            listings.emplace_back(folder, list);
+        }
+        CameraList* list = listings.back().second;
+
+        seed = seed * 1103515245u + 12345u;
+        int roll = static_cast<int>((seed >> 16) % 100);
+        int stem = shot % STEM_MODULO;
+        shot++;
+        auto append = [&](const char* prefix, const char* ext) {
+            snprintf(name, sizeof(name), "%s_%04d.%s", prefix, stem, ext);
+            gp_list_append(list, name, nullptr);
+            names.emplace_back(name);
+            generated++;
+        };
+        if (roll < options.rawPercent) {
+            append("DSC", RAW_EXTENSIONS[shot % 4]);
+        } else if (roll < options.rawPercent + options.pairPercent) {
+            append("DSC", "JPG");
+            if (generated < options.fileCount) {
+                append("DSC", "NEF");
+            }
+        } else if (roll < options.rawPercent + options.pairPercent + options.videoPercent) {
+            append("MOV", VIDEO_EXTENSIONS[shot % 2]);
+        } else if (roll < options.rawPercent + options.pairPercent + options.videoPercent + options.sidecarPercent) {
+            append("DSC", SIDECAR_EXTENSIONS[shot % 2]);
+        } else {
+            append("DSC", "JPG");
+        }
+    }
+    report.fileCount = generated;
+
+    // 2. 文件类型判断微基准
+    auto classifyStart = std::chrono::steady_clock::now();
+    size_t photoCount = 0;
+    for (const auto& fileName : names) {
+        photoCount += IsPhotoMediaType(ClassifyFileName(fileName.c_str())) ? 1 : 0;
+    }
+    auto classifyEnd = std::chrono::steady_clock::now();
+    report.classifyNsPerFile = names.empty() ? 0 :
+        std::chrono::duration<double, std::nano>(classifyEnd - classifyStart).count() / names.size();
+    names.clear();
+    names.shrink_to_fit();
+
+    // 3. 扫描（尽量重置峰值内存统计，内核不支持时VmHWM为进程生命周期峰值）
+    FILE* clearRefs = fopen("/proc/self/clear_refs", "w");
+    if (clearRefs) {
+        fputs("5", clearRefs);
+        fclose(clearRefs);
+    }
+    report.rssBeforeKb = ReadStatusKb("VmRSS:");
+
+    PhotoScanner scanner;
+    g_allocCount = 0;
+    g_allocBytes = 0;
+    g_countAllocs = true;
+    auto scanStart = std::chrono::steady_clock::now();
+    scanner.ScanListings(listings);
+    auto scanEnd = std::chrono::steady_clock::now();
+    g_countAllocs = false;
+    report.scanMs = std::chrono::duration<double, std::milli>(scanEnd - scanStart).count();
+    report.scanAllocs = g_allocCount;
+    report.scanAllocBytes = g_allocBytes;
+
+    for (auto& listing : listings) {
+        gp_list_free(listing.second);
+    }
+
+    // 4. 逐页读取
+    std::vector<double> pageUs;
+    uint64_t pageAllocs = 0;
+    for (int page = 0;; page++) {
+        g_allocCount = 0;
+        g_countAllocs = true;
+        auto pageStart = std::chrono::steady_clock::now();
+        auto photos = scanner.GetPhotoMetaList(page, options.pageSize);
+        auto pageEnd = std::chrono::steady_clock::now();
+        g_countAllocs = false;
+        if (photos.empty()) {
+            break;
+        }
+        pageAllocs += g_allocCount;
+        pageUs.push_back(std::chrono::duration<double, std::micro>(pageEnd - pageStart).count());
+        report.entryCount += static_cast<int>(photos.size());
+    }
+    report.pageCount = static_cast<int>(pageUs.size());
+    if (!pageUs.empty()) {
+        double total = 0;
+        for (double us : pageUs) {
+            total += us;
+        }
+        report.pageAvgUs = total / pageUs.size();
+        report.pageAllocsAvg = static_cast<double>(pageAllocs) / pageUs.size();
+        std::sort(pageUs.begin(), pageUs.end());
+        report.pageP50Us = pageUs[pageUs.size() / 2];
+        report.pageP99Us = pageUs[std::min(pageUs.size() - 1, pageUs.size() * 99 / 100)];
+        report.pageMaxUs = pageUs.back();
+    }
+
+    report.rssAfterKb = ReadStatusKb("VmRSS:");
+    report.peakRssKb = ReadStatusKb("VmHWM:");
+
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                 "扫描基准: %{public}d 个文件 -> %{public}d 条, 扫描 %{public}.2f ms, 分配 %{public}llu 次, "
+                 "单页 avg %{public}.1f us / p99 %{public}.1f us, 峰值内存 %{public}ld KB (照片 %{public}zu)",
+                 report.fileCount, report.entryCount, report.scanMs,
+                 static_cast<unsigned long long>(report.scanAllocs), report.pageAvgUs, report.pageP99Us,
+                 report.peakRssKb, photoCount);
+    return true;
+}
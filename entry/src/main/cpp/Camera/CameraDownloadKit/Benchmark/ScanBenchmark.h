@@ -0,0 +1,65 @@
+// ScanBenchmark.h
+// Created on 2026/1/20.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef SCAN_BENCHMARK_H
+#define SCAN_BENCHMARK_H
+
+#include <cstdint>
+
+/**
+ * @brief 扫描基准测试参数（百分比按拍摄张数计，其余为单JPEG）
+ */
+struct ScanBenchmarkOptions {
+    int fileCount = 10000;       // 文件列表条目数（10k～200k）
+    int rawPercent = 20;         // 单RAW
+    int pairPercent = 40;        // RAW+JPEG（每张两个文件）
+    int videoPercent = 5;        // 视频
+    int sidecarPercent = 5;      // 附属文件（XMP/THM等，只计数不进列表）
+    int filesPerFolder = 9999;   // 每个DCIM子目录的文件数
+    int pageSize = 50;           // 分页大小
+};
+
+/**
+ * @brief 扫描基准测试结果
+ */
+struct ScanBenchmarkReport {
+    int fileCount = 0;            // 实际生成的文件数
+    int entryCount = 0;           // 合并配对后的列表条目数
+    double scanMs = 0;            // ScanListings耗时（毫秒）
+    uint64_t scanAllocs = 0;      // 扫描期间的operator new次数
+    uint64_t scanAllocBytes = 0;  // 扫描期间的operator new字节数
+    double classifyNsPerFile = 0; // ClassifyFileName平均耗时（纳秒）
+    int pageCount = 0;            // 分页数
+    double pageAvgUs = 0;         // 单页GetPhotoMetaList平均耗时（微秒）
+    double pageP50Us = 0;
+    double pageP99Us = 0;
+    double pageMaxUs = 0;
+    double pageAllocsAvg = 0;     // 单页平均operator new次数
+    long rssBeforeKb = 0;         // 测试前常驻内存
+    long rssAfterKb = 0;          // 测试后常驻内存
+    long peakRssKb = 0;           // 测试期间峰值常驻内存（VmHWM）
+};
+
+/**
+ * @brief 扫描基准测试：用合成的CameraList驱动一个独立的PhotoScanner
+ * @details 走与真实扫描相同的AppendFolderListing/CommitFileList路径，不访问相机，
+ *          不影响当前连接的扫描缓存。仅在PHOTOSEND_BENCHMARK构建中编译。
+ */
+class ScanBenchmark {
+public:
+    /**
+     * @brief 运行一次基准测试
+     * @param options 测试参数
+     * @param report 测试结果（输出参数）
+     * @return 参数无效或生成列表失败时返回false
+     */
+    static bool Run(const ScanBenchmarkOptions& options, ScanBenchmarkReport& report);
+
+private:
+    static long ReadStatusKb(const char* field);
+};
+
+#endif // SCAN_BENCHMARK_H
@@ -0,0 +1,257 @@
+// ExifHarvester.cpp
+// Created on 2026/1/14.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "ExifHarvester.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/CameraDownloadKit/PhotoScanner/PhotoScanner.h"
+#include "Camera/CameraDownloadKit/PhotoScanner/TimelineIndex.h"
+#include "../../Common/native_common.h"
+#include "gphoto2/gphoto2-port-result.h"
+#include <hilog/log.h>
+#include <libexif/exif-data.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <Camera/Common/Constants.h>
+
+#define LOG_DOMAIN ModuleLogs::ExifHarvester.domain
+#define LOG_TAG ModuleLogs::ExifHarvester.tag
+
+// 读取有理数标签，分母为0时返回0
+static double GetExifRational(ExifData* exifData, ExifTag tag, ExifByteOrder byteOrder) {
+    ExifEntry* entry = exif_data_get_entry(exifData, tag);
+    if (!entry || !entry->data || entry->format != EXIF_FORMAT_RATIONAL) {
+        return 0;
+    }
+    ExifRational value = exif_get_rational(entry->data, byteOrder);
+    return value.denominator ? static_cast<double>(value.numerator) / value.denominator : 0;
+}
+
+// 读取短整型标签，不存在时返回默认值
+static int GetExifShort(ExifData* exifData, ExifTag tag, ExifByteOrder byteOrder, int defaultValue) {
+    ExifEntry* entry = exif_data_get_entry(exifData, tag);
+    if (!entry || !entry->data || entry->size < 2) {
+        return defaultValue;
+    }
+    return exif_get_short(entry->data, byteOrder);
+}
+
+// 读取拍摄时间，换算为时间轴使用的挂钟秒数（相机时间不带时区，只用于排序和分组）
+static int64_t ParseExifDateTime(ExifData* exifData) {
+    ExifEntry* entry = exif_data_get_entry(exifData, EXIF_TAG_DATE_TIME_ORIGINAL);
+    if (!entry || !entry->data || entry->size < 19) {
+        entry = exif_data_get_entry(exifData, EXIF_TAG_DATE_TIME);
+    }
+    if (!entry || !entry->data || entry->size < 19) {
+        return 0;
+    }
+    
+    char text[20] = {0};
+    memcpy(text, entry->data, 19);
+    return TimelineIndex::WallClockFromExifText(text);
+}
+
+// 从内存中的EXIF数据块解析摘要
+static bool ParseExifBlob(const unsigned char* data, unsigned long size, PhotoExifMeta& exif) {
+    ExifData* exifData = exif_data_new_from_data(data, static_cast<unsigned int>(size));
+    if (!exifData) {
+        return false;
+    }
+    
+    ExifByteOrder byteOrder = exif_data_get_byte_order(exifData);
+    exif.captureTime = ParseExifDateTime(exifData);
+    exif.exposureTime = GetExifRational(exifData, EXIF_TAG_EXPOSURE_TIME, byteOrder);
+    exif.fNumber = GetExifRational(exifData, EXIF_TAG_FNUMBER, byteOrder);
+    exif.focalLength = GetExifRational(exifData, EXIF_TAG_FOCAL_LENGTH, byteOrder);
+    exif.iso = GetExifShort(exifData, EXIF_TAG_ISO_SPEED_RATINGS, byteOrder, 0);
+    exif.orientation = GetExifShort(exifData, EXIF_TAG_ORIENTATION, byteOrder, 1);
+    
+    exif_data_unref(exifData);
+    return exif.captureTime != 0 || exif.exposureTime > 0 || exif.iso > 0;
+}
+
+ExifHarvester::ExifHarvester()
+    : camera_(nullptr)
+    , context_(nullptr)
+    , scanner_(nullptr)
+    , running_(false)
+    , stopRequested_(false)
+    , exifSupported_(true)
+    , progressCurrent_(0)
+    , progressTotal_(0) {
+}
+
+ExifHarvester::~ExifHarvester() {
+    Cleanup();
+}
+
+void ExifHarvester::Init(Camera* camera, GPContext* context, PhotoScanner* scanner) {
+    Stop();
+    camera_ = camera;
+    context_ = context;
+    scanner_ = scanner;
+    exifSupported_ = true;
+}
+
+void ExifHarvester::Cleanup() {
+    Stop();
+    camera_ = nullptr;
+    context_ = nullptr;
+    scanner_ = nullptr;
+}
+
+bool ExifHarvester::Start() {
+    if (!camera_ || !context_ || !scanner_) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "相机未连接，无法采集EXIF");
+        return false;
+    }
+    if (!scanner_->IsScanComplete()) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "扫描未完成，无法采集EXIF");
+        return false;
+    }
+    if (running_) {
+        return false;
+    }
+    
+    // 回收上一轮已结束的线程
+    if (harvestThread_.joinable()) {
+        harvestThread_.join();
+    }
+    
+    stopRequested_ = false;
+    running_ = true;
+    harvestThread_ = std::thread(&ExifHarvester::HarvestLoop, this);
+    return true;
+}
+
+void ExifHarvester::Stop() {
+    stopRequested_ = true;
+    if (harvestThread_.joinable()) {
+        harvestThread_.join();
+    }
+    running_ = false;
+}
+
+bool ExifHarvester::GetProgress(int& current, int& total) const {
+    current = progressCurrent_;
+    total = progressTotal_;
+    return running_;
+}
+
+std::unique_lock<std::recursive_mutex> ExifHarvester::AcquireIoLowPriority() {
+    std::unique_lock<std::recursive_mutex> lock(GetCameraIoMutex(), std::defer_lock);
+    while (!stopRequested_) {
+        if (lock.try_lock()) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(LOCK_BACKOFF_MS));
+    }
+    return lock;
+}
+
+bool ExifHarvester::HarvestFile(const std::string& folder, const std::string& fileName,
+                                PhotoExifMeta& exif, size_t& fileSize) {
+    fileSize = 0;
+    
+    // 1. 优先只取EXIF数据块
+    if (exifSupported_) {
+        CameraFile* file = nullptr;
+        gp_file_new(&file);
+        
+        int ret;
+        {
+            auto lock = AcquireIoLowPriority();
+            if (!lock.owns_lock()) {
+                gp_file_free(file);
+                return false;
+            }
+            ret = gp_camera_file_get(camera_, folder.c_str(), fileName.c_str(),
+                                     GP_FILE_TYPE_EXIF, file, context_);
+        }
+        
+        if (ret == GP_OK) {
+            const char* data = nullptr;
+            unsigned long size = 0;
+            gp_file_get_data_and_size(file, &data, &size);
+            bool parsed = data && size > 0 &&
+                          ParseExifBlob(reinterpret_cast<const unsigned char*>(data), size, exif);
+            gp_file_free(file);
+            if (parsed) {
+                return true;
+            }
+        } else {
+            gp_file_free(file);
+            if (ret == GP_ERROR_NOT_SUPPORTED) {
+                OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                               "相机不支持读取EXIF数据块，改用文件信息");
+                exifSupported_ = false;
+            }
+        }
+    }
+    
+    // 2. 退化为文件信息（只有修改时间和大小）
+    CameraFileInfo info;
+    memset(&info, 0, sizeof(info));
+    int ret;
+    {
+        auto lock = AcquireIoLowPriority();
+        if (!lock.owns_lock()) {
+            return false;
+        }
+        ret = gp_camera_file_get_info(camera_, folder.c_str(), fileName.c_str(), &info, context_);
+    }
+    if (ret != GP_OK) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, 
+                    "获取文件信息失败: %{public}s/%{public}s, %{public}s",
+                    folder.c_str(), fileName.c_str(), gp_result_as_string(ret));
+        return false;
+    }
+    if (info.file.fields & GP_FILE_INFO_MTIME) {
+        // 修改时间是真实时间戳，转换为与EXIF时间相同的挂钟秒数
+        exif.captureTime = TimelineIndex::WallClockFromEpoch(static_cast<int64_t>(info.file.mtime));
+    }
+    if (info.file.fields & GP_FILE_INFO_SIZE) {
+        fileSize = static_cast<size_t>(info.file.size);
+    }
+    return exif.captureTime != 0;
+}
+
+void ExifHarvester::HarvestLoop() {
+    auto pending = scanner_->GetPendingExifFiles();
+    progressCurrent_ = 0;
+    progressTotal_ = static_cast<int>(pending.size());
+    
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "EXIF采集开始，待处理 %{public}zu 个文件", pending.size());
+    
+    int harvested = 0;
+    for (const auto& file : pending) {
+        if (stopRequested_) {
+            OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "EXIF采集被停止");
+            break;
+        }
+        
+        PhotoExifMeta exif;
+        size_t fileSize = 0;
+        if (HarvestFile(file.first, file.second, exif, fileSize)) {
+            harvested++;
+        } else if (stopRequested_) {
+            break;
+        }
+        // 失败的文件也标记为已采集，避免反复重试拖慢相机
+        exif.loaded = true;
+        scanner_->UpdatePhotoExif(file.first, file.second, exif, fileSize);
+        progressCurrent_++;
+    }
+    
+    // 按EXIF字段排序时，采集结果到齐后重排一次
+    scanner_->ResortCache();
+    
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "EXIF采集结束: 有效 %{public}d/%{public}d", harvested, progressCurrent_.load());
+    running_ = false;
+}
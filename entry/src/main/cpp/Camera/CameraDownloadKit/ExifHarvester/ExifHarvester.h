@@ -0,0 +1,106 @@
+// ExifHarvester.h
+// Created on 2026/1/14.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef EXIF_HARVESTER_H
+#define EXIF_HARVESTER_H
+
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+// libgphoto2头文件
+#include <gphoto2/gphoto2.h>
+#include <gphoto2/gphoto2-camera.h>
+
+class PhotoScanner;
+struct PhotoExifMeta;
+
+/**
+ * @brief EXIF采集器，后台逐个读取相机内文件的EXIF摘要并写回扫描缓存
+ *
+ * 只传输EXIF数据块（不支持时退化为文件信息），以低优先级占用相机：
+ * 每个文件都用try_lock获取相机I/O锁，前台操作等待时让出。
+ */
+class ExifHarvester {
+public:
+    /**
+     * @brief 构造函数
+     */
+    ExifHarvester();
+
+    /**
+     * @brief 析构函数
+     */
+    ~ExifHarvester();
+
+    /**
+     * @brief 初始化采集器
+     * @param camera libgphoto2相机对象
+     * @param context libgphoto2上下文对象
+     * @param scanner 扫描器（提供待采集列表并接收结果）
+     */
+    void Init(Camera* camera, GPContext* context, PhotoScanner* scanner);
+
+    /**
+     * @brief 清理资源（会等待后台线程退出）
+     */
+    void Cleanup();
+
+    /**
+     * @brief 启动后台采集
+     * @return 是否成功启动（已在运行或扫描未完成返回false）
+     */
+    bool Start();
+
+    /**
+     * @brief 停止后台采集并等待线程退出
+     */
+    void Stop();
+
+    /**
+     * @brief 获取采集进度
+     * @param current 已处理数（输出参数）
+     * @param total 本轮待处理总数（输出参数）
+     * @return 是否正在采集
+     */
+    bool GetProgress(int& current, int& total) const;
+
+private:
+    /**
+     * @brief 后台采集循环
+     */
+    void HarvestLoop();
+
+    /**
+     * @brief 采集单个文件
+     * @return 是否取得有效数据
+     */
+    bool HarvestFile(const std::string& folder, const std::string& fileName,
+                     PhotoExifMeta& exif, size_t& fileSize);
+
+    /**
+     * @brief 低优先级获取相机I/O锁：锁被占用时退避重试，直到取得锁或被停止
+     * @return 相机I/O锁（未持有表示已停止）
+     */
+    std::unique_lock<std::recursive_mutex> AcquireIoLowPriority();
+
+private:
+    Camera* camera_;                   // libgphoto2相机对象
+    GPContext* context_;               // libgphoto2上下文对象
+    PhotoScanner* scanner_;            // 扫描器（不持有）
+
+    std::thread harvestThread_;        // 采集线程
+    std::atomic<bool> running_;        // 是否正在采集
+    std::atomic<bool> stopRequested_;  // 是否请求停止
+    std::atomic<bool> exifSupported_;  // 相机是否支持GP_FILE_TYPE_EXIF
+    std::atomic<int> progressCurrent_; // 已处理数
+    std::atomic<int> progressTotal_;   // 待处理总数
+
+    static constexpr int LOCK_BACKOFF_MS = 20;  // 相机忙时的退避间隔
+};
+
+#endif // EXIF_HARVESTER_H
@@ -0,0 +1,264 @@
+// FolderTree.cpp
+// Created on 2026/1/16.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "FolderTree.h"
+#include "../../Common/native_common.h"
+#include "gphoto2/gphoto2-list.h"
+#include "gphoto2/gphoto2-port-result.h"
+#include <hilog/log.h>
+#include <algorithm>
+#include <chrono>
+#include <Camera/Common/Constants.h>
+
+#define LOG_DOMAIN ModuleLogs::FolderTree.domain
+#define LOG_TAG ModuleLogs::FolderTree.tag
+
+// 读取CameraList中的全部名称
+static std::vector<std::string> ListToNames(CameraList* list) {
+    std::vector<std::string> names;
+    int count = gp_list_count(list);
+    names.reserve(count > 0 ? count : 0);
+    for (int i = 0; i < count; i++) {
+        const char* name = nullptr;
+        if (gp_list_get_name(list, i, &name) == GP_OK && name) {
+            names.emplace_back(name);
+        }
+    }
+    return names;
+}
+
+FolderTree::FolderTree()
+    : camera_(nullptr)
+    , context_(nullptr)
+    , generation_(1)
+    , cacheHits_(0)
+    , cacheMisses_(0)
+    , stopPrefetch_(true) {
+}
+
+FolderTree::~FolderTree() {
+    Cleanup();
+}
+
+void FolderTree::Init(Camera* camera, GPContext* context) {
+    Cleanup();
+    camera_ = camera;
+    context_ = context;
+    
+    stopPrefetch_ = false;
+    prefetchThread_ = std::thread(&FolderTree::PrefetchLoop, this);
+}
+
+void FolderTree::Cleanup() {
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex_);
+        stopPrefetch_ = true;
+        prefetchQueue_.clear();
+    }
+    prefetchCv_.notify_all();
+    if (prefetchThread_.joinable()) {
+        prefetchThread_.join();
+    }
+    
+    Invalidate();
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        cache_.clear();
+    }
+    camera_ = nullptr;
+    context_ = nullptr;
+}
+
+std::string FolderTree::ParentOf(const std::string& path) {
+    size_t pos = path.find_last_of('/');
+    if (pos == std::string::npos || pos == 0) {
+        return "/";
+    }
+    return path.substr(0, pos);
+}
+
+std::string FolderTree::JoinPath(const std::string& parent, const std::string& name) {
+    if (!parent.empty() && parent.back() == '/') {
+        return parent + name;
+    }
+    return parent + "/" + name;
+}
+
+bool FolderTree::LookupLocked(const std::string& path, FolderListing& listing) const {
+    auto it = cache_.find(path);
+    if (it == cache_.end() || !it->second.valid || it->second.generation < generation_) {
+        return false;
+    }
+    listing = it->second;
+    return true;
+}
+
+FolderListing FolderTree::ListFolder(const std::string& path, bool refresh) {
+    FolderListing listing;
+    if (!refresh) {
+        bool hit;
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+            hit = LookupLocked(path, listing);
+        }
+        if (hit) {
+            cacheHits_++;
+            SchedulePrefetch(listing);
+            return listing;
+        }
+    }
+    
+    cacheMisses_++;
+    listing = FetchFolder(path, false);
+    if (listing.valid) {
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+            cache_[path] = listing;
+        }
+        SchedulePrefetch(listing);
+    }
+    return listing;
+}
+
+FolderListing FolderTree::FetchFolder(const std::string& path, bool prefetch) {
+    FolderListing listing;
+    listing.path = path;
+    // 以开始列出时的代数为准，期间发生的失效会使本次结果直接过期
+    listing.generation = generation_;
+    
+    if (!camera_ || !context_) {
+        return listing;
+    }
+    
+    CameraList* folders = nullptr;
+    CameraList* files = nullptr;
+    gp_list_new(&folders);
+    gp_list_new(&files);
+    
+    int ret;
+    {
+        std::unique_lock<std::recursive_mutex> ioLock(GetCameraIoMutex(), std::defer_lock);
+        if (prefetch) {
+            // 预取以低优先级占用相机，前台操作等待时让出
+            while (!ioLock.try_lock()) {
+                if (stopPrefetch_) {
+                    gp_list_free(folders);
+                    gp_list_free(files);
+                    return listing;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(LOCK_BACKOFF_MS));
+            }
+        } else {
+            ioLock.lock();
+        }
+        
+        ret = gp_camera_folder_list_folders(camera_, path.c_str(), folders, context_);
+        if (ret == GP_OK) {
+            ret = gp_camera_folder_list_files(camera_, path.c_str(), files, context_);
+        }
+    }
+    
+    if (ret == GP_OK) {
+        listing.folders = ListToNames(folders);
+        listing.files = ListToNames(files);
+        listing.valid = true;
+    } else {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, 
+                    "列出目录失败: %{public}s, %{public}s", path.c_str(), gp_result_as_string(ret));
+    }
+    
+    gp_list_free(folders);
+    gp_list_free(files);
+    return listing;
+}
+
+void FolderTree::SchedulePrefetch(const FolderListing& listing) {
+    std::vector<std::string> targets;
+    
+    // 1. 兄弟目录（父目录已缓存时才知道）
+    std::string parent = ParentOf(listing.path);
+    if (parent != listing.path) {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        FolderListing parentListing;
+        if (LookupLocked(parent, parentListing)) {
+            for (const auto& name : parentListing.folders) {
+                std::string sibling = JoinPath(parent, name);
+                if (sibling != listing.path) {
+                    targets.push_back(sibling);
+                }
+            }
+        }
+    }
+    
+    // 2. 子目录
+    for (const auto& name : listing.folders) {
+        targets.push_back(JoinPath(listing.path, name));
+    }
+    
+    if (targets.empty()) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex_);
+        if (stopPrefetch_) {
+            return;
+        }
+        for (const auto& target : targets) {
+            if (prefetchQueue_.size() >= MAX_PREFETCH_QUEUE) {
+                break;
+            }
+            if (std::find(prefetchQueue_.begin(), prefetchQueue_.end(), target) == prefetchQueue_.end()) {
+                prefetchQueue_.push_back(target);
+            }
+        }
+    }
+    prefetchCv_.notify_one();
+}
+
+void FolderTree::PrefetchLoop() {
+    while (true) {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(prefetchMutex_);
+            prefetchCv_.wait(lock, [this] { return stopPrefetch_ || !prefetchQueue_.empty(); });
+            if (stopPrefetch_) {
+                return;
+            }
+            path = prefetchQueue_.front();
+            prefetchQueue_.pop_front();
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+            FolderListing cached;
+            if (LookupLocked(path, cached)) {
+                continue;
+            }
+        }
+        
+        // 预取结果只入缓存，不再递归预取，避免遍历整张卡
+        FolderListing listing = FetchFolder(path, true);
+        if (listing.valid) {
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+            cache_[path] = listing;
+        }
+    }
+}
+
+void FolderTree::Invalidate() {
+    generation_++;
+}
+
+void FolderTree::InvalidateFolder(const std::string& path) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    cache_.erase(path);
+}
+
+void FolderTree::GetCacheStats(uint64_t& hits, uint64_t& misses) const {
+    hits = cacheHits_;
+    misses = cacheMisses_;
+}
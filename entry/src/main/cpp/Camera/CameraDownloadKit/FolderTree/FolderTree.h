@@ -0,0 +1,134 @@
+// FolderTree.h
+// Created on 2026/1/16.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef FOLDER_TREE_H
+#define FOLDER_TREE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+
+// libgphoto2头文件
+#include <gphoto2/gphoto2.h>
+#include <gphoto2/gphoto2-camera.h>
+
+/**
+ * @brief 单个相机目录的列表结果
+ */
+struct FolderListing {
+    std::string path;                   // 目录绝对路径
+    std::vector<std::string> folders;   // 子目录名
+    std::vector<std::string> files;     // 文件名
+    uint64_t generation = 0;            // 列出时的代数，小于当前代数即过期
+    bool valid = false;                 // 是否列出成功
+};
+
+/**
+ * @brief 相机目录树模型：按需列出目录，缓存每个目录的结果，空闲时预取兄弟目录
+ *
+ * 缓存以代数判定新旧：Invalidate()使全部缓存过期，InvalidateFolder()只使单个目录过期。
+ */
+class FolderTree {
+public:
+    /**
+     * @brief 构造函数
+     */
+    FolderTree();
+
+    /**
+     * @brief 析构函数
+     */
+    ~FolderTree();
+
+    /**
+     * @brief 初始化目录树并启动预取线程
+     * @param camera libgphoto2相机对象
+     * @param context libgphoto2上下文对象
+     */
+    void Init(Camera* camera, GPContext* context);
+
+    /**
+     * @brief 清理资源（停止预取线程并清空缓存）
+     */
+    void Cleanup();
+
+    /**
+     * @brief 列出目录，命中缓存时不访问相机；随后在空闲时预取兄弟目录和子目录
+     * @param path 目录绝对路径（如"/store_00010001/DCIM"）
+     * @param refresh 是否忽略缓存重新列出
+     * @return 目录列表结果
+     */
+    FolderListing ListFolder(const std::string& path, bool refresh = false);
+
+    /**
+     * @brief 使全部缓存过期（如更换存储卡后）
+     */
+    void Invalidate();
+
+    /**
+     * @brief 使单个目录的缓存过期（如联机拍摄新增文件后）
+     * @param path 目录绝对路径
+     */
+    void InvalidateFolder(const std::string& path);
+
+    /**
+     * @brief 缓存命中统计
+     * @param hits 命中次数（输出参数）
+     * @param misses 未命中次数（输出参数）
+     */
+    void GetCacheStats(uint64_t& hits, uint64_t& misses) const;
+
+private:
+    /**
+     * @brief 访问相机列出目录（prefetch为true时以低优先级获取相机I/O锁）
+     */
+    FolderListing FetchFolder(const std::string& path, bool prefetch);
+
+    /**
+     * @brief 查询缓存（调用方需持有cacheMutex_）
+     */
+    bool LookupLocked(const std::string& path, FolderListing& listing) const;
+
+    /**
+     * @brief 将兄弟目录和子目录加入预取队列
+     */
+    void SchedulePrefetch(const FolderListing& listing);
+
+    /**
+     * @brief 预取线程循环
+     */
+    void PrefetchLoop();
+
+    static std::string ParentOf(const std::string& path);
+    static std::string JoinPath(const std::string& parent, const std::string& name);
+
+private:
+    Camera* camera_;                   // libgphoto2相机对象
+    GPContext* context_;               // libgphoto2上下文对象
+
+    mutable std::mutex cacheMutex_;                         // 缓存互斥锁
+    std::unordered_map<std::string, FolderListing> cache_;  // 路径 -> 列表结果
+    std::atomic<uint64_t> generation_;                      // 当前代数
+    std::atomic<uint64_t> cacheHits_;
+    std::atomic<uint64_t> cacheMisses_;
+
+    std::mutex prefetchMutex_;                 // 预取队列互斥锁
+    std::condition_variable prefetchCv_;       // 预取队列条件变量
+    std::deque<std::string> prefetchQueue_;    // 待预取目录
+    std::thread prefetchThread_;               // 预取线程
+    std::atomic<bool> stopPrefetch_;           // 是否停止预取
+
+    static const size_t MAX_PREFETCH_QUEUE = 64;   // 预取队列上限
+    static constexpr int LOCK_BACKOFF_MS = 20;        // 相机忙时的退避间隔
+};
+
+#endif // FOLDER_TREE_H
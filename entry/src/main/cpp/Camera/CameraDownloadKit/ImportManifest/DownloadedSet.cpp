@@ -0,0 +1,361 @@
+// DownloadedSet.cpp
+// Created on 2026/1/18.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "DownloadedSet.h"
+#include "ImportManifest.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/CameraDownloadKit/PhotoDownloader/AtomicFileWriter.h"
+#include <hilog/log.h>
+#include <cstring>
+#include <fstream>
+#include <Camera/Common/Constants.h>
+
+#define LOG_DOMAIN ModuleLogs::DownloadedSet.domain
+#define LOG_TAG ModuleLogs::DownloadedSet.tag
+
+// 文件格式：魔数 + 版本 + 布隆参数 + 位图指纹/位数，随后是布隆位数组和位图
+static const char DOWNLOADED_SET_MAGIC[4] = {'P', 'S', 'D', 'S'};
+static const uint32_t DOWNLOADED_SET_VERSION = 1;
+// 2^19位（64KB）、7个哈希，约5万个文件时误判率约1%
+static const uint32_t BLOOM_BITS = 1u << 19;
+static const uint32_t BLOOM_HASH_COUNT = 7;
+static const uint32_t NO_SCAN_INDEX = UINT32_MAX;
+
+#pragma pack(push, 1)
+struct DownloadedSetHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t bloomBits;
+    uint32_t hashCount;
+    uint64_t fingerprint;
+    uint32_t bitmapBits;
+};
+#pragma pack(pop)
+
+DownloadedSet::DownloadedSet()
+    : bitmapBits_(0)
+    , fingerprint_(0)
+    , dirty_(false) {
+}
+
+DownloadedSet::~DownloadedSet() {
+    Close();
+}
+
+bool DownloadedSet::Open(const std::string& dir, const std::string& cameraSerial, const ImportManifest* manifest) {
+    // 序列号中可能含空格等字符，仅保留字母数字作为文件名
+    std::string safeSerial;
+    for (char c : cameraSerial) {
+        bool alnum = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        safeSerial.push_back(alnum ? c : '_');
+    }
+    if (safeSerial.empty()) {
+        safeSerial = "unknown";
+    }
+    std::string path = dir;
+    if (!path.empty() && path.back() != '/') {
+        path.push_back('/');
+    }
+    path += "downloaded_" + safeSerial + ".bin";
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (path == filePath_) {
+        return true;
+    }
+    if (!filePath_.empty() && dirty_) {
+        SaveLocked();
+    }
+
+    filePath_ = path;
+    dirty_ = false;
+    bloom_.assign(BLOOM_BITS / 8, 0);
+    bitmap_.clear();
+    bitmapBits_ = 0;
+    fingerprint_ = 0;
+    indexByKey_.clear();
+
+    if (LoadLocked()) {
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                     "已下载集合加载完成: %{public}s", filePath_.c_str());
+        return true;
+    }
+
+    // 首次使用：从导入清单中该相机的记录初始化
+    size_t seeded = 0;
+    if (manifest) {
+        for (const auto& record : manifest->GetRecordsForCamera(cameraSerial)) {
+            BloomAddLocked(MakeKey(record.folder, record.fileName));
+            seeded++;
+        }
+    }
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                 "新建已下载集合: %{public}s, 从导入清单导入 %{public}zu 条", filePath_.c_str(), seeded);
+    return SaveLocked();
+}
+
+bool DownloadedSet::IsOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !filePath_.empty();
+}
+
+void DownloadedSet::Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (filePath_.empty()) {
+        return;
+    }
+    if (dirty_) {
+        SaveLocked();
+    }
+    filePath_.clear();
+    dirty_ = false;
+    bloom_.clear();
+    bitmap_.clear();
+    bitmapBits_ = 0;
+    fingerprint_ = 0;
+    indexByKey_.clear();
+}
+
+void DownloadedSet::BindIndex(const std::vector<PhotoMeta>& scanList) {
+    uint64_t fingerprint = ComputeFingerprint(scanList);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (filePath_.empty()) {
+        return;
+    }
+
+    indexByKey_.clear();
+    indexByKey_.reserve(scanList.size() * 2);
+    for (const auto& meta : scanList) {
+        indexByKey_[MakeKey(meta.folder, meta.fileName)] = meta.scanIndex;
+        if (!meta.pairedFileName.empty()) {
+            indexByKey_[MakeKey(meta.folder, meta.pairedFileName)] = meta.scanIndex;
+        }
+    }
+
+    uint32_t bits = static_cast<uint32_t>(scanList.size());
+    if (fingerprint == fingerprint_ && bits == bitmapBits_) {
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                     "扫描列表未变化，沿用已保存位图（%{public}u 项）", bits);
+        return;
+    }
+
+    // 列表变化：按布隆过滤器重建位图
+    bitmapBits_ = bits;
+    fingerprint_ = fingerprint;
+    bitmap_.assign((bits + 7) / 8, 0);
+    uint32_t downloaded = 0;
+    for (const auto& meta : scanList) {
+        bool hit = BloomTestLocked(MakeKey(meta.folder, meta.fileName));
+        if (!hit && !meta.pairedFileName.empty()) {
+            hit = BloomTestLocked(MakeKey(meta.folder, meta.pairedFileName));
+        }
+        if (hit) {
+            SetBitLocked(meta.scanIndex);
+            downloaded++;
+        }
+    }
+    SaveLocked();
+
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                 "重建已下载位图: %{public}u/%{public}u 项已下载", downloaded, bits);
+}
+
+void DownloadedSet::AddIndex(const PhotoMeta& meta) {
+    std::string key = MakeKey(meta.folder, meta.fileName);
+    std::string pairedKey = meta.pairedFileName.empty() ? std::string() : MakeKey(meta.folder, meta.pairedFileName);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (filePath_.empty() || meta.scanIndex == NO_SCAN_INDEX) {
+        return;
+    }
+    indexByKey_[key] = meta.scanIndex;
+    if (!pairedKey.empty()) {
+        indexByKey_[pairedKey] = meta.scanIndex;
+    }
+    if (meta.scanIndex >= bitmapBits_) {
+        bitmapBits_ = meta.scanIndex + 1;
+        bitmap_.resize((bitmapBits_ + 7) / 8, 0);
+        // 位图已不对应任何一次完整扫描，下次绑定时按布隆过滤器重建
+        fingerprint_ = 0;
+    }
+    // 以前导入过的文件（如拷回存储卡）按布隆过滤器恢复标记
+    if (BloomTestLocked(key) || (!pairedKey.empty() && BloomTestLocked(pairedKey))) {
+        SetBitLocked(meta.scanIndex);
+    }
+}
+
+void DownloadedSet::MarkDownloaded(const std::string& folder, const std::string& fileName) {
+    std::string key = MakeKey(folder, fileName);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (filePath_.empty()) {
+        return;
+    }
+    bool changed = BloomAddLocked(key);
+    auto it = indexByKey_.find(key);
+    if (it != indexByKey_.end()) {
+        changed = SetBitLocked(it->second) || changed;
+    }
+    // 批量下载时每个文件都写一次（整文件重写+fdatasync）代价太高，只记下有变化，由Flush写回
+    dirty_ = dirty_ || changed;
+}
+
+void DownloadedSet::Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (filePath_.empty() || !dirty_) {
+        return;
+    }
+    SaveLocked();
+}
+
+bool DownloadedSet::IsDownloaded(uint32_t scanIndex) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return TestBitLocked(scanIndex);
+}
+
+bool DownloadedSet::MayContain(const std::string& folder, const std::string& fileName) const {
+    std::string key = MakeKey(folder, fileName);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !bloom_.empty() && BloomTestLocked(key);
+}
+
+bool DownloadedSet::IsDownloaded(const std::string& folder, const std::string& fileName) const {
+    std::string key = MakeKey(folder, fileName);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = indexByKey_.find(key);
+    if (it != indexByKey_.end()) {
+        return TestBitLocked(it->second);
+    }
+    return !bloom_.empty() && BloomTestLocked(key);
+}
+
+std::string DownloadedSet::MakeKey(const std::string& folder, const std::string& fileName) {
+    std::string key;
+    key.reserve(folder.size() + fileName.size() + 1);
+    key.append(folder).append(1, '/').append(fileName);
+    return key;
+}
+
+uint64_t DownloadedSet::HashKey(const std::string& key) {
+    // FNV-1a 64位
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t DownloadedSet::ComputeFingerprint(const std::vector<PhotoMeta>& scanList) {
+    uint64_t fingerprint = 14695981039346656037ULL;
+    for (const auto& meta : scanList) {
+        uint64_t hash = HashKey(MakeKey(meta.folder, meta.fileName)) ^ HashKey(meta.pairedFileName);
+        fingerprint = (fingerprint ^ hash) * 1099511628211ULL;
+        fingerprint ^= meta.scanIndex;
+    }
+    return fingerprint;
+}
+
+bool DownloadedSet::BloomAddLocked(const std::string& key) {
+    // 双重哈希：h1 + i*h2，h2取高位并保证为奇数
+    uint64_t hash = HashKey(key);
+    uint64_t h1 = hash;
+    uint64_t h2 = (hash >> 32) | 1;
+    bool changed = false;
+    for (uint32_t i = 0; i < BLOOM_HASH_COUNT; i++) {
+        uint32_t bit = static_cast<uint32_t>((h1 + i * h2) % BLOOM_BITS);
+        uint8_t mask = static_cast<uint8_t>(1u << (bit & 7));
+        changed = changed || !(bloom_[bit >> 3] & mask);
+        bloom_[bit >> 3] |= mask;
+    }
+    return changed;
+}
+
+bool DownloadedSet::BloomTestLocked(const std::string& key) const {
+    uint64_t hash = HashKey(key);
+    uint64_t h1 = hash;
+    uint64_t h2 = (hash >> 32) | 1;
+    for (uint32_t i = 0; i < BLOOM_HASH_COUNT; i++) {
+        uint32_t bit = static_cast<uint32_t>((h1 + i * h2) % BLOOM_BITS);
+        if (!(bloom_[bit >> 3] & (1u << (bit & 7)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DownloadedSet::SetBitLocked(uint32_t scanIndex) {
+    if (scanIndex == NO_SCAN_INDEX || scanIndex >= bitmapBits_) {
+        return false;
+    }
+    uint8_t mask = static_cast<uint8_t>(1u << (scanIndex & 7));
+    bool changed = !(bitmap_[scanIndex >> 3] & mask);
+    bitmap_[scanIndex >> 3] |= mask;
+    return changed;
+}
+
+bool DownloadedSet::TestBitLocked(uint32_t scanIndex) const {
+    if (scanIndex == NO_SCAN_INDEX || scanIndex >= bitmapBits_) {
+        return false;
+    }
+    return (bitmap_[scanIndex >> 3] & (1u << (scanIndex & 7))) != 0;
+}
+
+bool DownloadedSet::LoadLocked() {
+    std::ifstream inFile(filePath_, std::ios::binary);
+    if (!inFile.is_open()) {
+        return false;
+    }
+
+    DownloadedSetHeader header;
+    if (!inFile.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, DOWNLOADED_SET_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != DOWNLOADED_SET_VERSION ||
+        header.bloomBits != BLOOM_BITS || header.hashCount != BLOOM_HASH_COUNT) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG,
+                     "已下载集合文件格式不匹配，将重建: %{public}s", filePath_.c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> bloom(BLOOM_BITS / 8);
+    std::vector<uint8_t> bitmap((header.bitmapBits + 7) / 8);
+    if (!inFile.read(reinterpret_cast<char*>(bloom.data()), bloom.size()) ||
+        !inFile.read(reinterpret_cast<char*>(bitmap.data()), bitmap.size())) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG,
+                     "已下载集合文件不完整，将重建: %{public}s", filePath_.c_str());
+        return false;
+    }
+
+    bloom_.swap(bloom);
+    bitmap_.swap(bitmap);
+    bitmapBits_ = header.bitmapBits;
+    fingerprint_ = header.fingerprint;
+    return true;
+}
+
+bool DownloadedSet::SaveLocked() {
+    DownloadedSetHeader header;
+    memcpy(header.magic, DOWNLOADED_SET_MAGIC, sizeof(header.magic));
+    header.version = DOWNLOADED_SET_VERSION;
+    header.bloomBits = BLOOM_BITS;
+    header.hashCount = BLOOM_HASH_COUNT;
+    header.fingerprint = fingerprint_;
+    header.bitmapBits = bitmapBits_;
+
+    uint64_t totalSize = sizeof(header) + bloom_.size() + bitmap_.size();
+    AtomicFileWriter writer;
+    if (!writer.Open(filePath_, totalSize, false) ||
+        !writer.Write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+        !writer.Write(reinterpret_cast<const char*>(bloom_.data()), bloom_.size()) ||
+        (!bitmap_.empty() && !writer.Write(reinterpret_cast<const char*>(bitmap_.data()), bitmap_.size())) ||
+        !writer.Commit()) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG,
+                     "写入已下载集合失败: %{public}s", writer.GetLastError().c_str());
+        return false;
+    }
+    dirty_ = false;
+    return true;
+}
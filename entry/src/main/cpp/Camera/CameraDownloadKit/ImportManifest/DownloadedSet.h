@@ -0,0 +1,112 @@
+// DownloadedSet.h
+// Created on 2026/1/18.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef DOWNLOADED_SET_H
+#define DOWNLOADED_SET_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct PhotoMeta;
+class ImportManifest;
+
+/**
+ * @brief 单台相机的"已下载"集合
+ * @details 由两部分组成，按相机序列号持久化为一个二进制文件：
+ *          1. 位图：以扫描下标为位号，列表渲染时按位查询，无需逐项查清单
+ *          2. 布隆过滤器：以"目录/文件名"为键，覆盖不在当前扫描列表中的文件，
+ *             重新扫描后用它重建位图（可能有极低的误判，不会漏判）
+ */
+class DownloadedSet {
+public:
+    DownloadedSet();
+    ~DownloadedSet();
+
+    /**
+     * @brief 打开指定相机的集合文件（不存在时新建）
+     * @param dir 保存目录（与导入清单同目录）
+     * @param cameraSerial 相机序列号
+     * @param manifest 导入清单，集合为空时用其中的记录初始化（可为nullptr）
+     * @return 是否打开成功
+     */
+    bool Open(const std::string& dir, const std::string& cameraSerial, const ImportManifest* manifest);
+
+    /**
+     * @brief 集合是否已打开
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief 关闭集合（写回文件并清空内存）
+     */
+    void Close();
+
+    /**
+     * @brief 绑定新的扫描列表，按PhotoMeta::scanIndex重建位图
+     * @details 列表与上次保存时一致（指纹相同）时直接沿用已保存的位图
+     * @param scanList 扫描得到的文件列表（RAW+JPEG配对已合并）
+     */
+    void BindIndex(const std::vector<PhotoMeta>& scanList);
+
+    /**
+     * @brief 扫描后增量加入的条目（联机拍摄新增、补上配对文件）登记到位图
+     * @details 新条目的扫描下标超出绑定时的列表长度，位图随之扩展
+     * @param meta 新增或合并后的条目
+     */
+    void AddIndex(const PhotoMeta& meta);
+
+    /**
+     * @brief 标记文件已下载（只更新内存中的布隆过滤器和位图，由Flush统一写回文件）
+     */
+    void MarkDownloaded(const std::string& folder, const std::string& fileName);
+
+    /**
+     * @brief 有未保存的标记时写回文件（批量下载结束、单个下载完成时调用，Close时也会写回）
+     */
+    void Flush();
+
+    /**
+     * @brief 按扫描下标查询是否已下载（O(1)，供列表批量返回）
+     */
+    bool IsDownloaded(uint32_t scanIndex) const;
+
+    /**
+     * @brief 按文件查询是否可能已下载（布隆过滤器，不在扫描列表中的文件使用）
+     */
+    bool MayContain(const std::string& folder, const std::string& fileName) const;
+
+    /**
+     * @brief 按文件查询是否已下载：在扫描列表中的查位图，否则查布隆过滤器（不会漏判）
+     */
+    bool IsDownloaded(const std::string& folder, const std::string& fileName) const;
+
+private:
+    static std::string MakeKey(const std::string& folder, const std::string& fileName);
+    static uint64_t HashKey(const std::string& key);
+    static uint64_t ComputeFingerprint(const std::vector<PhotoMeta>& scanList);
+
+    bool BloomAddLocked(const std::string& key);
+    bool BloomTestLocked(const std::string& key) const;
+    bool SetBitLocked(uint32_t scanIndex);
+    bool TestBitLocked(uint32_t scanIndex) const;
+    bool LoadLocked();
+    bool SaveLocked();
+
+private:
+    std::string filePath_;                                // 集合文件路径（为空表示未打开）
+    std::vector<uint8_t> bloom_;                          // 布隆过滤器位数组
+    std::vector<uint8_t> bitmap_;                         // 扫描下标位图
+    uint32_t bitmapBits_;                                 // 位图有效位数（扫描列表长度）
+    uint64_t fingerprint_;                                // 位图对应扫描列表的指纹
+    bool dirty_;                                          // 是否有未写回文件的标记
+    std::unordered_map<std::string, uint32_t> indexByKey_; // 目录/文件名 → 扫描下标
+    mutable std::mutex mutex_;                            // 保护以上成员
+};
+
+#endif // DOWNLOADED_SET_H
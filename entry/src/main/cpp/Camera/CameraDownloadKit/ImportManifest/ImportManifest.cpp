@@ -0,0 +1,230 @@
+// ImportManifest.cpp
+// Created on 2026/1/6.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "ImportManifest.h"
+#include <hilog/log.h>
+#include <cinttypes>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <Camera/Common/Constants.h>
+
+#define LOG_DOMAIN ModuleLogs::ImportManifest.domain
+#define LOG_TAG ModuleLogs::ImportManifest.tag
+
+// 每行字段数：serial folder name size mtime crc32 localPath
+static const size_t MANIFEST_FIELD_COUNT = 7;
+
+ImportManifest::ImportManifest() {
+}
+
+ImportManifest::~ImportManifest() {
+}
+
+bool ImportManifest::Open(const std::string& manifestPath) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    manifestPath_ = manifestPath;
+    records_.clear();
+    latestByName_.clear();
+    byContent_.clear();
+
+    std::ifstream inFile(manifestPath_);
+    if (!inFile.is_open()) {
+        // 首次使用时文件不存在，属于正常情况
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                     "导入清单不存在，将新建: %{public}s", manifestPath_.c_str());
+        return true;
+    }
+
+    std::string line;
+    int badLines = 0;
+    int unkeyedLines = 0;
+    while (std::getline(inFile, line)) {
+        if (line.empty()) continue;
+        ImportRecord record;
+        if (!ParseLine(line, record)) {
+            badLines++;
+            continue;
+        }
+        // 旧版本在读不到文件信息时写入的0/0记录会与同名的其他文件撞键
+        if (!HasFileIdentity(record)) {
+            unkeyedLines++;
+            continue;
+        }
+        std::string key = MakeKey(record);
+        records_[key] = record;
+        IndexLocked(key, record);
+    }
+
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                 "导入清单加载完成: %{public}zu 条记录, 跳过 %{public}d 行损坏记录, %{public}d 行缺少文件信息",
+                 records_.size(), badLines, unkeyedLines);
+    return true;
+}
+
+bool ImportManifest::IsOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !manifestPath_.empty();
+}
+
+bool ImportManifest::Lookup(const ImportRecord& record, ImportRecord* outRecord) const {
+    if (!HasFileIdentity(record)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(MakeKey(record));
+    if (it == records_.end()) {
+        return false;
+    }
+    if (outRecord) {
+        *outRecord = it->second;
+    }
+    return true;
+}
+
+bool ImportManifest::LookupByContent(const ImportRecord& record, ImportRecord* outRecord) const {
+    char crcBuf[16] = {0};
+    snprintf(crcBuf, sizeof(crcBuf), "%08" PRIx32, record.crc32);
+    std::string contentKey = MakeNameKey(record.cameraSerial, record.folder, record.fileName);
+    contentKey.append(1, '|').append(crcBuf);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = byContent_.find(contentKey);
+    if (it == byContent_.end()) {
+        return false;
+    }
+    if (outRecord) {
+        *outRecord = records_.at(it->second);
+    }
+    return true;
+}
+
+bool ImportManifest::LookupLatest(const std::string& cameraSerial, const std::string& folder,
+                                  const std::string& fileName, ImportRecord* outRecord) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = latestByName_.find(MakeNameKey(cameraSerial, folder, fileName));
+    if (it == latestByName_.end()) {
+        return false;
+    }
+    if (outRecord) {
+        *outRecord = records_.at(it->second);
+    }
+    return true;
+}
+
+bool ImportManifest::Record(const ImportRecord& record) {
+    if (!HasFileIdentity(record)) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG,
+                     "文件信息缺失，不写入导入清单: %{public}s/%{public}s",
+                     record.folder.c_str(), record.fileName.c_str());
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string key = MakeKey(record);
+    records_[key] = record;
+    IndexLocked(key, record);
+
+    if (manifestPath_.empty()) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "导入清单未打开，记录仅保存在内存中");
+        return false;
+    }
+
+    std::ofstream outFile(manifestPath_, std::ios::app);
+    if (!outFile.is_open()) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG,
+                     "无法写入导入清单: %{public}s", manifestPath_.c_str());
+        return false;
+    }
+    outFile << FormatLine(record) << '\n';
+    outFile.flush();
+    return outFile.good();
+}
+
+size_t ImportManifest::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_.size();
+}
+
+std::vector<ImportRecord> ImportManifest::GetRecordsForCamera(const std::string& cameraSerial) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ImportRecord> result;
+    for (const auto& entry : records_) {
+        if (entry.second.cameraSerial == cameraSerial) {
+            result.push_back(entry.second);
+        }
+    }
+    return result;
+}
+
+std::string ImportManifest::MakeKey(const ImportRecord& record) {
+    std::string key;
+    key.reserve(record.cameraSerial.size() + record.folder.size() + record.fileName.size() + 48);
+    key.append(record.cameraSerial).append(1, '|');
+    key.append(record.folder).append(1, '|');
+    key.append(record.fileName).append(1, '|');
+    key.append(std::to_string(record.fileSize)).append(1, '|');
+    key.append(std::to_string(static_cast<long long>(record.mtime)));
+    return key;
+}
+
+bool ImportManifest::HasFileIdentity(const ImportRecord& record) {
+    return record.fileSize > 0 && record.mtime > 0;
+}
+
+std::string ImportManifest::MakeNameKey(const std::string& cameraSerial, const std::string& folder,
+                                        const std::string& fileName) {
+    std::string key;
+    key.reserve(cameraSerial.size() + folder.size() + fileName.size() + 12);
+    key.append(cameraSerial).append(1, '|');
+    key.append(folder).append(1, '|');
+    key.append(fileName);
+    return key;
+}
+
+void ImportManifest::IndexLocked(const std::string& key, const ImportRecord& record) {
+    std::string nameKey = MakeNameKey(record.cameraSerial, record.folder, record.fileName);
+    char crcBuf[16] = {0};
+    snprintf(crcBuf, sizeof(crcBuf), "%08" PRIx32, record.crc32);
+    byContent_[nameKey + "|" + crcBuf] = key;
+    latestByName_[std::move(nameKey)] = key;
+}
+
+bool ImportManifest::ParseLine(const std::string& line, ImportRecord& record) {
+    std::vector<std::string> fields;
+    std::string field;
+    std::istringstream stream(line);
+    while (std::getline(stream, field, '\t')) {
+        fields.push_back(field);
+    }
+    if (fields.size() != MANIFEST_FIELD_COUNT) {
+        return false;
+    }
+
+    record.cameraSerial = fields[0];
+    record.folder = fields[1];
+    record.fileName = fields[2];
+    record.fileSize = strtoull(fields[3].c_str(), nullptr, 10);
+    record.mtime = static_cast<time_t>(strtoll(fields[4].c_str(), nullptr, 10));
+    record.crc32 = static_cast<uint32_t>(strtoul(fields[5].c_str(), nullptr, 16));
+    record.localPath = fields[6];
+    return !record.fileName.empty();
+}
+
+std::string ImportManifest::FormatLine(const ImportRecord& record) {
+    char crcBuf[16] = {0};
+    snprintf(crcBuf, sizeof(crcBuf), "%08" PRIx32, record.crc32);
+
+    std::string line;
+    line.append(record.cameraSerial).append(1, '\t');
+    line.append(record.folder).append(1, '\t');
+    line.append(record.fileName).append(1, '\t');
+    line.append(std::to_string(record.fileSize)).append(1, '\t');
+    line.append(std::to_string(static_cast<long long>(record.mtime))).append(1, '\t');
+    line.append(crcBuf).append(1, '\t');
+    line.append(record.localPath);
+    return line;
+}
@@ -0,0 +1,121 @@
+// ImportManifest.h
+// Created on 2026/1/6.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef IMPORT_MANIFEST_H
+#define IMPORT_MANIFEST_H
+
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 导入清单中的一条记录
+ * @details 以"相机序列号/目录/文件名/大小/修改时间"作为键，唯一标识相机内的一个文件
+ */
+struct ImportRecord {
+    std::string cameraSerial;  // 相机序列号
+    std::string folder;        // 相机内目录
+    std::string fileName;      // 文件名
+    uint64_t fileSize;         // 文件大小（字节）
+    time_t mtime;              // 相机内文件修改时间
+    uint32_t crc32;            // 下载时边传边算的CRC32校验值
+    std::string localPath;     // 本地保存路径
+};
+
+/**
+ * @brief 导入清单，记录已经下载到手机的相机文件
+ * @details 清单以追加写的文本文件持久化（每行一条记录，字段以\t分隔），
+ *          加载时后出现的记录覆盖先出现的同键记录，进程崩溃最多丢失最后一行。
+ *          读不到文件信息（大小或修改时间为0）的文件无法与同名的其他文件区分，
+ *          既不写入清单也不按键查询，下载后只能按CRC32与已有记录比对（LookupByContent）
+ */
+class ImportManifest {
+public:
+    ImportManifest();
+    ~ImportManifest();
+
+    /**
+     * @brief 打开（或创建）清单文件并加载已有记录
+     * @param manifestPath 清单文件完整路径
+     * @return 是否加载成功
+     */
+    bool Open(const std::string& manifestPath);
+
+    /**
+     * @brief 清单是否已打开
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief 查询文件是否已导入
+     * @param record 仅需填写cameraSerial/folder/fileName/fileSize/mtime
+     * @param outRecord 命中时输出完整记录（可为nullptr）
+     * @return 是否已导入
+     */
+    bool Lookup(const ImportRecord& record, ImportRecord* outRecord = nullptr) const;
+
+    /**
+     * @brief 按内容查询：同一相机、目录、文件名且CRC32相同的记录（文件信息缺失时下载后使用）
+     * @param record 仅需填写cameraSerial/folder/fileName/crc32
+     * @param outRecord 命中时输出完整记录（可为nullptr）
+     */
+    bool LookupByContent(const ImportRecord& record, ImportRecord* outRecord = nullptr) const;
+
+    /**
+     * @brief 按文件名查询最近一次导入的记录（不核对大小和修改时间，不访问相机）
+     * @param outRecord 命中时输出完整记录（可为nullptr）
+     */
+    bool LookupLatest(const std::string& cameraSerial, const std::string& folder, const std::string& fileName,
+                      ImportRecord* outRecord = nullptr) const;
+
+    /**
+     * @brief 记录一次成功导入（内存更新并追加写入清单文件）
+     * @param record 完整记录
+     * @return 是否写入成功（文件信息缺失的记录不写入，返回false）
+     */
+    bool Record(const ImportRecord& record);
+
+    /**
+     * @brief 已导入记录数
+     */
+    size_t Size() const;
+
+    /**
+     * @brief 获取指定相机的全部导入记录
+     * @param cameraSerial 相机序列号
+     */
+    std::vector<ImportRecord> GetRecordsForCamera(const std::string& cameraSerial) const;
+
+    /**
+     * @brief 生成记录的查找键
+     */
+    static std::string MakeKey(const ImportRecord& record);
+
+    /**
+     * @brief 记录是否带有可用作键的文件信息（大小和修改时间都非0）
+     */
+    static bool HasFileIdentity(const ImportRecord& record);
+
+private:
+    static std::string MakeNameKey(const std::string& cameraSerial, const std::string& folder,
+                                   const std::string& fileName);
+    void IndexLocked(const std::string& key, const ImportRecord& record);
+
+    static bool ParseLine(const std::string& line, ImportRecord& record);
+    static std::string FormatLine(const ImportRecord& record);
+
+private:
+    std::string manifestPath_;                               // 清单文件路径
+    std::unordered_map<std::string, ImportRecord> records_;  // 键 → 记录
+    std::unordered_map<std::string, std::string> latestByName_;  // 相机/目录/文件名 → 最近一条记录的键
+    std::unordered_map<std::string, std::string> byContent_;     // 相机/目录/文件名/CRC32 → 记录的键
+    mutable std::mutex mutex_;                               // 保护records_和文件写入
+};
+
+#endif // IMPORT_MANIFEST_H
@@ -0,0 +1,186 @@
+// AtomicFileWriter.cpp
+// Created on 2026/1/8.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "AtomicFileWriter.h"
+#include <hilog/log.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <Camera/Common/Constants.h>
+
+#define LOG_DOMAIN ModuleLogs::PhotoDownloader.domain
+#define LOG_TAG ModuleLogs::PhotoDownloader.tag
+
+AtomicFileWriter::AtomicFileWriter()
+    : fd_(-1)
+    , directIo_(false)
+    , staging_(nullptr)
+    , stagingUsed_(0)
+    , bytesWritten_(0)
+    , fileOffset_(0) {
+}
+
+AtomicFileWriter::~AtomicFileWriter() {
+    if (fd_ >= 0) {
+        Abort();
+    }
+    free(staging_);
+}
+
+bool AtomicFileWriter::Open(const std::string& finalPath, uint64_t expectedSize, bool directIo) {
+    if (fd_ >= 0) {
+        Abort();
+    }
+    finalPath_ = finalPath;
+    tempPath_ = finalPath + ".part";
+    stagingUsed_ = 0;
+    bytesWritten_ = 0;
+    fileOffset_ = 0;
+    lastError_.clear();
+
+    if (!staging_ && posix_memalign(reinterpret_cast<void**>(&staging_), IO_ALIGNMENT, STAGING_SIZE) != 0) {
+        staging_ = nullptr;
+        lastError_ = "分配对齐缓冲区失败";
+        return false;
+    }
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    directIo_ = false;
+#ifdef O_DIRECT
+    if (directIo) {
+        fd_ = open(tempPath_.c_str(), flags | O_DIRECT, 0644);
+        if (fd_ >= 0) {
+            directIo_ = true;
+        } else {
+            OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG,
+                         "O_DIRECT打开失败(%{public}s)，回退到普通写", strerror(errno));
+        }
+    }
+#endif
+    if (fd_ < 0) {
+        fd_ = open(tempPath_.c_str(), flags, 0644);
+    }
+    if (fd_ < 0) {
+        lastError_ = std::string("无法创建临时文件: ") + strerror(errno);
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG,
+                     "%{public}s (%{public}s)", lastError_.c_str(), tempPath_.c_str());
+        return false;
+    }
+
+    // 已知大小时一次性预分配，减少碎片；文件系统不支持时忽略
+    if (expectedSize > 0) {
+        int ret = posix_fallocate(fd_, 0, static_cast<off_t>(expectedSize));
+        if (ret != 0 && ret != EOPNOTSUPP && ret != EINVAL) {
+            lastError_ = std::string("预分配空间失败: ") + strerror(ret);
+            OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "%{public}s", lastError_.c_str());
+            Abort();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AtomicFileWriter::Write(const char* data, size_t size) {
+    if (fd_ < 0) {
+        lastError_ = "文件未打开";
+        return false;
+    }
+    while (size > 0) {
+        size_t copySize = STAGING_SIZE - stagingUsed_;
+        if (copySize > size) {
+            copySize = size;
+        }
+        memcpy(staging_ + stagingUsed_, data, copySize);
+        stagingUsed_ += copySize;
+        bytesWritten_ += copySize;
+        data += copySize;
+        size -= copySize;
+
+        if (stagingUsed_ == STAGING_SIZE && !FlushStaging(false)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AtomicFileWriter::FlushStaging(bool finalBlock) {
+    if (stagingUsed_ == 0) {
+        return true;
+    }
+
+    // O_DIRECT要求长度对齐：最后一块补零写满对齐长度，提交时再截断到实际大小
+    size_t writeSize = stagingUsed_;
+    if (directIo_ && finalBlock && (writeSize % IO_ALIGNMENT) != 0) {
+        size_t padded = (writeSize + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT;
+        memset(staging_ + writeSize, 0, padded - writeSize);
+        writeSize = padded;
+    }
+
+    size_t done = 0;
+    while (done < writeSize) {
+        ssize_t ret = pwrite(fd_, staging_ + done, writeSize - done, static_cast<off_t>(fileOffset_ + done));
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            lastError_ = std::string("写入文件失败: ") + strerror(errno);
+            OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "%{public}s", lastError_.c_str());
+            return false;
+        }
+        done += static_cast<size_t>(ret);
+    }
+    fileOffset_ += stagingUsed_;
+    stagingUsed_ = 0;
+    return true;
+}
+
+bool AtomicFileWriter::Commit() {
+    if (fd_ < 0) {
+        lastError_ = "文件未打开";
+        return false;
+    }
+    if (!FlushStaging(true)) {
+        Abort();
+        return false;
+    }
+
+    // 截掉预分配多出的空间和O_DIRECT尾块填充
+    if (ftruncate(fd_, static_cast<off_t>(bytesWritten_)) != 0) {
+        lastError_ = std::string("截断文件失败: ") + strerror(errno);
+        Abort();
+        return false;
+    }
+    if (fdatasync(fd_) != 0) {
+        lastError_ = std::string("同步文件失败: ") + strerror(errno);
+        Abort();
+        return false;
+    }
+    CloseFd();
+
+    if (rename(tempPath_.c_str(), finalPath_.c_str()) != 0) {
+        lastError_ = std::string("重命名文件失败: ") + strerror(errno);
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "%{public}s", lastError_.c_str());
+        unlink(tempPath_.c_str());
+        return false;
+    }
+    return true;
+}
+
+void AtomicFileWriter::Abort() {
+    CloseFd();
+    if (!tempPath_.empty()) {
+        unlink(tempPath_.c_str());
+    }
+    stagingUsed_ = 0;
+}
+
+void AtomicFileWriter::CloseFd() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
@@ -0,0 +1,86 @@
+// AtomicFileWriter.h
+// Created on 2026/1/8.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef ATOMIC_FILE_WRITER_H
+#define ATOMIC_FILE_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 原子落盘写文件器
+ * @details 先写入"<目标路径>.part"临时文件，提交时fdatasync后rename到目标路径，
+ *          中途崩溃或失败不会在目标路径留下半截文件。
+ *          已知文件大小时预先fallocate，减少闪存碎片；数据先汇聚到对齐的缓冲区，
+ *          以大块对齐写入；可选O_DIRECT绕过页缓存（适合超大RAW/视频文件）。
+ */
+class AtomicFileWriter {
+public:
+    AtomicFileWriter();
+
+    /**
+     * @brief 析构时若尚未提交则自动放弃（删除临时文件）
+     */
+    ~AtomicFileWriter();
+
+    AtomicFileWriter(const AtomicFileWriter&) = delete;
+    AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+    /**
+     * @brief 打开临时文件
+     * @param finalPath 最终目标路径
+     * @param expectedSize 预期文件大小（0表示未知，不做预分配）
+     * @param directIo 是否使用O_DIRECT（文件系统不支持时自动回退到普通写）
+     * @return 是否打开成功
+     */
+    bool Open(const std::string& finalPath, uint64_t expectedSize, bool directIo);
+
+    /**
+     * @brief 追加写入数据（内部按对齐大块落盘）
+     */
+    bool Write(const char* data, size_t size);
+
+    /**
+     * @brief 写出剩余数据、截断到实际大小、fdatasync并rename到目标路径
+     */
+    bool Commit();
+
+    /**
+     * @brief 放弃写入，关闭并删除临时文件
+     */
+    void Abort();
+
+    /**
+     * @brief 已写入的字节数
+     */
+    uint64_t BytesWritten() const { return bytesWritten_; }
+
+    /**
+     * @brief 最后一次错误信息
+     */
+    const std::string& GetLastError() const { return lastError_; }
+
+    static const size_t IO_ALIGNMENT = 4096;             // 对齐粒度（闪存页/O_DIRECT要求）
+    static const size_t STAGING_SIZE = 1024 * 1024;      // 对齐缓冲区大小（1MB）
+
+private:
+    bool FlushStaging(bool finalBlock);
+    void CloseFd();
+
+private:
+    int fd_;                     // 临时文件描述符
+    bool directIo_;              // 是否实际启用了O_DIRECT
+    std::string finalPath_;      // 目标路径
+    std::string tempPath_;       // 临时文件路径
+    char* staging_;              // 对齐缓冲区
+    size_t stagingUsed_;         // 缓冲区已用字节
+    uint64_t bytesWritten_;      // 已接收字节数
+    uint64_t fileOffset_;        // 已落盘的文件偏移
+    std::string lastError_;      // 最后错误信息
+};
+
+#endif // ATOMIC_FILE_WRITER_H
@@ -6,10 +6,14 @@
 
 #include "PhotoDownloader.h"
 #include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/CameraDownloadKit/ImportManifest/ImportManifest.h"
+#include "Camera/CameraDownloadKit/ImportManifest/DownloadedSet.h"
+#include "AtomicFileWriter.h"
 #include "../../Common/native_common.h"
 #include "gphoto2/gphoto2-port-result.h"
 #include <hilog/log.h>
-#include <fstream>
+#include <cstring>
+#include <zlib.h>
 #include <Camera/Common/Constants.h>
 #include <memory>
 
@@ -59,7 +63,10 @@ static void ProgressStopCallback(GPContext *context, unsigned int id, void *data
 PhotoDownloader::PhotoDownloader() 
     : camera_(nullptr)
     , context_(nullptr)
-    , currentProgressData_(nullptr) {
+    , currentProgressData_(nullptr)
+    , manifest_(nullptr)
+    , downloadedSet_(nullptr)
+    , directIoThreshold_(0) {
 }
 
 PhotoDownloader::~PhotoDownloader() {
@@ -70,6 +77,7 @@ void PhotoDownloader::Init(Camera* camera, GPContext* context) {
     camera_ = camera;
     context_ = context;
     ClearProgressCallback();
+    cameraSerial_ = QueryCameraSerial();
 }
 
 void PhotoDownloader::Cleanup() {
@@ -80,6 +88,7 @@ void PhotoDownloader::Cleanup() {
     
     camera_ = nullptr;
     context_ = nullptr;
+    cameraSerial_.clear();
     ClearProgressCallback();
 }
 
@@ -101,12 +110,224 @@ bool PhotoDownloader::DownloadFile(const std::string& folder,
         return false;
     }
 
-    return InternalDownloadFile(folder, filename, filePath);
+    ImportRecord record;
+    FillRemoteFileInfo(folder, filename, record);
+    bool success = InternalDownloadFile(filePath, record, true);
+    if (downloadedSet_) {
+        downloadedSet_->Flush();
+    }
+    return success;
+}
+
+std::vector<BatchDownloadResult> PhotoDownloader::DownloadBatch(
+    const std::vector<std::pair<std::string, std::string>>& files,
+    const std::string& destDir, bool skipImported) {
+    
+    std::vector<BatchDownloadResult> results;
+    results.reserve(files.size());
+    
+    int downloaded = 0, skipped = 0, failed = 0;
+    for (const auto& file : files) {
+        BatchDownloadResult result;
+        result.folder = file.first;
+        result.fileName = file.second;
+        result.outcome = DownloadOutcome::Failed;
+        result.crc32 = 0;
+        
+        if (!camera_ || !context_) {
+            result.error = "相机未连接";
+            results.push_back(result);
+            failed++;
+            continue;
+        }
+        
+        // 1. 先查导入清单（只读取文件信息，不传输数据；同一份信息用于下载后写清单）
+        ImportRecord record;
+        FillRemoteFileInfo(file.first, file.second, record);
+        ImportRecord imported;
+        bool alreadyImported = manifest_ && manifest_->Lookup(record, &imported);
+        if (alreadyImported) {
+            result.importedPath = imported.localPath;
+            if (downloadedSet_) {
+                downloadedSet_->MarkDownloaded(file.first, file.second);
+            }
+            if (skipImported) {
+                result.outcome = DownloadOutcome::Skipped;
+                result.localPath = imported.localPath;
+                result.crc32 = imported.crc32;
+                results.push_back(result);
+                skipped++;
+                continue;
+            }
+        }
+        
+        // 2. 下载到目标目录
+        std::string filePath = destDir;
+        if (!filePath.empty() && filePath.back() != '/') {
+            filePath.push_back('/');
+        }
+        filePath += file.second;
+        
+        // 已导入过的文件重新下载时不覆盖清单中首次导入的记录
+        if (InternalDownloadFile(filePath, record, !alreadyImported)) {
+            // 读不到文件信息时无法事先查清单，下载后按CRC32比对是否导入过同一份内容
+            if (!alreadyImported && !ImportManifest::HasFileIdentity(record) && manifest_ &&
+                manifest_->LookupByContent(record, &imported)) {
+                alreadyImported = true;
+                result.importedPath = imported.localPath;
+            }
+            result.outcome = alreadyImported ? DownloadOutcome::Reimported : DownloadOutcome::Downloaded;
+            result.localPath = filePath;
+            result.crc32 = record.crc32;
+            downloaded++;
+        } else {
+            result.error = lastError_;
+            failed++;
+        }
+        results.push_back(result);
+    }
+    
+    // 整批的下载标记一次写回
+    if (downloadedSet_) {
+        downloadedSet_->Flush();
+    }
+    
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "批量下载完成: 下载 %{public}d, 跳过 %{public}d, 失败 %{public}d", 
+                downloaded, skipped, failed);
+    return results;
+}
+
+bool PhotoDownloader::IsImported(const std::string& folder, const std::string& filename,
+                                 ImportRecord* outRecord) {
+    if (downloadedSet_ && !downloadedSet_->IsDownloaded(folder, filename)) {
+        return false;
+    }
+    if (!manifest_) {
+        return downloadedSet_ != nullptr;
+    }
+    return manifest_->LookupLatest(cameraSerial_, folder, filename, outRecord);
+}
+
+std::vector<std::pair<std::string, std::string>> PhotoDownloader::SelectPairFiles(
+    const std::string& folder, const std::string& fileName,
+    const std::string& pairedFileName, PairImportPolicy policy) {
+    
+    std::vector<std::pair<std::string, std::string>> files;
+    if (pairedFileName.empty()) {
+        files.emplace_back(folder, fileName);
+        return files;
+    }
+    
+    switch (policy) {
+        case PairImportPolicy::JpegOnly:
+            files.emplace_back(folder, fileName);
+            break;
+        case PairImportPolicy::RawOnly:
+            files.emplace_back(folder, pairedFileName);
+            break;
+        case PairImportPolicy::RawWhenProtected:
+            files.emplace_back(folder, fileName);
+            if (IsFileProtected(folder, fileName) || IsFileProtected(folder, pairedFileName)) {
+                files.emplace_back(folder, pairedFileName);
+            }
+            break;
+        case PairImportPolicy::Both:
+        default:
+            files.emplace_back(folder, fileName);
+            files.emplace_back(folder, pairedFileName);
+            break;
+    }
+    return files;
+}
+
+bool PhotoDownloader::IsFileProtected(const std::string& folder, const std::string& filename) {
+    if (!camera_ || !context_) {
+        return false;
+    }
+    
+    CameraFileInfo info;
+    memset(&info, 0, sizeof(info));
+    int ret;
+    {
+        std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+        ret = gp_camera_file_get_info(camera_, folder.c_str(), filename.c_str(), &info, context_);
+    }
+    if (ret != GP_OK || !(info.file.fields & GP_FILE_INFO_PERMISSIONS)) {
+        return false;
+    }
+    
+    // libgphoto2不提供评分，机身"保护"会去掉删除权限，以此作为星标
+    return (info.file.permissions & GP_FILE_PERM_DELETE) == 0;
 }
 
-bool PhotoDownloader::InternalDownloadFile(const std::string& folder, 
-                                          const std::string& filename, 
-                                          const std::string& filePath) {
+void PhotoDownloader::FillRemoteFileInfo(const std::string& folder, const std::string& filename,
+                                         ImportRecord& record) {
+    record.cameraSerial = cameraSerial_;
+    record.folder = folder;
+    record.fileName = filename;
+    record.crc32 = 0;
+    record.fileSize = 0;
+    record.mtime = 0;
+    
+    CameraFileInfo info;
+    memset(&info, 0, sizeof(info));
+    int ret;
+    {
+        std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+        ret = gp_camera_file_get_info(camera_, folder.c_str(), filename.c_str(), &info, context_);
+    }
+    if (ret != GP_OK) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, 
+                   "获取文件信息失败: %{public}s/%{public}s, %{public}s", 
+                   folder.c_str(), filename.c_str(), gp_result_as_string(ret));
+        return;
+    }
+    
+    if (info.file.fields & GP_FILE_INFO_SIZE) {
+        record.fileSize = info.file.size;
+    }
+    if (info.file.fields & GP_FILE_INFO_MTIME) {
+        record.mtime = info.file.mtime;
+    }
+}
+
+std::string PhotoDownloader::QueryCameraSerial() {
+    if (!camera_ || !context_) {
+        return "";
+    }
+    
+    // CameraText有32KB，放在堆上避免占用线程栈
+    std::unique_ptr<CameraText> summary = std::make_unique<CameraText>();
+    std::unique_lock<std::recursive_mutex> lock(GetCameraIoMutex());
+    int ret = gp_camera_get_summary(camera_, summary.get(), context_);
+    lock.unlock();
+    if (ret != GP_OK) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "获取相机摘要失败，序列号未知");
+        return "";
+    }
+    
+    // PTP相机摘要中形如 "Serial Number: 6012345"
+    const char* key = "Serial Number:";
+    const char* pos = strstr(summary->text, key);
+    if (!pos) {
+        return "";
+    }
+    pos += strlen(key);
+    while (*pos == ' ' || *pos == '\t') pos++;
+    
+    std::string serial;
+    while (*pos && *pos != '\n' && *pos != '\r') {
+        serial.push_back(*pos++);
+    }
+    
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "相机序列号: %{public}s", serial.c_str());
+    return serial;
+}
+
+bool PhotoDownloader::InternalDownloadFile(const std::string& filePath, ImportRecord& record, bool updateManifest) {
+    const std::string& folder = record.folder;
+    const std::string& filename = record.fileName;
     
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
                 "===== 开始执行 InternalDownloadFile =====");
@@ -114,6 +335,123 @@ bool PhotoDownloader::InternalDownloadFile(const std::string& folder,
                 "参数: folder='%{public}s', filename='%{public}s', filePath='%{public}s'", 
                 folder.c_str(), filename.c_str(), filePath.c_str());
 
+    record.localPath = filePath;
+
+    // 优先分块读取：数据边到边写盘并计算CRC32，不在内存中保留整个文件
+    int ret = StreamFileToDisk(folder, filename, filePath, record);
+    if (ret == GP_ERROR_NOT_SUPPORTED) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                       "相机不支持分块读取，回退到整文件下载");
+        if (!GetWholeFileToDisk(folder, filename, filePath, record)) {
+            return false;
+        }
+    } else if (ret != GP_OK) {
+        return false;
+    }
+
+    // 写入导入清单
+    if (manifest_ && updateManifest) {
+        manifest_->Record(record);
+    }
+    if (downloadedSet_) {
+        downloadedSet_->MarkDownloaded(record.folder, record.fileName);
+    }
+
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "===== InternalDownloadFile 执行成功, CRC32: %{public}08x =====", record.crc32);
+    return true;
+}
+
+int PhotoDownloader::StreamFileToDisk(const std::string& folder, const std::string& filename,
+                                      const std::string& filePath, ImportRecord& record) {
+    std::vector<char> buffer(STREAM_CHUNK_SIZE);
+    AtomicFileWriter writer;
+    bool writerOpened = false;
+    
+    DownloadProgressData progress;
+    progress.fileName = filename;
+    progress.currentProgress = 0.0f;
+    progress.totalSize = static_cast<float>(record.fileSize);
+    
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uint64_t offset = 0;
+    while (record.fileSize == 0 || offset < record.fileSize) {
+        uint64_t chunkSize = STREAM_CHUNK_SIZE;
+        if (record.fileSize > 0 && record.fileSize - offset < chunkSize) {
+            chunkSize = record.fileSize - offset;
+        }
+        
+        // 按块加锁：块与块之间其他线程（如联机会话）可以插入相机操作
+        int ret;
+        {
+            std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+            ret = gp_camera_file_read(camera_, folder.c_str(), filename.c_str(), GP_FILE_TYPE_NORMAL,
+                                      offset, buffer.data(), &chunkSize, context_);
+        }
+        if (ret != GP_OK) {
+            if (offset == 0 && ret == GP_ERROR_NOT_SUPPORTED) {
+                return ret;
+            }
+            lastError_ = std::string("gp_camera_file_read 读取失败: ") + gp_result_as_string(ret);
+            OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
+                       "错误: 分块读取失败, offset=%{public}llu, ret=%{public}d",
+                       static_cast<unsigned long long>(offset), ret);
+            return ret;
+        }
+        if (chunkSize == 0) {
+            break; // 已读到文件末尾
+        }
+        
+        // 首块数据到达后再创建临时文件，避免相机不支持分块读取时留下空文件
+        if (!writerOpened) {
+            if (!writer.Open(filePath, record.fileSize, UseDirectIo(record.fileSize))) {
+                lastError_ = "无法打开沙箱文件进行写入: " + writer.GetLastError();
+                OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
+                           "错误: 无法打开沙箱文件进行写入");
+                return GP_ERROR_IO;
+            }
+            writerOpened = true;
+        }
+        
+        if (!writer.Write(buffer.data(), static_cast<size_t>(chunkSize))) {
+            lastError_ = "写入沙箱文件失败: " + writer.GetLastError();
+            return GP_ERROR_IO;
+        }
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(buffer.data()), static_cast<uInt>(chunkSize));
+        offset += chunkSize;
+        
+        if (record.fileSize > 0) {
+            progress.currentProgress = static_cast<float>(offset) / record.fileSize;
+        }
+        UpdateProgress(progress);
+        
+        // 文件大小未知时，读到不足一整块即认为结束
+        if (record.fileSize == 0 && chunkSize < STREAM_CHUNK_SIZE) {
+            break;
+        }
+    }
+    
+    if (offset == 0) {
+        lastError_ = "提取的数据为空或大小为0";
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "错误: 分块读取得到的数据为空");
+        return GP_ERROR_CORRUPTED_DATA;
+    }
+    
+    // fdatasync后再rename，目标路径上只会出现完整文件
+    if (!writer.Commit()) {
+        lastError_ = "写入沙箱文件失败: " + writer.GetLastError();
+        return GP_ERROR_IO;
+    }
+    
+    // record.fileSize保持相机报告的大小（是清单的键），实际字节数只用于日志
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "分块读取完成: %{public}llu 字节",
+                 static_cast<unsigned long long>(offset));
+    record.crc32 = static_cast<uint32_t>(crc);
+    return GP_OK;
+}
+
+bool PhotoDownloader::GetWholeFileToDisk(const std::string& folder, const std::string& filename,
+                                         const std::string& filePath, ImportRecord& record) {
     CameraFile *file = nullptr;
     int ret = gp_file_new(&file);
     if (ret != GP_OK) {
@@ -132,33 +470,37 @@ bool PhotoDownloader::InternalDownloadFile(const std::string& folder,
     currentProgressData_->currentProgress = 0.0f;
     currentProgressData_->totalSize = 0.0f;
 
-    // 设置进度回调
-    gp_context_set_progress_funcs(
-        context_,
-        ProgressStartCallback,   // 使用新定义的函数
-        ProgressUpdateCallback,  // 使用新定义的函数
-        ProgressStopCallback,    // 使用新定义的函数
-        currentProgressData_
-    );
-
     // 开始下载
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
                 "步骤: 调用 gp_camera_file_get 开始下载文件");
-    ret = gp_camera_file_get(camera_, folder.c_str(), filename.c_str(), 
-                            GP_FILE_TYPE_NORMAL, file, context_);
+    {
+        // 上下文为各模块共享，进度回调的设置与清除都在锁内完成
+        std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+        
+        // 设置进度回调
+        gp_context_set_progress_funcs(
+            context_,
+            ProgressStartCallback,   // 使用新定义的函数
+            ProgressUpdateCallback,  // 使用新定义的函数
+            ProgressStopCallback,    // 使用新定义的函数
+            currentProgressData_
+        );
+        
+        ret = gp_camera_file_get(camera_, folder.c_str(), filename.c_str(), 
+                                GP_FILE_TYPE_NORMAL, file, context_);
+        
+        // 清除进度回调
+        gp_context_set_progress_funcs(context_, nullptr, nullptr, nullptr, nullptr);
+    }
     
-    // 清除进度回调
-    gp_context_set_progress_funcs(context_, nullptr, nullptr, nullptr, nullptr);
+    delete currentProgressData_;
+    currentProgressData_ = nullptr;
     
     if (ret != GP_OK) {
         lastError_ = std::string("gp_camera_file_get 下载失败: ") + gp_result_as_string(ret);
         OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
                    "错误: gp_camera_file_get 下载失败. ret=%{public}d", ret);
         gp_file_unref(file);
-        
-        delete currentProgressData_;
-        currentProgressData_ = nullptr;
-        
         return false;
     }
     
@@ -179,47 +521,45 @@ bool PhotoDownloader::InternalDownloadFile(const std::string& folder,
         OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
                    "错误: 提取的数据为空或大小为0");
         gp_file_unref(file);
-        
-        delete currentProgressData_;
-        currentProgressData_ = nullptr;
-        
         return false;
     }
 
     // 将数据写入文件
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
                 "步骤: 将数据写入沙箱文件: %{public}s", filePath.c_str());
-    std::ofstream outFile(filePath, std::ios::binary);
-    if (!outFile.is_open()) {
-        lastError_ = "无法打开沙箱文件进行写入";
+    AtomicFileWriter writer;
+    if (!writer.Open(filePath, fileSize, UseDirectIo(fileSize))) {
+        lastError_ = "无法打开沙箱文件进行写入: " + writer.GetLastError();
         OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
                    "错误: 无法打开沙箱文件进行写入");
         gp_file_unref(file);
-        
-        delete currentProgressData_;
-        currentProgressData_ = nullptr;
-        
         return false;
     }
 
-    outFile.write(fileData, fileSize);
-    outFile.close();
+    if (!writer.Write(fileData, fileSize) || !writer.Commit()) {
+        lastError_ = "写入沙箱文件失败: " + writer.GetLastError();
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
+                   "错误: %{public}s", lastError_.c_str());
+        gp_file_unref(file);
+        return false;
+    }
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
                 "成功: 数据已全部写入沙箱文件");
 
+    record.crc32 = static_cast<uint32_t>(
+        crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(fileData), static_cast<uInt>(fileSize)));
+
     // 释放资源
     gp_file_unref(file);
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
                 "成功: CameraFile 对象已释放");
-    
-    delete currentProgressData_;
-    currentProgressData_ = nullptr;
-
-    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
-                "===== InternalDownloadFile 执行成功 =====");
     return true;
 }
 
+bool PhotoDownloader::UseDirectIo(uint64_t fileSize) const {
+    return directIoThreshold_ > 0 && fileSize >= directIoThreshold_;
+}
+
 void PhotoDownloader::SetProgressCallback(ProgressCallback callback) {
     progressCallback_ = callback;
 }
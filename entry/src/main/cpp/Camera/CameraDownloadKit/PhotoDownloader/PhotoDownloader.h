@@ -10,12 +10,49 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <cstdint>
 
 // libgphoto2头文件
 #include <gphoto2/gphoto2.h>
 #include <gphoto2/gphoto2-camera.h>
 
 struct DownloadProgressData;
+struct ImportRecord;
+class ImportManifest;
+class DownloadedSet;
+
+/**
+ * @brief 批量下载中单个文件的处理结果
+ */
+enum class DownloadOutcome {
+    Downloaded,   // 本次已下载
+    Skipped,      // 导入清单中已存在，未传输
+    Reimported,   // 导入清单中已存在，仍按要求重新下载（清单保留首次导入的记录）
+    Failed        // 下载失败
+};
+
+/**
+ * @brief RAW+JPEG配对照片的导入策略
+ */
+enum class PairImportPolicy {
+    Both,               // 两个文件都导入
+    JpegOnly,           // 仅导入JPEG
+    RawOnly,            // 仅导入RAW
+    RawWhenProtected    // 默认仅JPEG，相机内已保护（锁定）的照片额外导入RAW
+};
+
+/**
+ * @brief 批量下载的单项结果
+ */
+struct BatchDownloadResult {
+    std::string folder;        // 相机内目录
+    std::string fileName;      // 文件名
+    std::string localPath;     // 本地路径（跳过时为上次导入的路径）
+    std::string importedPath;  // 导入清单中记录的路径（已导入过时）
+    DownloadOutcome outcome;   // 处理结果
+    uint32_t crc32;            // 文件CRC32
+    std::string error;         // 失败原因
+};
 
 /**
  * @brief 照片下载器类，负责从相机下载原始照片
@@ -59,6 +96,63 @@ public:
     bool DownloadFile(const std::string& folder, const std::string& filename, 
                      const std::string& filePath);
 
+    /**
+     * @brief 批量下载照片到指定目录，导入清单中已存在的文件不再传输
+     * @param files 待下载文件列表（folder, fileName）
+     * @param destDir 本地保存目录
+     * @param skipImported 是否跳过已导入的文件（false时仍会下载，结果标记为Reimported，清单记录不变）
+     * @return 每个文件的处理结果
+     */
+    std::vector<BatchDownloadResult> DownloadBatch(
+        const std::vector<std::pair<std::string, std::string>>& files,
+        const std::string& destDir, bool skipImported);
+
+    /**
+     * @brief 按配对策略选出需要传输的文件
+     * @param folder 照片所在文件夹
+     * @param fileName 主文件名（配对时为JPEG）
+     * @param pairedFileName 配对的RAW文件名（为空表示无配对）
+     * @param policy 配对导入策略
+     * @return 需要传输的文件列表（folder, fileName）
+     */
+    std::vector<std::pair<std::string, std::string>> SelectPairFiles(
+        const std::string& folder, const std::string& fileName,
+        const std::string& pairedFileName, PairImportPolicy policy);
+
+    /**
+     * @brief 查询文件是否已导入（只查已下载集合和导入清单，不访问相机，可在ArkTS线程调用）
+     * @details 已下载集合不会漏判，先用它排除；再按文件名取清单中最近一次导入的记录。
+     *          不核对大小和修改时间，下载时仍以DownloadBatch按完整键的判断为准
+     * @param folder 照片所在文件夹
+     * @param filename 照片文件名
+     * @param outRecord 命中时输出清单记录（可为nullptr）
+     * @return 是否已导入
+     */
+    bool IsImported(const std::string& folder, const std::string& filename, ImportRecord* outRecord);
+
+    /**
+     * @brief 设置导入清单（由camera_download模块持有，生命周期长于下载器）
+     * @param manifest 导入清单，传nullptr表示不使用清单
+     */
+    void SetImportManifest(ImportManifest* manifest) { manifest_ = manifest; }
+
+    /**
+     * @brief 设置已下载集合（由camera_download模块持有），下载成功后自动标记
+     * @param downloadedSet 已下载集合，传nullptr表示不标记
+     */
+    void SetDownloadedSet(DownloadedSet* downloadedSet) { downloadedSet_ = downloadedSet; }
+
+    /**
+     * @brief 获取当前相机序列号（Init时从相机摘要中读取）
+     */
+    const std::string& GetCameraSerial() const { return cameraSerial_; }
+
+    /**
+     * @brief 设置直接I/O阈值，不小于该大小的文件以O_DIRECT写入（绕过页缓存）
+     * @param thresholdBytes 阈值（字节），0表示关闭直接I/O
+     */
+    void SetDirectIoThreshold(uint64_t thresholdBytes) { directIoThreshold_ = thresholdBytes; }
+
     /**
      * @brief 设置进度回调
      * @param callback 进度回调函数
@@ -80,8 +174,42 @@ private:
     /**
      * @brief 内部下载文件实现
      */
-    bool InternalDownloadFile(const std::string& folder, const std::string& filename, 
-                             const std::string& filePath);
+    bool InternalDownloadFile(const std::string& filePath, ImportRecord& record, bool updateManifest);
+
+    /**
+     * @brief 分块读取相机文件并边写边算CRC32
+     * @return GP_OK成功；GP_ERROR_NOT_SUPPORTED表示相机不支持分块读取
+     */
+    int StreamFileToDisk(const std::string& folder, const std::string& filename,
+                         const std::string& filePath, ImportRecord& record);
+
+    /**
+     * @brief 一次性下载整个文件（相机不支持分块读取时的回退路径）
+     */
+    bool GetWholeFileToDisk(const std::string& folder, const std::string& filename,
+                            const std::string& filePath, ImportRecord& record);
+
+    /**
+     * @brief 填写清单记录的键：序列号、目录、文件名，以及相机报告的大小和修改时间
+     * @details 每个文件只读取一次文件信息，查清单和下载后写清单使用同一个键；
+     *          相机未报告大小时大小为0，写入清单的记录也保持为0，否则再次查询时无法命中
+     */
+    void FillRemoteFileInfo(const std::string& folder, const std::string& filename, ImportRecord& record);
+
+    /**
+     * @brief 指定大小的文件是否使用直接I/O
+     */
+    bool UseDirectIo(uint64_t fileSize) const;
+
+    /**
+     * @brief 相机内文件是否被保护（不可删除），用作"星标"判断
+     */
+    bool IsFileProtected(const std::string& folder, const std::string& filename);
+
+    /**
+     * @brief 从相机摘要中读取序列号
+     */
+    std::string QueryCameraSerial();
 
     /**
      * @brief libgphoto2进度回调函数
@@ -103,6 +231,12 @@ private:
     ProgressCallback progressCallback_;    // 进度回调函数
     std::string lastError_;                // 最后一次的错误信息
     DownloadProgressData* currentProgressData_; // 当前下载进度数据
+    ImportManifest* manifest_;             // 导入清单（不持有）
+    DownloadedSet* downloadedSet_;         // 已下载集合（不持有）
+    std::string cameraSerial_;             // 相机序列号
+    uint64_t directIoThreshold_;           // 直接I/O阈值（0=关闭）
+
+    static const uint64_t STREAM_CHUNK_SIZE = 1024 * 1024; // 分块读取大小（1MB）
 };
 
 #endif // PHOTO_DOWNLOADER_H
\ No newline at end of file
@@ -0,0 +1,126 @@
+// FileNameIndex.cpp
+// Created on 2026/1/19.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "FileNameIndex.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include <algorithm>
+
+std::string FileNameIndex::ToUpper(const std::string& text) {
+    std::string upper = text;
+    for (char& c : upper) {
+        if (c >= 'a' && c <= 'z') {
+            c = static_cast<char>(c - 'a' + 'A');
+        }
+    }
+    return upper;
+}
+
+uint32_t FileNameIndex::PackTrigram(const char* text) {
+    return (static_cast<uint32_t>(static_cast<uint8_t>(text[0])) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(text[1])) << 8) |
+           static_cast<uint32_t>(static_cast<uint8_t>(text[2]));
+}
+
+void FileNameIndex::Clear() {
+    names_.clear();
+    scanIndices_.clear();
+    sortedNames_.clear();
+    trigrams_.clear();
+}
+
+uint32_t FileNameIndex::AppendName(const std::string& fileName, uint32_t scanIndex) {
+    uint32_t nameId = static_cast<uint32_t>(names_.size());
+    names_.push_back(ToUpper(fileName));
+    scanIndices_.push_back(scanIndex);
+
+    const std::string& name = names_.back();
+    for (size_t i = 0; i + 3 <= name.size(); i++) {
+        std::vector<uint32_t>& postings = trigrams_[PackTrigram(name.c_str() + i)];
+        if (postings.empty() || postings.back() != nameId) {
+            postings.push_back(nameId);
+        }
+    }
+    return nameId;
+}
+
+void FileNameIndex::Rebuild(const std::vector<PhotoMeta>& photos) {
+    Clear();
+    names_.reserve(photos.size());
+    scanIndices_.reserve(photos.size());
+    for (const auto& meta : photos) {
+        AppendName(meta.fileName, meta.scanIndex);
+        if (!meta.pairedFileName.empty()) {
+            AppendName(meta.pairedFileName, meta.scanIndex);
+        }
+    }
+
+    // 全部加入后一次性排序，避免逐个插入排序数组
+    sortedNames_.resize(names_.size());
+    for (uint32_t i = 0; i < sortedNames_.size(); i++) {
+        sortedNames_[i] = i;
+    }
+    std::sort(sortedNames_.begin(), sortedNames_.end(),
+        [this](uint32_t a, uint32_t b) { return names_[a] < names_[b]; });
+}
+
+void FileNameIndex::Add(const std::string& fileName, uint32_t scanIndex) {
+    uint32_t nameId = AppendName(fileName, scanIndex);
+    const std::string& name = names_[nameId];
+    auto pos = std::upper_bound(sortedNames_.begin(), sortedNames_.end(), name,
+        [this](const std::string& value, uint32_t id) { return value < names_[id]; });
+    sortedNames_.insert(pos, nameId);
+}
+
+std::vector<uint32_t> FileNameIndex::FindPrefix(const std::string& prefix) const {
+    std::vector<uint32_t> result;
+    std::string upper = ToUpper(prefix);
+    auto it = std::lower_bound(sortedNames_.begin(), sortedNames_.end(), upper,
+        [this](uint32_t id, const std::string& value) { return names_[id] < value; });
+    for (; it != sortedNames_.end(); ++it) {
+        const std::string& name = names_[*it];
+        if (name.compare(0, upper.size(), upper) != 0) {
+            break;
+        }
+        result.push_back(scanIndices_[*it]);
+    }
+    return result;
+}
+
+std::vector<uint32_t> FileNameIndex::FindSubstring(const std::string& text) const {
+    std::vector<uint32_t> result;
+    std::string upper = ToUpper(text);
+    if (upper.empty()) {
+        return result;
+    }
+
+    // 不足三个字符时没有三字符组可用，直接逐个比较
+    if (upper.size() < 3) {
+        for (uint32_t nameId = 0; nameId < names_.size(); nameId++) {
+            if (names_[nameId].find(upper) != std::string::npos) {
+                result.push_back(scanIndices_[nameId]);
+            }
+        }
+        return result;
+    }
+
+    // 取查询串中最短的倒排表作为候选集，任一三字符组不存在即无结果
+    const std::vector<uint32_t>* candidates = nullptr;
+    for (size_t i = 0; i + 3 <= upper.size(); i++) {
+        auto it = trigrams_.find(PackTrigram(upper.c_str() + i));
+        if (it == trigrams_.end()) {
+            return result;
+        }
+        if (!candidates || it->second.size() < candidates->size()) {
+            candidates = &it->second;
+        }
+    }
+    for (uint32_t nameId : *candidates) {
+        if (names_[nameId].find(upper) != std::string::npos) {
+            result.push_back(scanIndices_[nameId]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,79 @@
+// FileNameIndex.h
+// Created on 2026/1/19.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef FILE_NAME_INDEX_H
+#define FILE_NAME_INDEX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct PhotoMeta;
+
+/**
+ * @brief 文件名检索索引（不区分大小写）
+ * @details 前缀查询走按名称排序的数组（二分定位），子串查询走三字符组倒排表
+ *          （取最短的倒排表逐项校验）。索引项以PhotoMeta::scanIndex标识，
+ *          不受列表排序影响；RAW+JPEG配对的两个文件名指向同一个scanIndex。
+ *
+ * 不自带锁，由PhotoScanner在cacheMutex_保护下访问。
+ */
+class FileNameIndex {
+public:
+    /**
+     * @brief 清空索引
+     */
+    void Clear();
+
+    /**
+     * @brief 按扫描列表全量重建（每次扫描完成后调用）
+     * @param photos 扫描列表（主文件名和配对文件名都会加入索引）
+     */
+    void Rebuild(const std::vector<PhotoMeta>& photos);
+
+    /**
+     * @brief 增量加入一个文件名
+     * @param fileName 文件名
+     * @param scanIndex 所属条目的扫描下标
+     */
+    void Add(const std::string& fileName, uint32_t scanIndex);
+
+    /**
+     * @brief 前缀查询
+     * @return 匹配条目的扫描下标（可能重复，按名称排序）
+     */
+    std::vector<uint32_t> FindPrefix(const std::string& prefix) const;
+
+    /**
+     * @brief 子串查询
+     * @return 匹配条目的扫描下标（可能重复，按加入顺序）
+     */
+    std::vector<uint32_t> FindSubstring(const std::string& text) const;
+
+    /**
+     * @brief 已索引的文件名数
+     */
+    size_t Size() const { return names_.size(); }
+
+private:
+    static std::string ToUpper(const std::string& text);
+    static uint32_t PackTrigram(const char* text);
+
+    /**
+     * @brief 追加名称并加入倒排表（不更新排序数组）
+     * @return 名称编号
+     */
+    uint32_t AppendName(const std::string& fileName, uint32_t scanIndex);
+
+    std::vector<std::string> names_;     // 名称编号 -> 大写文件名
+    std::vector<uint32_t> scanIndices_;  // 名称编号 -> 扫描下标
+    std::vector<uint32_t> sortedNames_;  // 按名称排序的名称编号
+    std::unordered_map<uint32_t, std::vector<uint32_t>> trigrams_; // 三字符组 -> 名称编号（升序）
+};
+
+#endif // FILE_NAME_INDEX_H
@@ -11,19 +11,31 @@
 #include "gphoto2/gphoto2-port-result.h"
 #include <hilog/log.h>
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <strings.h>
 #include <fstream>
-#include <set>
+#include <map>
+#include <unordered_set>
+#include <climits>
 #include <Camera/Common/Constants.h>
 
 
 #define LOG_DOMAIN ModuleLogs::PhotoScanner.domain
 #define LOG_TAG ModuleLogs::PhotoScanner.tag
 
-// 支持的图片格式
-static const std::set<std::string> PHOTO_EXTENSIONS = {
-    "jpg", "jpeg", "nef", "cr2", "arw", "dng", "rw2", "orf"
-};
+// 获取小写文件名主干（去掉扩展名），用于配对
+static std::string GetLowerStem(const std::string& fileName) {
+    std::string stem = fileName.substr(0, fileName.rfind('.'));
+    std::transform(stem.begin(), stem.end(), stem.begin(), ::tolower);
+    return stem;
+}
+
+// 获取目录所在的存储卡根目录（如"/store_00010001"）
+static std::string GetStorageRoot(const std::string& folder) {
+    size_t end = folder.find('/', 1);
+    return end == std::string::npos ? folder : folder.substr(0, end);
+}
 
 PhotoScanner::PhotoScanner() 
     : camera_(nullptr)
@@ -32,7 +44,15 @@ PhotoScanner::PhotoScanner()
     , isScanning_(false)
     , scanCancelled_(false)
     , scanProgressCurrent_(0)
-    , scanProgressTotal_(0) {
+    , scanProgressTotal_(0)
+    , sortKey_(PhotoSortKey::Name)
+    , sortAscending_(true)
+    , typeFilterMask_(DefaultTypeFilter())
+    , scanAllStorages_(false)
+    , duplicateCount_(0) {
+    for (auto& count : typeCounts_) {
+        count = 0;
+    }
 }
 
 PhotoScanner::~PhotoScanner() {
@@ -70,8 +90,8 @@ int PhotoScanner::GetPhotoTotalCount() {
         std::lock_guard<std::mutex> lock(cacheMutex_);
         if (isFileListCached_) {
             OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
-                        "使用缓存的文件列表，照片总数: %{public}zu", cachedFileList_.size());
-            return static_cast<int>(cachedFileList_.size());
+                        "使用缓存的文件列表，照片总数: %{public}zu", viewIndex_.size());
+            return static_cast<int>(viewIndex_.size());
         }
     }
     
@@ -102,15 +122,15 @@ std::vector<PhotoMeta> PhotoScanner::GetPhotoMetaList(int pageIndex, int pageSiz
     // 计算分页范围
     std::lock_guard<std::mutex> lock(cacheMutex_);
     size_t startIndex = pageIndex * pageSize;
-    size_t endIndex = std::min(startIndex + pageSize, cachedFileList_.size());
+    size_t endIndex = std::min(startIndex + pageSize, viewIndex_.size());
     
-    if (startIndex >= cachedFileList_.size()) {
+    if (startIndex >= viewIndex_.size()) {
         return result;
     }
     
     // 复制分页数据
     for (size_t i = startIndex; i < endIndex; i++) {
-        result.push_back(cachedFileList_[i]);
+        result.push_back(cachedFileList_[viewIndex_[i]]);
     }
     
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
@@ -135,6 +155,10 @@ bool PhotoScanner::StartAsyncScan() {
     scanCancelled_ = false;
     scanProgressCurrent_ = 0;
     scanProgressTotal_ = 0;
+    duplicateCount_ = 0;
+    for (auto& count : typeCounts_) {
+        count = 0;
+    }
     
     scanThread_ = std::thread(&PhotoScanner::AsyncScanInternal, this);
     scanThread_.detach();
@@ -148,84 +172,63 @@ void PhotoScanner::AsyncScanInternal() {
     try {
         std::vector<PhotoMeta> fileList;
         
-        // 1. 寻找DCIM目录
-        std::string dcimFolder = FindDcimFolder();
-        if (dcimFolder.empty()) {
-            OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "未找到DCIM目录");
-            isScanning_ = false;
-            return;
-        }
-        
-        // 2. 获取照片目录
-        std::string photoFolder = FindPhotoFolder(dcimFolder);
-        if (photoFolder.empty()) {
-            photoFolder = dcimFolder;
+        // 1-2. 使用指定目录；未指定时寻找DCIM下的照片目录（多卡模式下为所有存储卡的全部照片目录）
+        std::vector<std::string> photoFolders;
+        std::string photoFolder = GetScanFolder();
+        if (!photoFolder.empty()) {
+            photoFolders.push_back(photoFolder);
+        } else if (scanAllStorages_) {
+            photoFolders = FindPhotoFoldersOnAllStorages();
+        } else {
+            std::string dcimFolder = FindDcimFolder();
+            if (!dcimFolder.empty()) {
+                photoFolder = FindPhotoFolder(dcimFolder);
+                photoFolders.push_back(photoFolder.empty() ? dcimFolder : photoFolder);
+            }
         }
-        
-        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
-                    "扫描照片目录: %{public}s", photoFolder.c_str());
-        
-        // 3. 获取文件列表
-        CameraList *files = nullptr;
-        gp_list_new(&files);
-        int ret = gp_camera_folder_list_files(camera_, photoFolder.c_str(), files, context_);
-        
-        if (ret != GP_OK) {
-            OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
-                        "获取文件列表失败: %{public}s", gp_result_as_string(ret));
-            gp_list_free(files);
+        if (photoFolders.empty()) {
+            OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "未找到DCIM目录");
             isScanning_ = false;
             return;
         }
         
-        // 4. 获取文件总数用于进度
-        int numFiles = gp_list_count(files);
-        scanProgressTotal_ = numFiles;
-        
-        // 5. 构建元信息列表
-        for (int i = 0; i < numFiles; i++) {
-            // 检查是否被取消
+        int scannedFiles = 0;
+        for (const auto& folder : photoFolders) {
             if (scanCancelled_) {
-                OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "扫描被取消");
                 break;
             }
+            OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                        "扫描照片目录: %{public}s", folder.c_str());
             
-            const char *fileName;
-            gp_list_get_name(files, i, &fileName);
-            
-            if (IsPhotoFile(fileName)) {
-                PhotoMeta meta;
-                meta.folder = photoFolder;
-                meta.fileName = fileName;
-                meta.fileSize = 0; // 暂时不获取文件大小
-                
-                fileList.push_back(meta);
+            // 3. 获取文件列表
+            CameraList *files = nullptr;
+            gp_list_new(&files);
+            int ret;
+            {
+                std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
+                ret = gp_camera_folder_list_files(camera_, folder.c_str(), files, context_);
             }
             
-            // 更新进度
-            scanProgressCurrent_ = i + 1;
-            
-            // 每扫描100个文件记录一次
-            if (i % 100 == 0 || i == numFiles - 1) {
-                OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
-                            "扫描进度: %{public}d/%{public}d", i + 1, numFiles);
-            }
-        }
-        
-        gp_list_free(files);
-        
-        if (!scanCancelled_) {
-            // 6. 更新缓存
-            {
-                std::lock_guard<std::mutex> lock(cacheMutex_);
-                cachedFileList_ = fileList;
-                isFileListCached_ = true;
+            if (ret != GP_OK) {
+                OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
+                            "获取文件列表失败: %{public}s", gp_result_as_string(ret));
+                gp_list_free(files);
+                // 单目录扫描失败直接结束，多目录时跳过该目录
+                if (photoFolders.size() == 1) {
+                    isScanning_ = false;
+                    return;
+                }
+                continue;
             }
             
-            OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
-                        "异步扫描完成，找到 %{public}zu 个照片文件", fileList.size());
+            // 4-5. 构建元信息列表
+            AppendFolderListing(folder, files, fileList, scannedFiles);
+            gp_list_free(files);
         }
         
+        // 6-8. 合并配对/重复并更新缓存
+        CommitFileList(fileList, photoFolders);
+        
     } catch (const std::exception& e) {
         OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
                     "异步扫描异常: %{public}s", e.what());
@@ -236,6 +239,126 @@ void PhotoScanner::AsyncScanInternal() {
     isScanning_ = false;
 }
 
+void PhotoScanner::AppendFolderListing(const std::string& folder, CameraList* files,
+                                       std::vector<PhotoMeta>& fileList, int& scannedFiles) {
+    // 4. 获取文件总数用于进度
+    int numFiles = gp_list_count(files);
+    scanProgressTotal_ += numFiles;
+    
+    // 5. 构建元信息列表
+    for (int i = 0; i < numFiles; i++) {
+        // 检查是否被取消
+        if (scanCancelled_) {
+            OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "扫描被取消");
+            break;
+        }
+        
+        const char *fileName;
+        gp_list_get_name(files, i, &fileName);
+        
+        // 照片和视频进入列表，附属文件只计数
+        MediaType type = ClassifyFileName(fileName);
+        typeCounts_[static_cast<size_t>(type)]++;
+        if (IsPhotoMediaType(type) || type == MediaType::Video) {
+            PhotoMeta meta;
+            meta.folder = folder;
+            meta.fileName = fileName;
+            meta.fileSize = 0; // 暂时不获取文件大小
+            meta.mediaType = type;
+            
+            fileList.push_back(meta);
+        }
+        
+        // 更新进度
+        scannedFiles++;
+        scanProgressCurrent_ = scannedFiles;
+        
+        // 每扫描100个文件记录一次
+        if (i % 100 == 0 || i == numFiles - 1) {
+            OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                        "扫描进度: %{public}d/%{public}d", i + 1, numFiles);
+        }
+    }
+}
+
+void PhotoScanner::CommitFileList(std::vector<PhotoMeta>& fileList, const std::vector<std::string>& folders) {
+    // 6. 合并RAW+JPEG配对
+    size_t pairCount = GroupRawJpegPairs(fileList);
+    if (pairCount > 0) {
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                    "合并RAW+JPEG配对 %{public}zu 组", pairCount);
+    }
+    // 7. 合并双卡备份模式下两张卡上的同一张照片
+    if (folders.size() > 1 && !scanCancelled_) {
+        size_t duplicates = MergeStorageDuplicates(fileList);
+        duplicateCount_ = static_cast<int>(duplicates);
+        if (duplicates > 0) {
+            OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                        "合并跨存储卡重复照片 %{public}zu 张", duplicates);
+        }
+    }
+    
+    for (size_t i = 0; i < fileList.size(); i++) {
+        fileList[i].scanIndex = static_cast<uint32_t>(i);
+    }
+    
+    if (!scanCancelled_) {
+        // 8. 更新缓存
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+            cachedFileList_ = fileList;
+            cachedFolders_ = folders;
+            nameIndex_.Rebuild(cachedFileList_);
+            ApplySortLocked();
+            isFileListCached_ = true;
+        }
+        
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                    "异步扫描完成，找到 %{public}zu 个照片文件", fileList.size());
+        
+        if (scanCompleteCallback_) {
+            scanCompleteCallback_(fileList);
+        }
+    }
+}
+
+bool PhotoScanner::ScanListings(const std::vector<std::pair<std::string, CameraList*>>& listings) {
+    if (isScanning_.exchange(true)) {
+        return false;
+    }
+    scanCancelled_ = false;
+    scanProgressCurrent_ = 0;
+    scanProgressTotal_ = 0;
+    duplicateCount_ = 0;
+    for (auto& count : typeCounts_) {
+        count = 0;
+    }
+    
+    std::vector<PhotoMeta> fileList;
+    std::vector<std::string> folders;
+    int scannedFiles = 0;
+    for (const auto& listing : listings) {
+        folders.push_back(listing.first);
+        AppendFolderListing(listing.first, listing.second, fileList, scannedFiles);
+    }
+    CommitFileList(fileList, folders);
+    
+    isScanning_ = false;
+    return true;
+}
+
+void PhotoScanner::SetScanCompleteCallback(ScanCompleteCallback callback) {
+    scanCompleteCallback_ = std::move(callback);
+}
+
+void PhotoScanner::SetFileAddedCallback(FileAddedCallback callback) {
+    fileAddedCallback_ = std::move(callback);
+}
+
+void PhotoScanner::SetFileInfoSource(FileInfoSource source) {
+    fileInfoSource_ = std::move(source);
+}
+
 bool PhotoScanner::IsScanComplete() const {
     return !isScanning_ && isFileListCached_;
 }
@@ -254,21 +377,618 @@ void PhotoScanner::CancelScan() {
 void PhotoScanner::ClearCache() {
     std::lock_guard<std::mutex> lock(cacheMutex_);
     cachedFileList_.clear();
+    indexByKey_.clear();
+    viewIndex_.clear();
+    viewPosition_.clear();
+    timeline_.Clear();
+    nameIndex_.Clear();
+    cacheIndexByScan_.clear();
+    cachedFolders_.clear();
+    duplicateCount_ = 0;
     isFileListCached_ = false;
     OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "已清理照片缓存");
 }
 
+void PhotoScanner::SetScanFolder(const std::string& folder) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    scanFolder_ = folder;
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "扫描目录设置为: %{public}s", folder.empty() ? "(自动)" : folder.c_str());
+}
+
+std::string PhotoScanner::GetScanFolder() const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return scanFolder_;
+}
+
+void PhotoScanner::SetMultiStorageScan(bool enabled, const std::string& preferredStorage) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    scanAllStorages_ = enabled;
+    preferredStorage_ = preferredStorage;
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "多卡扫描: %{public}s, 优先存储卡: %{public}s", 
+                enabled ? "开启" : "关闭", preferredStorage.empty() ? "(卡槽1)" : preferredStorage.c_str());
+}
+
+int PhotoScanner::GetDuplicateCount() const {
+    return duplicateCount_;
+}
+
+std::vector<std::pair<std::string, std::string>> PhotoScanner::GetPendingExifFiles() const {
+    std::vector<std::pair<std::string, std::string>> pending;
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    // 先采集可见列表，再采集被过滤掉的条目
+    for (size_t index : viewIndex_) {
+        const PhotoMeta& meta = cachedFileList_[index];
+        if (!meta.exif.loaded) {
+            pending.emplace_back(meta.folder, meta.fileName);
+        }
+    }
+    for (size_t i = 0; i < cachedFileList_.size(); i++) {
+        const PhotoMeta& meta = cachedFileList_[i];
+        if (!meta.exif.loaded && viewPosition_[i] == SIZE_MAX) {
+            pending.emplace_back(meta.folder, meta.fileName);
+        }
+    }
+    return pending;
+}
+
+void PhotoScanner::UpdatePhotoExif(const std::string& folder, const std::string& fileName,
+                                   const PhotoExifMeta& exif, size_t fileSize) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto it = indexByKey_.find(folder + "/" + fileName);
+    if (it == indexByKey_.end()) {
+        return;
+    }
+    PhotoMeta& meta = cachedFileList_[it->second];
+    if (!meta.exif.loaded && exif.loaded && viewPosition_[it->second] != SIZE_MAX) {
+        timeline_.Add(exif.captureTime, viewPosition_[it->second]);
+    }
+    meta.exif = exif;
+    if (fileSize > 0) {
+        meta.fileSize = fileSize;
+    }
+}
+
+void PhotoScanner::SetSortOrder(PhotoSortKey key, bool ascending) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    sortKey_ = key;
+    sortAscending_ = ascending;
+    ApplySortLocked();
+}
+
+void PhotoScanner::ResortCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (sortKey_ != PhotoSortKey::Name) {
+        ApplySortLocked();
+    }
+}
+
+void PhotoScanner::ApplySortLocked() {
+    // 取排序字段值，名称排序时比较文件夹+文件名
+    auto fieldOf = [this](const PhotoMeta& meta) -> double {
+        switch (sortKey_) {
+            case PhotoSortKey::CaptureTime: return static_cast<double>(meta.exif.captureTime);
+            case PhotoSortKey::ExposureTime: return meta.exif.exposureTime;
+            case PhotoSortKey::FNumber: return meta.exif.fNumber;
+            case PhotoSortKey::Iso: return meta.exif.iso;
+            case PhotoSortKey::FocalLength: return meta.exif.focalLength;
+            case PhotoSortKey::Size: return static_cast<double>(meta.fileSize);
+            default: return 0;
+        }
+    };
+    
+    std::stable_sort(cachedFileList_.begin(), cachedFileList_.end(),
+        [this, &fieldOf](const PhotoMeta& a, const PhotoMeta& b) {
+            if (sortKey_ == PhotoSortKey::Name) {
+                int cmp = a.folder.compare(b.folder);
+                if (cmp == 0) {
+                    cmp = a.fileName.compare(b.fileName);
+                }
+                return sortAscending_ ? cmp < 0 : cmp > 0;
+            }
+            // 未采集EXIF的条目始终排在最后
+            if (a.exif.loaded != b.exif.loaded) {
+                return a.exif.loaded;
+            }
+            double va = fieldOf(a);
+            double vb = fieldOf(b);
+            return sortAscending_ ? va < vb : va > vb;
+        });
+    
+    indexByKey_.clear();
+    indexByKey_.reserve(cachedFileList_.size());
+    // 扫描下标连续（增量加入的条目取当时的列表长度），可直接作为数组下标
+    cacheIndexByScan_.assign(cachedFileList_.size(), SIZE_MAX);
+    for (size_t i = 0; i < cachedFileList_.size(); i++) {
+        indexByKey_[cachedFileList_[i].folder + "/" + cachedFileList_[i].fileName] = i;
+        if (cachedFileList_[i].scanIndex < cacheIndexByScan_.size()) {
+            cacheIndexByScan_[cachedFileList_[i].scanIndex] = i;
+        }
+    }
+    RebuildViewLocked();
+}
+
+void PhotoScanner::RebuildViewLocked() {
+    viewIndex_.clear();
+    viewPosition_.assign(cachedFileList_.size(), SIZE_MAX);
+    for (size_t i = 0; i < cachedFileList_.size(); i++) {
+        if (IsVisibleLocked(cachedFileList_[i])) {
+            viewPosition_[i] = viewIndex_.size();
+            viewIndex_.push_back(i);
+        }
+    }
+    timeline_.Rebuild(cachedFileList_, viewIndex_);
+}
+
+bool PhotoScanner::IsVisibleLocked(const PhotoMeta& meta) const {
+    // 配对条目的任一文件匹配即可见（如只看RAW时仍显示RAW+JPEG组）
+    return (typeFilterMask_ & MediaTypeBit(meta.mediaType)) != 0 ||
+           (!meta.pairedFileName.empty() && (typeFilterMask_ & MediaTypeBit(meta.pairedMediaType)) != 0);
+}
+
+std::vector<size_t> PhotoScanner::SearchFileName(const std::string& query, bool prefixOnly, size_t limit) const {
+    std::vector<size_t> positions;
+    if (query.empty()) {
+        return positions;
+    }
+    
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    std::vector<uint32_t> hits = prefixOnly ? nameIndex_.FindPrefix(query) : nameIndex_.FindSubstring(query);
+    positions.reserve(hits.size());
+    for (uint32_t scanIndex : hits) {
+        if (scanIndex >= cacheIndexByScan_.size()) {
+            continue;
+        }
+        size_t position = viewPosition_[cacheIndexByScan_[scanIndex]];
+        if (position != SIZE_MAX) {
+            positions.push_back(position);
+        }
+    }
+    
+    // 配对的两个文件名可能同时命中，去重后按列表顺序返回
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    if (limit > 0 && positions.size() > limit) {
+        positions.resize(limit);
+    }
+    return positions;
+}
+
+bool PhotoScanner::AddFile(const std::string& folder, const std::string& fileName) {
+    // 多卡模式下另一张卡上的同名文件不一定是双卡备份（两张卡可能各自编号到同一文件名），
+    // 与扫描时一样按大小和修改时间确认；读取文件信息要拿相机I/O锁，放在缓存锁外
+    std::string copyFolder;
+    std::string copyName;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (!FindStorageCopyLocked(folder, fileName, copyFolder, copyName)) {
+            copyFolder.clear();
+        }
+    }
+    if (!copyFolder.empty()) {
+        CameraFileInfo copyInfo;
+        CameraFileInfo newInfo;
+        if (!QueryFileInfo(copyFolder, copyName, copyInfo) || !QueryFileInfo(folder, fileName, newInfo) ||
+            !IsSameShot(copyInfo, newInfo)) {
+            copyFolder.clear();
+        }
+    }
+    
+    PhotoMeta added;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (!AddFileLocked(folder, fileName, copyFolder, added)) {
+            return false;
+        }
+    }
+    // 新条目的扫描下标超出扫描完成时的列表，通知已下载集合等扩展按下标的索引
+    if (fileAddedCallback_) {
+        fileAddedCallback_(added);
+    }
+    return true;
+}
+
+bool PhotoScanner::FindStorageCopyLocked(const std::string& folder, const std::string& fileName,
+                                         std::string& copyFolder, std::string& copyName) const {
+    if (!isFileListCached_ || cachedFolders_.size() <= 1) {
+        return false;
+    }
+    for (uint32_t scanIndex : nameIndex_.FindPrefix(fileName)) {
+        if (scanIndex >= cacheIndexByScan_.size()) {
+            continue;
+        }
+        const PhotoMeta& group = cachedFileList_[cacheIndexByScan_[scanIndex]];
+        if (!group.duplicateFolder.empty() || GetStorageRoot(group.folder) == GetStorageRoot(folder)) {
+            continue;
+        }
+        if (strcasecmp(group.fileName.c_str(), fileName.c_str()) == 0) {
+            copyName = group.fileName;
+        } else if (strcasecmp(group.pairedFileName.c_str(), fileName.c_str()) == 0) {
+            copyName = group.pairedFileName;
+        } else {
+            continue;
+        }
+        copyFolder = group.folder;
+        return true;
+    }
+    return false;
+}
+
+bool PhotoScanner::AddFileLocked(const std::string& folder, const std::string& fileName,
+                                 const std::string& copyFolder, PhotoMeta& added) {
+    MediaType type = ClassifyFileName(fileName.c_str());
+    std::string key = folder + "/" + fileName;
+    
+    if (!isFileListCached_ || indexByKey_.count(key) > 0 ||
+        std::find(cachedFolders_.begin(), cachedFolders_.end(), folder) == cachedFolders_.end()) {
+        return false;
+    }
+    typeCounts_[static_cast<size_t>(type)]++;
+    if (!IsPhotoMediaType(type) && type != MediaType::Video) {
+        return false;
+    }
+    
+    // 多卡模式下另一张卡写入的同名文件（双卡备份）并入已有条目：
+    // 已合并过副本的条目直接并入（副本的配对文件），否则只并入AddFile已确认为同一张的条目
+    if (cachedFolders_.size() > 1) {
+        for (uint32_t scanIndex : nameIndex_.FindPrefix(fileName)) {
+            if (scanIndex >= cacheIndexByScan_.size()) {
+                continue;
+            }
+            PhotoMeta& group = cachedFileList_[cacheIndexByScan_[scanIndex]];
+            bool sameName = strcasecmp(group.fileName.c_str(), fileName.c_str()) == 0 ||
+                            strcasecmp(group.pairedFileName.c_str(), fileName.c_str()) == 0;
+            if (!sameName || GetStorageRoot(group.folder) == GetStorageRoot(folder)) {
+                continue;
+            }
+            if (group.duplicateFolder.empty() && group.folder == copyFolder) {
+                group.duplicateFolder = folder;
+                duplicateCount_++;
+            }
+            if (group.duplicateFolder == folder) {
+                added = group;
+                return true;
+            }
+        }
+    }
+    
+    // 与已有的同名JPEG/RAW合并（规则同GroupRawJpegPairs），用前缀索引查找同目录同名文件
+    bool isRaw = IsRawMediaType(type);
+    bool isJpeg = type == MediaType::Jpeg;
+    if (isRaw || isJpeg) {
+        std::string stem = GetLowerStem(fileName);
+        for (uint32_t scanIndex : nameIndex_.FindPrefix(stem + ".")) {
+            if (scanIndex >= cacheIndexByScan_.size()) {
+                continue;
+            }
+            size_t index = cacheIndexByScan_[scanIndex];
+            PhotoMeta& group = cachedFileList_[index];
+            bool groupIsJpeg = group.mediaType == MediaType::Jpeg;
+            bool groupIsRaw = IsRawMediaType(group.mediaType);
+            if (group.folder != folder || !group.pairedFileName.empty() || GetLowerStem(group.fileName) != stem ||
+                !((groupIsJpeg && isRaw) || (groupIsRaw && isJpeg))) {
+                continue;
+            }
+            
+            bool wasVisible = viewPosition_[index] != SIZE_MAX;
+            if (isJpeg) {
+                indexByKey_.erase(group.folder + "/" + group.fileName);
+                group.pairedFileName = group.fileName;
+                group.pairedMediaType = group.mediaType;
+                group.fileName = fileName;
+                group.mediaType = type;
+                indexByKey_[key] = index;
+            } else {
+                group.pairedFileName = fileName;
+                group.pairedMediaType = type;
+            }
+            nameIndex_.Add(fileName, group.scanIndex);
+            added = group;
+            if (IsVisibleLocked(group) != wasVisible) {
+                RebuildViewLocked();
+            }
+            return true;
+        }
+    }
+    
+    PhotoMeta meta;
+    meta.folder = folder;
+    meta.fileName = fileName;
+    meta.fileSize = 0;
+    meta.mediaType = type;
+    meta.scanIndex = static_cast<uint32_t>(cachedFileList_.size());
+    
+    // 未采集EXIF的条目本就排在最后，只有按名称排序且新文件名不在末尾时才需要重排
+    bool appendKeepsOrder = true;
+    if (sortKey_ == PhotoSortKey::Name && !cachedFileList_.empty()) {
+        const PhotoMeta& last = cachedFileList_.back();
+        int cmp = last.folder.compare(folder);
+        if (cmp == 0) {
+            cmp = last.fileName.compare(fileName);
+        }
+        appendKeepsOrder = sortAscending_ ? cmp <= 0 : cmp >= 0;
+    }
+    
+    size_t index = cachedFileList_.size();
+    cachedFileList_.push_back(meta);
+    nameIndex_.Add(fileName, meta.scanIndex);
+    added = meta;
+    if (!appendKeepsOrder) {
+        ApplySortLocked();
+        return true;
+    }
+    
+    indexByKey_[key] = index;
+    cacheIndexByScan_.push_back(index);
+    viewPosition_.push_back(SIZE_MAX);
+    if (IsVisibleLocked(meta)) {
+        viewPosition_[index] = viewIndex_.size();
+        viewIndex_.push_back(index);
+    }
+    return true;
+}
+
+uint32_t PhotoScanner::DefaultTypeFilter() {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < MEDIA_TYPE_COUNT; i++) {
+        if (IsPhotoMediaType(static_cast<MediaType>(i))) {
+            mask |= MediaTypeBit(static_cast<MediaType>(i));
+        }
+    }
+    return mask;
+}
+
+void PhotoScanner::SetTypeFilter(uint32_t mask) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    typeFilterMask_ = mask != 0 ? mask : DefaultTypeFilter();
+    RebuildViewLocked();
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "类型过滤: 0x%{public}x, 可见 %{public}zu/%{public}zu", 
+                typeFilterMask_, viewIndex_.size(), cachedFileList_.size());
+}
+
+void PhotoScanner::GetTypeCounts(std::array<int, MEDIA_TYPE_COUNT>& counts) const {
+    for (size_t i = 0; i < MEDIA_TYPE_COUNT; i++) {
+        counts[i] = typeCounts_[i];
+    }
+}
+
+std::vector<TimelineBucket> PhotoScanner::GetTimelineBuckets(int64_t bucketSeconds) const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return timeline_.GetBuckets(bucketSeconds);
+}
+
+bool PhotoScanner::FindPositionForDate(int64_t timestamp, size_t& position) const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return timeline_.FindPosition(timestamp, position);
+}
+
 bool PhotoScanner::IsPhotoFile(const char* fileName) {
-    if (!fileName) return false;
+    return IsPhotoMediaType(ClassifyFileName(fileName));
+}
+
+bool PhotoScanner::IsRawFile(const char* fileName) {
+    return IsRawMediaType(ClassifyFileName(fileName));
+}
+
+bool PhotoScanner::IsJpegFile(const char* fileName) {
+    return ClassifyFileName(fileName) == MediaType::Jpeg;
+}
+
+size_t PhotoScanner::GroupRawJpegPairs(std::vector<PhotoMeta>& fileList) {
+    // 目录+主干 -> 结果列表中的下标
+    std::map<std::string, size_t> groupIndex;
+    std::vector<PhotoMeta> grouped;
+    grouped.reserve(fileList.size());
+    size_t pairCount = 0;
+    
+    for (auto& meta : fileList) {
+        std::string key = meta.folder + "/" + GetLowerStem(meta.fileName);
+        bool isRaw = IsRawMediaType(meta.mediaType);
+        bool isJpeg = meta.mediaType == MediaType::Jpeg;
+        
+        auto it = groupIndex.find(key);
+        if (it != groupIndex.end()) {
+            PhotoMeta& group = grouped[it->second];
+            bool groupIsJpeg = group.mediaType == MediaType::Jpeg;
+            bool groupIsRaw = IsRawMediaType(group.mediaType);
+            
+            // 只合并一对JPEG+RAW，主文件始终为JPEG（可直接显示缩略图）
+            if (group.pairedFileName.empty() && ((groupIsJpeg && isRaw) || (groupIsRaw && isJpeg))) {
+                if (isJpeg) {
+                    group.pairedFileName = group.fileName;
+                    group.pairedMediaType = group.mediaType;
+                    group.fileName = meta.fileName;
+                    group.mediaType = meta.mediaType;
+                } else {
+                    group.pairedFileName = meta.fileName;
+                    group.pairedMediaType = meta.mediaType;
+                }
+                pairCount++;
+                continue;
+            }
+        } else if (isRaw || isJpeg) {
+            groupIndex[key] = grouped.size();
+        }
+        grouped.push_back(std::move(meta));
+    }
+    
+    fileList.swap(grouped);
+    return pairCount;
+}
+
+bool PhotoScanner::IsPreferredCopy(const std::string& folder, const std::string& otherFolder) const {
+    std::string root = GetStorageRoot(folder);
+    std::string otherRoot = GetStorageRoot(otherFolder);
+    std::string preferred;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        preferred = preferredStorage_;
+    }
+    if (!preferred.empty() && (root == preferred) != (otherRoot == preferred)) {
+        return root == preferred;
+    }
+    // 未指定或都不是指定卡时，取编号小的存储卡（卡槽1）
+    return root <= otherRoot;
+}
+
+bool PhotoScanner::QueryFileInfo(const std::string& folder, const std::string& fileName, CameraFileInfo& info) {
+    if (fileInfoSource_) {
+        return fileInfoSource_(folder, fileName, info);
+    }
+    std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
+    return gp_camera_file_get_info(camera_, folder.c_str(), fileName.c_str(), &info, context_) == GP_OK;
+}
+
+bool PhotoScanner::IsSameShot(const CameraFileInfo& infoA, const CameraFileInfo& infoB) {
+    bool hasSize = (infoA.file.fields & GP_FILE_INFO_SIZE) && (infoB.file.fields & GP_FILE_INFO_SIZE);
+    bool hasTime = (infoA.file.fields & GP_FILE_INFO_MTIME) && (infoB.file.fields & GP_FILE_INFO_MTIME);
+    if (!hasSize && !hasTime) {
+        return false;
+    }
+    if (hasSize && infoA.file.size != infoB.file.size) {
+        return false;
+    }
+    return !hasTime || std::llabs(static_cast<long long>(infoA.file.mtime - infoB.file.mtime)) <= DUPLICATE_TIME_TOLERANCE;
+}
+
+size_t PhotoScanner::MergeStorageDuplicates(std::vector<PhotoMeta>& fileList) {
+    // 1. 主文件同名（不区分大小写）的条目逐个与之前保留的每一个同名条目比较：同一张卡上编号
+    //    回绕会产生多个同名文件，另一张卡上的副本不一定对应第一个出现的那个
+    std::unordered_map<std::string, std::vector<size_t>> keptByName;
+    // 2. 按大小和相机记录的拍摄（修改）时间确认是同一张，避免两张卡上编号重复的不同照片被合并
+    //    （扫描时EXIF尚未采集，拍摄时间取相机文件信息中的时间，与EXIF采集的回退值一致）
+    //    文件信息只在出现跨卡同名候选时才读取，每个条目最多读一次
+    std::unordered_map<size_t, CameraFileInfo> infos;
+    std::unordered_set<size_t> infoFailed;
+    auto getInfo = [&](size_t index) -> const CameraFileInfo* {
+        auto it = infos.find(index);
+        if (it != infos.end()) {
+            return &it->second;
+        }
+        if (infoFailed.count(index) > 0) {
+            return nullptr;
+        }
+        CameraFileInfo info;
+        if (!QueryFileInfo(fileList[index].folder, fileList[index].fileName, info)) {
+            infoFailed.insert(index);
+            return nullptr;
+        }
+        return &infos.emplace(index, info).first->second;
+    };
+    
+    std::vector<bool> removed(fileList.size(), false);
+    size_t merged = 0;
+    for (size_t i = 0; i < fileList.size() && !scanCancelled_; i++) {
+        std::string name = fileList[i].fileName;
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        std::vector<size_t>& kept = keptByName[name];
+        bool isDuplicate = false;
+        for (size_t j : kept) {
+            const PhotoMeta& earlier = fileList[j];
+            if (GetStorageRoot(earlier.folder) == GetStorageRoot(fileList[i].folder) ||
+                strcasecmp(earlier.pairedFileName.c_str(), fileList[i].pairedFileName.c_str()) != 0) {
+                continue;
+            }
+            const CameraFileInfo* infoA = getInfo(j);
+            const CameraFileInfo* infoB = infoA ? getInfo(i) : nullptr;
+            if (!infoB || !IsSameShot(*infoA, *infoB)) {
+                continue;
+            }
+            
+            // 3. 保留优先存储卡上的副本（位置沿用先出现的条目），另一张卡记入duplicateFolder
+            bool hasSize = (infoA->file.fields & GP_FILE_INFO_SIZE) && (infoB->file.fields & GP_FILE_INFO_SIZE);
+            uint64_t size = infoA->file.size;
+            if (!IsPreferredCopy(fileList[j].folder, fileList[i].folder)) {
+                std::swap(fileList[j], fileList[i]);
+                infos[j] = *infoB;
+            }
+            fileList[j].duplicateFolder = fileList[i].folder;
+            if (hasSize) {
+                fileList[j].fileSize = size;
+            }
+            removed[i] = true;
+            merged++;
+            isDuplicate = true;
+            break;
+        }
+        if (!isDuplicate) {
+            kept.push_back(i);
+        }
+    }
     
-    // 获取文件扩展名
-    const char* dot = strrchr(fileName, '.');
-    if (!dot) return false;
+    if (merged > 0) {
+        size_t out = 0;
+        for (size_t i = 0; i < fileList.size(); i++) {
+            if (!removed[i]) {
+                if (out != i) {
+                    fileList[out] = std::move(fileList[i]);
+                }
+                out++;
+            }
+        }
+        fileList.resize(out);
+    }
+    return merged;
+}
+
+std::vector<std::string> PhotoScanner::FindPhotoFoldersOnAllStorages() {
+    std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
+    std::vector<std::string> folders;
     
-    std::string ext = dot + 1;
-    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    CameraList *rootFolders = nullptr;
+    gp_list_new(&rootFolders);
+    if (gp_camera_folder_list_folders(camera_, "/", rootFolders, context_) == GP_OK) {
+        int numRootFolders = gp_list_count(rootFolders);
+        for (int i = 0; i < numRootFolders; i++) {
+            const char *storageFolder;
+            gp_list_get_name(rootFolders, i, &storageFolder);
+            std::string storagePath = '/' + std::string(storageFolder);
+            
+            // 每张卡上的DCIM目录
+            CameraList *storageSubFolders = nullptr;
+            gp_list_new(&storageSubFolders);
+            std::string dcimFolder;
+            if (gp_camera_folder_list_folders(camera_, storagePath.c_str(), storageSubFolders, context_) == GP_OK) {
+                int numSubFolders = gp_list_count(storageSubFolders);
+                for (int j = 0; j < numSubFolders; j++) {
+                    const char *subFolderName;
+                    gp_list_get_name(storageSubFolders, j, &subFolderName);
+                    if (strstr(subFolderName, "DCIM") != nullptr) {
+                        dcimFolder = storagePath + "/" + subFolderName;
+                        break;
+                    }
+                }
+            }
+            gp_list_free(storageSubFolders);
+            if (dcimFolder.empty()) {
+                continue;
+            }
+            
+            // DCIM下的全部照片目录（如100NIKON、101NIKON）
+            CameraList *dcimSubFolders = nullptr;
+            gp_list_new(&dcimSubFolders);
+            size_t before = folders.size();
+            if (gp_camera_folder_list_folders(camera_, dcimFolder.c_str(), dcimSubFolders, context_) == GP_OK) {
+                int numDcimSubFolders = gp_list_count(dcimSubFolders);
+                for (int j = 0; j < numDcimSubFolders; j++) {
+                    const char *subFolderName;
+                    gp_list_get_name(dcimSubFolders, j, &subFolderName);
+                    folders.push_back(dcimFolder + "/" + subFolderName);
+                }
+            }
+            gp_list_free(dcimSubFolders);
+            if (folders.size() == before) {
+                folders.push_back(dcimFolder);
+            }
+        }
+    }
+    gp_list_free(rootFolders);
     
-    return PHOTO_EXTENSIONS.find(ext) != PHOTO_EXTENSIONS.end();
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "多卡扫描共找到 %{public}zu 个照片目录", folders.size());
+    return folders;
 }
 
 std::vector<PhotoMeta> PhotoScanner::ScanPhotoFilesOnly() {
@@ -299,7 +1019,11 @@ std::vector<PhotoMeta> PhotoScanner::ScanPhotoFilesOnly() {
     // 3. 获取文件列表
     CameraList *files = nullptr;
     gp_list_new(&files);
-    int ret = gp_camera_folder_list_files(camera_, photoFolder.c_str(), files, context_);
+    int ret;
+    {
+        std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
+        ret = gp_camera_folder_list_files(camera_, photoFolder.c_str(), files, context_);
+    }
     
     if (ret != GP_OK) {
         OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
@@ -315,17 +1039,20 @@ std::vector<PhotoMeta> PhotoScanner::ScanPhotoFilesOnly() {
         gp_list_get_name(files, i, &fileName);
 
         // 筛选照片文件
-        if (IsPhotoFile(fileName)) {
+        MediaType type = ClassifyFileName(fileName);
+        if (IsPhotoMediaType(type)) {
             PhotoMeta meta;
             meta.folder = photoFolder;
             meta.fileName = fileName;
             meta.fileSize = 0;
+            meta.mediaType = type;
             
             fileList.push_back(meta);
         }
     }
 
     gp_list_free(files);
+    GroupRawJpegPairs(fileList);
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
                 "扫描完成，找到 %{public}zu 个照片文件", fileList.size());
     
@@ -333,6 +1060,7 @@ std::vector<PhotoMeta> PhotoScanner::ScanPhotoFilesOnly() {
 }
 
 std::string PhotoScanner::FindDcimFolder() {
+    std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
     CameraList *rootFolders = nullptr;
     gp_list_new(&rootFolders);
     std::string dcimFolder;
@@ -373,6 +1101,7 @@ found_dcim:
 }
 
 std::string PhotoScanner::FindPhotoFolder(const std::string& dcimFolder) {
+    std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
     CameraList *dcimSubFolders = nullptr;
     gp_list_new(&dcimSubFolders);
     std::string photoFolder;
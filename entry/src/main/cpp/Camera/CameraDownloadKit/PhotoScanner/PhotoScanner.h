@@ -12,18 +12,45 @@
 #include <mutex>
 #include <atomic>
 #include <thread>
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include "Camera/Common/MediaType.h"
+#include "TimelineIndex.h"
+#include "FileNameIndex.h"
 
 // libgphoto2头文件
 #include <gphoto2/gphoto2.h>
 #include <gphoto2/gphoto2-camera.h>
 
 struct PhotoMeta;
+struct PhotoExifMeta;
+
+/**
+ * @brief 照片列表排序字段
+ */
+enum class PhotoSortKey {
+    Name,           // 扫描顺序（相机内文件名顺序）
+    CaptureTime,    // 拍摄时间
+    ExposureTime,   // 曝光时间
+    FNumber,        // 光圈
+    Iso,            // ISO
+    FocalLength,    // 焦距
+    Size            // 文件大小
+};
 
 /**
  * @brief 照片扫描器类，负责扫描相机中的照片文件
  */
 class PhotoScanner {
 public:
+    // 扫描完成回调（参数为排序前的扫描列表，scanIndex与下标一致）
+    using ScanCompleteCallback = std::function<void(const std::vector<PhotoMeta>&)>;
+    // 扫描后增量加入文件的回调（参数为新增或合并了配对文件的条目）
+    using FileAddedCallback = std::function<void(const PhotoMeta&)>;
+    // 文件信息来源（folder, fileName, info输出），离线扫描时代替相机提供大小和修改时间
+    using FileInfoSource = std::function<bool(const std::string&, const std::string&, CameraFileInfo&)>;
+
     /**
      * @brief 构造函数
      */
@@ -66,6 +93,54 @@ public:
      */
     bool StartAsyncScan();
 
+    /**
+     * @brief 用已获取的文件列表同步完成一次扫描（不访问相机目录），供基准测试等离线场景使用
+     * @param listings 目录及其文件列表（按顺序处理）
+     * @return 正在扫描时返回false
+     */
+    bool ScanListings(const std::vector<std::pair<std::string, CameraList*>>& listings);
+
+    /**
+     * @brief 指定扫描目录，下次扫描时生效
+     * @param folder 目录绝对路径，为空表示自动查找DCIM下的照片目录
+     */
+    void SetScanFolder(const std::string& folder);
+
+    /**
+     * @brief 获取当前指定的扫描目录（为空表示自动查找）
+     */
+    std::string GetScanFolder() const;
+
+    /**
+     * @brief 设置多卡扫描（双卡相机），下次扫描时生效
+     * @details 开启后扫描所有存储卡DCIM下的全部照片目录，并将双卡备份模式下
+     *          两张卡上的同一张照片合并为一条，只从优先存储卡导入
+     * @param enabled 是否扫描所有存储卡
+     * @param preferredStorage 优先的存储卡根目录（如"/store_00020001"），为空表示卡槽1
+     */
+    void SetMultiStorageScan(bool enabled, const std::string& preferredStorage);
+
+    /**
+     * @brief 最近一次扫描合并的跨存储卡重复照片数
+     */
+    int GetDuplicateCount() const;
+
+    /**
+     * @brief 设置扫描完成回调（在扫描线程中调用，不持有缓存锁）
+     */
+    void SetScanCompleteCallback(ScanCompleteCallback callback);
+
+    /**
+     * @brief 设置增量加入文件回调（在AddFile调用方线程中调用，不持有缓存锁）
+     */
+    void SetFileAddedCallback(FileAddedCallback callback);
+
+    /**
+     * @brief 设置文件信息来源，设置后合并双卡备份时不再访问相机（基准测试、单元测试等离线场景使用）
+     * @param source 文件信息来源，传空函数恢复为从相机读取
+     */
+    void SetFileInfoSource(FileInfoSource source);
+
     /**
      * @brief 检查扫描是否完成
      * @return 是否完成
@@ -81,6 +156,23 @@ public:
      */
     bool GetScanProgress(int& current, int& total, bool& cached) const;
 
+    /**
+     * @brief 获取按媒体类型统计的文件数（扫描过程中实时更新，含附属文件）
+     * @param counts 各类型数量（输出参数，下标为MediaType）
+     */
+    void GetTypeCounts(std::array<int, MEDIA_TYPE_COUNT>& counts) const;
+
+    /**
+     * @brief 设置列表显示的媒体类型，无需重新扫描
+     * @param mask 类型位掩码（见MediaTypeBit），0表示恢复默认（仅照片）
+     */
+    void SetTypeFilter(uint32_t mask);
+
+    /**
+     * @brief 媒体类型对应的过滤位
+     */
+    static constexpr uint32_t MediaTypeBit(MediaType type) { return 1u << static_cast<uint32_t>(type); }
+
     /**
      * @brief 取消扫描
      */
@@ -91,6 +183,66 @@ public:
      */
     void ClearCache();
 
+    /**
+     * @brief 获取尚未采集EXIF的文件列表
+     * @return (folder, fileName)列表，按当前列表顺序
+     */
+    std::vector<std::pair<std::string, std::string>> GetPendingExifFiles() const;
+
+    /**
+     * @brief 写入单个文件的EXIF摘要（文件已不在缓存中时忽略）
+     * @param folder 照片所在文件夹
+     * @param fileName 文件名
+     * @param exif EXIF摘要
+     * @param fileSize 文件大小（0表示未知，不覆盖）
+     */
+    void UpdatePhotoExif(const std::string& folder, const std::string& fileName,
+                         const PhotoExifMeta& exif, size_t fileSize);
+
+    /**
+     * @brief 设置列表排序方式，立即对缓存重排，重新扫描后保持
+     * @param key 排序字段
+     * @param ascending 是否升序
+     */
+    void SetSortOrder(PhotoSortKey key, bool ascending);
+
+    /**
+     * @brief 按当前排序方式重排缓存（EXIF采集完成后调用）
+     */
+    void ResortCache();
+
+    /**
+     * @brief 获取时间轴桶列表
+     * @param bucketSeconds 桶大小（秒），小时或天
+     * @return 按时间升序的桶列表
+     */
+    std::vector<TimelineBucket> GetTimelineBuckets(int64_t bucketSeconds) const;
+
+    /**
+     * @brief 查找指定时间的照片在列表中的位置
+     * @param timestamp 目标时间（秒）
+     * @param position 列表下标（输出参数）
+     * @return 时间轴为空时返回false
+     */
+    bool FindPositionForDate(int64_t timestamp, size_t& position) const;
+
+    /**
+     * @brief 按文件名检索（不区分大小写，RAW+JPEG任一文件名匹配即命中）
+     * @param query 查询串
+     * @param prefixOnly true为前缀匹配，false为子串匹配
+     * @param limit 最多返回条数（0表示不限）
+     * @return 命中条目在当前列表中的下标（升序，被过滤的条目不返回）
+     */
+    std::vector<size_t> SearchFileName(const std::string& query, bool prefixOnly, size_t limit) const;
+
+    /**
+     * @brief 增量加入相机新增的文件（联机拍摄时调用），无需重新扫描
+     * @param folder 文件所在目录（与已扫描目录不同时忽略）
+     * @param fileName 文件名
+     * @return 是否加入了列表
+     */
+    bool AddFile(const std::string& folder, const std::string& fileName);
+
     /**
      * @brief 判断是否为照片文件
      * @param fileName 文件名
@@ -98,12 +250,46 @@ public:
      */
     static bool IsPhotoFile(const char* fileName);
 
+    /**
+     * @brief 判断是否为RAW格式文件
+     * @param fileName 文件名
+     * @return 是否为RAW文件
+     */
+    static bool IsRawFile(const char* fileName);
+
+    /**
+     * @brief 判断是否为JPEG格式文件
+     * @param fileName 文件名
+     * @return 是否为JPEG文件
+     */
+    static bool IsJpegFile(const char* fileName);
+
+    /**
+     * @brief 将同目录同名（不区分大小写）的RAW+JPEG合并为一条元信息
+     * @param fileList 扫描得到的文件列表（原地合并，保持原有顺序）
+     * @return 合并的配对数
+     */
+    static size_t GroupRawJpegPairs(std::vector<PhotoMeta>& fileList);
+
 private:
     /**
      * @brief 异步扫描内部实现
      */
     void AsyncScanInternal();
 
+    /**
+     * @brief 将一个目录的文件列表转换为元信息并追加到fileList（同时统计类型和进度）
+     */
+    void AppendFolderListing(const std::string& folder, CameraList* files,
+                             std::vector<PhotoMeta>& fileList, int& scannedFiles);
+
+    /**
+     * @brief 合并RAW+JPEG配对和跨存储卡重复照片，分配扫描下标并更新缓存
+     * @param fileList 扫描得到的文件列表（原地修改）
+     * @param folders 本次扫描的目录
+     */
+    void CommitFileList(std::vector<PhotoMeta>& fileList, const std::vector<std::string>& folders);
+
     /**
      * @brief 查找DCIM目录
      * @return DCIM目录路径，未找到返回空字符串
@@ -117,12 +303,77 @@ private:
      */
     std::string FindPhotoFolder(const std::string& dcimFolder);
 
+    /**
+     * @brief 查找所有存储卡DCIM下的照片目录
+     * @return 照片目录列表（按存储卡顺序）
+     */
+    std::vector<std::string> FindPhotoFoldersOnAllStorages();
+
+    /**
+     * @brief 合并不同存储卡上的同一张照片（同名、同大小、拍摄时间一致）
+     * @param fileList 扫描列表（RAW+JPEG配对已合并，原地修改）
+     * @return 合并的重复照片数
+     */
+    size_t MergeStorageDuplicates(std::vector<PhotoMeta>& fileList);
+
+    /**
+     * @brief folder上的副本是否优先于otherFolder上的副本
+     */
+    bool IsPreferredCopy(const std::string& folder, const std::string& otherFolder) const;
+
+    /**
+     * @brief 读取相机内文件信息（持有相机I/O锁；设置了文件信息来源时从来源读取）
+     */
+    bool QueryFileInfo(const std::string& folder, const std::string& fileName, CameraFileInfo& info);
+
+    /**
+     * @brief 两张卡上的同名文件是否为同一张照片（大小相同、修改时间在误差内）
+     */
+    static bool IsSameShot(const CameraFileInfo& infoA, const CameraFileInfo& infoB);
+
     /**
      * @brief 仅扫描照片文件，不下载缩略图
      * @return 照片元信息列表
      */
     std::vector<PhotoMeta> ScanPhotoFilesOnly();
 
+    /**
+     * @brief AddFile的实现（调用方需持有cacheMutex_）
+     * @param copyFolder 已确认为同一张照片的另一张卡上的副本所在目录（为空表示不是双卡备份）
+     * @param added 加入或合并后的条目（输出参数）
+     */
+    bool AddFileLocked(const std::string& folder, const std::string& fileName,
+                       const std::string& copyFolder, PhotoMeta& added);
+
+    /**
+     * @brief 多卡模式下查找另一张卡上尚未合并副本的同名条目（调用方需持有cacheMutex_）
+     * @param copyFolder 同名条目所在目录（输出参数）
+     * @param copyName 同名条目中与fileName同名的文件（输出参数，可能是配对文件）
+     * @return 是否找到
+     */
+    bool FindStorageCopyLocked(const std::string& folder, const std::string& fileName,
+                               std::string& copyFolder, std::string& copyName) const;
+
+    /**
+     * @brief 按当前排序方式重排缓存并重建索引（调用方需持有cacheMutex_）
+     */
+    void ApplySortLocked();
+
+    /**
+     * @brief 按类型过滤重建可见列表和时间轴（调用方需持有cacheMutex_）
+     */
+    void RebuildViewLocked();
+
+    /**
+     * @brief 条目是否通过类型过滤（调用方需持有cacheMutex_）
+     */
+    bool IsVisibleLocked(const PhotoMeta& meta) const;
+
+    /**
+     * @brief 默认过滤掩码：全部照片类型
+     */
+    static uint32_t DefaultTypeFilter();
+
 private:
     Camera* camera_;                   // libgphoto2相机对象
     GPContext* context_;               // libgphoto2上下文对象
@@ -136,6 +387,28 @@ private:
     mutable std::mutex cacheMutex_;            // 缓存互斥锁
     std::atomic<int> scanProgressCurrent_;     // 扫描当前进度
     std::atomic<int> scanProgressTotal_;       // 扫描总进度
+    
+    std::unordered_map<std::string, size_t> indexByKey_; // folder/fileName -> 缓存下标
+    PhotoSortKey sortKey_;                     // 排序字段
+    bool sortAscending_;                       // 是否升序
+    TimelineIndex timeline_;                   // 时间轴索引
+    std::string scanFolder_;                   // 指定的扫描目录（为空则自动查找）
+    
+    std::vector<size_t> viewIndex_;            // 可见列表（缓存下标，按过滤和排序）
+    std::vector<size_t> viewPosition_;         // 缓存下标 -> 可见列表位置（不可见为SIZE_MAX）
+    uint32_t typeFilterMask_;                  // 媒体类型过滤掩码
+    std::array<std::atomic<int>, MEDIA_TYPE_COUNT> typeCounts_; // 各媒体类型文件数
+    ScanCompleteCallback scanCompleteCallback_; // 扫描完成回调
+    FileAddedCallback fileAddedCallback_;      // 增量加入文件回调
+    FileInfoSource fileInfoSource_;            // 文件信息来源（为空时从相机读取）
+    FileNameIndex nameIndex_;                  // 文件名检索索引
+    std::vector<size_t> cacheIndexByScan_;     // 扫描下标 -> 缓存下标
+    std::vector<std::string> cachedFolders_;   // 缓存列表对应的相机目录
+    std::atomic<bool> scanAllStorages_;        // 是否扫描所有存储卡
+    std::string preferredStorage_;             // 重复照片优先的存储卡（为空表示卡槽1）
+    std::atomic<int> duplicateCount_;          // 合并的跨存储卡重复照片数
+    
+    static const long long DUPLICATE_TIME_TOLERANCE = 2; // 双卡写入时间允许的误差（秒）
 };
 
 #endif // PHOTO_SCANNER_H
@@ -0,0 +1,112 @@
+// TimelineIndex.cpp
+// Created on 2026/1/15.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "TimelineIndex.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+int64_t TimelineIndex::FloorTo(int64_t timestamp, int64_t bucketSeconds) {
+    int64_t remainder = timestamp % bucketSeconds;
+    if (remainder < 0) {
+        remainder += bucketSeconds;
+    }
+    return timestamp - remainder;
+}
+
+int64_t TimelineIndex::WallClockFromExifText(const char* text) {
+    struct tm tmValue;
+    memset(&tmValue, 0, sizeof(tmValue));
+    if (!text || sscanf(text, "%d:%d:%d %d:%d:%d", &tmValue.tm_year, &tmValue.tm_mon, &tmValue.tm_mday,
+                        &tmValue.tm_hour, &tmValue.tm_min, &tmValue.tm_sec) != 6) {
+        return 0;
+    }
+    tmValue.tm_year -= 1900;
+    tmValue.tm_mon -= 1;
+    return static_cast<int64_t>(timegm(&tmValue));
+}
+
+int64_t TimelineIndex::WallClockFromEpoch(int64_t epoch) {
+    if (epoch == 0) {
+        return 0;
+    }
+    time_t value = static_cast<time_t>(epoch);
+    struct tm tmValue;
+    if (!localtime_r(&value, &tmValue)) {
+        return epoch;
+    }
+    return static_cast<int64_t>(timegm(&tmValue));
+}
+
+void TimelineIndex::Clear() {
+    hourBuckets_.clear();
+    indexedCount_ = 0;
+}
+
+void TimelineIndex::Rebuild(const std::vector<PhotoMeta>& photos, const std::vector<size_t>& view) {
+    Clear();
+    for (size_t position = 0; position < view.size(); position++) {
+        const PhotoMeta& meta = photos[view[position]];
+        if (meta.exif.loaded) {
+            Add(meta.exif.captureTime, position);
+        }
+    }
+}
+
+void TimelineIndex::Add(int64_t captureTime, size_t position) {
+    if (captureTime == 0) {
+        return;
+    }
+    
+    int64_t start = FloorTo(captureTime, HOUR_SECONDS);
+    auto it = hourBuckets_.find(start);
+    if (it == hourBuckets_.end()) {
+        hourBuckets_.emplace(start, TimelineBucket{start, 1, position});
+    } else {
+        it->second.count++;
+        it->second.firstPosition = std::min(it->second.firstPosition, position);
+    }
+    indexedCount_++;
+}
+
+std::vector<TimelineBucket> TimelineIndex::GetBuckets(int64_t bucketSeconds) const {
+    std::vector<TimelineBucket> buckets;
+    if (bucketSeconds <= HOUR_SECONDS) {
+        buckets.reserve(hourBuckets_.size());
+        for (const auto& entry : hourBuckets_) {
+            buckets.push_back(entry.second);
+        }
+        return buckets;
+    }
+    
+    // 由小时桶合并为更大的桶
+    for (const auto& entry : hourBuckets_) {
+        int64_t start = FloorTo(entry.first, bucketSeconds);
+        if (buckets.empty() || buckets.back().start != start) {
+            buckets.push_back(TimelineBucket{start, 0, entry.second.firstPosition});
+        }
+        TimelineBucket& bucket = buckets.back();
+        bucket.count += entry.second.count;
+        bucket.firstPosition = std::min(bucket.firstPosition, entry.second.firstPosition);
+    }
+    return buckets;
+}
+
+bool TimelineIndex::FindPosition(int64_t timestamp, size_t& position) const {
+    if (hourBuckets_.empty()) {
+        return false;
+    }
+    
+    // 取起点不晚于目标时间的最后一个桶；目标早于所有照片时取第一个桶
+    auto it = hourBuckets_.upper_bound(FloorTo(timestamp, HOUR_SECONDS));
+    if (it != hourBuckets_.begin()) {
+        --it;
+    }
+    position = it->second.firstPosition;
+    return true;
+}
@@ -0,0 +1,98 @@
+// TimelineIndex.h
+// Created on 2026/1/15.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef TIMELINE_INDEX_H
+#define TIMELINE_INDEX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+struct PhotoMeta;
+
+/**
+ * @brief 时间轴桶：某个时间段内的照片数量及其在列表中的起始位置
+ */
+struct TimelineBucket {
+    int64_t start;          // 桶起始时间（挂钟秒数）
+    size_t count;           // 照片数量
+    size_t firstPosition;   // 该时间段照片在列表中的最小下标
+};
+
+/**
+ * @brief 照片时间轴索引，按小时分桶，支持一次查找定位到日期所在位置
+ *
+ * 所有时间统一为"挂钟秒数"：把相机本地的日期时间当作UTC换算得到的秒数。
+ * EXIF时间不带时区，直接按此换算；文件修改时间、ArkTS传入的时间是真实时间戳，
+ * 先用WallClockFromEpoch按本机时区转换，这样按天/小时分桶时两种来源落在同一天。
+ *
+ * 不自带锁，由PhotoScanner在cacheMutex_保护下访问。
+ */
+class TimelineIndex {
+public:
+    static const int64_t HOUR_SECONDS = 3600;
+    static const int64_t DAY_SECONDS = 86400;
+
+    /**
+     * @brief 解析EXIF日期时间"YYYY:MM:DD HH:MM:SS"为挂钟秒数
+     * @return 挂钟秒数，格式不符时返回0
+     */
+    static int64_t WallClockFromExifText(const char* text);
+
+    /**
+     * @brief 真实时间戳（文件修改时间等）按本机时区转换为挂钟秒数
+     * @return 挂钟秒数，epoch为0时返回0（表示未知）
+     */
+    static int64_t WallClockFromEpoch(int64_t epoch);
+
+    /**
+     * @brief 清空索引
+     */
+    void Clear();
+
+    /**
+     * @brief 按可见列表全量重建（列表重排或过滤后调用）
+     * @param photos 照片缓存
+     * @param view 可见列表（photos下标，位置即列表下标）
+     */
+    void Rebuild(const std::vector<PhotoMeta>& photos, const std::vector<size_t>& view);
+
+    /**
+     * @brief 增量加入一张照片
+     * @param captureTime 拍摄时间（挂钟秒数，0表示未知，忽略）
+     * @param position 照片在列表中的下标
+     */
+    void Add(int64_t captureTime, size_t position);
+
+    /**
+     * @brief 获取时间轴桶列表（按时间升序）
+     * @param bucketSeconds 桶大小（HOUR_SECONDS或DAY_SECONDS）
+     * @return 桶列表
+     */
+    std::vector<TimelineBucket> GetBuckets(int64_t bucketSeconds) const;
+
+    /**
+     * @brief 查找指定时间所在（或之前最近的）小时桶的起始位置
+     * @param timestamp 目标时间（挂钟秒数）
+     * @param position 列表下标（输出参数）
+     * @return 索引为空时返回false
+     */
+    bool FindPosition(int64_t timestamp, size_t& position) const;
+
+    /**
+     * @brief 已索引的照片数
+     */
+    size_t Size() const { return indexedCount_; }
+
+private:
+    static int64_t FloorTo(int64_t timestamp, int64_t bucketSeconds);
+
+    std::map<int64_t, TimelineBucket> hourBuckets_;  // 小时起点 -> 桶
+    size_t indexedCount_ = 0;
+};
+
+#endif // TIMELINE_INDEX_H
@@ -0,0 +1,311 @@
+// RawPreviewExtractor.cpp
+// Created on 2026/1/12.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "RawPreviewExtractor.h"
+#include "../../Common/native_common.h"
+#include "gphoto2/gphoto2-port-result.h"
+#include <hilog/log.h>
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <Camera/Common/Constants.h>
+
+#define LOG_DOMAIN ModuleLogs::RawPreviewExtractor.domain
+#define LOG_TAG ModuleLogs::RawPreviewExtractor.tag
+
+// TIFF标签
+static const uint16_t TAG_COMPRESSION = 0x0103;
+static const uint16_t TAG_PHOTOMETRIC = 0x0106;
+static const uint16_t TAG_STRIP_OFFSETS = 0x0111;
+static const uint16_t TAG_STRIP_BYTE_COUNTS = 0x0117;
+static const uint16_t TAG_SUB_IFDS = 0x014A;
+static const uint16_t TAG_JPEG_IF_OFFSET = 0x0201;
+static const uint16_t TAG_JPEG_IF_LENGTH = 0x0202;
+static const uint16_t TAG_EXIF_IFD = 0x8769;
+static const uint16_t TAG_RW2_JPG_FROM_RAW = 0x002E;  // 松下RW2的全尺寸内嵌JPEG
+static const uint16_t TAG_CR2_SLICE = 0xC640;         // 佳能CR2原始数据分片
+
+// TIFF数据类型
+static const uint16_t TYPE_SHORT = 3;
+static const uint16_t TYPE_LONG = 4;
+static const uint16_t TYPE_IFD = 13;
+
+// 压缩方式：6=旧式JPEG，7=JPEG
+static const uint32_t COMPRESSION_OJPEG = 6;
+static const uint32_t COMPRESSION_JPEG = 7;
+
+// 光度解释：CFA/LinearRaw表示RAW数据而非预览
+static const uint32_t PHOTOMETRIC_CFA = 32803;
+static const uint32_t PHOTOMETRIC_LINEAR_RAW = 34892;
+
+RawPreviewExtractor::RawPreviewExtractor()
+    : camera_(nullptr)
+    , context_(nullptr) {
+}
+
+RawPreviewExtractor::~RawPreviewExtractor() {
+    Cleanup();
+}
+
+void RawPreviewExtractor::Init(Camera* camera, GPContext* context) {
+    camera_ = camera;
+    context_ = context;
+}
+
+void RawPreviewExtractor::Cleanup() {
+    camera_ = nullptr;
+    context_ = nullptr;
+}
+
+uint16_t RawPreviewExtractor::ReadU16(const ReadContext& ctx, const uint8_t* p) const {
+    return ctx.littleEndian ? static_cast<uint16_t>(p[0] | (p[1] << 8))
+                            : static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t RawPreviewExtractor::ReadU32(const ReadContext& ctx, const uint8_t* p) const {
+    if (ctx.littleEndian) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+bool RawPreviewExtractor::ReadAt(ReadContext& ctx, uint64_t offset, uint32_t len, std::vector<uint8_t>& out) {
+    out.clear();
+    
+    // 1. 命中文件头缓存
+    if (offset + len <= ctx.head.size()) {
+        out.assign(ctx.head.begin() + offset, ctx.head.begin() + offset + len);
+        return true;
+    }
+    
+    // 2. 分块读取相机文件
+    out.resize(len);
+    uint64_t done = 0;
+    while (done < len) {
+        uint64_t chunkSize = len - done;
+        int ret;
+        {
+            std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+            ret = gp_camera_file_read(camera_, ctx.folder.c_str(), ctx.filename.c_str(), GP_FILE_TYPE_NORMAL,
+                                      offset + done, reinterpret_cast<char*>(out.data() + done),
+                                      &chunkSize, context_);
+        }
+        if (ret != GP_OK) {
+            ctx.error = std::string("gp_camera_file_read 读取失败: ") + gp_result_as_string(ret);
+            out.clear();
+            return false;
+        }
+        if (chunkSize == 0) {
+            break; // 已读到文件末尾
+        }
+        done += chunkSize;
+    }
+    out.resize(done);
+    return done == len;
+}
+
+void RawPreviewExtractor::CollectCandidates(ReadContext& ctx, uint32_t firstIfdOffset,
+                                            std::vector<PreviewCandidate>& candidates) {
+    std::vector<uint32_t> pending = {firstIfdOffset};
+    std::set<uint32_t> visited;
+    std::vector<uint8_t> buf;
+    
+    while (!pending.empty() && static_cast<int>(visited.size()) < MAX_IFD_COUNT) {
+        uint32_t ifdOffset = pending.back();
+        pending.pop_back();
+        if (ifdOffset == 0 || !visited.insert(ifdOffset).second) {
+            continue;
+        }
+        
+        // 1. 读取条目数和全部条目
+        if (!ReadAt(ctx, ifdOffset, 2, buf)) {
+            continue;
+        }
+        uint16_t entryCount = ReadU16(ctx, buf.data());
+        if (entryCount == 0 || entryCount > MAX_IFD_ENTRIES) {
+            continue;
+        }
+        uint32_t ifdSize = 2 + entryCount * 12 + 4;
+        if (!ReadAt(ctx, ifdOffset, ifdSize, buf)) {
+            continue;
+        }
+        
+        // 2. 解析关心的标签
+        uint32_t compression = 0, photometric = 0;
+        uint32_t stripOffset = 0, stripLength = 0, jpegOffset = 0, jpegLength = 0;
+        bool singleStrip = false, isRawSlice = false;
+        
+        for (uint16_t i = 0; i < entryCount; i++) {
+            const uint8_t* entry = buf.data() + 2 + i * 12;
+            uint16_t tag = ReadU16(ctx, entry);
+            uint16_t type = ReadU16(ctx, entry + 2);
+            uint32_t count = ReadU32(ctx, entry + 4);
+            uint32_t value = (type == TYPE_SHORT && count == 1) ? ReadU16(ctx, entry + 8) : ReadU32(ctx, entry + 8);
+            
+            switch (tag) {
+                case TAG_COMPRESSION: compression = value; break;
+                case TAG_PHOTOMETRIC: photometric = value; break;
+                case TAG_STRIP_OFFSETS: stripOffset = value; singleStrip = (count == 1); break;
+                case TAG_STRIP_BYTE_COUNTS: stripLength = value; break;
+                case TAG_JPEG_IF_OFFSET: jpegOffset = value; break;
+                case TAG_JPEG_IF_LENGTH: jpegLength = value; break;
+                case TAG_CR2_SLICE: isRawSlice = true; break;
+                case TAG_RW2_JPG_FROM_RAW:
+                    // 类型为UNDEFINED，count即字节数，值为偏移
+                    if (count > 4) {
+                        candidates.push_back({value, count});
+                    }
+                    break;
+                case TAG_EXIF_IFD:
+                    pending.push_back(value);
+                    break;
+                case TAG_SUB_IFDS:
+                    if (type != TYPE_LONG && type != TYPE_IFD) {
+                        break;
+                    }
+                    if (count == 1) {
+                        pending.push_back(value);
+                    } else if (count > 1 && count <= MAX_IFD_COUNT) {
+                        std::vector<uint8_t> offsets;
+                        if (ReadAt(ctx, value, count * 4, offsets)) {
+                            for (uint32_t j = 0; j < count; j++) {
+                                pending.push_back(ReadU32(ctx, offsets.data() + j * 4));
+                            }
+                        }
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        
+        // 3. 记录候选：JPEGInterchangeFormat，或单条带JPEG压缩且非RAW数据的图像
+        if (jpegOffset > 0 && jpegLength > 0) {
+            candidates.push_back({jpegOffset, jpegLength});
+        }
+        bool isRawData = photometric == PHOTOMETRIC_CFA || photometric == PHOTOMETRIC_LINEAR_RAW || isRawSlice;
+        if (singleStrip && stripOffset > 0 && stripLength > 0 && !isRawData &&
+            (compression == COMPRESSION_OJPEG || compression == COMPRESSION_JPEG)) {
+            candidates.push_back({stripOffset, stripLength});
+        }
+        
+        // 4. 下一个IFD
+        pending.push_back(ReadU32(ctx, buf.data() + 2 + entryCount * 12));
+    }
+}
+
+bool RawPreviewExtractor::IsDisplayableJpeg(ReadContext& ctx, const PreviewCandidate& candidate) {
+    // 只读候选开头的一小段，遍历JPEG段直到SOF
+    std::vector<uint8_t> buf;
+    uint32_t probeSize = std::min<uint32_t>(candidate.length, 64 * 1024);
+    if (!ReadAt(ctx, candidate.offset, probeSize, buf) || buf.size() < 4) {
+        return false;
+    }
+    if (buf[0] != 0xFF || buf[1] != 0xD8) {
+        return false;
+    }
+    
+    size_t pos = 2;
+    while (pos + 4 <= buf.size()) {
+        if (buf[pos] != 0xFF) {
+            return false;
+        }
+        uint8_t marker = buf[pos + 1];
+        if (marker == 0xFF) {
+            pos++;  // 填充字节
+            continue;
+        }
+        // SOF0/1/2为可显示的基线/渐进JPEG，SOF3为无损JPEG（RAW数据）
+        if (marker == 0xC0 || marker == 0xC1 || marker == 0xC2) {
+            return true;
+        }
+        if (marker == 0xC3 || marker == 0xDA) {
+            return false;
+        }
+        uint16_t segLength = static_cast<uint16_t>((buf[pos + 2] << 8) | buf[pos + 3]);
+        pos += 2 + segLength;
+    }
+    return false;
+}
+
+std::vector<uint8_t> RawPreviewExtractor::ExtractLargestPreview(const std::string& folder,
+                                                                const std::string& filename,
+                                                                std::string& error) {
+    std::vector<uint8_t> result;
+    error.clear();
+    
+    if (!camera_ || !context_) {
+        error = "相机未连接";
+        return result;
+    }
+    
+    ReadContext ctx;
+    ctx.folder = folder;
+    ctx.filename = filename;
+    ctx.littleEndian = true;
+    
+    // 1. 读取文件头（大部分RAW的IFD都在前256KB内）
+    uint64_t headSize = HEAD_READ_SIZE;
+    ctx.head.resize(headSize);
+    int ret;
+    {
+        std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+        ret = gp_camera_file_read(camera_, folder.c_str(), filename.c_str(), GP_FILE_TYPE_NORMAL,
+                                  0, reinterpret_cast<char*>(ctx.head.data()), &headSize, context_);
+    }
+    if (ret != GP_OK) {
+        error = std::string("相机不支持分块读取: ") + gp_result_as_string(ret);
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "%{public}s", error.c_str());
+        return result;
+    }
+    ctx.head.resize(headSize);
+    
+    // 2. 校验TIFF头（兼容RW2的0x55和ORF的RO/RS魔数）
+    if (ctx.head.size() < 8) {
+        error = "文件过小";
+        return result;
+    }
+    if (ctx.head[0] == 'I' && ctx.head[1] == 'I') {
+        ctx.littleEndian = true;
+    } else if (ctx.head[0] == 'M' && ctx.head[1] == 'M') {
+        ctx.littleEndian = false;
+    } else {
+        error = "不是TIFF结构的RAW文件";
+        return result;
+    }
+    uint16_t magic = ReadU16(ctx, ctx.head.data() + 2);
+    if (magic != 42 && magic != 0x55 && magic != 0x4F52 && magic != 0x5352) {
+        error = "不是TIFF结构的RAW文件";
+        return result;
+    }
+    
+    // 3. 收集候选并按大小从大到小尝试
+    std::vector<PreviewCandidate> candidates;
+    CollectCandidates(ctx, ReadU32(ctx, ctx.head.data() + 4), candidates);
+    std::sort(candidates.begin(), candidates.end(),
+              [](const PreviewCandidate& a, const PreviewCandidate& b) { return a.length > b.length; });
+    
+    for (const auto& candidate : candidates) {
+        if (candidate.length > MAX_PREVIEW_SIZE || !IsDisplayableJpeg(ctx, candidate)) {
+            continue;
+        }
+        if (ReadAt(ctx, candidate.offset, candidate.length, result)) {
+            OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                        "提取内嵌JPEG成功: %{public}s, offset=%{public}u, 大小=%{public}u",
+                        filename.c_str(), candidate.offset, candidate.length);
+            return result;
+        }
+    }
+    
+    result.clear();
+    error = ctx.error.empty() ? "未找到内嵌JPEG" : ctx.error;
+    OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, 
+                "提取内嵌JPEG失败: %{public}s, 候选%{public}zu个, %{public}s",
+                filename.c_str(), candidates.size(), error.c_str());
+    return result;
+}
@@ -0,0 +1,107 @@
+// RawPreviewExtractor.h
+// Created on 2026/1/12.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef RAW_PREVIEW_EXTRACTOR_H
+#define RAW_PREVIEW_EXTRACTOR_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// libgphoto2头文件
+#include <gphoto2/gphoto2.h>
+#include <gphoto2/gphoto2-camera.h>
+
+/**
+ * @brief RAW内嵌JPEG提取器
+ *
+ * NEF/CR2/ARW/DNG/RW2/ORF均为TIFF结构，文件前部的IFD中记录了内嵌预览JPEG的位置。
+ * 通过分块读取只取回IFD和最大的那张JPEG，无需传输整个RAW文件。
+ */
+class RawPreviewExtractor {
+public:
+    /**
+     * @brief 构造函数
+     */
+    RawPreviewExtractor();
+
+    /**
+     * @brief 析构函数
+     */
+    ~RawPreviewExtractor();
+
+    /**
+     * @brief 初始化提取器
+     * @param camera libgphoto2相机对象
+     * @param context libgphoto2上下文对象
+     */
+    void Init(Camera* camera, GPContext* context);
+
+    /**
+     * @brief 清理资源
+     */
+    void Cleanup();
+
+    /**
+     * @brief 提取RAW文件中最大的内嵌JPEG（可多个线程同时调用）
+     * @param folder 照片所在文件夹
+     * @param filename RAW文件名
+     * @param error 输出：失败原因（每次调用各自返回，不与其他调用共享）
+     * @return JPEG数据，失败返回空
+     */
+    std::vector<uint8_t> ExtractLargestPreview(const std::string& folder, const std::string& filename,
+                                               std::string& error);
+
+private:
+    /**
+     * @brief 内嵌JPEG候选位置
+     */
+    struct PreviewCandidate {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    /**
+     * @brief 读取单个文件时的上下文（文件头缓存与字节序）
+     */
+    struct ReadContext {
+        std::string folder;
+        std::string filename;
+        std::vector<uint8_t> head;   // 文件头缓存
+        bool littleEndian;
+        std::string error;           // 读取失败的原因
+    };
+
+    /**
+     * @brief 按偏移读取相机文件，优先命中文件头缓存
+     * @return 是否读满len字节
+     */
+    bool ReadAt(ReadContext& ctx, uint64_t offset, uint32_t len, std::vector<uint8_t>& out);
+
+    /**
+     * @brief 遍历IFD链（含SubIFD/ExifIFD），收集JPEG候选
+     */
+    void CollectCandidates(ReadContext& ctx, uint32_t firstIfdOffset, std::vector<PreviewCandidate>& candidates);
+
+    /**
+     * @brief 检查候选数据开头是否为可显示的JPEG（排除无损JPEG编码的RAW数据）
+     */
+    bool IsDisplayableJpeg(ReadContext& ctx, const PreviewCandidate& candidate);
+
+    uint16_t ReadU16(const ReadContext& ctx, const uint8_t* p) const;
+    uint32_t ReadU32(const ReadContext& ctx, const uint8_t* p) const;
+
+private:
+    Camera* camera_;           // libgphoto2相机对象
+    GPContext* context_;       // libgphoto2上下文对象
+
+    static const uint32_t HEAD_READ_SIZE = 256 * 1024;          // 首次读取的文件头大小
+    static const uint32_t MAX_PREVIEW_SIZE = 32 * 1024 * 1024;  // 内嵌JPEG大小上限
+    static const int MAX_IFD_COUNT = 32;                        // 最多遍历的IFD数（防止环）
+    static const uint16_t MAX_IFD_ENTRIES = 512;                // 单个IFD最多条目数
+};
+
+#endif // RAW_PREVIEW_EXTRACTOR_H
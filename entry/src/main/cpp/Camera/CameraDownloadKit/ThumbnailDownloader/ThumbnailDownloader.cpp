@@ -10,6 +10,7 @@
 #include "gphoto2/gphoto2-port-result.h"
 #include <hilog/log.h>
 #include <chrono>
+#include <mutex>
 #include <thread>
 #include <Camera/Common/Constants.h>
 
@@ -126,6 +127,7 @@ std::vector<uint8_t> ThumbnailDownloader::InternalDownloadThumbnail(
     int ret = GP_OK;
     try {
         // 获取缩略图
+        std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
         ret = gp_camera_file_get(camera_, folder.c_str(), filename.c_str(), 
                                 GP_FILE_TYPE_PREVIEW, thumbFile, context_);
     } catch (...) {
@@ -8,10 +8,19 @@
 #include <Camera/CameraDownloadKit/PhotoScanner/PhotoScanner.h>
 #include "Camera/CameraDownloadKit/ThumbnailDownloader/ThumbnailDownloader.h"
 #include "Camera/CameraDownloadKit/PhotoDownloader/PhotoDownloader.h"
+#include "Camera/CameraDownloadKit/ImportManifest/ImportManifest.h"
+#include "Camera/CameraDownloadKit/ImportManifest/DownloadedSet.h"
+#include "Camera/CameraDownloadKit/RawPreviewExtractor/RawPreviewExtractor.h"
+#include "Camera/CameraDownloadKit/ExifHarvester/ExifHarvester.h"
+#include "Camera/CameraDownloadKit/FolderTree/FolderTree.h"
+#ifdef PHOTOSEND_BENCHMARK
+#include "Camera/CameraDownloadKit/Benchmark/ScanBenchmark.h"
+#endif
 #include "../Common/native_common.h"
 #include <hilog/log.h>
 #include <Camera/Common/Constants.h>
 #include <memory>
+#include <cstring>
 #include <thread>
 #include <condition_variable>
 
@@ -22,6 +31,23 @@
 static std::unique_ptr<PhotoScanner> g_photoScanner;
 static std::unique_ptr<ThumbnailDownloader> g_thumbnailDownloader;
 static std::unique_ptr<PhotoDownloader> g_photoDownloader;
+static std::unique_ptr<RawPreviewExtractor> g_rawPreviewExtractor;
+static std::unique_ptr<ExifHarvester> g_exifHarvester;
+static std::unique_ptr<FolderTree> g_folderTree;
+
+// 导入清单（跨连接保留，由SetImportManifestDir打开）
+static ImportManifest g_importManifest;
+static const char* IMPORT_MANIFEST_FILE_NAME = "import_manifest.tsv";
+static std::string g_importManifestDir;
+
+// 当前相机的已下载集合（连接后按序列号打开，断开时关闭）
+static DownloadedSet g_downloadedSet;
+
+// 直接I/O阈值（字节，0=关闭），跨连接保留
+static uint64_t g_directIoThreshold = 0;
+
+// RAW+JPEG配对导入策略，跨连接保留
+static PairImportPolicy g_pairImportPolicy = PairImportPolicy::Both;
 
 // 辅助函数：创建NAPI字符串
 static napi_value CreateNapiStringHelper(napi_env env, const char* str) {
@@ -30,6 +56,27 @@ static napi_value CreateNapiStringHelper(napi_env env, const char* str) {
     return result;
 }
 
+ImportManifest* GetImportManifest() {
+    return g_importManifest.IsOpen() ? &g_importManifest : nullptr;
+}
+
+DownloadedSet* GetDownloadedSet() {
+    return g_downloadedSet.IsOpen() ? &g_downloadedSet : nullptr;
+}
+
+const std::string& GetImportManifestDir() {
+    return g_importManifestDir;
+}
+
+// 清单目录和相机都就绪后按序列号打开已下载集合
+static void OpenDownloadedSet() {
+    if (g_importManifestDir.empty() || !g_camera || !g_photoDownloader) {
+        return;
+    }
+    g_downloadedSet.Open(g_importManifestDir, g_photoDownloader->GetCameraSerial(), GetImportManifest());
+    g_photoDownloader->SetDownloadedSet(GetDownloadedSet());
+}
+
 // ========== 模块初始化函数 ==========
 void InitCameraDownloadModules() {
     if (!g_photoScanner) {
@@ -44,16 +91,45 @@ void InitCameraDownloadModules() {
         g_photoDownloader = std::make_unique<PhotoDownloader>();
     }
     
+    if (!g_rawPreviewExtractor) {
+        g_rawPreviewExtractor = std::make_unique<RawPreviewExtractor>();
+    }
+    
+    if (!g_exifHarvester) {
+        g_exifHarvester = std::make_unique<ExifHarvester>();
+    }
+    
+    if (!g_folderTree) {
+        g_folderTree = std::make_unique<FolderTree>();
+    }
+    
     // 初始化模块
     if (g_camera && g_context) {
         g_photoScanner->Init(g_camera, g_context);
         g_thumbnailDownloader->Init(g_camera, g_context);
         g_photoDownloader->Init(g_camera, g_context);
+        g_rawPreviewExtractor->Init(g_camera, g_context);
+        g_exifHarvester->Init(g_camera, g_context, g_photoScanner.get());
+        g_folderTree->Init(g_camera, g_context);
     }
+    g_photoDownloader->SetImportManifest(GetImportManifest());
+    g_photoDownloader->SetDirectIoThreshold(g_directIoThreshold);
+    OpenDownloadedSet();
+    g_photoScanner->SetScanCompleteCallback([](const std::vector<PhotoMeta>& scanList) {
+        g_downloadedSet.BindIndex(scanList);
+    });
+    g_photoScanner->SetFileAddedCallback([](const PhotoMeta& meta) {
+        g_downloadedSet.AddIndex(meta);
+    });
 }
 
 // ========== 模块清理函数 ==========
 void CleanupCameraDownloadModules() {
+    // EXIF采集线程依赖扫描器，最先停止
+    if (g_exifHarvester) {
+        g_exifHarvester->Cleanup();
+    }
+    
     if (g_photoScanner) {
         g_photoScanner->Cleanup();
     }
@@ -63,8 +139,27 @@ void CleanupCameraDownloadModules() {
     }
     
     if (g_photoDownloader) {
+        g_photoDownloader->SetDownloadedSet(nullptr);
         g_photoDownloader->Cleanup();
     }
+    g_downloadedSet.Close();
+    
+    if (g_rawPreviewExtractor) {
+        g_rawPreviewExtractor->Cleanup();
+    }
+    
+    if (g_folderTree) {
+        g_folderTree->Cleanup();
+    }
+}
+
+void NotifyCameraFileAdded(const std::string& folder, const std::string& fileName) {
+    if (g_folderTree) {
+        g_folderTree->InvalidateFolder(folder);
+    }
+    if (g_photoScanner) {
+        g_photoScanner->AddFile(folder, fileName);
+    }
 }
 
 // ========== 缩略图信号量相关函数 ==========
@@ -152,6 +247,22 @@ napi_value GetPhotoMetaList(napi_env env, napi_callback_info info) {
                               CreateNapiStringHelper(env, meta.folder.c_str()));
         napi_set_named_property(env, metaObj, "filename", 
                               CreateNapiStringHelper(env, meta.fileName.c_str()));
+        if (!meta.pairedFileName.empty()) {
+            napi_set_named_property(env, metaObj, "pairedFilename", 
+                                  CreateNapiStringHelper(env, meta.pairedFileName.c_str()));
+        }
+        napi_set_named_property(env, metaObj, "mediaType", 
+                              CreateNapiStringHelper(env, MediaTypeName(meta.mediaType)));
+        if (!meta.duplicateFolder.empty()) {
+            napi_set_named_property(env, metaObj, "duplicateFolder", 
+                                  CreateNapiStringHelper(env, meta.duplicateFolder.c_str()));
+        }
+        
+        
+        // 已下载标记（按扫描下标查位图，RAW+JPEG任一已下载即为true）
+        napi_value downloadedValue;
+        napi_get_boolean(env, g_downloadedSet.IsDownloaded(meta.scanIndex), &downloadedValue);
+        napi_set_named_property(env, metaObj, "downloaded", downloadedValue);
         
         // 如果有文件大小，也返回
         if (meta.fileSize > 0) {
@@ -160,6 +271,23 @@ napi_value GetPhotoMetaList(napi_env env, napi_callback_info info) {
             napi_set_named_property(env, metaObj, "size", sizeValue);
         }
         
+        // 已采集EXIF时返回可排序字段
+        if (meta.exif.loaded) {
+            napi_value value;
+            napi_create_int64(env, meta.exif.captureTime, &value);
+            napi_set_named_property(env, metaObj, "captureTime", value);
+            napi_create_double(env, meta.exif.exposureTime, &value);
+            napi_set_named_property(env, metaObj, "exposureTime", value);
+            napi_create_double(env, meta.exif.fNumber, &value);
+            napi_set_named_property(env, metaObj, "fNumber", value);
+            napi_create_int32(env, meta.exif.iso, &value);
+            napi_set_named_property(env, metaObj, "iso", value);
+            napi_create_double(env, meta.exif.focalLength, &value);
+            napi_set_named_property(env, metaObj, "focalLength", value);
+            napi_create_int32(env, meta.exif.orientation, &value);
+            napi_set_named_property(env, metaObj, "orientation", value);
+        }
+        
         // 添加到数组
         napi_set_element(env, resultArray, i, metaObj);
     }
@@ -298,6 +426,93 @@ napi_value DownloadSingleThumbnail(napi_env env, napi_callback_info info) {
     return result;
 }
 
+napi_value ExtractRawPreview(napi_env env, napi_callback_info info) {
+    // 1. 解析参数
+    size_t argc = 3;
+    napi_value args[3];
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 3) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
+                       "ExtractRawPreview 参数错误：需要folder、filename、callback");
+        return nullptr;
+    }
+    
+    napi_valuetype argType;
+    napi_typeof(env, args[2], &argType);
+    if (argType != napi_function) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "第三个参数必须是回调函数");
+        return nullptr;
+    }
+    
+    // 2. 创建异步任务数据
+    struct AsyncRawPreviewTaskData {
+        napi_ref callback;
+        std::string folder;
+        std::string filename;
+        std::vector<uint8_t> jpegData;
+        std::string errorMsg;
+    };
+    
+    AsyncRawPreviewTaskData* taskData = new AsyncRawPreviewTaskData();
+    char folder[256] = {0};
+    char filename[256] = {0};
+    napi_get_value_string_utf8(env, args[0], folder, sizeof(folder), nullptr);
+    napi_get_value_string_utf8(env, args[1], filename, sizeof(filename), nullptr);
+    taskData->folder = folder;
+    taskData->filename = filename;
+    napi_create_reference(env, args[2], 1, &taskData->callback);
+    
+    // 3. 创建异步工作
+    napi_value workName;
+    napi_create_string_utf8(env, "ExtractRawPreview", NAPI_AUTO_LENGTH, &workName);
+    napi_async_work work;
+    
+    // 工作函数（在后台线程执行）
+    auto executeWork = [](napi_env env, void* data) {
+        AsyncRawPreviewTaskData* taskData = static_cast<AsyncRawPreviewTaskData*>(data);
+        if (!g_rawPreviewExtractor) {
+            taskData->errorMsg = "RAW预览提取器未初始化";
+            return;
+        }
+        taskData->jpegData = g_rawPreviewExtractor->ExtractLargestPreview(taskData->folder, taskData->filename,
+                                                                          taskData->errorMsg);
+    };
+    
+    // 完成函数（在主线程执行）
+    auto completeWork = [](napi_env env, napi_status status, void* data) {
+        AsyncRawPreviewTaskData* taskData = static_cast<AsyncRawPreviewTaskData*>(data);
+        
+        napi_value callback;
+        napi_get_reference_value(env, taskData->callback, &callback);
+        
+        napi_value args[2];
+        if (!taskData->jpegData.empty()) {
+            void* bufferData = nullptr;
+            napi_create_buffer_copy(env, taskData->jpegData.size(), taskData->jpegData.data(),
+                                   &bufferData, &args[1]);
+            napi_get_null(env, &args[0]);
+        } else {
+            napi_create_string_utf8(env, taskData->errorMsg.c_str(), NAPI_AUTO_LENGTH, &args[0]);
+            napi_get_null(env, &args[1]);
+        }
+        
+        napi_value global;
+        napi_get_global(env, &global);
+        napi_make_callback(env, nullptr, global, callback, 2, args, nullptr);
+        
+        napi_delete_reference(env, taskData->callback);
+        delete taskData;
+    };
+    
+    napi_create_async_work(env, nullptr, workName, executeWork, completeWork, 
+                          taskData, &work);
+    napi_queue_async_work(env, work);
+    
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
 napi_value DownloadPhoto(napi_env env, napi_callback_info info) {
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
                 "!!!!!!!!!! 开始执行 NAPI 接口 DownloadPhoto !!!!!!!!!!");
@@ -385,9 +600,288 @@ napi_value DownloadPhoto(napi_env env, napi_callback_info info) {
     return result;
 }
 
+napi_value DownloadPhotoBatch(napi_env env, napi_callback_info info) {
+    // 1. 解析参数
+    size_t argc = 4;
+    napi_value args[4];
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 4) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
+                       "DownloadPhotoBatch 参数错误：需要files、destDir、skipImported、callback");
+        return nullptr;
+    }
+    
+    napi_valuetype argType;
+    napi_typeof(env, args[3], &argType);
+    if (argType != napi_function) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "第四个参数必须是回调函数");
+        return nullptr;
+    }
+    
+    // 2. 创建异步任务数据
+    struct AsyncBatchTaskData {
+        napi_ref callback;
+        std::vector<PhotoMeta> files;
+        PairImportPolicy pairPolicy;
+        std::string destDir;
+        bool skipImported;
+        std::vector<BatchDownloadResult> results;
+        std::string errorMsg;
+    };
+    
+    AsyncBatchTaskData* taskData = new AsyncBatchTaskData();
+    taskData->skipImported = true;
+    taskData->pairPolicy = g_pairImportPolicy;
+    
+    uint32_t fileCount = 0;
+    napi_get_array_length(env, args[0], &fileCount);
+    taskData->files.reserve(fileCount);
+    for (uint32_t i = 0; i < fileCount; i++) {
+        napi_value item, folderValue, nameValue;
+        napi_get_element(env, args[0], i, &item);
+        napi_get_named_property(env, item, "folder", &folderValue);
+        napi_get_named_property(env, item, "filename", &nameValue);
+        
+        char folder[256] = {0};
+        char filename[256] = {0};
+        napi_get_value_string_utf8(env, folderValue, folder, sizeof(folder), nullptr);
+        napi_get_value_string_utf8(env, nameValue, filename, sizeof(filename), nullptr);
+        
+        PhotoMeta meta;
+        meta.folder = folder;
+        meta.fileName = filename;
+        meta.fileSize = 0;
+        
+        // 配对文件可选
+        bool hasPaired = false;
+        napi_has_named_property(env, item, "pairedFilename", &hasPaired);
+        if (hasPaired) {
+            napi_value pairedValue;
+            napi_valuetype pairedType;
+            napi_get_named_property(env, item, "pairedFilename", &pairedValue);
+            napi_typeof(env, pairedValue, &pairedType);
+            if (pairedType == napi_string) {
+                char pairedName[256] = {0};
+                napi_get_value_string_utf8(env, pairedValue, pairedName, sizeof(pairedName), nullptr);
+                meta.pairedFileName = pairedName;
+            }
+        }
+        taskData->files.push_back(meta);
+    }
+    
+    char destDir[1024] = {0};
+    napi_get_value_string_utf8(env, args[1], destDir, sizeof(destDir), nullptr);
+    taskData->destDir = destDir;
+    napi_get_value_bool(env, args[2], &taskData->skipImported);
+    napi_create_reference(env, args[3], 1, &taskData->callback);
+    
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "DownloadPhotoBatch: %{public}zu 个文件 -> %{public}s, 跳过已导入: %{public}d", 
+                taskData->files.size(), taskData->destDir.c_str(), taskData->skipImported);
+    
+    // 3. 创建异步工作
+    napi_value workName;
+    napi_create_string_utf8(env, "DownloadPhotoBatch", NAPI_AUTO_LENGTH, &workName);
+    napi_async_work work;
+    
+    // 工作函数（在后台线程执行）
+    auto executeWork = [](napi_env env, void* data) {
+        AsyncBatchTaskData* taskData = static_cast<AsyncBatchTaskData*>(data);
+        if (!g_photoDownloader) {
+            taskData->errorMsg = "照片下载器未初始化";
+            return;
+        }
+        
+        // 按配对策略展开需要传输的文件
+        std::vector<std::pair<std::string, std::string>> files;
+        files.reserve(taskData->files.size());
+        for (const auto& meta : taskData->files) {
+            auto selected = g_photoDownloader->SelectPairFiles(
+                meta.folder, meta.fileName, meta.pairedFileName, taskData->pairPolicy);
+            files.insert(files.end(), selected.begin(), selected.end());
+        }
+        taskData->results = g_photoDownloader->DownloadBatch(
+            files, taskData->destDir, taskData->skipImported);
+    };
+    
+    // 完成函数（在主线程执行）
+    auto completeWork = [](napi_env env, napi_status status, void* data) {
+        AsyncBatchTaskData* taskData = static_cast<AsyncBatchTaskData*>(data);
+        
+        napi_value callback;
+        napi_get_reference_value(env, taskData->callback, &callback);
+        
+        napi_value args[2];
+        if (taskData->errorMsg.empty()) {
+            napi_get_null(env, &args[0]);
+            napi_create_array(env, &args[1]);
+            for (size_t i = 0; i < taskData->results.size(); i++) {
+                const BatchDownloadResult& result = taskData->results[i];
+                const char* outcome = "failed";
+                if (result.outcome == DownloadOutcome::Downloaded) {
+                    outcome = "downloaded";
+                } else if (result.outcome == DownloadOutcome::Skipped) {
+                    outcome = "skipped";
+                } else if (result.outcome == DownloadOutcome::Reimported) {
+                    outcome = "reimported";
+                }
+                
+                napi_value resultObj;
+                napi_create_object(env, &resultObj);
+                napi_set_named_property(env, resultObj, "folder", 
+                                      CreateNapiStringHelper(env, result.folder.c_str()));
+                napi_set_named_property(env, resultObj, "filename", 
+                                      CreateNapiStringHelper(env, result.fileName.c_str()));
+                napi_set_named_property(env, resultObj, "status", CreateNapiStringHelper(env, outcome));
+                napi_set_named_property(env, resultObj, "localPath", 
+                                      CreateNapiStringHelper(env, result.localPath.c_str()));
+                if (!result.importedPath.empty()) {
+                    napi_set_named_property(env, resultObj, "importedPath",
+                                          CreateNapiStringHelper(env, result.importedPath.c_str()));
+                }
+                napi_value crcValue;
+                napi_create_uint32(env, result.crc32, &crcValue);
+                napi_set_named_property(env, resultObj, "crc32", crcValue);
+                if (!result.error.empty()) {
+                    napi_set_named_property(env, resultObj, "error", 
+                                          CreateNapiStringHelper(env, result.error.c_str()));
+                }
+                napi_set_element(env, args[1], i, resultObj);
+            }
+        } else {
+            napi_create_string_utf8(env, taskData->errorMsg.c_str(), NAPI_AUTO_LENGTH, &args[0]);
+            napi_get_null(env, &args[1]);
+        }
+        
+        napi_value global;
+        napi_get_global(env, &global);
+        napi_make_callback(env, nullptr, global, callback, 2, args, nullptr);
+        
+        napi_delete_reference(env, taskData->callback);
+        delete taskData;
+    };
+    
+    napi_create_async_work(env, nullptr, workName, executeWork, completeWork, 
+                          taskData, &work);
+    napi_queue_async_work(env, work);
+    
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+napi_value SetImportManifestDir(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    napi_value result;
+    if (argc < 1) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "SetImportManifestDir 参数错误");
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+    
+    char dir[1024] = {0};
+    napi_get_value_string_utf8(env, args[0], dir, sizeof(dir), nullptr);
+    
+    std::string manifestPath = dir;
+    if (!manifestPath.empty() && manifestPath.back() != '/') {
+        manifestPath.push_back('/');
+    }
+    manifestPath += IMPORT_MANIFEST_FILE_NAME;
+    
+    bool success = g_importManifest.Open(manifestPath);
+    if (success && g_photoDownloader) {
+        g_photoDownloader->SetImportManifest(&g_importManifest);
+    }
+    if (success) {
+        g_importManifestDir = dir;
+        OpenDownloadedSet();
+    }
+    
+    napi_get_boolean(env, success, &result);
+    return result;
+}
+
+napi_value SetDownloadDirectIoThreshold(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    int64_t threshold = 0;
+    if (argc >= 1) {
+        napi_get_value_int64(env, args[0], &threshold);
+    }
+    g_directIoThreshold = threshold > 0 ? static_cast<uint64_t>(threshold) : 0;
+    if (g_photoDownloader) {
+        g_photoDownloader->SetDirectIoThreshold(g_directIoThreshold);
+    }
+    
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "直接I/O阈值设置为: %{public}llu 字节", static_cast<unsigned long long>(g_directIoThreshold));
+    
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+napi_value SetPairImportPolicy(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    napi_value result;
+    char policy[32] = {0};
+    if (argc >= 1) {
+        napi_get_value_string_utf8(env, args[0], policy, sizeof(policy), nullptr);
+    }
+    
+    if (strcmp(policy, "both") == 0) {
+        g_pairImportPolicy = PairImportPolicy::Both;
+    } else if (strcmp(policy, "jpeg") == 0) {
+        g_pairImportPolicy = PairImportPolicy::JpegOnly;
+    } else if (strcmp(policy, "raw") == 0) {
+        g_pairImportPolicy = PairImportPolicy::RawOnly;
+    } else if (strcmp(policy, "rawIfProtected") == 0) {
+        g_pairImportPolicy = PairImportPolicy::RawWhenProtected;
+    } else {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "未知的配对导入策略: %{public}s", policy);
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+    
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "配对导入策略设置为: %{public}s", policy);
+    napi_get_boolean(env, true, &result);
+    return result;
+}
+
+napi_value IsPhotoImported(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    bool imported = false;
+    if (argc >= 2 && g_photoDownloader) {
+        char folder[256] = {0};
+        char filename[256] = {0};
+        napi_get_value_string_utf8(env, args[0], folder, sizeof(folder), nullptr);
+        napi_get_value_string_utf8(env, args[1], filename, sizeof(filename), nullptr);
+        imported = g_photoDownloader->IsImported(folder, filename, nullptr);
+    }
+    
+    napi_value result;
+    napi_get_boolean(env, imported, &result);
+    return result;
+}
+
 napi_value ClearPhotoCacheNapi(napi_env env, napi_callback_info info) {
     OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "调用 ClearPhotoCacheNapi");
     
+    if (g_exifHarvester) {
+        g_exifHarvester->Stop();
+    }
+    
     if (g_photoScanner) {
         g_photoScanner->ClearCache();
     }
@@ -478,6 +972,25 @@ napi_value GetScanProgress(napi_env env, napi_callback_info info) {
     napi_get_boolean(env, cached, &cachedValue);
     napi_set_named_property(env, result, "cached", cachedValue);
     
+    // 添加各媒体类型文件数（只返回非零项）
+    std::array<int, MEDIA_TYPE_COUNT> typeCounts;
+    g_photoScanner->GetTypeCounts(typeCounts);
+    napi_value typeCountsObj;
+    napi_create_object(env, &typeCountsObj);
+    for (size_t i = 0; i < MEDIA_TYPE_COUNT; i++) {
+        if (typeCounts[i] > 0) {
+            napi_value countValue;
+            napi_create_int32(env, typeCounts[i], &countValue);
+            napi_set_named_property(env, typeCountsObj, MediaTypeName(static_cast<MediaType>(i)), countValue);
+        }
+    }
+    napi_set_named_property(env, result, "typeCounts", typeCountsObj);
+    
+    // 添加合并的跨存储卡重复照片数
+    napi_value duplicatesValue;
+    napi_create_int32(env, g_photoScanner->GetDuplicateCount(), &duplicatesValue);
+    napi_set_named_property(env, result, "duplicates", duplicatesValue);
+    
     // 添加照片总数（如果缓存存在）
     if (cached) {
         // 注意：这里需要从扫描器获取总数，但GetScanProgress没有返回这个信息
@@ -488,6 +1001,499 @@ napi_value GetScanProgress(napi_env env, napi_callback_info info) {
     return result;
 }
 
+napi_value StartExifHarvest(napi_env env, napi_callback_info info) {
+    bool started = g_exifHarvester && g_exifHarvester->Start();
+    
+    napi_value result;
+    napi_get_boolean(env, started, &result);
+    return result;
+}
+
+napi_value StopExifHarvest(napi_env env, napi_callback_info info) {
+    if (g_exifHarvester) {
+        g_exifHarvester->Stop();
+    }
+    
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+napi_value GetExifHarvestProgress(napi_env env, napi_callback_info info) {
+    int current = 0, total = 0;
+    bool harvesting = g_exifHarvester && g_exifHarvester->GetProgress(current, total);
+    
+    napi_value result;
+    napi_create_object(env, &result);
+    
+    napi_value harvestingValue;
+    napi_get_boolean(env, harvesting, &harvestingValue);
+    napi_set_named_property(env, result, "harvesting", harvestingValue);
+    
+    napi_value currentValue;
+    napi_create_int32(env, current, &currentValue);
+    napi_set_named_property(env, result, "current", currentValue);
+    
+    napi_value totalValue;
+    napi_create_int32(env, total, &totalValue);
+    napi_set_named_property(env, result, "total", totalValue);
+    
+    return result;
+}
+
+napi_value SetPhotoSortOrder(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    napi_value result;
+    char key[32] = {0};
+    bool ascending = true;
+    if (argc >= 1) {
+        napi_get_value_string_utf8(env, args[0], key, sizeof(key), nullptr);
+    }
+    if (argc >= 2) {
+        napi_get_value_bool(env, args[1], &ascending);
+    }
+    
+    static const std::pair<const char*, PhotoSortKey> SORT_KEYS[] = {
+        {"name", PhotoSortKey::Name},
+        {"captureTime", PhotoSortKey::CaptureTime},
+        {"exposureTime", PhotoSortKey::ExposureTime},
+        {"fNumber", PhotoSortKey::FNumber},
+        {"iso", PhotoSortKey::Iso},
+        {"focalLength", PhotoSortKey::FocalLength},
+        {"size", PhotoSortKey::Size},
+    };
+    
+    for (const auto& sortKey : SORT_KEYS) {
+        if (strcmp(key, sortKey.first) == 0) {
+            if (g_photoScanner) {
+                g_photoScanner->SetSortOrder(sortKey.second, ascending);
+            }
+            napi_get_boolean(env, g_photoScanner != nullptr, &result);
+            return result;
+        }
+    }
+    
+    OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "未知的排序字段: %{public}s", key);
+    napi_get_boolean(env, false, &result);
+    return result;
+}
+
+napi_value ListCameraFolder(napi_env env, napi_callback_info info) {
+    // 1. 解析参数
+    size_t argc = 3;
+    napi_value args[3];
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 3) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, 
+                       "ListCameraFolder 参数错误：需要path、refresh、callback");
+        return nullptr;
+    }
+    
+    napi_valuetype argType;
+    napi_typeof(env, args[2], &argType);
+    if (argType != napi_function) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "第三个参数必须是回调函数");
+        return nullptr;
+    }
+    
+    // 2. 创建异步任务数据
+    struct AsyncListFolderTaskData {
+        napi_ref callback;
+        std::string path;
+        bool refresh;
+        FolderListing listing;
+        std::string errorMsg;
+    };
+    
+    AsyncListFolderTaskData* taskData = new AsyncListFolderTaskData();
+    char path[1024] = {0};
+    napi_get_value_string_utf8(env, args[0], path, sizeof(path), nullptr);
+    taskData->path = path;
+    taskData->refresh = false;
+    napi_get_value_bool(env, args[1], &taskData->refresh);
+    napi_create_reference(env, args[2], 1, &taskData->callback);
+    
+    // 3. 创建异步工作
+    napi_value workName;
+    napi_create_string_utf8(env, "ListCameraFolder", NAPI_AUTO_LENGTH, &workName);
+    napi_async_work work;
+    
+    // 工作函数（在后台线程执行）
+    auto executeWork = [](napi_env env, void* data) {
+        AsyncListFolderTaskData* taskData = static_cast<AsyncListFolderTaskData*>(data);
+        if (!g_folderTree) {
+            taskData->errorMsg = "目录树未初始化";
+            return;
+        }
+        taskData->listing = g_folderTree->ListFolder(taskData->path, taskData->refresh);
+        if (!taskData->listing.valid) {
+            taskData->errorMsg = "列出目录失败";
+        }
+    };
+    
+    // 完成函数（在主线程执行）
+    auto completeWork = [](napi_env env, napi_status status, void* data) {
+        AsyncListFolderTaskData* taskData = static_cast<AsyncListFolderTaskData*>(data);
+        
+        napi_value callback;
+        napi_get_reference_value(env, taskData->callback, &callback);
+        
+        napi_value args[2];
+        if (taskData->errorMsg.empty()) {
+            napi_get_null(env, &args[0]);
+            napi_create_object(env, &args[1]);
+            napi_set_named_property(env, args[1], "path", 
+                                  CreateNapiStringHelper(env, taskData->listing.path.c_str()));
+            
+            napi_value folders;
+            napi_create_array(env, &folders);
+            for (size_t i = 0; i < taskData->listing.folders.size(); i++) {
+                napi_set_element(env, folders, i, 
+                               CreateNapiStringHelper(env, taskData->listing.folders[i].c_str()));
+            }
+            napi_set_named_property(env, args[1], "folders", folders);
+            
+            napi_value files;
+            napi_create_array(env, &files);
+            for (size_t i = 0; i < taskData->listing.files.size(); i++) {
+                napi_set_element(env, files, i, 
+                               CreateNapiStringHelper(env, taskData->listing.files[i].c_str()));
+            }
+            napi_set_named_property(env, args[1], "files", files);
+        } else {
+            napi_create_string_utf8(env, taskData->errorMsg.c_str(), NAPI_AUTO_LENGTH, &args[0]);
+            napi_get_null(env, &args[1]);
+        }
+        
+        napi_value global;
+        napi_get_global(env, &global);
+        napi_make_callback(env, nullptr, global, callback, 2, args, nullptr);
+        
+        napi_delete_reference(env, taskData->callback);
+        delete taskData;
+    };
+    
+    napi_create_async_work(env, nullptr, workName, executeWork, completeWork, 
+                          taskData, &work);
+    napi_queue_async_work(env, work);
+    
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+napi_value SetScanFolder(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    napi_value result;
+    if (!g_photoScanner) {
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+    
+    char folder[1024] = {0};
+    if (argc >= 1) {
+        napi_get_value_string_utf8(env, args[0], folder, sizeof(folder), nullptr);
+    }
+    
+    // 切换目录后旧缓存失效，需重新扫描
+    if (g_exifHarvester) {
+        g_exifHarvester->Stop();
+    }
+    g_photoScanner->SetScanFolder(folder);
+    g_photoScanner->ClearCache();
+    
+    napi_get_boolean(env, true, &result);
+    return result;
+}
+
+napi_value SetMultiStorageScan(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    napi_value result;
+    if (!g_photoScanner || argc < 1) {
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+    
+    bool enabled = false;
+    napi_get_value_bool(env, args[0], &enabled);
+    char preferredStorage[256] = {0};
+    if (argc >= 2) {
+        napi_valuetype type;
+        napi_typeof(env, args[1], &type);
+        if (type == napi_string) {
+            napi_get_value_string_utf8(env, args[1], preferredStorage, sizeof(preferredStorage), nullptr);
+        }
+    }
+    
+    // 扫描范围变化后旧缓存失效，需重新扫描
+    if (g_exifHarvester) {
+        g_exifHarvester->Stop();
+    }
+    g_photoScanner->SetMultiStorageScan(enabled, preferredStorage);
+    g_photoScanner->ClearCache();
+    
+    napi_get_boolean(env, true, &result);
+    return result;
+}
+
+napi_value SetMediaTypeFilter(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    napi_value result;
+    if (!g_photoScanner) {
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+    
+    // 类型名数组 -> 位掩码；"raw"表示全部RAW，空数组恢复默认
+    uint32_t mask = 0;
+    uint32_t count = 0;
+    if (argc >= 1) {
+        napi_get_array_length(env, args[0], &count);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value item;
+        char typeName[32] = {0};
+        napi_get_element(env, args[0], i, &item);
+        napi_get_value_string_utf8(env, item, typeName, sizeof(typeName), nullptr);
+        
+        for (size_t t = 0; t < MEDIA_TYPE_COUNT; t++) {
+            MediaType type = static_cast<MediaType>(t);
+            if (strcmp(typeName, MediaTypeName(type)) == 0 ||
+                (strcmp(typeName, "raw") == 0 && IsRawMediaType(type))) {
+                mask |= PhotoScanner::MediaTypeBit(type);
+            }
+        }
+    }
+    
+    g_photoScanner->SetTypeFilter(mask);
+    napi_get_boolean(env, true, &result);
+    return result;
+}
+
+napi_value GetTimelineBuckets(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    // 默认按天分桶
+    int64_t bucketSeconds = TimelineIndex::DAY_SECONDS;
+    if (argc >= 1) {
+        char granularity[16] = {0};
+        napi_get_value_string_utf8(env, args[0], granularity, sizeof(granularity), nullptr);
+        if (strcmp(granularity, "hour") == 0) {
+            bucketSeconds = TimelineIndex::HOUR_SECONDS;
+        }
+    }
+    
+    napi_value resultArray;
+    napi_create_array(env, &resultArray);
+    if (!g_photoScanner) {
+        return resultArray;
+    }
+    
+    auto buckets = g_photoScanner->GetTimelineBuckets(bucketSeconds);
+    for (size_t i = 0; i < buckets.size(); i++) {
+        napi_value bucketObj;
+        napi_create_object(env, &bucketObj);
+        
+        napi_value value;
+        napi_create_int64(env, buckets[i].start, &value);
+        napi_set_named_property(env, bucketObj, "start", value);
+        napi_create_int64(env, static_cast<int64_t>(buckets[i].count), &value);
+        napi_set_named_property(env, bucketObj, "count", value);
+        napi_create_int64(env, static_cast<int64_t>(buckets[i].firstPosition), &value);
+        napi_set_named_property(env, bucketObj, "position", value);
+        
+        napi_set_element(env, resultArray, i, bucketObj);
+    }
+    return resultArray;
+}
+
+napi_value GetPageForDate(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    int32_t page = -1;
+    if (argc >= 2 && g_photoScanner) {
+        int64_t timestamp = 0;
+        int32_t pageSize = 0;
+        napi_get_value_int64(env, args[0], &timestamp);
+        napi_get_value_int32(env, args[1], &pageSize);
+        
+        // ArkTS传入真实时间戳，转换为时间轴的挂钟秒数
+        size_t position = 0;
+        if (pageSize > 0 && g_photoScanner->FindPositionForDate(TimelineIndex::WallClockFromEpoch(timestamp), position)) {
+            page = static_cast<int32_t>(position / pageSize);
+        }
+    }
+    
+    napi_value result;
+    napi_create_int32(env, page, &result);
+    return result;
+}
+
+napi_value SearchPhotos(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    napi_value resultArray;
+    napi_create_array(env, &resultArray);
+    if (argc < 1 || !g_photoScanner) {
+        return resultArray;
+    }
+    
+    char query[256] = {0};
+    napi_get_value_string_utf8(env, args[0], query, sizeof(query), nullptr);
+    
+    // 匹配方式："prefix"（默认）或"substring"
+    bool prefixOnly = true;
+    if (argc >= 2) {
+        napi_valuetype type;
+        napi_typeof(env, args[1], &type);
+        if (type == napi_string) {
+            char mode[16] = {0};
+            napi_get_value_string_utf8(env, args[1], mode, sizeof(mode), nullptr);
+            prefixOnly = strcmp(mode, "substring") != 0;
+        }
+    }
+    
+    int32_t limit = 0;
+    if (argc >= 3) {
+        napi_get_value_int32(env, args[2], &limit);
+    }
+    
+    auto positions = g_photoScanner->SearchFileName(query, prefixOnly, limit > 0 ? static_cast<size_t>(limit) : 0);
+    for (size_t i = 0; i < positions.size(); i++) {
+        napi_value value;
+        napi_create_int64(env, static_cast<int64_t>(positions[i]), &value);
+        napi_set_element(env, resultArray, i, value);
+    }
+    
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
+                "SearchPhotos '%{public}s' (%{public}s) 命中 %{public}zu 条", 
+                query, prefixOnly ? "prefix" : "substring", positions.size());
+    return resultArray;
+}
+
+#ifdef PHOTOSEND_BENCHMARK
+napi_value RunScanBenchmark(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    // 读取可选参数对象中的整数字段
+    ScanBenchmarkOptions options;
+    if (argc >= 1) {
+        napi_valuetype type;
+        napi_typeof(env, args[0], &type);
+        if (type == napi_object) {
+            const std::pair<const char*, int*> fields[] = {
+                {"fileCount", &options.fileCount},
+                {"rawPercent", &options.rawPercent},
+                {"pairPercent", &options.pairPercent},
+                {"videoPercent", &options.videoPercent},
+                {"sidecarPercent", &options.sidecarPercent},
+                {"filesPerFolder", &options.filesPerFolder},
+                {"pageSize", &options.pageSize},
+            };
+            for (const auto& field : fields) {
+                bool hasField = false;
+                napi_has_named_property(env, args[0], field.first, &hasField);
+                if (hasField) {
+                    napi_value value;
+                    napi_get_named_property(env, args[0], field.first, &value);
+                    napi_get_value_int32(env, value, field.second);
+                }
+            }
+        }
+    }
+    
+    // 百万级文件的基准要跑数秒，放到后台线程执行，结果经Promise返回
+    struct AsyncBenchmarkTaskData {
+        napi_async_work work;
+        napi_deferred deferred;
+        ScanBenchmarkOptions options;
+        ScanBenchmarkReport report;
+        bool success;
+    };
+
+    AsyncBenchmarkTaskData* taskData = new AsyncBenchmarkTaskData();
+    taskData->options = options;
+    taskData->success = false;
+
+    napi_value promise;
+    napi_create_promise(env, &taskData->deferred, &promise);
+
+    napi_value workName;
+    napi_create_string_utf8(env, "RunScanBenchmark", NAPI_AUTO_LENGTH, &workName);
+
+    // 工作函数（在后台线程执行）
+    auto executeWork = [](napi_env env, void* data) {
+        AsyncBenchmarkTaskData* taskData = static_cast<AsyncBenchmarkTaskData*>(data);
+        taskData->success = ScanBenchmark::Run(taskData->options, taskData->report);
+    };
+
+    // 完成函数（在主线程执行）
+    auto completeWork = [](napi_env env, napi_status status, void* data) {
+        AsyncBenchmarkTaskData* taskData = static_cast<AsyncBenchmarkTaskData*>(data);
+        if (!taskData->success) {
+            napi_value error;
+            napi_value message;
+            napi_create_string_utf8(env, "基准测试参数无效", NAPI_AUTO_LENGTH, &message);
+            napi_create_error(env, nullptr, message, &error);
+            napi_reject_deferred(env, taskData->deferred, error);
+        } else {
+            const ScanBenchmarkReport& report = taskData->report;
+            napi_value result;
+            napi_create_object(env, &result);
+            const std::pair<const char*, double> values[] = {
+                {"fileCount", report.fileCount},
+                {"entryCount", report.entryCount},
+                {"scanMs", report.scanMs},
+                {"scanAllocs", static_cast<double>(report.scanAllocs)},
+                {"scanAllocBytes", static_cast<double>(report.scanAllocBytes)},
+                {"classifyNsPerFile", report.classifyNsPerFile},
+                {"pageCount", report.pageCount},
+                {"pageAvgUs", report.pageAvgUs},
+                {"pageP50Us", report.pageP50Us},
+                {"pageP99Us", report.pageP99Us},
+                {"pageMaxUs", report.pageMaxUs},
+                {"pageAllocsAvg", report.pageAllocsAvg},
+                {"rssBeforeKb", static_cast<double>(report.rssBeforeKb)},
+                {"rssAfterKb", static_cast<double>(report.rssAfterKb)},
+                {"peakRssKb", static_cast<double>(report.peakRssKb)},
+            };
+            for (const auto& entry : values) {
+                napi_value value;
+                napi_create_double(env, entry.second, &value);
+                napi_set_named_property(env, result, entry.first, value);
+            }
+            napi_resolve_deferred(env, taskData->deferred, result);
+        }
+        napi_delete_async_work(env, taskData->work);
+        delete taskData;
+    };
+
+    napi_create_async_work(env, nullptr, workName, executeWork, completeWork, taskData, &taskData->work);
+    napi_queue_async_work(env, taskData->work);
+    return promise;
+}
+#endif
+
 /*
 napi_value DisconnectCamera(napi_env env, napi_callback_info info) {
     OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "断开相机连接，清理下载模块");
@@ -10,17 +10,38 @@
 #include <napi/native_api.h>
 #include <string>
 #include <functional>
+#include <cstdint>
+#include "Camera/Common/MediaType.h"
 
 // 前向声明各个模块类
 class PhotoScanner;
 class ThumbnailDownloader;
 class PhotoDownloader;
+class ImportManifest;
+class DownloadedSet;
+
+// 照片EXIF摘要（后台采集，未采集时loaded为false）
+struct PhotoExifMeta {
+    bool loaded = false;        // 是否已采集
+    int64_t captureTime = 0;    // 拍摄时间（挂钟秒数：DateTimeOriginal按UTC换算，无EXIF时为按本机时区转换的文件修改时间）
+    double exposureTime = 0;    // 曝光时间（秒）
+    double fNumber = 0;         // 光圈值
+    int iso = 0;                // ISO感光度
+    double focalLength = 0;     // 焦距（毫米）
+    int orientation = 1;        // 方向（1-8）
+};
 
 // 照片元信息
 struct PhotoMeta {
     std::string folder;    // 文件夹路径
-    std::string fileName;  // 文件名
+    std::string fileName;  // 文件名（RAW+JPEG配对时为JPEG）
     size_t fileSize;       // 文件大小
+    std::string pairedFileName; // 同目录同名的RAW文件（无配对时为空）
+    PhotoExifMeta exif;         // EXIF摘要
+    MediaType mediaType = MediaType::Unknown;       // 主文件媒体类型
+    MediaType pairedMediaType = MediaType::Unknown; // 配对文件媒体类型
+    uint32_t scanIndex = UINT32_MAX; // 扫描列表中的下标（排序前，用于已下载位图）
+    std::string duplicateFolder; // 双卡备份时另一张存储卡上同一照片所在目录（无重复时为空）
 };
 
 // 用于在回调函数之间传递的进度信息结构体
@@ -38,6 +59,42 @@ struct DownloadProgressData {
  */
 extern napi_value DownloadPhoto(napi_env env, napi_callback_info info);
 
+/**
+ * @brief 从RAW文件中提取最大的内嵌JPEG（分块读取，只传输IFD和JPEG数据）
+ * @param env NAPI环境
+ * @param info NAPI回调信息（3个参数：folder、filename、callback）
+ * @return napi_value 返回undefined，结果通过callback(err, buffer)异步返回
+ */
+extern napi_value ExtractRawPreview(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 批量下载照片到指定目录，已导入的文件不再传输
+ * @param env NAPI环境
+ * @param info NAPI回调信息（4个参数：files数组[{folder, filename}]、destDir、skipImported、callback）
+ * @return napi_value 返回undefined，结果通过callback(err, results)异步返回
+ */
+extern napi_value DownloadPhotoBatch(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 设置导入清单所在目录（应用沙箱目录），加载已导入记录
+ */
+extern napi_value SetImportManifestDir(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 设置直接I/O阈值，不小于该大小的文件下载时绕过页缓存写入（0表示关闭）
+ */
+extern napi_value SetDownloadDirectIoThreshold(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 设置RAW+JPEG配对照片的导入策略（both/jpeg/raw/rawIfProtected）
+ */
+extern napi_value SetPairImportPolicy(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 查询照片是否已导入到手机
+ */
+extern napi_value IsPhotoImported(napi_env env, napi_callback_info info);
+
 /**
  * @brief 获取照片总数
  */
@@ -76,6 +133,71 @@ extern napi_value IsScanComplete(napi_env env, napi_callback_info info);
  */
 extern napi_value GetScanProgress(napi_env env, napi_callback_info info);
 
+/**
+ * @brief 启动后台EXIF采集（扫描完成后调用，低优先级，不影响前台下载）
+ */
+extern napi_value StartExifHarvest(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 停止后台EXIF采集
+ */
+extern napi_value StopExifHarvest(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 获取EXIF采集进度
+ */
+extern napi_value GetExifHarvestProgress(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 设置照片列表排序方式（name/captureTime/exposureTime/fNumber/iso/focalLength/size）
+ */
+extern napi_value SetPhotoSortOrder(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 列出相机目录（子目录和文件），结果按目录缓存，命中时不访问相机
+ * @param env NAPI环境
+ * @param info NAPI回调信息（3个参数：path、refresh、callback）
+ * @return napi_value 返回undefined，结果通过callback(err, listing)异步返回
+ */
+extern napi_value ListCameraFolder(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 指定照片扫描目录（空字符串恢复自动查找DCIM），清空缓存后需重新扫描
+ */
+extern napi_value SetScanFolder(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 设置多卡扫描（扫描所有存储卡并合并双卡备份的重复照片），清空缓存后需重新扫描
+ */
+extern napi_value SetMultiStorageScan(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 设置照片列表显示的媒体类型（jpeg/heif/raw/rawNikon.../video），无需重新扫描
+ */
+extern napi_value SetMediaTypeFilter(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 获取时间轴桶列表（按天或按小时），每个桶包含数量和在列表中的起始位置
+ */
+extern napi_value GetTimelineBuckets(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 获取指定时间的照片所在页码
+ */
+extern napi_value GetPageForDate(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 按文件名检索照片（前缀或子串，不区分大小写），返回命中照片在列表中的下标
+ */
+extern napi_value SearchPhotos(napi_env env, napi_callback_info info);
+
+#ifdef PHOTOSEND_BENCHMARK
+/**
+ * @brief 运行扫描基准测试（合成文件列表，不访问相机），仅在基准构建中提供
+ */
+extern napi_value RunScanBenchmark(napi_env env, napi_callback_info info);
+#endif
+
 /**
  * @brief 初始化缩略图下载信号量（在相机连接成功时调用）
  */
@@ -87,6 +209,26 @@ extern void InitThumbnailSemaphore();
 extern void CleanupThumbnailSemaphore();
 
 
+/**
+ * @brief 获取已打开的导入清单（未调用SetImportManifestDir时返回nullptr）
+ */
+extern ImportManifest* GetImportManifest();
+
+/**
+ * @brief 获取当前相机的已下载集合（未打开时返回nullptr）
+ */
+extern DownloadedSet* GetDownloadedSet();
+
+/**
+ * @brief 获取SetImportManifestDir设置的目录（未设置时为空）
+ */
+extern const std::string& GetImportManifestDir();
+
+/**
+ * @brief 相机新增文件时调用：使目录树中该目录的缓存过期，并将文件增量加入照片列表
+ */
+extern void NotifyCameraFileAdded(const std::string& folder, const std::string& fileName);
+
 extern void InitCameraDownloadModules();
 
 extern void CleanupCameraDownloadModules();
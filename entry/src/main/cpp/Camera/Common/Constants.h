@@ -28,6 +28,19 @@ namespace ModuleLogs {
     inline const ModuleLogConfig DeviceScanner = {0x0010, "DeviceScanner"};
     inline const ModuleLogConfig NapiDeviceInterface = {0x0011, "NapiDeviceInterface"};
     inline const ModuleLogConfig ExifReader = {0x0011, "ExifReader"};
+    inline const ModuleLogConfig ImportManifest = {0x0012, "ImportManifest"};
+    inline const ModuleLogConfig TetherSession = {0x0013, "TetherSession"};
+    inline const ModuleLogConfig CameraCapture = {0x0014, "CameraCapture"};
+    inline const ModuleLogConfig RawPreviewExtractor = {0x0015, "RawPreviewExtractor"};
+    inline const ModuleLogConfig ExifHarvester = {0x0016, "ExifHarvester"};
+    inline const ModuleLogConfig FolderTree = {0x0017, "FolderTree"};
+    inline const ModuleLogConfig DownloadedSet = {0x0018, "DownloadedSet"};
+    inline const ModuleLogConfig ScanBenchmark = {0x0019, "ScanBenchmark"};
+    inline const ModuleLogConfig ConfigSnapshot = {0x0020, "ConfigSnapshot"};
+    inline const ModuleLogConfig ConfigWriteQueue = {0x0021, "ConfigWriteQueue"};
+    inline const ModuleLogConfig StatusMonitor = {0x0022, "StatusMonitor"};
+    inline const ModuleLogConfig ConfigSchemaCache = {0x0023, "ConfigSchemaCache"};
+    inline const ModuleLogConfig ConfigPrefetcher = {0x0024, "ConfigPrefetcher"};
     // 添加更多...
 }
 
@@ -0,0 +1,169 @@
+// MediaType.h
+// Created on 2026/1/17.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef PHOTOSEND_MEDIA_TYPE_H
+#define PHOTOSEND_MEDIA_TYPE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 相机内文件的媒体类型（RAW按厂商区分）
+ */
+enum class MediaType : uint8_t {
+    Unknown = 0,
+    Jpeg,
+    Heif,
+    RawNikon,       // NEF/NRW
+    RawCanon,       // CR2/CR3/CRW
+    RawSony,        // ARW/SRF/SR2
+    RawFuji,        // RAF
+    RawPanasonic,   // RW2
+    RawOlympus,     // ORF
+    RawPentax,      // PEF
+    RawDng,         // DNG
+    Video,          // MOV/MP4/AVI/MTS/M2TS/MXF
+    Sidecar,        // XMP/THM/WAV等附属文件
+    Count
+};
+
+constexpr size_t MEDIA_TYPE_COUNT = static_cast<size_t>(MediaType::Count);
+
+/**
+ * @brief 将扩展名（最多4个字符）按小写打包为32位整数，可用作switch的case标签
+ * @return 打包值，扩展名过长或含非ASCII字母数字时返回0
+ */
+constexpr uint32_t PackExtension(const char* ext, size_t len) {
+    if (len == 0 || len > 4) {
+        return 0;
+    }
+    uint32_t packed = 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = ext[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        } else if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))) {
+            return 0;
+        }
+        packed = (packed << 8) | static_cast<uint8_t>(c);
+    }
+    return packed;
+}
+
+/**
+ * @brief 字面量版本，供case标签使用
+ */
+template <size_t N>
+constexpr uint32_t PackExtension(const char (&ext)[N]) {
+    return PackExtension(ext, N - 1);
+}
+
+/**
+ * @brief 按扩展名判断媒体类型（不区分大小写，不分配内存）
+ */
+constexpr MediaType ClassifyExtension(const char* ext, size_t len) {
+    switch (PackExtension(ext, len)) {
+        case PackExtension("jpg"):
+        case PackExtension("jpeg"):
+            return MediaType::Jpeg;
+        case PackExtension("heif"):
+        case PackExtension("heic"):
+        case PackExtension("hif"):
+            return MediaType::Heif;
+        case PackExtension("nef"):
+        case PackExtension("nrw"):
+            return MediaType::RawNikon;
+        case PackExtension("cr2"):
+        case PackExtension("cr3"):
+        case PackExtension("crw"):
+            return MediaType::RawCanon;
+        case PackExtension("arw"):
+        case PackExtension("srf"):
+        case PackExtension("sr2"):
+            return MediaType::RawSony;
+        case PackExtension("raf"):
+            return MediaType::RawFuji;
+        case PackExtension("rw2"):
+            return MediaType::RawPanasonic;
+        case PackExtension("orf"):
+            return MediaType::RawOlympus;
+        case PackExtension("pef"):
+            return MediaType::RawPentax;
+        case PackExtension("dng"):
+            return MediaType::RawDng;
+        case PackExtension("mov"):
+        case PackExtension("mp4"):
+        case PackExtension("avi"):
+        case PackExtension("mts"):
+        case PackExtension("m2ts"):
+        case PackExtension("mxf"):
+            return MediaType::Video;
+        case PackExtension("xmp"):
+        case PackExtension("thm"):
+        case PackExtension("wav"):
+        case PackExtension("lrv"):
+            return MediaType::Sidecar;
+        default:
+            return MediaType::Unknown;
+    }
+}
+
+/**
+ * @brief 按文件名判断媒体类型
+ */
+constexpr MediaType ClassifyFileName(const char* fileName) {
+    if (!fileName) {
+        return MediaType::Unknown;
+    }
+    const char* dot = nullptr;
+    const char* p = fileName;
+    for (; *p; p++) {
+        if (*p == '.') {
+            dot = p;
+        }
+    }
+    if (!dot) {
+        return MediaType::Unknown;
+    }
+    return ClassifyExtension(dot + 1, static_cast<size_t>(p - dot - 1));
+}
+
+constexpr bool IsRawMediaType(MediaType type) {
+    return type >= MediaType::RawNikon && type <= MediaType::RawDng;
+}
+
+constexpr bool IsPhotoMediaType(MediaType type) {
+    return type == MediaType::Jpeg || type == MediaType::Heif || IsRawMediaType(type);
+}
+
+/**
+ * @brief 媒体类型名称（用于ArkTS层的统计与过滤）
+ */
+constexpr const char* MediaTypeName(MediaType type) {
+    switch (type) {
+        case MediaType::Jpeg: return "jpeg";
+        case MediaType::Heif: return "heif";
+        case MediaType::RawNikon: return "rawNikon";
+        case MediaType::RawCanon: return "rawCanon";
+        case MediaType::RawSony: return "rawSony";
+        case MediaType::RawFuji: return "rawFuji";
+        case MediaType::RawPanasonic: return "rawPanasonic";
+        case MediaType::RawOlympus: return "rawOlympus";
+        case MediaType::RawPentax: return "rawPentax";
+        case MediaType::RawDng: return "rawDng";
+        case MediaType::Video: return "video";
+        case MediaType::Sidecar: return "sidecar";
+        default: return "unknown";
+    }
+}
+
+static_assert(ClassifyFileName("DSC_0001.NEF") == MediaType::RawNikon, "NEF应识别为尼康RAW");
+static_assert(ClassifyFileName("IMG_0001.jpeg") == MediaType::Jpeg, "JPEG扩展名不区分大小写");
+static_assert(ClassifyFileName("C0001.M2TS") == MediaType::Video, "M2TS应识别为视频");
+static_assert(ClassifyFileName("a.b.HIF") == MediaType::Heif, "以最后一个点为扩展名");
+static_assert(ClassifyFileName("README") == MediaType::Unknown, "无扩展名为未知类型");
+
+#endif // PHOTOSEND_MEDIA_TYPE_H
@@ -76,6 +76,11 @@ void ClearCameraInstance() {
                  "清除全局相机实例");
 }
 
+std::recursive_mutex& GetCameraIoMutex() {
+    static std::recursive_mutex s_cameraIoMutex;
+    return s_cameraIoMutex;
+}
+
 // ======================= 原有的全局变量定义 =======================
 // 移除原有的全局变量定义，或者保留但标记为废弃
 // Camera* g_camera = nullptr;  // 移除
@@ -11,6 +11,7 @@
 #include "gphoto2/gphoto2-camera.h"
 #include "gphoto2/gphoto2-context.h"
 #include <cstdarg>
+#include <mutex>
 #include <napi/native_api.h>
 #include <string>
 
@@ -57,6 +58,13 @@ void SetCameraInstance(Camera* camera, GPContext* context, bool connected);
  */
 void ClearCameraInstance();
 
+/**
+ * @brief 获取相机I/O互斥锁
+ * @details libgphoto2的Camera对象不是线程安全的，后台线程访问相机前必须持有此锁
+ * @return std::recursive_mutex& 全局唯一的相机I/O锁
+ */
+std::recursive_mutex& GetCameraIoMutex();
+
 // ======================= 向后兼容的宏定义 =======================
 // 为了兼容现有代码，提供宏定义（逐渐淘汰直接使用全局变量）
 
@@ -0,0 +1,303 @@
+// TetherSession.cpp
+// Created on 2026/1/10.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "TetherSession.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/CameraDownloadKit/PhotoDownloader/AtomicFileWriter.h"
+#include "Camera/Common/native_common.h"
+#include "Camera/Common/MediaType.h"
+#include "Camera/Core/Config/StatusMonitor.h"
+#include "gphoto2/gphoto2-port-result.h"
+#include <hilog/log.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <Camera/Common/Constants.h>
+
+#define LOG_DOMAIN ModuleLogs::TetherSession.domain
+#define LOG_TAG ModuleLogs::TetherSession.tag
+
+TetherSession::TetherSession()
+    : camera_(nullptr)
+    , context_(nullptr)
+    , policy_(TetherPolicy::FullFile)
+    , running_(false)
+    , stopRequested_(false)
+    , captureRequested_(false) {
+}
+
+TetherSession::~TetherSession() {
+    stop();
+}
+
+TetherSession& TetherSession::getInstance() {
+    static TetherSession instance;
+    return instance;
+}
+
+TetherPolicy TetherSession::parsePolicy(const std::string& policy) {
+    if (policy == "jpeg") {
+        return TetherPolicy::JpegOnly;
+    }
+    if (policy == "preview") {
+        return TetherPolicy::PreviewOnly;
+    }
+    return TetherPolicy::FullFile;
+}
+
+bool TetherSession::start(const std::string& destDir, TetherPolicy policy, EventCallback callback) {
+    if (running_) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "联机会话已在运行");
+        return false;
+    }
+    if (!g_connected || !g_camera || !g_context) {
+        OH_LOG_PrintMsg(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "相机未连接，无法启动联机会话");
+        return false;
+    }
+
+    camera_ = g_camera;
+    context_ = g_context;
+    destDir_ = destDir;
+    policy_ = policy;
+    callback_ = callback;
+    pending_.clear();
+
+    downloader_.Init(camera_, context_);
+    downloader_.SetImportManifest(GetImportManifest());
+    downloader_.SetDownloadedSet(GetDownloadedSet());
+
+    // 上一次会话因相机无响应自行结束时，线程已退出但尚未回收
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    stopRequested_ = false;
+    captureRequested_ = false;
+    running_ = true;
+    thread_ = std::thread(&TetherSession::eventLoop, this);
+
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                 "联机会话已启动: 目录=%{public}s, 策略=%{public}d", destDir_.c_str(), static_cast<int>(policy_));
+    return true;
+}
+
+void TetherSession::stop() {
+    if (!thread_.joinable()) {
+        running_ = false;
+        return;
+    }
+    stopRequested_ = true;
+    thread_.join();
+    running_ = false;
+
+    downloader_.Cleanup();
+    callback_ = nullptr;
+    camera_ = nullptr;
+    context_ = nullptr;
+    OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "联机会话已停止");
+}
+
+bool TetherSession::requestCapture() {
+    if (!running_) {
+        return false;
+    }
+    captureRequested_ = true;
+    return true;
+}
+
+void TetherSession::eventLoop() {
+    OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "联机事件循环开始");
+
+    int failures = 0;   // 等待事件连续失败次数
+    while (!stopRequested_) {
+        // 1. 执行App触发的拍摄
+        if (captureRequested_.exchange(false)) {
+            doCapture();
+        }
+
+        // 2. 新文件优先：队列非空时先下载，再继续等待事件
+        if (!pending_.empty()) {
+            CameraFilePath path = pending_.front();
+            pending_.pop_front();
+            processNewFile(path);
+            continue;
+        }
+
+        // 3. 等待相机事件（短超时，等待期间持有IO锁）
+        CameraEventType eventType = GP_EVENT_UNKNOWN;
+        void* eventData = nullptr;
+        int ret;
+        {
+            std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+            ret = gp_camera_wait_for_event(camera_, EVENT_POLL_MS, &eventType, &eventData, context_);
+        }
+        if (ret != GP_OK) {
+            // 只上报连续失败中的第一次，之后按指数退避重试，持续失败（如相机已拔出）时结束会话
+            failures++;
+            TetherEvent event;
+            event.error = std::string("等待相机事件失败: ") + gp_result_as_string(ret);
+            event.latencyMs = 0;
+            if (failures >= MAX_EVENT_FAILURES) {
+                OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG,
+                             "等待相机事件连续失败%{public}d次，结束联机会话", failures);
+                event.type = "stopped";
+                emit(event);
+                break;
+            }
+            if (failures == 1) {
+                event.type = "error";
+                emit(event);
+            }
+            int delayMs = std::min(EVENT_RETRY_BASE_MS << (failures - 1), EVENT_RETRY_MAX_MS);
+            for (int waited = 0; waited < delayMs && !stopRequested_; waited += EVENT_POLL_MS) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(EVENT_POLL_MS));
+            }
+            continue;
+        }
+        failures = 0;
+        if (eventType == GP_EVENT_TIMEOUT) {
+            // 没有事件：已释放IO锁，稍等再取，让等锁的状态监视、配置预取、EXIF采集插入
+            free(eventData);
+            std::this_thread::sleep_for(std::chrono::milliseconds(EVENT_YIELD_MS));
+            continue;
+        }
+
+        if (eventType == GP_EVENT_FILE_ADDED && eventData) {
+            CameraFilePath* path = static_cast<CameraFilePath*>(eventData);
+            OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                         "新文件: %{public}s/%{public}s", path->folder, path->name);
+            pending_.push_back(*path);
+        } else if (eventType == GP_EVENT_UNKNOWN && eventData &&
+                   strstr(static_cast<const char*>(eventData), "Property") != nullptr) {
+            // ptp2把属性变化上报为"PTP Property xxxx changed"：机身拨盘改了参数，配置快照作废，状态监视随即刷新
+            NotifyCameraPropertyChanged();
+        }
+        free(eventData);
+    }
+
+    running_ = false;
+    OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "联机事件循环结束");
+}
+
+void TetherSession::doCapture() {
+    std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+
+    // 优先只触发快门，新文件经由GP_EVENT_FILE_ADDED到达；不支持时回退到阻塞拍摄
+    int ret = gp_camera_trigger_capture(camera_, context_);
+    if (ret == GP_ERROR_NOT_SUPPORTED) {
+        CameraFilePath path;
+        ret = gp_camera_capture(camera_, GP_CAPTURE_IMAGE, &path, context_);
+        if (ret == GP_OK) {
+            pending_.push_back(path);
+        }
+    }
+
+    if (ret != GP_OK) {
+        TetherEvent event;
+        event.type = "error";
+        event.error = std::string("拍摄失败: ") + gp_result_as_string(ret);
+        event.latencyMs = 0;
+        emit(event);
+    }
+}
+
+void TetherSession::processNewFile(const CameraFilePath& path) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    TetherEvent event;
+    event.folder = path.folder;
+    event.fileName = path.name;
+    event.latencyMs = 0;
+
+    event.type = "fileAdded";
+    emit(event);
+    NotifyCameraFileAdded(path.folder, path.name);
+
+    bool success = false;
+    switch (policy_) {
+        case TetherPolicy::JpegOnly:
+            if (ClassifyFileName(path.name) != MediaType::Jpeg) {
+                event.type = "skipped";
+                emit(event);
+                return;
+            }
+            // JPEG按完整文件下载
+            [[fallthrough]];
+        case TetherPolicy::FullFile:
+            event.localPath = makeLocalPath(path.name);
+            success = downloader_.DownloadFile(path.folder, path.name, event.localPath);
+            if (!success) {
+                event.error = downloader_.GetLastError();
+            }
+            break;
+        case TetherPolicy::PreviewOnly:
+            success = downloadPreview(path, event.localPath, event.error);
+            break;
+    }
+
+    event.type = success ? "downloaded" : "error";
+    event.latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
+                 "联机导入 %{public}s: %{public}s, 耗时 %{public}lldms",
+                 path.name, success ? "成功" : "失败", event.latencyMs);
+    emit(event);
+}
+
+bool TetherSession::downloadPreview(const CameraFilePath& path, std::string& localPath, std::string& error) {
+    CameraFile* file = nullptr;
+    gp_file_new(&file);
+
+    int ret;
+    {
+        std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+        ret = gp_camera_file_get(camera_, path.folder, path.name, GP_FILE_TYPE_PREVIEW, file, context_);
+    }
+    if (ret != GP_OK) {
+        error = std::string("下载预览图失败: ") + gp_result_as_string(ret);
+        gp_file_unref(file);
+        return false;
+    }
+
+    const char* data = nullptr;
+    unsigned long size = 0;
+    gp_file_get_data_and_size(file, &data, &size);
+    if (!data || size == 0) {
+        error = "预览图数据为空";
+        gp_file_unref(file);
+        return false;
+    }
+
+    // 预览图保存为"<文件名主干>_preview.jpg"
+    std::string stem = path.name;
+    size_t dot = stem.rfind('.');
+    if (dot != std::string::npos) {
+        stem.erase(dot);
+    }
+    localPath = makeLocalPath(stem + "_preview.jpg");
+
+    AtomicFileWriter writer;
+    bool success = writer.Open(localPath, size, false) && writer.Write(data, size) && writer.Commit();
+    if (!success) {
+        error = "写入预览图失败: " + writer.GetLastError();
+    }
+    gp_file_unref(file);
+    return success;
+}
+
+void TetherSession::emit(const TetherEvent& event) {
+    if (callback_) {
+        callback_(event);
+    }
+}
+
+std::string TetherSession::makeLocalPath(const std::string& fileName) const {
+    std::string path = destDir_;
+    if (!path.empty() && path.back() != '/') {
+        path.push_back('/');
+    }
+    return path + fileName;
+}
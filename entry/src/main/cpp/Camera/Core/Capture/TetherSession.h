@@ -0,0 +1,121 @@
+// TetherSession.h
+// Created on 2026/1/10.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef TETHER_SESSION_H
+#define TETHER_SESSION_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gphoto2/gphoto2.h>
+#include <gphoto2/gphoto2-camera.h>
+
+#include "Camera/CameraDownloadKit/PhotoDownloader/PhotoDownloader.h"
+
+/**
+ * @brief 联机自动导入策略
+ */
+enum class TetherPolicy {
+    FullFile,     // 下载新拍摄的完整文件（RAW和JPEG都下载）
+    JpegOnly,     // 只下载JPEG，RAW仅上报不传输
+    PreviewOnly   // 只下载内嵌预览图（数据量最小）
+};
+
+/**
+ * @brief 联机会话事件（由后台线程产生，回调给NAPI层）
+ */
+struct TetherEvent {
+    std::string type;       // fileAdded / downloaded / skipped / error / stopped
+    std::string folder;     // 相机内目录
+    std::string fileName;   // 文件名
+    std::string localPath;  // 本地保存路径（downloaded时有效）
+    std::string error;      // 错误信息（error时有效）
+    long long latencyMs;    // 从收到新文件事件到落盘完成的耗时
+};
+
+/**
+ * @brief 联机拍摄会话
+ * @details 后台线程循环调用gp_camera_wait_for_event监听GP_EVENT_FILE_ADDED（机身快门或App触发均可），
+ *          新文件立即进入高优先级下载队列，按策略下载后通过回调上报本地路径。
+ *          快门到手机的延迟约等于一次传输时间。
+ *          全局唯一：gp_camera_wait_for_event会取走事件，同一台相机只能有一个事件循环。
+ */
+class TetherSession {
+public:
+    using EventCallback = std::function<void(const TetherEvent&)>;
+
+    static TetherSession& getInstance();
+
+    TetherSession(const TetherSession&) = delete;
+    TetherSession& operator=(const TetherSession&) = delete;
+
+    /**
+     * @brief 启动联机会话
+     * @param destDir 本地保存目录
+     * @param policy 自动导入策略
+     * @param callback 事件回调（在后台线程调用）
+     * @return 是否启动成功
+     */
+    bool start(const std::string& destDir, TetherPolicy policy, EventCallback callback);
+
+    /**
+     * @brief 停止联机会话（等待后台线程退出）
+     */
+    void stop();
+
+    /**
+     * @brief 会话是否正在运行
+     */
+    bool isRunning() const { return running_; }
+
+    /**
+     * @brief 请求拍摄一张照片（不阻塞调用线程，由后台线程执行，新文件通过事件上报）
+     * @return 会话未运行时返回false
+     */
+    bool requestCapture();
+
+    /**
+     * @brief 解析策略字符串（"full" / "jpeg" / "preview"）
+     */
+    static TetherPolicy parsePolicy(const std::string& policy);
+
+private:
+    TetherSession();
+    ~TetherSession();
+
+    void eventLoop();
+    void doCapture();
+    void processNewFile(const CameraFilePath& path);
+    bool downloadPreview(const CameraFilePath& path, std::string& localPath, std::string& error);
+    void emit(const TetherEvent& event);
+    std::string makeLocalPath(const std::string& fileName) const;
+
+private:
+    Camera* camera_;                         // libgphoto2相机对象
+    GPContext* context_;                     // libgphoto2上下文对象
+    std::string destDir_;                    // 本地保存目录
+    TetherPolicy policy_;                    // 导入策略
+    EventCallback callback_;                 // 事件回调
+    PhotoDownloader downloader_;             // 会话专用下载器（与批量下载互不干扰）
+
+    std::thread thread_;                     // 事件循环线程
+    std::atomic<bool> running_;              // 是否运行中
+    std::atomic<bool> stopRequested_;        // 是否请求停止
+    std::atomic<bool> captureRequested_;     // 是否有待执行的拍摄请求
+    std::deque<CameraFilePath> pending_;     // 待下载的新文件（仅事件循环线程访问）
+
+    static constexpr int EVENT_POLL_MS = 50;    // 单次等待事件超时（毫秒，持有IO锁），决定stop的响应速度
+    static constexpr int EVENT_YIELD_MS = 10;   // 两次等待之间释放IO锁的时间（毫秒），让状态监视等其他操作插入
+    static constexpr int EVENT_RETRY_BASE_MS = 200;   // 等待事件失败后的首次重试间隔（毫秒）
+    static constexpr int EVENT_RETRY_MAX_MS = 3200;   // 等待事件连续失败时的最长重试间隔（毫秒）
+    static constexpr int MAX_EVENT_FAILURES = 8;      // 连续失败次数上限，超过后结束会话
+};
+
+#endif // TETHER_SESSION_H
@@ -9,6 +9,11 @@
 #include <hilog/log.h>
 #include <Camera/Common/Constants.h>
 #include "../../Common/native_common.h"
+#include "camera_capture.h"
+#include "TetherSession.h"
+
+#define LOG_DOMAIN ModuleLogs::CameraCapture.domain
+#define LOG_TAG ModuleLogs::CameraCapture.tag
 
 
 
@@ -30,6 +35,9 @@ static bool InternalCapture(char *outFolder, char *outFilename) {
     // CameraFilePath：libgphoto2结构体，存储相机中文件的路径（文件夹+文件名）
     CameraFilePath path;
 
+    // 与联机会话等后台线程互斥访问相机
+    std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+
     // 调用libgphoto2拍照函数：gp_camera_capture
     // 参数1：已连接的相机对象
     // 参数2：拍摄类型（GP_CAPTURE_IMAGE = 静态照片，还有视频、音频等类型）
@@ -90,3 +98,102 @@ napi_value TakePhoto(napi_env env, napi_callback_info info) {
     // 返回对象给ArkTS（ArkTS侧可通过result.folder获取路径）
     return result;
 }
+
+
+
+// ###########################################################################
+// 联机自动导入：后台线程产生事件，经线程安全函数回到ArkTS线程
+// ###########################################################################
+static napi_threadsafe_function g_tetherTsfn = nullptr;
+
+/**
+ * @brief 在ArkTS线程中把TetherEvent转换为JS对象并调用回调
+ */
+static void CallTetherCallbackJs(napi_env env, napi_value jsCallback, void* context, void* data) {
+    TetherEvent* event = static_cast<TetherEvent*>(data);
+    if (env != nullptr && jsCallback != nullptr) {
+        napi_value eventObj;
+        napi_create_object(env, &eventObj);
+        napi_set_named_property(env, eventObj, "type", CreateNapiString(env, event->type.c_str()));
+        napi_set_named_property(env, eventObj, "folder", CreateNapiString(env, event->folder.c_str()));
+        napi_set_named_property(env, eventObj, "filename", CreateNapiString(env, event->fileName.c_str()));
+        napi_set_named_property(env, eventObj, "localPath", CreateNapiString(env, event->localPath.c_str()));
+        napi_set_named_property(env, eventObj, "error", CreateNapiString(env, event->error.c_str()));
+        napi_value latency;
+        napi_create_int64(env, event->latencyMs, &latency);
+        napi_set_named_property(env, eventObj, "latencyMs", latency);
+
+        napi_value global;
+        napi_get_global(env, &global);
+        napi_call_function(env, global, jsCallback, 1, &eventObj, nullptr);
+    }
+    delete event;
+}
+
+void CleanupTetherSession() {
+    TetherSession::getInstance().stop();
+    if (g_tetherTsfn) {
+        napi_release_threadsafe_function(g_tetherTsfn, napi_tsfn_release);
+        g_tetherTsfn = nullptr;
+    }
+}
+
+napi_value StartTetherSession(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    napi_value result;
+    if (argc < 3) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "StartTetherSession 参数错误：需要destDir、policy、callback");
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+
+    char destDir[1024] = {0};
+    char policy[32] = {0};
+    napi_get_value_string_utf8(env, args[0], destDir, sizeof(destDir), nullptr);
+    napi_get_value_string_utf8(env, args[1], policy, sizeof(policy), nullptr);
+
+    // 重新启动时先停掉旧会话
+    CleanupTetherSession();
+
+    napi_value workName;
+    napi_create_string_utf8(env, "TetherSessionEvent", NAPI_AUTO_LENGTH, &workName);
+    napi_status status = napi_create_threadsafe_function(env, args[2], nullptr, workName, 0, 1, nullptr, nullptr,
+                                                         nullptr, CallTetherCallbackJs, &g_tetherTsfn);
+    if (status != napi_ok) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "创建线程安全回调失败: %{public}d", status);
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+
+    napi_threadsafe_function tsfn = g_tetherTsfn;
+    bool success = TetherSession::getInstance().start(
+        destDir, TetherSession::parsePolicy(policy), [tsfn](const TetherEvent& event) {
+            napi_call_threadsafe_function(tsfn, new TetherEvent(event), napi_tsfn_nonblocking);
+        });
+    if (!success) {
+        napi_release_threadsafe_function(g_tetherTsfn, napi_tsfn_release);
+        g_tetherTsfn = nullptr;
+    }
+
+    napi_get_boolean(env, success, &result);
+    return result;
+}
+
+napi_value StopTetherSession(napi_env env, napi_callback_info info) {
+    CleanupTetherSession();
+
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+napi_value TriggerCapture(napi_env env, napi_callback_info info) {
+    bool success = TetherSession::getInstance().requestCapture();
+
+    napi_value result;
+    napi_get_boolean(env, success, &result);
+    return result;
+}
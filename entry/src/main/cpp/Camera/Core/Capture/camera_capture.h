@@ -12,4 +12,27 @@
 
 extern  napi_value TakePhoto(napi_env env, napi_callback_info info);
 
+/**
+ * @brief 启动联机自动导入会话
+ * @param env NAPI环境
+ * @param info NAPI回调信息（3个参数：destDir、policy("full"/"jpeg"/"preview")、callback(event)）
+ * @return napi_value 是否启动成功
+ */
+extern napi_value StartTetherSession(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 停止联机自动导入会话
+ */
+extern napi_value StopTetherSession(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 非阻塞拍摄：由联机会话后台线程触发快门，新文件通过会话事件上报
+ */
+extern napi_value TriggerCapture(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 断开连接前停止联机会话并释放回调（由ConnectionManager调用）
+ */
+extern void CleanupTetherSession();
+
 #endif //PHOTOSEND_CAMERA_CAPTURE_H
@@ -5,7 +5,11 @@
 #include <pthread.h>
 #include <gphoto2/gphoto2.h>
 #include <Camera/Common/Constants.h>
+#include "Camera/Core/Config/SingleConfig.h"
+#include <mutex>
+#include <string>
 #include <unistd.h>
+#include <vector>
 
 // 日志配置
 #define LOG_DOMAIN ModuleLogs::CameraPreview.domain
@@ -15,6 +19,9 @@
 static pthread_mutex_t g_camera_mutex = PTHREAD_MUTEX_INITIALIZER;
 static bool g_liveview_active = false;
 
+// 各机身的实时预览开关配置项名
+static const std::vector<std::string> LIVEVIEW_CONFIG_NAMES = {"liveview", "live-view", "lv"};
+
 
 // 启动预览
 static bool startLiveview(Camera *camera, GPContext *ctx) {
@@ -23,32 +30,21 @@ static bool startLiveview(Camera *camera, GPContext *ctx) {
         return true;
     }
 
-    // 尝试通过配置项启用预览
-    CameraWidget *root = nullptr;
-    int ret = gp_camera_get_config(camera, &root, ctx);
-    if (ret == GP_OK) {
-        CameraWidget *liveview_widget = nullptr;
-        // 尝试匹配常见预览配置项
-        if (gp_widget_get_child_by_name(root, "liveview", &liveview_widget) == GP_OK ||
-            gp_widget_get_child_by_name(root, "live-view", &liveview_widget) == GP_OK ||
-            gp_widget_get_child_by_name(root, "lv", &liveview_widget) == GP_OK) {
-            int enable = 1;
-            gp_widget_set_value(liveview_widget, &enable);
-            gp_camera_set_config(camera, root, ctx);
-            // OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "已启用预览模式");
-        }
-        gp_widget_unref(root);
-    }
+    // 尝试通过配置项启用预览（单项写入，候选名按常见程度排列）
+    WriteFirstSingleConfig(LIVEVIEW_CONFIG_NAMES, "1");
 
     // 验证预览可用性
     CameraFile *test_file = nullptr;
-    ret = gp_file_new(&test_file);
+    int ret = gp_file_new(&test_file);
     if (ret != GP_OK) {
         OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "创建测试文件失败: %s", gp_result_as_string(ret));
         return false;
     }
 
-    ret = gp_camera_capture_preview(camera, test_file, ctx);
+    {
+        std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+        ret = gp_camera_capture_preview(camera, test_file, ctx);
+    }
     gp_file_unref(test_file);
     if (ret != GP_OK) {
         OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "预览启动失败: %s", gp_result_as_string(ret));
@@ -65,15 +61,7 @@ static void stopLiveview(Camera *camera, GPContext *ctx) {
     if (!g_liveview_active) return;
 
     // 尝试关闭预览配置
-    CameraWidget *root = nullptr;
-    if (gp_camera_get_config(camera, &root, ctx) == GP_OK) {
-        CameraWidget *liveview_widget = nullptr;
-        if (gp_widget_get_child_by_name(root, "liveview", &liveview_widget) == GP_OK) {
-            gp_widget_set_value(liveview_widget, 0);
-            gp_camera_set_config(camera, root, ctx);
-        }
-        gp_widget_unref(root);
-    }
+    WriteFirstSingleConfig(LIVEVIEW_CONFIG_NAMES, "0");
 
     g_liveview_active = false;
     // OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "预览已停止");
@@ -106,8 +94,11 @@ static bool GetCameraPreview(uint8_t **data, size_t *length) {
         return false;
     }
 
-    // 捕获预览帧
-    ret = gp_camera_capture_preview(g_camera, file, ctx);
+    // 捕获预览帧（g_camera_mutex只串行化预览接口本身，与其他模块共用相机仍需IO锁）
+    {
+        std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+        ret = gp_camera_capture_preview(g_camera, file, ctx);
+    }
     if (ret != GP_OK) {
         OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "捕获预览失败: %{public}s", gp_result_as_string(ret));
         gp_file_unref(file);
@@ -0,0 +1,107 @@
+// ConfigPrefetcher.cpp
+// Created on 2026/1/30.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "ConfigPrefetcher.h"
+#include "camera_config.h"
+#include "Camera/Common/Constants.h"
+#include "Camera/Common/native_common.h"
+#include <hilog/log.h>
+#include <chrono>
+#include <mutex>
+
+#define LOG_DOMAIN ModuleLogs::ConfigPrefetcher.domain
+#define LOG_TAG ModuleLogs::ConfigPrefetcher.tag
+
+// 相机忙时每隔多久再试一次IO锁
+static const int IDLE_POLL_MS = 50;
+// 最多让路多久，超过后排队等锁
+static const int MAX_YIELD_MS = 5000;
+
+ConfigPrefetcher& ConfigPrefetcher::getInstance() {
+    static ConfigPrefetcher instance;
+    return instance;
+}
+
+ConfigPrefetcher::~ConfigPrefetcher() {
+    stop();
+}
+
+void ConfigPrefetcher::start() {
+    stop();
+    if (!g_connected) {
+        return;
+    }
+    pushed_.clear();
+    stopRequested_ = false;
+    thread_ = std::thread(&ConfigPrefetcher::prefetch, this);
+}
+
+void ConfigPrefetcher::stop() {
+    stopRequested_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ConfigPrefetcher::pushOptions(const char* source) {
+    ParamOptions options = ExtractParamOptions(DEFAULT_PARAMS_TO_EXTRACT);
+    if (options.empty() || options == pushed_) {
+        return;
+    }
+    PushParamOptionsToArkTS(options);
+    pushed_.swap(options);
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "已推送默认参数可选值（%{public}s）", source);
+}
+
+void ConfigPrefetcher::prefetch() {
+    auto begin = std::chrono::steady_clock::now();
+
+    // 1. 有配置结构缓存时先推送缓存的可选值，不访问相机
+    if (GetConfigItems()) {
+        pushOptions("配置结构缓存");
+    }
+
+    // 2. 等相机空闲：拿不到IO锁说明有下载、取景等在进行，隔一会儿再试
+    std::unique_lock<std::recursive_mutex> lock(GetCameraIoMutex(), std::try_to_lock);
+    int waitedMs = 0;
+    while (!lock.owns_lock() && waitedMs < MAX_YIELD_MS) {
+        if (stopRequested_ || !g_connected) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_POLL_MS));
+        waitedMs += IDLE_POLL_MS;
+        lock.try_lock();
+    }
+    if (stopRequested_ || !g_connected) {
+        return;
+    }
+    if (!lock.owns_lock()) {
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "相机持续忙碌%{public}dms，排队读取配置", waitedMs);
+        lock.lock();
+    }
+
+    // 3. 读取实时配置树（进入快照缓存并发布），持锁期间其他相机操作排在预取之后
+    std::vector<ConfigItem> items;
+    bool loaded = GetAllConfigItems(items);
+    lock.unlock();
+    if (!loaded) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "预取配置失败");
+        return;
+    }
+    pushOptions("实时配置树");
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "配置预取完成：%{public}zu项，让路%{public}dms，总耗时%{public}lldms",
+                 items.size(), waitedMs, static_cast<long long>(elapsed.count()));
+}
+
+void StartConfigPrefetch() {
+    ConfigPrefetcher::getInstance().start();
+}
+
+void CleanupConfigPrefetch() {
+    ConfigPrefetcher::getInstance().stop();
+}
@@ -0,0 +1,72 @@
+// ConfigPrefetcher.h
+// Created on 2026/1/30.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef CONFIG_PREFETCHER_H
+#define CONFIG_PREFETCHER_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 连接后的配置预取
+ * @details 连接成功后在后台读取一次配置树，把DEFAULT_PARAMS_TO_EXTRACT的可选值推送给ArkTS，
+ *          第一次打开ISO、快门等对话框时不必再现场整树读取。
+ *          有配置结构缓存时先直接推送缓存的可选值（不访问相机），再读取实时配置树预热快照，
+ *          可选值有变化时再推送一次。
+ *          预取是低优先级的：只在相机空闲（拿得到IO锁）时才开始读取，下载、取实时取景等
+ *          正在进行时让路；等待超过上限后再排队等锁。
+ *          全局唯一：预取结果写进全局的配置快照和结构缓存，每次连接只需预取一次。
+ */
+class ConfigPrefetcher {
+public:
+    using ParamOptions = std::unordered_map<std::string, std::vector<std::string>>;
+
+    static ConfigPrefetcher& getInstance();
+
+    ConfigPrefetcher(const ConfigPrefetcher&) = delete;
+    ConfigPrefetcher& operator=(const ConfigPrefetcher&) = delete;
+
+    /**
+     * @brief 启动预取（上一次未结束时先停止）
+     */
+    void start();
+
+    /**
+     * @brief 停止预取（等待后台线程退出）
+     */
+    void stop();
+
+private:
+    ConfigPrefetcher() = default;
+    ~ConfigPrefetcher();
+
+    void prefetch();
+
+    /**
+     * @brief 推送默认参数的可选值（与上次推送相同时跳过）
+     */
+    void pushOptions(const char* source);
+
+private:
+    std::thread thread_;
+    std::atomic<bool> stopRequested_{false};
+    ParamOptions pushed_;     // 上次推送的可选值（只在后台线程访问）
+};
+
+/**
+ * @brief 连接成功后调用：启动配置预取
+ */
+void StartConfigPrefetch();
+
+/**
+ * @brief 断开连接时调用：停止配置预取
+ */
+void CleanupConfigPrefetch();
+
+#endif // CONFIG_PREFETCHER_H
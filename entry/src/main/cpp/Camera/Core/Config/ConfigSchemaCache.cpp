@@ -0,0 +1,348 @@
+// ConfigSchemaCache.cpp
+// Created on 2026/1/28.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "ConfigSchemaCache.h"
+#include "camera_config.h"
+#include "SingleConfig.h"
+#include "Camera/CameraDownloadKit/PhotoDownloader/AtomicFileWriter.h"
+#include "Camera/Common/Constants.h"
+#include <hilog/log.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#define LOG_DOMAIN ModuleLogs::ConfigSchemaCache.domain
+#define LOG_TAG ModuleLogs::ConfigSchemaCache.tag
+
+// 文件格式：魔数 + 版本 + 配置项数，随后逐项为
+// 名称、标签、类型（uint32长度+字节）、可选值数 + 各可选值、范围下限/上限/步长（float）
+static const char CONFIG_SCHEMA_MAGIC[4] = {'P', 'S', 'C', 'S'};
+static const uint32_t CONFIG_SCHEMA_VERSION = 1;
+// 单个文件的上限，超过视为损坏
+static const size_t MAX_SCHEMA_FILE_SIZE = 4 * 1024 * 1024;
+// 应用文件目录下的缓存子目录
+static const char* CONFIG_SCHEMA_SUBDIR = "config_schema";
+
+// 缓存保存目录（SetConfigSchemaDir设置，为空表示不启用缓存）
+static std::string g_schemaDir;
+static std::mutex g_schemaDirMutex;
+
+#pragma pack(push, 1)
+struct ConfigSchemaHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t itemCount;
+};
+#pragma pack(pop)
+
+namespace {
+
+bool IsRange(const ConfigItem& item) {
+    return item.type == "range";
+}
+
+/**
+ * @brief 比较两项的结构（不比较当前值；范围只对range类型有意义）
+ */
+bool SameSchema(const ConfigItem& a, const ConfigItem& b) {
+    if (a.name != b.name || a.label != b.label || a.type != b.type || a.choices != b.choices) {
+        return false;
+    }
+    if (IsRange(a)) {
+        return a.bottomFloat == b.bottomFloat && a.topFloat == b.topFloat && a.stepFloat == b.stepFloat;
+    }
+    return true;
+}
+
+/**
+ * @brief 只保留结构字段的副本
+ */
+ConfigItem SchemaOf(const ConfigItem& item) {
+    ConfigItem schema;
+    schema.name = item.name;
+    schema.label = item.label;
+    schema.type = item.type;
+    schema.choices = item.choices;
+    schema.floatValue = 0.0f;
+    schema.bottomFloat = IsRange(item) ? item.bottomFloat : 0.0f;
+    schema.topFloat = IsRange(item) ? item.topFloat : 0.0f;
+    schema.stepFloat = IsRange(item) ? item.stepFloat : 0.0f;
+    schema.intValue = 0;
+    return schema;
+}
+
+void PutU32(std::string& out, uint32_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void PutFloat(std::string& out, float value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void PutString(std::string& out, const std::string& value) {
+    PutU32(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+/**
+ * @brief 顺序读取缓冲区，越界时置失败标志
+ */
+struct Reader {
+    const char* pos;
+    const char* end;
+    bool ok = true;
+
+    bool take(void* dst, size_t size) {
+        if (!ok || static_cast<size_t>(end - pos) < size) {
+            ok = false;
+            return false;
+        }
+        memcpy(dst, pos, size);
+        pos += size;
+        return true;
+    }
+
+    uint32_t u32() {
+        uint32_t value = 0;
+        take(&value, sizeof(value));
+        return value;
+    }
+
+    float f32() {
+        float value = 0.0f;
+        take(&value, sizeof(value));
+        return value;
+    }
+
+    std::string str() {
+        uint32_t size = u32();
+        if (!ok || static_cast<size_t>(end - pos) < size) {
+            ok = false;
+            return "";
+        }
+        std::string value(pos, size);
+        pos += size;
+        return value;
+    }
+};
+
+std::string SanitizeFileName(const std::string& text) {
+    std::string safe;
+    for (char c : text) {
+        bool alnum = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        safe.push_back(alnum ? c : '_');
+    }
+    return safe.empty() ? "unknown" : safe;
+}
+
+/**
+ * @brief 读取固件版本（ptp2的deviceversion状态项）
+ * @details 只读这一个配置项，不取整份相机摘要（摘要要查询全部设备属性和存储信息）
+ */
+std::string QueryFirmwareVersion() {
+    std::string firmware;
+    int ret = ReadSingleConfig("deviceversion", firmware);
+    if (ret != GP_OK) {
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "读取固件版本失败：%{public}s", gp_result_as_string(ret));
+        return "";
+    }
+    return firmware;
+}
+
+} // namespace
+
+ConfigSchemaCache& ConfigSchemaCache::getInstance() {
+    static ConfigSchemaCache instance;
+    return instance;
+}
+
+bool ConfigSchemaCache::open(const std::string& dir, const std::string& model, const std::string& firmware) {
+    std::string path = dir;
+    if (!path.empty() && path.back() != '/') {
+        path.push_back('/');
+    }
+    path += "config_schema_" + SanitizeFileName(model) + "_" + SanitizeFileName(firmware) + ".bin";
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    filePath_ = path;
+    items_.clear();
+    revalidated_ = false;
+    loaded_ = loadLocked();
+    if (loaded_) {
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "配置结构缓存加载完成：%{public}zu项，%{public}s",
+                     items_.size(), filePath_.c_str());
+    } else {
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "没有可用的配置结构缓存，等待实时配置树：%{public}s",
+                     filePath_.c_str());
+    }
+    return loaded_;
+}
+
+void ConfigSchemaCache::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    filePath_.clear();
+    items_.clear();
+    loaded_ = false;
+    revalidated_ = false;
+}
+
+bool ConfigSchemaCache::needsRevalidation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !filePath_.empty() && !revalidated_;
+}
+
+std::vector<ConfigItem> ConfigSchemaCache::items() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return loaded_ ? items_ : std::vector<ConfigItem>();
+}
+
+bool ConfigSchemaCache::update(const std::vector<ConfigItem>& items) {
+    if (items.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (filePath_.empty()) {
+        return false;
+    }
+    revalidated_ = true;
+
+    bool changed = !loaded_ || items.size() != items_.size();
+    for (size_t i = 0; !changed && i < items.size(); i++) {
+        changed = !SameSchema(items[i], items_[i]);
+    }
+    if (!changed) {
+        return false;
+    }
+
+    items_.clear();
+    items_.reserve(items.size());
+    for (const auto& item : items) {
+        items_.push_back(SchemaOf(item));
+    }
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "配置结构%{public}s，共%{public}zu项，写回缓存",
+                 loaded_ ? "有变化" : "首次获取", items_.size());
+    loaded_ = true;
+    saveLocked();
+    return true;
+}
+
+bool ConfigSchemaCache::loadLocked() {
+    std::ifstream inFile(filePath_, std::ios::binary);
+    if (!inFile.is_open()) {
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(ConfigSchemaHeader) || data.size() > MAX_SCHEMA_FILE_SIZE) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "配置结构缓存大小异常，将重建: %{public}s",
+                     filePath_.c_str());
+        return false;
+    }
+
+    ConfigSchemaHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, CONFIG_SCHEMA_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != CONFIG_SCHEMA_VERSION) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "配置结构缓存格式不匹配，将重建: %{public}s",
+                     filePath_.c_str());
+        return false;
+    }
+
+    Reader reader{data.data() + sizeof(header), data.data() + data.size()};
+    std::vector<ConfigItem> items;
+    for (uint32_t i = 0; i < header.itemCount && reader.ok; i++) {
+        ConfigItem item{};
+        item.name = reader.str();
+        item.label = reader.str();
+        item.type = reader.str();
+        uint32_t choiceCount = reader.u32();
+        for (uint32_t c = 0; c < choiceCount && reader.ok; c++) {
+            item.choices.push_back(reader.str());
+        }
+        item.bottomFloat = reader.f32();
+        item.topFloat = reader.f32();
+        item.stepFloat = reader.f32();
+        items.push_back(std::move(item));
+    }
+    if (!reader.ok || items.empty()) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "配置结构缓存不完整，将重建: %{public}s",
+                     filePath_.c_str());
+        return false;
+    }
+
+    items_.swap(items);
+    return true;
+}
+
+bool ConfigSchemaCache::saveLocked() {
+    ConfigSchemaHeader header;
+    memcpy(header.magic, CONFIG_SCHEMA_MAGIC, sizeof(header.magic));
+    header.version = CONFIG_SCHEMA_VERSION;
+    header.itemCount = static_cast<uint32_t>(items_.size());
+
+    std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& item : items_) {
+        PutString(data, item.name);
+        PutString(data, item.label);
+        PutString(data, item.type);
+        PutU32(data, static_cast<uint32_t>(item.choices.size()));
+        for (const auto& choice : item.choices) {
+            PutString(data, choice);
+        }
+        PutFloat(data, item.bottomFloat);
+        PutFloat(data, item.topFloat);
+        PutFloat(data, item.stepFloat);
+    }
+
+    AtomicFileWriter writer;
+    if (!writer.Open(filePath_, data.size(), false) || !writer.Write(data.data(), data.size()) || !writer.Commit()) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "写入配置结构缓存失败: %{public}s",
+                     writer.GetLastError().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool SetConfigSchemaDir(const std::string& dir) {
+    std::string path = dir;
+    if (!path.empty() && path.back() != '/') {
+        path.push_back('/');
+    }
+    path += CONFIG_SCHEMA_SUBDIR;
+    if (mkdir(path.c_str(), 0700) != 0 && errno != EEXIST) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "创建配置结构缓存目录失败：%{public}s，%{public}s",
+                     path.c_str(), strerror(errno));
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_schemaDirMutex);
+    g_schemaDir = path;
+    return true;
+}
+
+void OpenConfigSchema(const std::string& model) {
+    std::string dir;
+    {
+        std::lock_guard<std::mutex> lock(g_schemaDirMutex);
+        dir = g_schemaDir;
+    }
+    if (dir.empty()) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "未设置保存目录，不使用配置结构缓存");
+        return;
+    }
+    std::string firmware = QueryFirmwareVersion();
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "型号%{public}s，固件%{public}s", model.c_str(),
+                 firmware.empty() ? "未知" : firmware.c_str());
+    ConfigSchemaCache& schema = ConfigSchemaCache::getInstance();
+    if (schema.open(dir, model, firmware)) {
+        PublishConfigItems(schema.items());
+    }
+}
+
+void CloseConfigSchema() {
+    ConfigSchemaCache::getInstance().close();
+}
@@ -0,0 +1,93 @@
+// ConfigSchemaCache.h
+// Created on 2026/1/28.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef CONFIG_SCHEMA_CACHE_H
+#define CONFIG_SCHEMA_CACHE_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Camera/Common/native_common.h"
+
+/**
+ * @brief 按型号+固件持久化的配置结构缓存
+ * @details 配置项的名称、标签、类型、可选值和数值范围对同一型号同一固件基本不变，
+ *          而整树读取在尼康等机身上要一两秒。连接时先从文件加载上次保存的结构，
+ *          参数面板和对话框立即可用；之后第一次拿到实时配置树时（状态监视的首次刷新
+ *          或GetCameraConfig）与缓存比较，不一致时以实时结构为准并写回文件。
+ *          缓存只保存结构，不保存当前值（当前值仍以实时读取为准）。
+ *          文件保存在SetConfigSchemaDir设置的目录（应用文件目录下的子目录），使用单例模式。
+ */
+class ConfigSchemaCache {
+public:
+    static ConfigSchemaCache& getInstance();
+
+    ConfigSchemaCache(const ConfigSchemaCache&) = delete;
+    ConfigSchemaCache& operator=(const ConfigSchemaCache&) = delete;
+
+    /**
+     * @brief 打开指定型号+固件的缓存文件（不存在时为空，等待第一次实时结构）
+     * @param dir 保存目录
+     * @return 是否从文件加载到了结构
+     */
+    bool open(const std::string& dir, const std::string& model, const std::string& firmware);
+
+    /**
+     * @brief 关闭缓存（断开连接时调用）
+     */
+    void close();
+
+    /**
+     * @brief 本次连接是否还没有用实时结构校验过
+     */
+    bool needsRevalidation() const;
+
+    /**
+     * @brief 取缓存的配置结构（未加载时为空）
+     */
+    std::vector<ConfigItem> items() const;
+
+    /**
+     * @brief 用实时配置树的结构校验缓存，结构有变化时替换并写回文件
+     * @param items 实时遍历得到的配置项（当前值不参与比较）
+     * @return 结构是否有变化
+     */
+    bool update(const std::vector<ConfigItem>& items);
+
+private:
+    ConfigSchemaCache() = default;
+
+    bool loadLocked();
+    bool saveLocked();
+
+private:
+    std::string filePath_;               // 缓存文件路径（为空表示未打开）
+    std::vector<ConfigItem> items_;      // 配置结构（current为空）
+    bool loaded_ = false;                // items_是否可用
+    bool revalidated_ = false;           // 本次连接是否已用实时结构校验
+    mutable std::mutex mutex_;           // 保护以上成员
+};
+
+/**
+ * @brief 设置配置结构缓存的保存目录，在其下创建config_schema子目录
+ * @param dir 应用文件目录（如context.filesDir）
+ * @return 子目录是否可用
+ */
+bool SetConfigSchemaDir(const std::string& dir);
+
+/**
+ * @brief 连接成功后调用：读取固件版本，加载该型号+固件的配置结构缓存并发布为当前配置项
+ * @details 保存目录使用SetConfigSchemaDir设置的目录，未设置时不启用缓存
+ */
+void OpenConfigSchema(const std::string& model);
+
+/**
+ * @brief 断开连接时调用
+ */
+void CloseConfigSchema();
+
+#endif // CONFIG_SCHEMA_CACHE_H
@@ -0,0 +1,171 @@
+// ConfigSnapshot.cpp
+// Created on 2026/1/23.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "ConfigSnapshot.h"
+#include "Camera/Common/Constants.h"
+#include "Camera/Common/native_common.h"
+#include <hilog/log.h>
+#include <vector>
+
+#define LOG_DOMAIN ModuleLogs::ConfigSnapshot.domain
+#define LOG_TAG ModuleLogs::ConfigSnapshot.tag
+
+namespace {
+// 最长有效期：没有事件作废时，超过该时间重新取配置树
+constexpr int SNAPSHOT_MAX_AGE_MS = 1000;
+} // namespace
+
+// ======================== ConfigSnapshot ========================
+
+ConfigSnapshot::ConfigSnapshot(Camera* camera, CameraWidget* root)
+    : camera_(camera), root_(root), fetchTime_(std::chrono::steady_clock::now()) {
+    buildIndex();
+}
+
+ConfigSnapshot::~ConfigSnapshot() {
+    if (root_) {
+        gp_widget_free(root_);
+        root_ = nullptr;
+    }
+}
+
+void ConfigSnapshot::buildIndex() {
+    if (!root_) {
+        return;
+    }
+    // 显式栈做先序遍历，子节点逆序入栈，保证同名节点先遇到的优先
+    std::vector<CameraWidget*> stack;
+    stack.push_back(root_);
+    while (!stack.empty()) {
+        CameraWidget* widget = stack.back();
+        stack.pop_back();
+
+        const char* name = nullptr;
+        if (gp_widget_get_name(widget, &name) == GP_OK && name && name[0] != '\0') {
+            index_.emplace(name, widget);
+        }
+
+        int childCount = gp_widget_count_children(widget);
+        for (int i = childCount - 1; i >= 0; --i) {
+            CameraWidget* child = nullptr;
+            if (gp_widget_get_child(widget, i, &child) == GP_OK && child) {
+                stack.push_back(child);
+            }
+        }
+    }
+}
+
+CameraWidget* ConfigSnapshot::find(const std::string& name) const {
+    auto it = index_.find(name);
+    return it == index_.end() ? nullptr : it->second;
+}
+
+// ======================== ConfigSnapshotCache ========================
+
+ConfigSnapshotCache& ConfigSnapshotCache::getInstance() {
+    static ConfigSnapshotCache instance;
+    return instance;
+}
+
+std::shared_ptr<ConfigSnapshot> ConfigSnapshotCache::acquire(int* error) {
+    if (error) {
+        *error = GP_OK;
+    }
+    Camera* camera = g_camera;
+    GPContext* context = g_context;
+    if (!g_connected || !camera || !context) {
+        if (error) {
+            *error = GP_ERROR_IO;
+        }
+        return nullptr;
+    }
+
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (snapshot_ && snapshot_->getCamera() == camera) {
+            auto age = std::chrono::steady_clock::now() - snapshot_->getFetchTime();
+            if (age < std::chrono::milliseconds(SNAPSHOT_MAX_AGE_MS)) {
+                return snapshot_;
+            }
+        }
+        generation = generation_;
+    }
+
+    // 取配置树不持缓存锁：持有相机I/O锁的调用方也可能来取快照，避免锁序反转
+    CameraWidget* root = nullptr;
+    int ret;
+    {
+        std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
+        ret = gp_camera_get_config(camera, &root, context);
+    }
+    if (ret != GP_OK || !root) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "获取配置树失败：%{public}s", gp_result_as_string(ret));
+        if (error) {
+            *error = ret != GP_OK ? ret : GP_ERROR;
+        }
+        return nullptr;
+    }
+
+    auto snapshot = std::make_shared<ConfigSnapshot>(camera, root);
+    OH_LOG_Print(LOG_APP, LOG_DEBUG, LOG_DOMAIN, LOG_TAG, "配置树快照已更新，共%{public}zu个节点", snapshot->size());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 取树期间被作废（刚设置过参数）时不缓存，本次调用方仍可使用
+    if (generation == generation_) {
+        snapshot_ = snapshot;
+    }
+    return snapshot;
+}
+
+std::shared_ptr<ConfigSnapshot> ConfigSnapshotCache::peek() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (snapshot_ && snapshot_->getCamera() == g_camera) {
+        return snapshot_;
+    }
+    // 刚写过参数时缓存已作废，可选值一般不变，退回上一份快照
+    if (stale_ && stale_->getCamera() == g_camera) {
+        return stale_;
+    }
+    return nullptr;
+}
+
+void ConfigSnapshotCache::invalidate() {
+    std::shared_ptr<ConfigSnapshot> old;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_++;
+        if (snapshot_) {
+            old.swap(stale_);
+            stale_.swap(snapshot_);
+        }
+    }
+    // old在锁外析构：若没有其他持有者，在这里释放配置树
+}
+
+void ConfigSnapshotCache::clear() {
+    std::shared_ptr<ConfigSnapshot> old;
+    std::shared_ptr<ConfigSnapshot> oldStale;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_++;
+        old.swap(snapshot_);
+        oldStale.swap(stale_);
+    }
+}
+
+uint64_t ConfigSnapshotCache::getGeneration() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
+}
+
+void InvalidateConfigSnapshot() {
+    ConfigSnapshotCache::getInstance().invalidate();
+}
+
+void ClearConfigSnapshot() {
+    ConfigSnapshotCache::getInstance().clear();
+}
@@ -0,0 +1,115 @@
+// ConfigSnapshot.h
+// Created on 2026/1/23.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef CONFIG_SNAPSHOT_H
+#define CONFIG_SNAPSHOT_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <gphoto2/gphoto2.h>
+
+/**
+ * @brief 配置树快照
+ * @details 一次gp_camera_get_config得到的只读配置树，构造时遍历一遍建立"节点名→控件"哈希索引。
+ *          节点名包括文字名（"f-number"）和libgphoto2未识别属性的PTP属性码名（"5007"），
+ *          查找为O(1)。快照不可修改（设置参数请走SetConfig），析构时释放整棵树。
+ */
+class ConfigSnapshot {
+public:
+    ConfigSnapshot(Camera* camera, CameraWidget* root);
+    ~ConfigSnapshot();
+
+    ConfigSnapshot(const ConfigSnapshot&) = delete;
+    ConfigSnapshot& operator=(const ConfigSnapshot&) = delete;
+
+    /**
+     * @brief 按节点名查找控件
+     * @return 未找到返回nullptr（同名节点取深度优先遍历的第一个，与gp_widget_get_child_by_name一致）
+     */
+    CameraWidget* find(const std::string& name) const;
+
+    CameraWidget* getRoot() const { return root_; }
+    Camera* getCamera() const { return camera_; }
+    size_t size() const { return index_.size(); }
+    std::chrono::steady_clock::time_point getFetchTime() const { return fetchTime_; }
+
+private:
+    void buildIndex();
+
+private:
+    Camera* camera_;
+    CameraWidget* root_;
+    std::unordered_map<std::string, CameraWidget*> index_;
+    std::chrono::steady_clock::time_point fetchTime_;
+};
+
+/**
+ * @brief 配置树快照缓存
+ * @details 缓存最近一次取到的配置树，直到被设置参数、相机属性变化事件或断开连接作废。
+ *          机身不上报属性变化事件、也没有事件监听时，靠最长有效期兜底，避免拨盘改动长期看不到。
+ *          全局唯一：快照对应当前连接的那台相机，状态查询、参数校验和预取共用一份才能省掉重复取树。
+ */
+class ConfigSnapshotCache {
+public:
+    static ConfigSnapshotCache& getInstance();
+
+    ConfigSnapshotCache(const ConfigSnapshotCache&) = delete;
+    ConfigSnapshotCache& operator=(const ConfigSnapshotCache&) = delete;
+
+    /**
+     * @brief 取快照：缓存有效时直接返回，否则持相机I/O锁取一次配置树
+     * @param error 输出：失败时的libgphoto2错误码（可为nullptr）
+     * @return 相机未连接或取配置失败时返回nullptr
+     */
+    std::shared_ptr<ConfigSnapshot> acquire(int* error = nullptr);
+
+    /**
+     * @brief 取当前缓存的快照，不访问相机（不检查有效期，适合查可选值这类很少变化的信息）
+     * @return 没有缓存或相机已更换时返回nullptr
+     */
+    std::shared_ptr<ConfigSnapshot> peek();
+
+    /**
+     * @brief 作废缓存（正在使用的快照由持有者释放）
+     */
+    void invalidate();
+
+    /**
+     * @brief 清空缓存和上一份快照（断开连接时调用，避免新相机复用旧指针地址时误用旧可选值）
+     */
+    void clear();
+
+    /**
+     * @brief 作废计数（每次作废/清空加1），用于判断快照之后相机状态是否可能变化
+     */
+    uint64_t getGeneration();
+
+private:
+    ConfigSnapshotCache() = default;
+
+private:
+    std::shared_ptr<ConfigSnapshot> snapshot_;
+    std::shared_ptr<ConfigSnapshot> stale_;   // 最近一次被作废的快照，只供peek查可选值
+    uint64_t generation_ = 0;     // 每次作废加1，取树期间被作废的结果不进缓存
+    std::mutex mutex_;
+};
+
+/**
+ * @brief 作废配置树快照（设置参数、属性变化事件时调用）
+ */
+void InvalidateConfigSnapshot();
+
+/**
+ * @brief 清空配置树快照（断开连接时调用）
+ */
+void ClearConfigSnapshot();
+
+#endif // CONFIG_SNAPSHOT_H
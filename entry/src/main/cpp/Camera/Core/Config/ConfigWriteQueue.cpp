@@ -0,0 +1,195 @@
+// ConfigWriteQueue.cpp
+// Created on 2026/1/25.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "ConfigWriteQueue.h"
+#include "SingleConfig.h"
+#include "Camera/Common/Constants.h"
+#include "Camera/Common/native_common.h"
+#include <hilog/log.h>
+#include <vector>
+
+#define LOG_DOMAIN ModuleLogs::ConfigWriteQueue.domain
+#define LOG_TAG ModuleLogs::ConfigWriteQueue.tag
+
+ConfigWriteQueue& ConfigWriteQueue::getInstance() {
+    static ConfigWriteQueue instance;
+    return instance;
+}
+
+ConfigWriteQueue::~ConfigWriteQueue() {
+    stop();
+}
+
+void ConfigWriteQueue::setAckCallback(AckCallback callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    callback_ = std::move(callback);
+}
+
+void ConfigWriteQueue::start() {
+    std::lock_guard<std::mutex> lifecycle(lifecycleMutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    // stop已回收工作线程，下一次enqueue时重新创建
+    stopRequested_ = false;
+}
+
+bool ConfigWriteQueue::enqueue(const std::string& name, const std::string& value) {
+    if (!g_connected || name.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopRequested_) {
+        return false;
+    }
+    auto it = pending_.find(name);
+    if (it == pending_.end()) {
+        PendingWrite write;
+        write.value = value;
+        write.requestTime = std::chrono::steady_clock::now();
+        pending_.emplace(name, std::move(write));
+        order_.push_back(name);
+    } else {
+        // 还没写入的旧值直接作废
+        it->second.value = value;
+        it->second.coalesced++;
+        it->second.busyRetries = 0;
+        it->second.requestTime = std::chrono::steady_clock::now();
+    }
+
+    if (!running_) {
+        // 工作线程只在stopRequested_时退出，而stop会先回收它，这里的thread_必然不可join
+        running_ = true;
+        thread_ = std::thread(&ConfigWriteQueue::workerLoop, this);
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void ConfigWriteQueue::stop() {
+    std::lock_guard<std::mutex> lifecycle(lifecycleMutex_);
+    std::vector<ConfigWriteAck> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = true;
+        if (!pending_.empty()) {
+            OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "停止写入队列，丢弃%{public}zu个待写项", pending_.size());
+        }
+        auto now = std::chrono::steady_clock::now();
+        for (const auto& name : order_) {
+            const PendingWrite& write = pending_[name];
+            ConfigWriteAck ack;
+            ack.name = name;
+            ack.requested = write.value;
+            ack.applied = write.value;
+            ack.success = false;
+            ack.error = "相机已断开，写入取消";
+            ack.coalesced = write.coalesced;
+            ack.latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - write.requestTime).count();
+            dropped.push_back(std::move(ack));
+        }
+        pending_.clear();
+        order_.clear();
+    }
+    cv_.notify_all();
+    // 此后enqueue看到stopRequested_不会再碰thread_，可以在锁外回收
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    // ArkTS层据此把滑块恢复到实际值，而不是停留在没写进去的请求值上
+    for (const auto& ack : dropped) {
+        emit(ack);
+    }
+}
+
+void ConfigWriteQueue::workerLoop() {
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "参数写入线程启动");
+    bool backoff = false;
+    while (true) {
+        std::vector<ConfigWrite> writes;
+        std::vector<PendingWrite> taken;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (backoff) {
+                // 相机忙：退避期间仍接收新值，stop可提前唤醒
+                cv_.wait_for(lock, std::chrono::milliseconds(BUSY_BACKOFF_MS), [this] { return stopRequested_; });
+            }
+            cv_.wait(lock, [this] { return stopRequested_ || !order_.empty(); });
+            if (stopRequested_) {
+                break;
+            }
+            // 一轮取走所有待写项，写入期间新到的值进入下一轮
+            for (const auto& name : order_) {
+                auto it = pending_.find(name);
+                ConfigWrite write;
+                write.name = name;
+                write.value = it->second.value;
+                writes.push_back(std::move(write));
+                taken.push_back(std::move(it->second));
+            }
+            pending_.clear();
+            order_.clear();
+        }
+
+        WriteConfigBatch(writes);
+
+        backoff = false;
+        for (size_t i = 0; i < writes.size(); i++) {
+            const ConfigWrite& write = writes[i];
+            PendingWrite& request = taken[i];
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (pending_.count(write.name) > 0) {
+                    // 已有更新的值在排队，本次结果不再确认
+                    pending_[write.name].coalesced += request.coalesced + 1;
+                    continue;
+                }
+                if (write.result == GP_ERROR_CAMERA_BUSY && request.busyRetries < MAX_BUSY_RETRIES && !stopRequested_) {
+                    request.busyRetries++;
+                    pending_.emplace(write.name, request);
+                    order_.push_back(write.name);
+                    backoff = true;
+                    continue;
+                }
+            }
+
+            ConfigWriteAck ack;
+            ack.name = write.name;
+            ack.requested = write.value;
+            ack.applied = write.value;
+            ack.success = write.result == GP_OK;
+            ack.coalesced = request.coalesced;
+            if (ack.success) {
+                // 读回实际值：部分机身会把不在刻度上的值就近取整
+                std::string applied;
+                if (ReadSingleConfig(write.name, applied) == GP_OK) {
+                    ack.applied = applied;
+                }
+            } else {
+                ack.error = gp_result_as_string(write.result);
+            }
+            ack.latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now() - request.requestTime)
+                                .count();
+            OH_LOG_Print(LOG_APP, LOG_DEBUG, LOG_DOMAIN, LOG_TAG,
+                         "%{public}s写入%{public}s：请求%{public}s，实际%{public}s，合并%{public}d次，耗时%{public}lldms",
+                         ack.name.c_str(), ack.success ? "成功" : "失败", ack.requested.c_str(), ack.applied.c_str(),
+                         ack.coalesced, ack.latencyMs);
+            emit(ack);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "参数写入线程退出");
+}
+
+void ConfigWriteQueue::emit(const ConfigWriteAck& ack) {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    if (callback_) {
+        callback_(ack);
+    }
+}
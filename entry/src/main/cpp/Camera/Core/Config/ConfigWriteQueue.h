@@ -0,0 +1,106 @@
+// ConfigWriteQueue.h
+// Created on 2026/1/25.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef CONFIG_WRITE_QUEUE_H
+#define CONFIG_WRITE_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @brief 参数写入确认（由后台线程产生，回调给NAPI层）
+ */
+struct ConfigWriteAck {
+    std::string name;       // 配置项名
+    std::string requested;  // 最后一次请求的值
+    std::string applied;    // 写入后从相机读回的值（机身可能就近取值；读回失败时为请求值）
+    bool success;           // 是否写入成功
+    std::string error;      // 错误信息（失败时有效）
+    int coalesced;          // 本次写入合并掉的中间值个数
+    long long latencyMs;    // 从最后一次请求到写入完成的耗时
+};
+
+/**
+ * @brief 参数写入队列（按配置项只保留最新值）
+ * @details 滑块拖动时每一档都会请求写入，逐个同步写入既阻塞UI线程又会积压过时的中间值。
+ *          入队不访问相机：同一配置项未写入的旧值直接被新值替换；后台线程每轮取走所有待写项，
+ *          按单项接口/整树合并的方式写入（见WriteConfigBatch），写完一轮才取下一轮，
+ *          写入速率自然跟随相机的处理能力。相机返回忙时短暂退避后重试。
+ *          某配置项写完且没有更新的值在排队时，读回实际值并回调确认。
+ *          全局唯一：同一配置项的新旧值只有进同一个队列才能合并，各项的写入顺序也才确定。
+ */
+class ConfigWriteQueue {
+public:
+    using AckCallback = std::function<void(const ConfigWriteAck&)>;
+
+    static ConfigWriteQueue& getInstance();
+
+    ConfigWriteQueue(const ConfigWriteQueue&) = delete;
+    ConfigWriteQueue& operator=(const ConfigWriteQueue&) = delete;
+
+    /**
+     * @brief 设置确认回调（在后台线程调用，传nullptr取消）
+     */
+    void setAckCallback(AckCallback callback);
+
+    /**
+     * @brief 重新接受写入（连接成功后调用，撤销上一次stop）
+     */
+    void start();
+
+    /**
+     * @brief 请求写入（不阻塞），同一配置项未写入的旧值被替换；首次调用时启动后台线程
+     * @return 相机未连接或队列已停止时返回false
+     */
+    bool enqueue(const std::string& name, const std::string& value);
+
+    /**
+     * @brief 停止后台线程，未写入的值以失败回调确认后丢弃（断开连接时调用）
+     * @details 停止后enqueue一律失败，直到start()，避免对正在断开的相机重新启动写入线程
+     */
+    void stop();
+
+private:
+    ConfigWriteQueue() = default;
+    ~ConfigWriteQueue();
+
+    /**
+     * @brief 待写入的值
+     */
+    struct PendingWrite {
+        std::string value;
+        int coalesced = 0;   // 被替换掉的旧值个数
+        int busyRetries = 0; // 相机忙的重试次数
+        std::chrono::steady_clock::time_point requestTime;
+    };
+
+    void workerLoop();
+    void emit(const ConfigWriteAck& ack);
+
+private:
+    std::unordered_map<std::string, PendingWrite> pending_;   // 配置项名 -> 最新待写值
+    std::deque<std::string> order_;                           // 首次入队顺序（替换不改变顺序）
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;          // 只在mutex_内且未停止时创建，只在stop中回收
+    std::mutex lifecycleMutex_;   // 串行化start/stop（析构与断开连接可能同时调用stop）
+    bool running_ = false;
+    bool stopRequested_ = false;  // 已停止：工作线程退出，enqueue失败
+
+    AckCallback callback_;
+    std::mutex callbackMutex_;
+
+    static constexpr int BUSY_BACKOFF_MS = 50;   // 相机忙时的退避时间（毫秒）
+    static constexpr int MAX_BUSY_RETRIES = 5;   // 相机忙的最大重试次数
+};
+
+#endif // CONFIG_WRITE_QUEUE_H
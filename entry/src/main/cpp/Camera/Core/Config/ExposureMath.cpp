@@ -0,0 +1,470 @@
+// ExposureMath.cpp
+// Created on 2026/1/29.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "ExposureMath.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+/**
+ * @brief 标准档位表项：精确值num/den和标签
+ */
+struct StopEntry {
+    int32_t num;
+    int32_t den;
+    const char* label;
+
+    constexpr double value() const { return static_cast<double>(num) / den; }
+};
+
+constexpr bool StopLess(const StopEntry& a, const StopEntry& b) {
+    return a.value() < b.value();
+}
+
+template <size_t N>
+constexpr bool IsStrictlySorted(const StopEntry (&table)[N]) {
+    for (size_t i = 1; i < N; i++) {
+        if (!StopLess(table[i - 1], table[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 快门标签与机身显示一致（1/4秒以下为分数，0.3秒起为小数或整数秒）。
+// 新增表项必须保持升序，否则下面的static_assert编译失败。
+constexpr StopEntry SHUTTER_THIRDS[] = {
+    {1, 8000, "1/8000"}, {1, 6400, "1/6400"}, {1, 5000, "1/5000"}, {1, 4000, "1/4000"}, {1, 3200, "1/3200"},
+    {1, 2500, "1/2500"}, {1, 2000, "1/2000"}, {1, 1600, "1/1600"}, {1, 1250, "1/1250"}, {1, 1000, "1/1000"},
+    {1, 800, "1/800"},   {1, 640, "1/640"},   {1, 500, "1/500"},   {1, 400, "1/400"},   {1, 320, "1/320"},
+    {1, 250, "1/250"},   {1, 200, "1/200"},   {1, 160, "1/160"},   {1, 125, "1/125"},   {1, 100, "1/100"},
+    {1, 80, "1/80"},     {1, 60, "1/60"},     {1, 50, "1/50"},     {1, 40, "1/40"},     {1, 30, "1/30"},
+    {1, 25, "1/25"},     {1, 20, "1/20"},     {1, 15, "1/15"},     {1, 13, "1/13"},     {1, 10, "1/10"},
+    {1, 8, "1/8"},       {1, 6, "1/6"},       {1, 5, "1/5"},       {1, 4, "1/4"},       {3, 10, "0.3"},
+    {2, 5, "0.4"},       {1, 2, "0.5"},       {3, 5, "0.6"},       {4, 5, "0.8"},       {1, 1, "1"},
+    {13, 10, "1.3"},     {8, 5, "1.6"},       {2, 1, "2"},         {5, 2, "2.5"},       {16, 5, "3.2"},
+    {4, 1, "4"},         {5, 1, "5"},         {6, 1, "6"},         {8, 1, "8"},         {10, 1, "10"},
+    {13, 1, "13"},       {15, 1, "15"},       {20, 1, "20"},       {25, 1, "25"},       {30, 1, "30"},
+};
+static_assert(IsStrictlySorted(SHUTTER_THIRDS), "SHUTTER_THIRDS必须严格升序");
+
+constexpr StopEntry SHUTTER_HALVES[] = {
+    {1, 8000, "1/8000"}, {1, 6000, "1/6000"}, {1, 4000, "1/4000"}, {1, 3000, "1/3000"}, {1, 2000, "1/2000"},
+    {1, 1500, "1/1500"}, {1, 1000, "1/1000"}, {1, 750, "1/750"},   {1, 500, "1/500"},   {1, 350, "1/350"},
+    {1, 250, "1/250"},   {1, 180, "1/180"},   {1, 125, "1/125"},   {1, 90, "1/90"},     {1, 60, "1/60"},
+    {1, 45, "1/45"},     {1, 30, "1/30"},     {1, 20, "1/20"},     {1, 15, "1/15"},     {1, 10, "1/10"},
+    {1, 8, "1/8"},       {1, 6, "1/6"},       {1, 4, "1/4"},       {3, 10, "0.3"},      {1, 2, "0.5"},
+    {7, 10, "0.7"},      {1, 1, "1"},         {3, 2, "1.5"},       {2, 1, "2"},         {3, 1, "3"},
+    {4, 1, "4"},         {6, 1, "6"},         {8, 1, "8"},         {12, 1, "12"},       {15, 1, "15"},
+    {20, 1, "20"},       {30, 1, "30"},
+};
+static_assert(IsStrictlySorted(SHUTTER_HALVES), "SHUTTER_HALVES必须严格升序");
+
+constexpr StopEntry APERTURE_THIRDS[] = {
+    {10, 10, "1"},   {11, 10, "1.1"}, {12, 10, "1.2"}, {14, 10, "1.4"}, {16, 10, "1.6"}, {18, 10, "1.8"},
+    {20, 10, "2"},   {22, 10, "2.2"}, {25, 10, "2.5"}, {28, 10, "2.8"}, {32, 10, "3.2"}, {35, 10, "3.5"},
+    {40, 10, "4"},   {45, 10, "4.5"}, {50, 10, "5"},   {56, 10, "5.6"}, {63, 10, "6.3"}, {71, 10, "7.1"},
+    {80, 10, "8"},   {90, 10, "9"},   {100, 10, "10"}, {110, 10, "11"}, {130, 10, "13"}, {140, 10, "14"},
+    {160, 10, "16"}, {180, 10, "18"}, {200, 10, "20"}, {220, 10, "22"}, {250, 10, "25"}, {290, 10, "29"},
+    {320, 10, "32"}, {360, 10, "36"}, {400, 10, "40"}, {450, 10, "45"}, {510, 10, "51"}, {570, 10, "57"},
+    {640, 10, "64"},
+};
+static_assert(IsStrictlySorted(APERTURE_THIRDS), "APERTURE_THIRDS必须严格升序");
+
+constexpr StopEntry APERTURE_HALVES[] = {
+    {10, 10, "1"},   {12, 10, "1.2"}, {14, 10, "1.4"}, {17, 10, "1.7"}, {20, 10, "2"},   {24, 10, "2.4"},
+    {28, 10, "2.8"}, {33, 10, "3.3"}, {40, 10, "4"},   {48, 10, "4.8"}, {56, 10, "5.6"}, {67, 10, "6.7"},
+    {80, 10, "8"},   {95, 10, "9.5"}, {110, 10, "11"}, {130, 10, "13"}, {160, 10, "16"}, {190, 10, "19"},
+    {220, 10, "22"}, {270, 10, "27"}, {320, 10, "32"}, {380, 10, "38"}, {450, 10, "45"}, {540, 10, "54"},
+    {640, 10, "64"},
+};
+static_assert(IsStrictlySorted(APERTURE_HALVES), "APERTURE_HALVES必须严格升序");
+
+// 十进制解析的位数上限：单个数的分子不超过约1e18、分母不超过1e9（int64范围内）。
+// 两个数相除、相加时乘积可能超出int64，由CheckedDivide/CheckedAdd检查
+constexpr int64_t MAX_INTEGER_PART = 1000000000LL;
+constexpr int64_t MAX_DENOMINATOR = 1000000000LL;
+// 曝光补偿对齐到1/6档的容差（以1/6档为单位，0.25即约0.04EV）
+constexpr double COMPENSATION_SNAP_TOLERANCE = 0.25;
+
+Rational Reduce(int64_t num, int64_t den) {
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    int64_t divisor = std::gcd(num, den);
+    if (divisor > 1) {
+        num /= divisor;
+        den /= divisor;
+    }
+    return Rational{num, den};
+}
+
+Rational Add(const Rational& a, const Rational& b) {
+    return Reduce(a.num * b.den + b.num * a.den, a.den * b.den);
+}
+
+Rational Multiply(const Rational& a, int64_t factor) {
+    return Reduce(a.num * factor, a.den);
+}
+
+/**
+ * @brief a/b，中间乘积溢出时返回false（如"999999999.999999999/0.000000001"）
+ */
+bool CheckedDivide(const Rational& a, const Rational& b, Rational& out) {
+    int64_t num = 0;
+    int64_t den = 0;
+    if (b.num == 0 || __builtin_mul_overflow(a.num, b.den, &num) || __builtin_mul_overflow(a.den, b.num, &den)) {
+        return false;
+    }
+    out = Reduce(num, den);
+    return true;
+}
+
+/**
+ * @brief a+b，中间结果溢出时返回false
+ */
+bool CheckedAdd(const Rational& a, const Rational& b, Rational& out) {
+    int64_t left = 0;
+    int64_t right = 0;
+    int64_t num = 0;
+    int64_t den = 0;
+    if (__builtin_mul_overflow(a.num, b.den, &left) || __builtin_mul_overflow(b.num, a.den, &right) ||
+        __builtin_add_overflow(left, right, &num) || __builtin_mul_overflow(a.den, b.den, &den)) {
+        return false;
+    }
+    out = Reduce(num, den);
+    return true;
+}
+
+void SkipSpaces(const char*& p) {
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+}
+
+bool IsDigit(char c) {
+    return isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+/**
+ * @brief 解析无符号十进制数（"2"、"2.8"、".5"）为精确分数
+ * @param separator 额外的小数点字符（快门"1\"3"中的'"'），为0时只认'.'
+ */
+bool ParseDecimal(const char*& p, Rational& out, char separator = 0) {
+    int64_t num = 0;
+    int64_t den = 1;
+    bool digits = false;
+    while (IsDigit(*p)) {
+        if (num >= MAX_INTEGER_PART) {
+            return false;
+        }
+        num = num * 10 + (*p++ - '0');
+        digits = true;
+    }
+    if ((*p == '.' || (separator != 0 && *p == separator)) && IsDigit(p[1])) {
+        p++;
+        while (IsDigit(*p)) {
+            // 超出精度的尾数直接忽略
+            if (den < MAX_DENOMINATOR) {
+                num = num * 10 + (*p - '0');
+                den *= 10;
+            }
+            p++;
+            digits = true;
+        }
+    } else if (*p == '.') {
+        p++;
+    }
+    if (!digits) {
+        return false;
+    }
+    out = Reduce(num, den);
+    return true;
+}
+
+/**
+ * @brief 跳过结尾的单位后缀，剩余部分必须为空
+ */
+bool MatchSuffix(const char* p, const char* const* suffixes, size_t count) {
+    SkipSpaces(p);
+    for (size_t i = 0; i < count; i++) {
+        size_t length = strlen(suffixes[i]);
+        if (strncmp(p, suffixes[i], length) == 0) {
+            p += length;
+            break;
+        }
+    }
+    SkipSpaces(p);
+    return *p == '\0';
+}
+
+template <size_t N>
+const StopEntry& NearestEntry(const StopEntry (&table)[N], double value) {
+    const StopEntry* end = table + N;
+    const StopEntry* it = std::lower_bound(table, end, value,
+                                           [](const StopEntry& entry, double v) { return entry.value() < v; });
+    if (it == table) {
+        return *it;
+    }
+    if (it == end) {
+        return table[N - 1];
+    }
+    // 按档数比较远近：以两档的几何中点为界
+    const StopEntry& low = *(it - 1);
+    return value * value < low.value() * it->value() ? low : *it;
+}
+
+const StopEntry& NearestTableStop(ExposureKind kind, StopStep step, double value) {
+    if (kind == ExposureKind::Shutter) {
+        return step == StopStep::Half ? NearestEntry(SHUTTER_HALVES, value) : NearestEntry(SHUTTER_THIRDS, value);
+    }
+    return step == StopStep::Half ? NearestEntry(APERTURE_HALVES, value) : NearestEntry(APERTURE_THIRDS, value);
+}
+
+bool CopyLabel(const char* text, char* label, size_t labelSize) {
+    if (!label || labelSize == 0 || strlen(text) >= labelSize) {
+        return false;
+    }
+    memcpy(label, text, strlen(text) + 1);
+    return true;
+}
+
+} // namespace
+
+bool ParseShutterSpeed(const char* text, Rational& seconds) {
+    if (!text) {
+        return false;
+    }
+    const char* p = text;
+    SkipSpaces(p);
+    Rational value;
+    if (!ParseDecimal(p, value, '"')) {
+        return false;
+    }
+    if (*p == '/') {
+        p++;
+        Rational divisor;
+        if (!ParseDecimal(p, divisor) || !CheckedDivide(value, divisor, value)) {
+            return false;
+        }
+    }
+    static const char* const SUFFIXES[] = {"sec", "s", "\""};
+    if (!MatchSuffix(p, SUFFIXES, sizeof(SUFFIXES) / sizeof(SUFFIXES[0])) || value.num <= 0) {
+        return false;
+    }
+    seconds = value;
+    return true;
+}
+
+bool ParseAperture(const char* text, Rational& fNumber) {
+    if (!text) {
+        return false;
+    }
+    const char* p = text;
+    SkipSpaces(p);
+    bool prefixed = false;
+    if (*p == 'f' || *p == 'F') {
+        prefixed = true;
+        p++;
+        if (*p == '/') {
+            p++;
+        }
+        SkipSpaces(p);
+    }
+    Rational value;
+    if (!ParseDecimal(p, value) || !MatchSuffix(p, nullptr, 0) || value.num <= 0) {
+        return false;
+    }
+    // 数字节点（5007）的取值是f值×100（如280→f/2.8）
+    if (!prefixed && value.den == 1 && value.num >= 100) {
+        value = Reduce(value.num, 100);
+    }
+    fNumber = value;
+    return true;
+}
+
+bool ParseCompensation(const char* text, Rational& ev) {
+    if (!text) {
+        return false;
+    }
+    const char* p = text;
+    SkipSpaces(p);
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+        negative = *p == '-';
+        p++;
+        SkipSpaces(p);
+    }
+    Rational value;
+    if (!ParseDecimal(p, value)) {
+        return false;
+    }
+    if (*p == '/') {
+        // 分数："1/3"
+        p++;
+        Rational divisor;
+        if (!ParseDecimal(p, divisor) || !CheckedDivide(value, divisor, value)) {
+            return false;
+        }
+    } else if (*p == ' ' && IsDigit(p[1]) && strchr(p, '/') != nullptr) {
+        // 带分数："1 1/3"
+        p++;
+        Rational part;
+        Rational divisor;
+        Rational fraction;
+        if (!ParseDecimal(p, part) || *p != '/' || !ParseDecimal(++p, divisor) ||
+            !CheckedDivide(part, divisor, fraction) || !CheckedAdd(value, fraction, value)) {
+            return false;
+        }
+    }
+    static const char* const SUFFIXES[] = {"EV", "ev"};
+    if (!MatchSuffix(p, SUFFIXES, sizeof(SUFFIXES) / sizeof(SUFFIXES[0]))) {
+        return false;
+    }
+
+    // 数字节点（5010）的取值是EV×1000（如-333→-0.333）
+    if (value.den == 1 && value.num > 100) {
+        value = Reduce(value.num, 1000);
+    }
+    // 近似小数（0.3、0.7、1.7、0.333）对齐为精确的1/3档或1/2档
+    double sixths = value.value() * 6.0;
+    double rounded = std::round(sixths);
+    if (std::fabs(sixths - rounded) <= COMPENSATION_SNAP_TOLERANCE) {
+        value = Reduce(static_cast<int64_t>(rounded), 6);
+    }
+    ev = negative ? Rational{-value.num, value.den} : value;
+    return true;
+}
+
+bool ParseExposure(ExposureKind kind, const char* text, Rational& value) {
+    switch (kind) {
+        case ExposureKind::Shutter:
+            return ParseShutterSpeed(text, value);
+        case ExposureKind::Aperture:
+            return ParseAperture(text, value);
+        case ExposureKind::Compensation:
+            return ParseCompensation(text, value);
+    }
+    return false;
+}
+
+double ExposureStops(ExposureKind kind, const Rational& value) {
+    switch (kind) {
+        case ExposureKind::Shutter:
+            return std::log2(value.value());
+        case ExposureKind::Aperture:
+            return 2.0 * std::log2(value.value());
+        case ExposureKind::Compensation:
+            return value.value();
+    }
+    return 0.0;
+}
+
+bool NearestStop(ExposureKind kind, const Rational& value, StopStep step, Rational& stop, char* label,
+                 size_t labelSize) {
+    if (kind == ExposureKind::Compensation) {
+        int64_t steps = static_cast<int64_t>(step);
+        stop = Reduce(static_cast<int64_t>(std::llround(value.value() * steps)), steps);
+        if (!label || labelSize == 0) {
+            return false;
+        }
+        // 与机身显示一致：0不带符号，其余带符号保留一位小数（+0.3、-1.7）
+        int written = stop.num == 0 ? snprintf(label, labelSize, "0")
+                                    : snprintf(label, labelSize, "%+.1f", stop.value());
+        return written > 0 && static_cast<size_t>(written) < labelSize;
+    }
+    if (value.num <= 0) {
+        return false;
+    }
+    const StopEntry& entry = NearestTableStop(kind, step, value.value());
+    stop = Reduce(entry.num, entry.den);
+    return CopyLabel(entry.label, label, labelSize);
+}
+
+double ExposureValue(const Rational& fNumber, const Rational& seconds, int iso) {
+    double n = fNumber.value();
+    double t = seconds.value();
+    if (n <= 0.0 || t <= 0.0 || iso <= 0) {
+        return 0.0;
+    }
+    return std::log2(n * n / t) - std::log2(iso / 100.0);
+}
+
+std::vector<EquivalentExposure> EquivalentExposures(const Rational& fNumber, const Rational& seconds,
+                                                    const std::vector<Rational>& apertures, StopStep step) {
+    std::vector<EquivalentExposure> result;
+    double n = fNumber.value();
+    double t = seconds.value();
+    if (n <= 0.0 || t <= 0.0) {
+        return result;
+    }
+
+    // 允许超出表两端不到1/6档的误差（标签是约数）
+    const double margin = std::exp2(1.0 / 6.0);
+    double shortest = NearestTableStop(ExposureKind::Shutter, step, 0.0).value();
+    double longest = NearestTableStop(ExposureKind::Shutter, step, HUGE_VAL).value();
+    result.reserve(apertures.size());
+    for (size_t i = 0; i < apertures.size(); i++) {
+        const Rational& aperture = apertures[i];
+        double ratio = aperture.value() / n;
+        double target = t * ratio * ratio;
+        if (aperture.num <= 0 || target < shortest / margin || target > longest * margin) {
+            continue;
+        }
+        const StopEntry& entry = NearestTableStop(ExposureKind::Shutter, step, target);
+        EquivalentExposure exposure;
+        exposure.apertureIndex = i;
+        exposure.fNumber = aperture;
+        exposure.seconds = Reduce(entry.num, entry.den);
+        CopyLabel(entry.label, exposure.shutterLabel, sizeof(exposure.shutterLabel));
+        result.push_back(exposure);
+    }
+    return result;
+}
+
+std::vector<Rational> BracketingSet(const Rational& center, int frames, const Rational& step) {
+    std::vector<Rational> result;
+    if (frames <= 0) {
+        return result;
+    }
+    frames = std::min(frames, MAX_BRACKETING_FRAMES);
+    result.reserve(frames);
+    result.push_back(center);
+    for (int level = 1; static_cast<int>(result.size()) < frames; level++) {
+        result.push_back(Add(center, Multiply(step, -level)));
+        if (static_cast<int>(result.size()) < frames) {
+            result.push_back(Add(center, Multiply(step, level)));
+        }
+    }
+    return result;
+}
+
+int NearestChoice(ExposureKind kind, const Rational& value, const std::vector<std::string>& choices) {
+    if (kind != ExposureKind::Compensation && value.num <= 0) {
+        return -1;
+    }
+    double target = ExposureStops(kind, value);
+    int best = -1;
+    double bestDistance = 0.0;
+    for (size_t i = 0; i < choices.size(); i++) {
+        Rational choice;
+        if (!ParseExposure(kind, choices[i].c_str(), choice)) {
+            continue;
+        }
+        double distance = std::fabs(ExposureStops(kind, choice) - target);
+        if (best < 0 || distance < bestDistance) {
+            best = static_cast<int>(i);
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,126 @@
+// ExposureMath.h
+// Created on 2026/1/29.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef EXPOSURE_MATH_H
+#define EXPOSURE_MATH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 曝光参数种类
+ */
+enum class ExposureKind : uint8_t {
+    Shutter = 0,    // 快门速度（秒）
+    Aperture,       // 光圈（f值）
+    Compensation    // 曝光补偿（EV）
+};
+
+/**
+ * @brief 档位间隔（每档几级）
+ */
+enum class StopStep : uint8_t {
+    Half = 2,   // 1/2档
+    Third = 3   // 1/3档
+};
+
+/**
+ * @brief 精确分数（den > 0，已约分）
+ */
+struct Rational {
+    int64_t num = 0;
+    int64_t den = 1;
+
+    double value() const { return static_cast<double>(num) / static_cast<double>(den); }
+};
+
+/**
+ * @brief 曝光计算
+ * @details 相机给出的快门、光圈、曝光补偿字符串格式因厂商和节点而异：
+ *          快门有"1/250"、"0.0040s"、"30\""、"1\"3"（1.3秒）、"2.5"；
+ *          光圈有"f/2.8"、"F2.8"、"2.8"以及数字节点的"280"（×100）；
+ *          曝光补偿有"0.333"、"-0.7"、"+1 1/3"、"1/3"以及数字节点的"-333"（×1000）。
+ *          解析结果是精确分数，全程不分配内存；曝光补偿的近似小数（0.3、0.7、1.7）按1/6档对齐
+ *          为精确的1/3档或1/2档。最近档位在编译期排好序的标准档位表中二分查找，按档数（对数）比较远近。
+ */
+
+/**
+ * @brief 解析快门速度（Bulb、Time、Auto等非数值返回false）
+ */
+bool ParseShutterSpeed(const char* text, Rational& seconds);
+
+/**
+ * @brief 解析光圈值
+ */
+bool ParseAperture(const char* text, Rational& fNumber);
+
+/**
+ * @brief 解析曝光补偿
+ */
+bool ParseCompensation(const char* text, Rational& ev);
+
+/**
+ * @brief 按种类解析
+ */
+bool ParseExposure(ExposureKind kind, const char* text, Rational& value);
+
+/**
+ * @brief 取值换算为档数：快门为log2(秒)，光圈为AV = 2*log2(N)，曝光补偿即其本身
+ */
+double ExposureStops(ExposureKind kind, const Rational& value);
+
+/**
+ * @brief 最近的标准档位
+ * @param stop 输出：档位的精确值
+ * @param label 输出：档位标签（快门"1/250"、光圈"5.6"、曝光补偿"+0.7"）
+ * @return 取值超出标准档位表时仍返回最近的端点档位；label缓冲区不足时返回false
+ */
+bool NearestStop(ExposureKind kind, const Rational& value, StopStep step, Rational& stop, char* label,
+                 size_t labelSize);
+
+/**
+ * @brief 曝光值（ISO 100下的EV）：EV = log2(N²/t) - log2(ISO/100)
+ */
+double ExposureValue(const Rational& fNumber, const Rational& seconds, int iso);
+
+/**
+ * @brief 等效曝光组合中的一项
+ */
+struct EquivalentExposure {
+    size_t apertureIndex;   // 在候选光圈中的下标
+    Rational fNumber;       // 光圈
+    Rational seconds;       // 对齐到标准档位后的快门
+    char shutterLabel[16];  // 快门档位标签
+};
+
+/**
+ * @brief 保持曝光量不变，为每个候选光圈计算对应的快门（对齐到标准档位）
+ * @param apertures 候选光圈（通常是相机的光圈可选值）
+ * @return 快门超出标准档位表的光圈不在结果中
+ */
+std::vector<EquivalentExposure> EquivalentExposures(const Rational& fNumber, const Rational& seconds,
+                                                    const std::vector<Rational>& apertures, StopStep step);
+
+// 包围曝光的最大张数（机身一般为2~9张，留有余量）
+constexpr int MAX_BRACKETING_FRAMES = 15;
+
+/**
+ * @brief 自动包围曝光的补偿序列，按相机的拍摄顺序：0、-1级、+1级、-2级、+2级……
+ * @param center 中心补偿值
+ * @param frames 张数（超过MAX_BRACKETING_FRAMES时按上限计）
+ * @param step 每级间隔（EV）
+ */
+std::vector<Rational> BracketingSet(const Rational& center, int frames, const Rational& step);
+
+/**
+ * @brief 在相机可选值中找与取值最接近（按档数）的一项
+ * @return 可选值下标，没有可解析的可选值时返回-1
+ */
+int NearestChoice(ExposureKind kind, const Rational& value, const std::vector<std::string>& choices);
+
+#endif // EXPOSURE_MATH_H
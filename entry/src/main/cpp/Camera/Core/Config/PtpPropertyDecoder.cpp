@@ -0,0 +1,427 @@
+// PtpPropertyDecoder.cpp
+// Created on 2026/1/27.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "PtpPropertyDecoder.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+/**
+ * @brief 原始值表项：（厂商，属性码，取值）→ 稳定取值
+ */
+struct RawEntry {
+    PtpVendor vendor;
+    uint16_t property;
+    uint32_t raw;
+    StatusValue value;
+};
+
+/**
+ * @brief 标签表项：（属性，libgphoto2英文标签）→ 稳定取值
+ */
+struct LabelEntry {
+    StatusProperty property;
+    std::string_view label;
+    StatusValue value;
+};
+
+constexpr bool RawLess(const RawEntry& a, const RawEntry& b) {
+    if (a.vendor != b.vendor) {
+        return a.vendor < b.vendor;
+    }
+    if (a.property != b.property) {
+        return a.property < b.property;
+    }
+    return a.raw < b.raw;
+}
+
+constexpr bool LabelLess(const LabelEntry& a, const LabelEntry& b) {
+    if (a.property != b.property) {
+        return a.property < b.property;
+    }
+    return a.label < b.label;
+}
+
+template <typename T, size_t N, typename Less>
+constexpr bool IsStrictlySorted(const T (&table)[N], Less less) {
+    for (size_t i = 1; i < N; i++) {
+        if (!less(table[i - 1], table[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 取值依据：PTP标准（ISO 15740）和各厂商扩展，与libgphoto2 ptp2驱动的取值含义一致。
+// 厂商表只放扩展取值和与标准含义不同的取值（如尼康拍摄模式0x0002是高速连拍）。
+// 新增表项必须保持排序，否则下面的static_assert编译失败。
+constexpr RawEntry RAW_TABLE[] = {
+    {PtpVendor::Generic, 0x5005, 0x0001, StatusValue::WbPreset},         // Manual
+    {PtpVendor::Generic, 0x5005, 0x0002, StatusValue::WbAuto},           // Automatic
+    {PtpVendor::Generic, 0x5005, 0x0003, StatusValue::WbPreset},         // One-push Automatic
+    {PtpVendor::Generic, 0x5005, 0x0004, StatusValue::WbDaylight},       // Daylight
+    {PtpVendor::Generic, 0x5005, 0x0005, StatusValue::WbFluorescent},    // Fluorescent
+    {PtpVendor::Generic, 0x5005, 0x0006, StatusValue::WbTungsten},       // Tungsten
+    {PtpVendor::Generic, 0x5005, 0x0007, StatusValue::WbFlash},          // Flash
+    {PtpVendor::Generic, 0x500A, 0x0001, StatusValue::FocusManual},      // Manual
+    {PtpVendor::Generic, 0x500A, 0x0002, StatusValue::FocusSingle},      // Automatic
+    {PtpVendor::Generic, 0x500A, 0x0003, StatusValue::FocusMacro},       // Automatic Macro
+    {PtpVendor::Generic, 0x500B, 0x0001, StatusValue::MeterAverage},     // Average
+    {PtpVendor::Generic, 0x500B, 0x0002, StatusValue::MeterCenterWeighted}, // Center Weighted
+    {PtpVendor::Generic, 0x500B, 0x0003, StatusValue::MeterMatrix},      // Multi Spot
+    {PtpVendor::Generic, 0x500B, 0x0004, StatusValue::MeterSpot},        // Center Spot
+    {PtpVendor::Generic, 0x500E, 0x0001, StatusValue::ProgramManual},    // Manual
+    {PtpVendor::Generic, 0x500E, 0x0002, StatusValue::ProgramAuto},      // Automatic
+    {PtpVendor::Generic, 0x500E, 0x0003, StatusValue::ProgramAperture},  // Aperture Priority
+    {PtpVendor::Generic, 0x500E, 0x0004, StatusValue::ProgramShutter},   // Shutter Priority
+    {PtpVendor::Generic, 0x500E, 0x0005, StatusValue::ProgramScene},     // Creative
+    {PtpVendor::Generic, 0x500E, 0x0006, StatusValue::ProgramScene},     // Action
+    {PtpVendor::Generic, 0x500E, 0x0007, StatusValue::ProgramScene},     // Portrait
+    {PtpVendor::Generic, 0x5013, 0x0001, StatusValue::DriveSingle},      // Single Shot
+    {PtpVendor::Generic, 0x5013, 0x0002, StatusValue::DriveContinuous},  // Burst
+    {PtpVendor::Generic, 0x5013, 0x0003, StatusValue::DriveTimelapse},   // Timelapse
+    {PtpVendor::Nikon, 0x5005, 0x8010, StatusValue::WbCloudy},           // Cloudy
+    {PtpVendor::Nikon, 0x5005, 0x8011, StatusValue::WbShade},            // Shade
+    {PtpVendor::Nikon, 0x5005, 0x8012, StatusValue::WbColorTemp},        // Color Temperature
+    {PtpVendor::Nikon, 0x5005, 0x8013, StatusValue::WbPreset},           // Preset
+    {PtpVendor::Nikon, 0x5005, 0x8016, StatusValue::WbNaturalAuto},      // Natural light auto
+    {PtpVendor::Nikon, 0x500A, 0x8010, StatusValue::FocusSingle},        // AF-S
+    {PtpVendor::Nikon, 0x500A, 0x8011, StatusValue::FocusContinuous},    // AF-C
+    {PtpVendor::Nikon, 0x500A, 0x8012, StatusValue::FocusAuto},          // AF-A
+    {PtpVendor::Nikon, 0x500A, 0x8013, StatusValue::FocusFullTime},      // AF-F
+    {PtpVendor::Nikon, 0x500B, 0x8010, StatusValue::MeterHighlight},     // Highlight-weighted
+    {PtpVendor::Nikon, 0x500E, 0x8010, StatusValue::ProgramFullAuto},    // Auto
+    {PtpVendor::Nikon, 0x500E, 0x8011, StatusValue::ProgramScene},       // Portrait
+    {PtpVendor::Nikon, 0x500E, 0x8012, StatusValue::ProgramScene},       // Landscape
+    {PtpVendor::Nikon, 0x500E, 0x8013, StatusValue::ProgramScene},       // Close-up
+    {PtpVendor::Nikon, 0x500E, 0x8014, StatusValue::ProgramScene},       // Sports
+    {PtpVendor::Nikon, 0x500E, 0x8015, StatusValue::ProgramScene},       // Night Portrait
+    {PtpVendor::Nikon, 0x500E, 0x8016, StatusValue::ProgramFullAuto},    // Flash Off
+    {PtpVendor::Nikon, 0x5013, 0x0002, StatusValue::DriveContinuousHigh}, // Continuous High Speed
+    {PtpVendor::Nikon, 0x5013, 0x8010, StatusValue::DriveContinuousLow}, // Continuous Low Speed
+    {PtpVendor::Nikon, 0x5013, 0x8011, StatusValue::DriveTimer},         // Timer
+    {PtpVendor::Nikon, 0x5013, 0x8012, StatusValue::DriveMirrorUp},      // Mirror Up
+    {PtpVendor::Nikon, 0x5013, 0x8013, StatusValue::DriveRemote},        // Remote
+    {PtpVendor::Nikon, 0x5013, 0x8014, StatusValue::DriveRemote},        // Quick Response Remote
+    {PtpVendor::Nikon, 0x5013, 0x8015, StatusValue::DriveRemote},        // Delayed Remote
+    {PtpVendor::Nikon, 0x5013, 0x8016, StatusValue::DriveQuiet},         // Quiet Release
+    {PtpVendor::Canon, 0xD105, 0x0000, StatusValue::ProgramAuto},        // P
+    {PtpVendor::Canon, 0xD105, 0x0001, StatusValue::ProgramShutter},     // Tv
+    {PtpVendor::Canon, 0xD105, 0x0002, StatusValue::ProgramAperture},    // Av
+    {PtpVendor::Canon, 0xD105, 0x0003, StatusValue::ProgramManual},      // M
+    {PtpVendor::Canon, 0xD105, 0x0004, StatusValue::ProgramBulb},        // Bulb
+    {PtpVendor::Canon, 0xD105, 0x0005, StatusValue::ProgramDepth},       // A-DEP
+    {PtpVendor::Canon, 0xD105, 0x0009, StatusValue::ProgramFullAuto},    // Green
+    {PtpVendor::Canon, 0xD105, 0x0016, StatusValue::ProgramFullAuto},    // Scene Intelligent Auto
+    {PtpVendor::Canon, 0xD106, 0x0000, StatusValue::DriveSingle},        // Single
+    {PtpVendor::Canon, 0xD106, 0x0001, StatusValue::DriveContinuous},    // Continuous
+    {PtpVendor::Canon, 0xD106, 0x0004, StatusValue::DriveContinuousLow}, // Continuous low speed
+    {PtpVendor::Canon, 0xD106, 0x0005, StatusValue::DriveQuiet},         // Single: Silent
+    {PtpVendor::Canon, 0xD106, 0x0007, StatusValue::DriveTimer},         // Timer 10 sec
+    {PtpVendor::Canon, 0xD106, 0x0010, StatusValue::DriveTimer},         // Timer 2 sec
+    {PtpVendor::Canon, 0xD106, 0x0011, StatusValue::DriveContinuousHigh}, // Super high speed continuous
+    {PtpVendor::Canon, 0xD106, 0x0012, StatusValue::DriveQuiet},         // Single silent
+    {PtpVendor::Canon, 0xD107, 0x0001, StatusValue::MeterSpot},          // Spot
+    {PtpVendor::Canon, 0xD107, 0x0003, StatusValue::MeterMatrix},        // Evaluative
+    {PtpVendor::Canon, 0xD107, 0x0004, StatusValue::MeterPartial},       // Partial
+    {PtpVendor::Canon, 0xD107, 0x0005, StatusValue::MeterCenterWeighted}, // Center-weighted average
+    {PtpVendor::Canon, 0xD108, 0x0000, StatusValue::FocusSingle},        // One Shot
+    {PtpVendor::Canon, 0xD108, 0x0001, StatusValue::FocusContinuous},    // AI Servo
+    {PtpVendor::Canon, 0xD108, 0x0002, StatusValue::FocusAuto},          // AI Focus
+    {PtpVendor::Canon, 0xD108, 0x0003, StatusValue::FocusManual},        // Manual
+    {PtpVendor::Canon, 0xD109, 0x0000, StatusValue::WbAuto},             // Auto
+    {PtpVendor::Canon, 0xD109, 0x0001, StatusValue::WbDaylight},         // Daylight
+    {PtpVendor::Canon, 0xD109, 0x0002, StatusValue::WbCloudy},           // Cloudy
+    {PtpVendor::Canon, 0xD109, 0x0003, StatusValue::WbTungsten},         // Tungsten
+    {PtpVendor::Canon, 0xD109, 0x0004, StatusValue::WbFluorescent},      // Fluorescent
+    {PtpVendor::Canon, 0xD109, 0x0005, StatusValue::WbFlash},            // Flash
+    {PtpVendor::Canon, 0xD109, 0x0006, StatusValue::WbPreset},           // Manual
+    {PtpVendor::Canon, 0xD109, 0x0008, StatusValue::WbShade},            // Shade
+    {PtpVendor::Canon, 0xD109, 0x0009, StatusValue::WbColorTemp},        // Color Temperature
+    {PtpVendor::Canon, 0xD109, 0x0017, StatusValue::WbAutoWhite},        // AWB White
+    {PtpVendor::Sony, 0x5005, 0x8001, StatusValue::WbFluorescent},       // Fluorescent: Warm White
+    {PtpVendor::Sony, 0x5005, 0x8002, StatusValue::WbFluorescent},       // Fluorescent: Cool White
+    {PtpVendor::Sony, 0x5005, 0x8003, StatusValue::WbFluorescent},       // Fluorescent: Day White
+    {PtpVendor::Sony, 0x5005, 0x8004, StatusValue::WbFluorescent},       // Fluorescent: Daylight
+    {PtpVendor::Sony, 0x5005, 0x8010, StatusValue::WbCloudy},            // Cloudy
+    {PtpVendor::Sony, 0x5005, 0x8011, StatusValue::WbShade},             // Shade
+    {PtpVendor::Sony, 0x5005, 0x8012, StatusValue::WbColorTemp},         // C-Temp/Filter
+    {PtpVendor::Sony, 0x5005, 0x8020, StatusValue::WbPreset},            // Custom
+    {PtpVendor::Sony, 0x5005, 0x8021, StatusValue::WbPreset},            // Custom 1
+    {PtpVendor::Sony, 0x5005, 0x8022, StatusValue::WbPreset},            // Custom 2
+    {PtpVendor::Sony, 0x5005, 0x8023, StatusValue::WbPreset},            // Custom 3
+    {PtpVendor::Sony, 0x5005, 0x8030, StatusValue::WbUnderwater},        // Underwater Auto
+    {PtpVendor::Sony, 0x500A, 0x8004, StatusValue::FocusContinuous},     // AF-C
+    {PtpVendor::Sony, 0x500A, 0x8005, StatusValue::FocusAuto},           // AF-A
+    {PtpVendor::Sony, 0x500A, 0x8006, StatusValue::FocusDmf},            // DMF
+    {PtpVendor::Sony, 0x500B, 0x8001, StatusValue::MeterMatrix},         // Multi
+    {PtpVendor::Sony, 0x500B, 0x8002, StatusValue::MeterCenterWeighted}, // Center
+    {PtpVendor::Sony, 0x500B, 0x8003, StatusValue::MeterAverage},        // Entire Screen Avg.
+    {PtpVendor::Sony, 0x500B, 0x8004, StatusValue::MeterSpot},           // Spot Standard
+    {PtpVendor::Sony, 0x500B, 0x8005, StatusValue::MeterSpot},           // Spot Large
+    {PtpVendor::Sony, 0x500B, 0x8006, StatusValue::MeterHighlight},      // Highlight
+    {PtpVendor::Sony, 0x500E, 0x8000, StatusValue::ProgramFullAuto},     // Intelligent Auto
+    {PtpVendor::Sony, 0x500E, 0x8001, StatusValue::ProgramFullAuto},     // Superior Auto
+    {PtpVendor::Sony, 0x5013, 0x8003, StatusValue::DriveTimer},          // Self-timer 5s
+    {PtpVendor::Sony, 0x5013, 0x8004, StatusValue::DriveTimer},          // Self-timer 10s
+    {PtpVendor::Sony, 0x5013, 0x8005, StatusValue::DriveTimer},          // Self-timer 2s
+    {PtpVendor::Sony, 0x5013, 0x8010, StatusValue::DriveContinuousHigh}, // Continuous Hi+
+    {PtpVendor::Sony, 0x5013, 0x8012, StatusValue::DriveContinuousLow},  // Continuous Lo
+    {PtpVendor::Fuji, 0x5005, 0x8001, StatusValue::WbFluorescent},       // Fluorescent Lamp 1
+    {PtpVendor::Fuji, 0x5005, 0x8002, StatusValue::WbFluorescent},       // Fluorescent Lamp 2
+    {PtpVendor::Fuji, 0x5005, 0x8003, StatusValue::WbFluorescent},       // Fluorescent Lamp 3
+    {PtpVendor::Fuji, 0x5005, 0x8006, StatusValue::WbShade},             // Shade
+    {PtpVendor::Fuji, 0x5005, 0x8007, StatusValue::WbPreset},            // Custom
+    {PtpVendor::Fuji, 0x5005, 0x800A, StatusValue::WbUnderwater},        // Underwater
+    {PtpVendor::Fuji, 0x500A, 0x8001, StatusValue::FocusSingle},         // Single Auto
+    {PtpVendor::Fuji, 0x500A, 0x8002, StatusValue::FocusContinuous},     // Continuous Auto
+    {PtpVendor::Fuji, 0x500B, 0x8001, StatusValue::MeterAverage},        // Average
+};
+static_assert(IsStrictlySorted(RAW_TABLE, RawLess), "RAW_TABLE必须按（厂商，属性码，取值）严格升序");
+
+// libgphoto2 ptp2驱动已识别取值时给出的英文标签（各厂商标签合在一起，同一属性内不冲突）
+constexpr LabelEntry LABEL_TABLE[] = {
+    {StatusProperty::FocusMode, "AF-A", StatusValue::FocusAuto},
+    {StatusProperty::FocusMode, "AF-C", StatusValue::FocusContinuous},
+    {StatusProperty::FocusMode, "AF-F", StatusValue::FocusFullTime},
+    {StatusProperty::FocusMode, "AF-S", StatusValue::FocusSingle},
+    {StatusProperty::FocusMode, "AI Focus", StatusValue::FocusAuto},
+    {StatusProperty::FocusMode, "AI Servo", StatusValue::FocusContinuous},
+    {StatusProperty::FocusMode, "Automatic", StatusValue::FocusSingle},
+    {StatusProperty::FocusMode, "Automatic Macro", StatusValue::FocusMacro},
+    {StatusProperty::FocusMode, "Continuous Auto", StatusValue::FocusContinuous},
+    {StatusProperty::FocusMode, "DMF", StatusValue::FocusDmf},
+    {StatusProperty::FocusMode, "MF", StatusValue::FocusManual},
+    {StatusProperty::FocusMode, "Manual", StatusValue::FocusManual},
+    {StatusProperty::FocusMode, "One Shot", StatusValue::FocusSingle},
+    {StatusProperty::FocusMode, "Single Auto", StatusValue::FocusSingle},
+    {StatusProperty::ExposureProgram, "A", StatusValue::ProgramAperture},
+    {StatusProperty::ExposureProgram, "AV", StatusValue::ProgramAperture},
+    {StatusProperty::ExposureProgram, "A_DEP", StatusValue::ProgramDepth},
+    {StatusProperty::ExposureProgram, "Action", StatusValue::ProgramScene},
+    {StatusProperty::ExposureProgram, "Aperture Priority", StatusValue::ProgramAperture},
+    {StatusProperty::ExposureProgram, "Auto", StatusValue::ProgramFullAuto},
+    {StatusProperty::ExposureProgram, "Bulb", StatusValue::ProgramBulb},
+    {StatusProperty::ExposureProgram, "Closeup", StatusValue::ProgramScene},
+    {StatusProperty::ExposureProgram, "Creative", StatusValue::ProgramScene},
+    {StatusProperty::ExposureProgram, "DEP", StatusValue::ProgramDepth},
+    {StatusProperty::ExposureProgram, "Flash Off", StatusValue::ProgramFullAuto},
+    {StatusProperty::ExposureProgram, "Green", StatusValue::ProgramFullAuto},
+    {StatusProperty::ExposureProgram, "Intelligent Auto", StatusValue::ProgramFullAuto},
+    {StatusProperty::ExposureProgram, "Landscape", StatusValue::ProgramScene},
+    {StatusProperty::ExposureProgram, "M", StatusValue::ProgramManual},
+    {StatusProperty::ExposureProgram, "Manual", StatusValue::ProgramManual},
+    {StatusProperty::ExposureProgram, "Night Portrait", StatusValue::ProgramScene},
+    {StatusProperty::ExposureProgram, "P", StatusValue::ProgramAuto},
+    {StatusProperty::ExposureProgram, "Portrait", StatusValue::ProgramScene},
+    {StatusProperty::ExposureProgram, "Program", StatusValue::ProgramAuto},
+    {StatusProperty::ExposureProgram, "S", StatusValue::ProgramShutter},
+    {StatusProperty::ExposureProgram, "Shutter Priority", StatusValue::ProgramShutter},
+    {StatusProperty::ExposureProgram, "Sports", StatusValue::ProgramScene},
+    {StatusProperty::ExposureProgram, "Superior Auto", StatusValue::ProgramFullAuto},
+    {StatusProperty::ExposureProgram, "TV", StatusValue::ProgramShutter},
+    {StatusProperty::MeteringMode, "Average", StatusValue::MeterAverage},
+    {StatusProperty::MeteringMode, "Center Spot", StatusValue::MeterSpot},
+    {StatusProperty::MeteringMode, "Center Weighted", StatusValue::MeterCenterWeighted},
+    {StatusProperty::MeteringMode, "Center-weighted average", StatusValue::MeterCenterWeighted},
+    {StatusProperty::MeteringMode, "Evaluative", StatusValue::MeterMatrix},
+    {StatusProperty::MeteringMode, "Highlight", StatusValue::MeterHighlight},
+    {StatusProperty::MeteringMode, "Multi", StatusValue::MeterMatrix},
+    {StatusProperty::MeteringMode, "Multi Spot", StatusValue::MeterMatrix},
+    {StatusProperty::MeteringMode, "Partial", StatusValue::MeterPartial},
+    {StatusProperty::MeteringMode, "Spot", StatusValue::MeterSpot},
+    {StatusProperty::WhiteBalance, "AWB White", StatusValue::WbAutoWhite},
+    {StatusProperty::WhiteBalance, "Auto", StatusValue::WbAuto},
+    {StatusProperty::WhiteBalance, "Automatic", StatusValue::WbAuto},
+    {StatusProperty::WhiteBalance, "Cloudy", StatusValue::WbCloudy},
+    {StatusProperty::WhiteBalance, "Color Temperature", StatusValue::WbColorTemp},
+    {StatusProperty::WhiteBalance, "Daylight", StatusValue::WbDaylight},
+    {StatusProperty::WhiteBalance, "Flash", StatusValue::WbFlash},
+    {StatusProperty::WhiteBalance, "Fluorescent", StatusValue::WbFluorescent},
+    {StatusProperty::WhiteBalance, "Incandescent", StatusValue::WbTungsten},
+    {StatusProperty::WhiteBalance, "Manual", StatusValue::WbPreset},
+    {StatusProperty::WhiteBalance, "Natural light auto", StatusValue::WbNaturalAuto},
+    {StatusProperty::WhiteBalance, "One-push Automatic", StatusValue::WbPreset},
+    {StatusProperty::WhiteBalance, "Preset", StatusValue::WbPreset},
+    {StatusProperty::WhiteBalance, "Shade", StatusValue::WbShade},
+    {StatusProperty::WhiteBalance, "Tungsten", StatusValue::WbTungsten},
+    {StatusProperty::WhiteBalance, "Underwater", StatusValue::WbUnderwater},
+    {StatusProperty::DriveMode, "Burst", StatusValue::DriveContinuous},
+    {StatusProperty::DriveMode, "Continuous", StatusValue::DriveContinuous},
+    {StatusProperty::DriveMode, "Continuous High Speed", StatusValue::DriveContinuousHigh},
+    {StatusProperty::DriveMode, "Continuous Low Speed", StatusValue::DriveContinuousLow},
+    {StatusProperty::DriveMode, "Continuous low speed", StatusValue::DriveContinuousLow},
+    {StatusProperty::DriveMode, "Mirror Up", StatusValue::DriveMirrorUp},
+    {StatusProperty::DriveMode, "Quiet Release", StatusValue::DriveQuiet},
+    {StatusProperty::DriveMode, "Remote", StatusValue::DriveRemote},
+    {StatusProperty::DriveMode, "Single", StatusValue::DriveSingle},
+    {StatusProperty::DriveMode, "Single Shot", StatusValue::DriveSingle},
+    {StatusProperty::DriveMode, "Timelapse", StatusValue::DriveTimelapse},
+    {StatusProperty::DriveMode, "Timer", StatusValue::DriveTimer},
+    {StatusProperty::DriveMode, "Timer 10 sec", StatusValue::DriveTimer},
+    {StatusProperty::DriveMode, "Timer 2 sec", StatusValue::DriveTimer},
+};
+static_assert(IsStrictlySorted(LABEL_TABLE, LabelLess), "LABEL_TABLE必须按（属性，标签）严格升序");
+
+// 按StatusValue顺序排列的中文标签
+constexpr const char* VALUE_LABELS[] = {
+    nullptr,                  // Unknown
+    "手动对焦（MF）",
+    "单次自动对焦（AF-S）",
+    "连续自动对焦（AF-C）",
+    "自动切换对焦（AF-A）",
+    "全时自动对焦（AF-F）",
+    "直接手动对焦（DMF）",
+    "微距自动对焦",
+    "M（手动）",
+    "P（程序自动）",
+    "A（光圈优先）",
+    "S（快门优先）",
+    "AUTO（自动）",
+    "B（B门）",
+    "A-DEP（景深优先）",
+    "SCENE（场景模式）",
+    "平均测光",
+    "中央重点测光",
+    "矩阵测光",
+    "点测光",
+    "局部测光",
+    "亮部重点测光",
+    "自动",
+    "自动（白色优先）",
+    "自动（自然光）",
+    "日光",
+    "阴天",
+    "阴影",
+    "钨丝灯",
+    "荧光灯",
+    "闪光灯",
+    "色温",
+    "预设（手动）",
+    "水下",
+    "单拍",
+    "连拍",
+    "高速连拍",
+    "低速连拍",
+    "自拍定时",
+    "反光板预升",
+    "遥控",
+    "静音快门释放",
+    "延时拍摄",
+};
+static_assert(sizeof(VALUE_LABELS) / sizeof(VALUE_LABELS[0]) == static_cast<size_t>(StatusValue::Count),
+              "VALUE_LABELS必须与StatusValue一一对应");
+
+std::atomic<PtpVendor> g_ptpVendor{PtpVendor::Generic};
+
+/**
+ * @brief 属性在各厂商下的属性码（佳能EOS使用自己的属性码）
+ */
+uint16_t PropertyCode(PtpVendor vendor, StatusProperty property) {
+    static constexpr uint16_t STANDARD_CODES[] = {0x500A, 0x500E, 0x500B, 0x5005, 0x5013};
+    static constexpr uint16_t CANON_EOS_CODES[] = {0xD108, 0xD105, 0xD107, 0xD109, 0xD106};
+    size_t index = static_cast<size_t>(property);
+    return vendor == PtpVendor::Canon ? CANON_EOS_CODES[index] : STANDARD_CODES[index];
+}
+
+StatusValue FindRaw(PtpVendor vendor, uint16_t property, uint32_t raw) {
+    RawEntry key{vendor, property, raw, StatusValue::Unknown};
+    const RawEntry* end = RAW_TABLE + sizeof(RAW_TABLE) / sizeof(RAW_TABLE[0]);
+    const RawEntry* it = std::lower_bound(RAW_TABLE, end, key, RawLess);
+    if (it != end && it->vendor == vendor && it->property == property && it->raw == raw) {
+        return it->value;
+    }
+    return StatusValue::Unknown;
+}
+
+StatusValue FindLabel(StatusProperty property, std::string_view label) {
+    LabelEntry key{property, label, StatusValue::Unknown};
+    const LabelEntry* end = LABEL_TABLE + sizeof(LABEL_TABLE) / sizeof(LABEL_TABLE[0]);
+    const LabelEntry* it = std::lower_bound(LABEL_TABLE, end, key, LabelLess);
+    if (it != end && it->property == property && it->label == label) {
+        return it->value;
+    }
+    return StatusValue::Unknown;
+}
+
+/**
+ * @brief 解析原始值："Unknown value 8011"按十六进制，纯数字按十进制
+ */
+bool ParseRawValue(const char* value, uint32_t& raw) {
+    static constexpr char UNKNOWN_PREFIX[] = "Unknown value ";
+    int base = 10;
+    if (strncmp(value, UNKNOWN_PREFIX, sizeof(UNKNOWN_PREFIX) - 1) == 0) {
+        value += sizeof(UNKNOWN_PREFIX) - 1;
+        base = 16;
+    }
+    if (*value == '\0') {
+        return false;
+    }
+    for (const char* p = value; *p; p++) {
+        if (base == 10 ? !isdigit(static_cast<unsigned char>(*p)) : !isxdigit(static_cast<unsigned char>(*p))) {
+            return false;
+        }
+    }
+    raw = static_cast<uint32_t>(strtoul(value, nullptr, base));
+    return true;
+}
+
+} // namespace
+
+void SelectPtpVendor(const std::string& model) {
+    g_ptpVendor = PtpVendorFromModel(model.c_str());
+}
+
+PtpVendor GetPtpVendor() {
+    return g_ptpVendor;
+}
+
+PtpVendor PtpVendorFromModel(const char* model) {
+    if (!model) {
+        return PtpVendor::Generic;
+    }
+    // libgphoto2的型号名以厂商开头（"Nikon Z 6"、"Canon EOS R5"、"Sony Alpha-A7 III"、"Fuji X-T3"）
+    if (strncmp(model, "Nikon", 5) == 0) {
+        return PtpVendor::Nikon;
+    }
+    if (strncmp(model, "Canon", 5) == 0) {
+        return PtpVendor::Canon;
+    }
+    if (strncmp(model, "Sony", 4) == 0) {
+        return PtpVendor::Sony;
+    }
+    if (strncmp(model, "Fuji", 4) == 0) {
+        return PtpVendor::Fuji;
+    }
+    return PtpVendor::Generic;
+}
+
+StatusValue DecodeStatusValue(StatusProperty property, const char* value) {
+    return DecodeStatusValue(GetPtpVendor(), property, value);
+}
+
+StatusValue DecodeStatusValue(PtpVendor vendor, StatusProperty property, const char* value) {
+    if (!value) {
+        return StatusValue::Unknown;
+    }
+    uint32_t raw = 0;
+    if (ParseRawValue(value, raw)) {
+        uint16_t code = PropertyCode(vendor, property);
+        StatusValue decoded = vendor != PtpVendor::Generic ? FindRaw(vendor, code, raw) : StatusValue::Unknown;
+        return decoded != StatusValue::Unknown ? decoded : FindRaw(PtpVendor::Generic, code, raw);
+    }
+    return FindLabel(property, value);
+}
+
+const char* StatusValueLabel(StatusValue value) {
+    size_t index = static_cast<size_t>(value);
+    return index < static_cast<size_t>(StatusValue::Count) ? VALUE_LABELS[index] : nullptr;
+}
@@ -0,0 +1,131 @@
+// PtpPropertyDecoder.h
+// Created on 2026/1/27.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef PTP_PROPERTY_DECODER_H
+#define PTP_PROPERTY_DECODER_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 相机厂商（决定厂商扩展属性码和取值的含义）
+ */
+enum class PtpVendor : uint8_t {
+    Generic = 0,   // 只按PTP标准取值解码
+    Nikon,
+    Canon,
+    Sony,
+    Fuji
+};
+
+/**
+ * @brief 需要解码的状态属性
+ */
+enum class StatusProperty : uint8_t {
+    FocusMode = 0,     // 对焦模式（标准0x500A，佳能EOS 0xD108）
+    ExposureProgram,   // 曝光模式（标准0x500E，佳能EOS 0xD105）
+    MeteringMode,      // 测光模式（标准0x500B，佳能EOS 0xD107）
+    WhiteBalance,      // 白平衡（标准0x5005，佳能EOS 0xD109）
+    DriveMode          // 拍摄模式（标准0x5013，佳能EOS 0xD106）
+};
+
+/**
+ * @brief 解码后的稳定取值（与厂商无关，ArkTS和日志都用它对应的中文标签）
+ */
+enum class StatusValue : uint8_t {
+    Unknown = 0,
+    // 对焦模式
+    FocusManual,
+    FocusSingle,
+    FocusContinuous,
+    FocusAuto,
+    FocusFullTime,
+    FocusDmf,
+    FocusMacro,
+    // 曝光模式
+    ProgramManual,
+    ProgramAuto,
+    ProgramAperture,
+    ProgramShutter,
+    ProgramFullAuto,
+    ProgramBulb,
+    ProgramDepth,
+    ProgramScene,
+    // 测光模式
+    MeterAverage,
+    MeterCenterWeighted,
+    MeterMatrix,
+    MeterSpot,
+    MeterPartial,
+    MeterHighlight,
+    // 白平衡
+    WbAuto,
+    WbAutoWhite,
+    WbNaturalAuto,
+    WbDaylight,
+    WbCloudy,
+    WbShade,
+    WbTungsten,
+    WbFluorescent,
+    WbFlash,
+    WbColorTemp,
+    WbPreset,
+    WbUnderwater,
+    // 拍摄模式
+    DriveSingle,
+    DriveContinuous,
+    DriveContinuousHigh,
+    DriveContinuousLow,
+    DriveTimer,
+    DriveMirrorUp,
+    DriveRemote,
+    DriveQuiet,
+    DriveTimelapse,
+    Count
+};
+
+/**
+ * @brief PTP状态属性解码
+ * @details 配置控件的值有三种形式：libgphoto2已识别的英文标签（"AF-C"）、未识别取值的
+ *          "Unknown value 8011"（十六进制），以及数字属性节点（"500a"）的十进制原始值。
+ *          原始值按（厂商，属性码，取值）在编译期排好序的常量表中二分查找，先查当前厂商的扩展取值，
+ *          再查PTP标准取值；英文标签按（属性，标签）查表。全程不分配内存。
+ *          厂商在连接时按型号选定一次（SelectPtpVendor）。
+ */
+
+/**
+ * @brief 按型号名选择厂商（连接成功时调用，断开时传空串恢复为Generic）
+ */
+void SelectPtpVendor(const std::string& model);
+
+/**
+ * @brief 当前连接的厂商
+ */
+PtpVendor GetPtpVendor();
+
+/**
+ * @brief 从型号名判断厂商（如"Nikon Z 6"→Nikon），无法判断时返回Generic
+ */
+PtpVendor PtpVendorFromModel(const char* model);
+
+/**
+ * @brief 解码控件值（按当前厂商）
+ * @param value 控件的字符串值
+ * @return 无法识别时返回StatusValue::Unknown
+ */
+StatusValue DecodeStatusValue(StatusProperty property, const char* value);
+
+/**
+ * @brief 解码控件值（指定厂商）
+ */
+StatusValue DecodeStatusValue(PtpVendor vendor, StatusProperty property, const char* value);
+
+/**
+ * @brief 取值对应的中文标签（Unknown返回nullptr）
+ */
+const char* StatusValueLabel(StatusValue value);
+
+#endif // PTP_PROPERTY_DECODER_H
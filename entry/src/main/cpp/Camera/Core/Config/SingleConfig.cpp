@@ -0,0 +1,494 @@
+// SingleConfig.cpp
+// Created on 2026/1/24.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "SingleConfig.h"
+#include "ConfigSnapshot.h"
+#include "Camera/Common/Constants.h"
+#include "Camera/Common/native_common.h"
+#include <hilog/log.h>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#define LOG_DOMAIN ModuleLogs::CameraConfig.domain
+#define LOG_TAG ModuleLogs::CameraConfig.tag
+
+namespace {
+
+/**
+ * @brief 按型号记录单项接口的回退信息（本次连接内有效，重连时清空：固件可能已升级）
+ */
+struct SingleConfigFallback {
+    std::unordered_set<std::string> treeOnly;       // 单项接口不可用、改走整树的"型号\n配置项"
+    std::unordered_set<std::string> missing;        // 整树里也不存在的"型号\n配置项"
+    std::unordered_map<std::string, int> failures;  // 单项接口连续失败次数（未确定不支持的错误）
+    std::mutex mutex;
+};
+
+// 非GP_ERROR_NOT_SUPPORTED的错误（超时、I/O等）可能是偶发的，连续失败这么多次才改走整树
+constexpr int MAX_SINGLE_FAILURES = 3;
+
+SingleConfigFallback& GetFallback() {
+    static SingleConfigFallback fallback;
+    return fallback;
+}
+
+std::string MakeKey(const std::string& model, const std::string& name) {
+    return model + "\n" + name;
+}
+
+std::string GetModelName(Camera* camera) {
+    CameraAbilities abilities;
+    if (gp_camera_get_abilities(camera, &abilities) == GP_OK) {
+        return abilities.model;
+    }
+    return "";
+}
+
+bool CamlibHasSingleConfig(Camera* camera) {
+    return camera->functions && camera->functions->get_single_config && camera->functions->set_single_config;
+}
+
+bool IsMissing(const std::string& model, const std::string& name) {
+    SingleConfigFallback& fallback = GetFallback();
+    std::lock_guard<std::mutex> lock(fallback.mutex);
+    return fallback.missing.count(MakeKey(model, name)) > 0;
+}
+
+bool UseSinglePath(Camera* camera, const std::string& model, const std::string& name) {
+    if (!CamlibHasSingleConfig(camera)) {
+        return false;
+    }
+    SingleConfigFallback& fallback = GetFallback();
+    std::lock_guard<std::mutex> lock(fallback.mutex);
+    return fallback.treeOnly.count(MakeKey(model, name)) == 0;
+}
+
+/**
+ * @brief 单项接口失败：明确不支持时立即记住，其他错误连续MAX_SINGLE_FAILURES次才记住
+ */
+void RememberTreeOnly(const std::string& model, const std::string& name, int ret) {
+    SingleConfigFallback& fallback = GetFallback();
+    std::lock_guard<std::mutex> lock(fallback.mutex);
+    std::string key = MakeKey(model, name);
+    if (ret != GP_ERROR_NOT_SUPPORTED && ++fallback.failures[key] < MAX_SINGLE_FAILURES) {
+        return;
+    }
+    fallback.failures.erase(key);
+    if (fallback.treeOnly.insert(key).second) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG,
+                     "%{public}s的配置项%{public}s不支持单项读写(%{public}s)，改用整树", model.c_str(), name.c_str(),
+                     gp_result_as_string(ret));
+    }
+}
+
+/**
+ * @brief 单项接口成功：清零连续失败次数
+ */
+void ForgetSingleFailures(const std::string& model, const std::string& name) {
+    SingleConfigFallback& fallback = GetFallback();
+    std::lock_guard<std::mutex> lock(fallback.mutex);
+    if (!fallback.failures.empty()) {
+        fallback.failures.erase(MakeKey(model, name));
+    }
+}
+
+void RememberMissing(const std::string& model, const std::string& name) {
+    SingleConfigFallback& fallback = GetFallback();
+    std::lock_guard<std::mutex> lock(fallback.mutex);
+    fallback.missing.insert(MakeKey(model, name));
+}
+
+/**
+ * @brief 单项写入
+ * @param valueError 输出：失败是否因为取值不合法（此时不应回退整树）
+ */
+int TrySingleWrite(Camera* camera, GPContext* context, const std::string& name, const std::string& value,
+                   bool& valueError) {
+    valueError = false;
+    CameraWidget* widget = nullptr;
+    int ret = gp_camera_get_single_config(camera, name.c_str(), &widget, context);
+    if (ret != GP_OK || !widget) {
+        return ret != GP_OK ? ret : GP_ERROR;
+    }
+    ret = SetWidgetValueFromString(widget, value);
+    if (ret != GP_OK) {
+        valueError = true;
+    } else {
+        ret = gp_camera_set_single_config(camera, name.c_str(), widget, context);
+    }
+    gp_widget_free(widget);
+    return ret;
+}
+
+/**
+ * @brief 整树写入：取一次树，写入候选中第一个存在的配置项
+ */
+int TreeWrite(Camera* camera, GPContext* context, const std::string& model, const std::vector<std::string>& names,
+              const std::string& value, std::string* appliedName) {
+    CameraWidget* root = nullptr;
+    int ret = gp_camera_get_config(camera, &root, context);
+    if (ret != GP_OK || !root) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "获取配置树失败：%{public}s", gp_result_as_string(ret));
+        return ret != GP_OK ? ret : GP_ERROR;
+    }
+
+    CameraWidget* child = nullptr;
+    const std::string* found = nullptr;
+    for (const auto& name : names) {
+        if (gp_widget_get_child_by_name(root, name.c_str(), &child) == GP_OK && child) {
+            found = &name;
+            break;
+        }
+        RememberMissing(model, name);
+    }
+    if (!found) {
+        gp_widget_free(root);
+        return GP_ERROR_BAD_PARAMETERS;
+    }
+
+    ret = SetWidgetValueFromString(child, value);
+    if (ret == GP_OK) {
+        ret = gp_camera_set_config(camera, root, context);
+    }
+    gp_widget_free(root);
+    if (ret == GP_OK && appliedName) {
+        *appliedName = *found;
+    }
+    return ret;
+}
+
+/**
+ * @brief 整树批量写入：取一次树，改完所有控件后提交一次
+ */
+void TreeWriteBatch(Camera* camera, GPContext* context, const std::string& model, std::vector<ConfigWrite*>& writes) {
+    CameraWidget* root = nullptr;
+    int ret = gp_camera_get_config(camera, &root, context);
+    if (ret != GP_OK || !root) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "获取配置树失败：%{public}s", gp_result_as_string(ret));
+        for (ConfigWrite* write : writes) {
+            write->result = ret != GP_OK ? ret : GP_ERROR;
+        }
+        return;
+    }
+
+    std::vector<ConfigWrite*> pending;
+    for (ConfigWrite* write : writes) {
+        CameraWidget* child = nullptr;
+        if (gp_widget_get_child_by_name(root, write->name.c_str(), &child) != GP_OK || !child) {
+            RememberMissing(model, write->name);
+            write->result = GP_ERROR_BAD_PARAMETERS;
+            continue;
+        }
+        write->result = SetWidgetValueFromString(child, write->value);
+        if (write->result == GP_OK) {
+            pending.push_back(write);
+        }
+    }
+
+    if (!pending.empty()) {
+        // ptp2只提交标记为已修改的控件，一次set_config完成所有改动
+        ret = gp_camera_set_config(camera, root, context);
+        for (ConfigWrite* write : pending) {
+            write->result = ret;
+        }
+        if (ret != GP_OK) {
+            OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "整树提交%{public}zu项失败：%{public}s",
+                         pending.size(), gp_result_as_string(ret));
+        }
+    }
+    gp_widget_free(root);
+}
+
+bool ParseNumber(const std::string& text, float& number) {
+    if (text.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    number = strtof(text.c_str(), &end);
+    return end && *end == '\0';
+}
+
+} // namespace
+
+int SetWidgetValueFromString(CameraWidget* widget, const std::string& value) {
+    CameraWidgetType type;
+    int ret = gp_widget_get_type(widget, &type);
+    if (ret != GP_OK) {
+        return ret;
+    }
+    switch (type) {
+        case GP_WIDGET_TOGGLE: {
+            int flag = (value == "on" || value == "true") ? 1 : atoi(value.c_str());
+            return gp_widget_set_value(widget, &flag);
+        }
+        case GP_WIDGET_DATE: {
+            int date = atoi(value.c_str());
+            return gp_widget_set_value(widget, &date);
+        }
+        case GP_WIDGET_RANGE: {
+            float number = static_cast<float>(atof(value.c_str()));
+            return gp_widget_set_value(widget, &number);
+        }
+        case GP_WIDGET_TEXT:
+        case GP_WIDGET_RADIO:
+        case GP_WIDGET_MENU:
+            return gp_widget_set_value(widget, value.c_str());
+        default:
+            return GP_ERROR_NOT_SUPPORTED;
+    }
+}
+
+int GetWidgetValueAsString(CameraWidget* widget, std::string& value) {
+    CameraWidgetType type;
+    int ret = gp_widget_get_type(widget, &type);
+    if (ret != GP_OK) {
+        return ret;
+    }
+    switch (type) {
+        case GP_WIDGET_TOGGLE:
+        case GP_WIDGET_DATE: {
+            int number = 0;
+            ret = gp_widget_get_value(widget, &number);
+            value = std::to_string(number);
+            return ret;
+        }
+        case GP_WIDGET_RANGE: {
+            float number = 0.0f;
+            ret = gp_widget_get_value(widget, &number);
+            char text[32];
+            snprintf(text, sizeof(text), "%g", number);
+            value = text;
+            return ret;
+        }
+        case GP_WIDGET_TEXT:
+        case GP_WIDGET_RADIO:
+        case GP_WIDGET_MENU: {
+            const char* text = nullptr;
+            ret = gp_widget_get_value(widget, &text);
+            value = text ? text : "";
+            return ret;
+        }
+        default:
+            return GP_ERROR_NOT_SUPPORTED;
+    }
+}
+
+void ClearSingleConfigFallback() {
+    SingleConfigFallback& fallback = GetFallback();
+    std::lock_guard<std::mutex> lock(fallback.mutex);
+    fallback.treeOnly.clear();
+    fallback.missing.clear();
+    fallback.failures.clear();
+}
+
+int ReadSingleConfig(const std::string& name, std::string& value) {
+    Camera* camera = g_camera;
+    GPContext* context = g_context;
+    if (!g_connected || !camera || !context) {
+        return GP_ERROR_IO;
+    }
+
+    std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
+    std::string model = GetModelName(camera);
+    if (UseSinglePath(camera, model, name)) {
+        CameraWidget* widget = nullptr;
+        int ret = gp_camera_get_single_config(camera, name.c_str(), &widget, context);
+        if (ret == GP_OK && widget) {
+            ForgetSingleFailures(model, name);
+            ret = GetWidgetValueAsString(widget, value);
+            gp_widget_free(widget);
+            return ret;
+        }
+        // 相机暂时忙不代表不支持单项读取，与写入一致直接返回，不记入整树名单
+        if (ret == GP_ERROR_CAMERA_BUSY) {
+            return ret;
+        }
+        RememberTreeOnly(model, name, ret);
+    }
+
+    // 整树回退：复用配置树快照
+    int error = GP_OK;
+    std::shared_ptr<ConfigSnapshot> snapshot = ConfigSnapshotCache::getInstance().acquire(&error);
+    if (!snapshot) {
+        return error;
+    }
+    CameraWidget* widget = snapshot->find(name);
+    if (!widget) {
+        return GP_ERROR_BAD_PARAMETERS;
+    }
+    return GetWidgetValueAsString(widget, value);
+}
+
+int WriteSingleConfig(const std::string& name, const std::string& value) {
+    return WriteFirstSingleConfig({name}, value, nullptr);
+}
+
+int WriteFirstSingleConfig(const std::vector<std::string>& candidates, const std::string& value,
+                           std::string* appliedName) {
+    Camera* camera = g_camera;
+    GPContext* context = g_context;
+    if (!g_connected || !camera || !context) {
+        return GP_ERROR_IO;
+    }
+
+    std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
+    std::string model = GetModelName(camera);
+    std::vector<std::string> treeNames;
+    for (const auto& name : candidates) {
+        if (IsMissing(model, name)) {
+            continue;
+        }
+        if (!UseSinglePath(camera, model, name)) {
+            treeNames.push_back(name);
+            continue;
+        }
+        bool valueError = false;
+        int ret = TrySingleWrite(camera, context, name, value, valueError);
+        if (ret == GP_OK) {
+            ForgetSingleFailures(model, name);
+            InvalidateConfigSnapshot();
+            if (appliedName) {
+                *appliedName = name;
+            }
+            return GP_OK;
+        }
+        if (valueError) {
+            OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "配置项%{public}s不接受取值%{public}s：%{public}s",
+                         name.c_str(), value.c_str(), gp_result_as_string(ret));
+            return ret;
+        }
+        if (ret == GP_ERROR_CAMERA_BUSY) {
+            return ret;
+        }
+        RememberTreeOnly(model, name, ret);
+        treeNames.push_back(name);
+    }
+
+    if (treeNames.empty()) {
+        return GP_ERROR_BAD_PARAMETERS;
+    }
+    int ret = TreeWrite(camera, context, model, treeNames, value, appliedName);
+    // 整树写入无论成败都作废快照：部分机身失败时也可能已改动其他属性
+    InvalidateConfigSnapshot();
+    return ret;
+}
+
+int WriteConfigBatch(std::vector<ConfigWrite>& writes) {
+    Camera* camera = g_camera;
+    GPContext* context = g_context;
+    if (!g_connected || !camera || !context) {
+        for (auto& write : writes) {
+            write.result = GP_ERROR_IO;
+        }
+        return GP_ERROR_IO;
+    }
+
+    std::lock_guard<std::recursive_mutex> ioLock(GetCameraIoMutex());
+    std::string model = GetModelName(camera);
+    std::vector<ConfigWrite*> treeWrites;
+    for (auto& write : writes) {
+        if (IsMissing(model, write.name)) {
+            write.result = GP_ERROR_BAD_PARAMETERS;
+            continue;
+        }
+        if (!UseSinglePath(camera, model, write.name)) {
+            treeWrites.push_back(&write);
+            continue;
+        }
+        bool valueError = false;
+        write.result = TrySingleWrite(camera, context, write.name, write.value, valueError);
+        if (write.result == GP_OK) {
+            ForgetSingleFailures(model, write.name);
+        }
+        // 相机忙不代表不支持单项接口，直接返回给调用方重试
+        if (write.result != GP_OK && !valueError && write.result != GP_ERROR_CAMERA_BUSY) {
+            RememberTreeOnly(model, write.name, write.result);
+            treeWrites.push_back(&write);
+        }
+    }
+    if (!treeWrites.empty()) {
+        TreeWriteBatch(camera, context, model, treeWrites);
+    }
+    InvalidateConfigSnapshot();
+
+    int firstError = GP_OK;
+    for (const auto& write : writes) {
+        if (write.result != GP_OK) {
+            OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "批量设置%{public}s=%{public}s失败：%{public}s",
+                         write.name.c_str(), write.value.c_str(), gp_result_as_string(write.result));
+            if (firstError == GP_OK) {
+                firstError = write.result;
+            }
+        }
+    }
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "批量设置%{public}zu项完成，其中整树%{public}zu项",
+                 writes.size(), treeWrites.size());
+    return firstError;
+}
+
+bool ValidateConfigValue(const std::string& name, const std::string& value, std::string& reason) {
+    std::shared_ptr<ConfigSnapshot> snapshot = ConfigSnapshotCache::getInstance().peek();
+    CameraWidget* widget = snapshot ? snapshot->find(name) : nullptr;
+    if (!widget) {
+        return true;
+    }
+
+    int readonly = 0;
+    if (gp_widget_get_readonly(widget, &readonly) == GP_OK && readonly) {
+        reason = "只读配置项";
+        return false;
+    }
+
+    CameraWidgetType type;
+    if (gp_widget_get_type(widget, &type) != GP_OK) {
+        return true;
+    }
+    switch (type) {
+        case GP_WIDGET_RADIO:
+        case GP_WIDGET_MENU: {
+            int count = gp_widget_count_choices(widget);
+            if (count <= 0) {
+                return true;
+            }
+            for (int i = 0; i < count; ++i) {
+                const char* choice = nullptr;
+                if (gp_widget_get_choice(widget, i, &choice) == GP_OK && choice && value == choice) {
+                    return true;
+                }
+            }
+            reason = "不在可选值中";
+            return false;
+        }
+        case GP_WIDGET_RANGE: {
+            float number = 0.0f;
+            float min = 0.0f;
+            float max = 0.0f;
+            float step = 0.0f;
+            if (!ParseNumber(value, number)) {
+                reason = "不是数值";
+                return false;
+            }
+            if (gp_widget_get_range(widget, &min, &max, &step) == GP_OK && (number < min || number > max)) {
+                reason = "超出取值范围";
+                return false;
+            }
+            return true;
+        }
+        case GP_WIDGET_TOGGLE: {
+            if (value == "0" || value == "1" || value == "on" || value == "off" || value == "true" ||
+                value == "false") {
+                return true;
+            }
+            reason = "开关只接受0/1/on/off";
+            return false;
+        }
+        default:
+            return true;
+    }
+}
@@ -0,0 +1,83 @@
+// SingleConfig.h
+// Created on 2026/1/24.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef SINGLE_CONFIG_H
+#define SINGLE_CONFIG_H
+
+#include <string>
+#include <vector>
+
+#include <gphoto2/gphoto2.h>
+
+/**
+ * @brief 单项配置读写
+ * @details 读写一个配置项时优先走gp_camera_get_single_config/set_single_config，
+ *          尼康等机身上一次读写只产生一次PTP属性事务，而整树读取要读几百个属性。
+ *          camlib没有实现单项接口时直接走整树；某个型号的某个配置项单项接口返回不支持，
+ *          或连续几次失败后（ptp2对未识别属性会拒绝单项访问），记住该型号+配置项，
+ *          本次连接内直接走整树。相机忙不计入失败。
+ *          所有函数内部持有相机I/O锁，写入后作废配置树快照。返回值为libgphoto2错误码。
+ */
+
+/**
+ * @brief 按控件类型把字符串写入控件（开关取"1"/"0"/"on"/"off"，范围取浮点数，其余按文本）
+ */
+int SetWidgetValueFromString(CameraWidget* widget, const std::string& value);
+
+/**
+ * @brief 把控件当前值转成字符串（开关/日期为整数，范围为浮点数）
+ */
+int GetWidgetValueAsString(CameraWidget* widget, std::string& value);
+
+/**
+ * @brief 清空单项接口的回退记录（断开连接时调用，重连后重新探测）
+ */
+void ClearSingleConfigFallback();
+
+/**
+ * @brief 读取单个配置项的当前值
+ */
+int ReadSingleConfig(const std::string& name, std::string& value);
+
+/**
+ * @brief 写入单个配置项
+ */
+int WriteSingleConfig(const std::string& name, const std::string& value);
+
+/**
+ * @brief 按顺序尝试多个候选配置项名，写入第一个存在的
+ * @details 用于不同机身名称不同的配置项（如liveview/live-view/lv），整树模式下只取一次树
+ * @param appliedName 输出：实际写入的配置项名（可为nullptr）
+ */
+int WriteFirstSingleConfig(const std::vector<std::string>& candidates, const std::string& value,
+                           std::string* appliedName = nullptr);
+
+/**
+ * @brief 批量写入中的一项
+ */
+struct ConfigWrite {
+    std::string name;    // 配置项名
+    std::string value;   // 目标值
+    int result = GP_OK;  // 输出：该项的libgphoto2错误码
+};
+
+/**
+ * @brief 批量写入多个配置项，整批只持一次相机I/O锁
+ * @details 支持单项接口的配置项按顺序逐个写入；其余配置项合并为一次整树事务
+ *          （取一次树、改多个控件、提交一次），整树提交失败时这些项一起失败。
+ * @return 全部成功返回GP_OK，否则返回第一个失败项的错误码
+ */
+int WriteConfigBatch(std::vector<ConfigWrite>& writes);
+
+/**
+ * @brief 按缓存的配置树快照检查取值是否合法（不访问相机）
+ * @details 单选/菜单项检查是否在可选值中，范围项检查数值区间，开关项检查0/1/on/off；
+ *          没有快照或快照里没有该配置项时视为合法，交给相机判断。
+ * @param reason 输出：不合法的原因
+ */
+bool ValidateConfigValue(const std::string& name, const std::string& value, std::string& reason);
+
+#endif // SINGLE_CONFIG_H
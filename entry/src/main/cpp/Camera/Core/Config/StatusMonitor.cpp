@@ -0,0 +1,207 @@
+// StatusMonitor.cpp
+// Created on 2026/1/26.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "StatusMonitor.h"
+#include "ConfigSnapshot.h"
+#include "camera_config.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/Common/Constants.h"
+#include "Camera/Common/native_common.h"
+#include "Camera/Core/Capture/TetherSession.h"
+#include <hilog/log.h>
+#include <cstdlib>
+#include <cstring>
+
+#define LOG_DOMAIN ModuleLogs::StatusMonitor.domain
+#define LOG_TAG ModuleLogs::StatusMonitor.tag
+
+namespace {
+
+StatusField TextField(const char* key, const char* value) {
+    return StatusField{key, value, 0, false};
+}
+
+StatusField NumberField(const char* key, long long value) {
+    return StatusField{key, "", value, true};
+}
+
+/**
+ * @brief 把CameraInfo展开为字段列表（顺序固定，便于逐项比较）
+ */
+std::vector<StatusField> CollectStatusFields(const CameraInfo& info) {
+    return {
+        TextField("batteryLevel", info.batteryLevel),
+        TextField("aperture", info.aperture),
+        TextField("shutter", info.shutter),
+        TextField("iso", info.iso),
+        TextField("exposureCompensation", info.exposureComp),
+        TextField("whiteBalance", info.whiteBalance),
+        TextField("captureMode", info.captureMode),
+        TextField("exposureProgram", info.exposureProgram),
+        TextField("focusMode", info.focusMode),
+        TextField("exposureMeterMode", info.exposureMeterMode),
+        NumberField("freeSpaceBytes", info.freeSpaceBytes),
+        NumberField("remainingPictures", info.remainingPictures),
+    };
+}
+
+bool SameField(const StatusField& a, const StatusField& b) {
+    return a.numeric ? a.number == b.number : a.text == b.text;
+}
+
+} // namespace
+
+StatusMonitor& StatusMonitor::getInstance() {
+    static StatusMonitor instance;
+    return instance;
+}
+
+StatusMonitor::~StatusMonitor() {
+    stop();
+}
+
+bool StatusMonitor::start(ChangeCallback callback) {
+    stop();
+    if (!g_connected) {
+        return false;
+    }
+
+    callback_ = std::move(callback);
+    last_.clear();
+    lastGeneration_ = 0;
+    propertyEventsSeen_ = false;
+    stopRequested_ = false;
+    running_ = true;
+    thread_ = std::thread(&StatusMonitor::monitorLoop, this);
+    return true;
+}
+
+void StatusMonitor::stop() {
+    stopRequested_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    running_ = false;
+}
+
+void StatusMonitor::notifyPropertyChanged() {
+    propertyEventsSeen_ = true;
+    InvalidateConfigSnapshot();
+}
+
+void StatusMonitor::monitorLoop() {
+    OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "状态监视开始");
+
+    bool first = true;
+    while (!stopRequested_) {
+        if (!g_connected) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(TICK_MS));
+            continue;
+        }
+
+        drainEvents();
+
+        // 快照作废触发的刷新按兜底间隔去抖：连续写入参数、转拨盘时一个间隔内只整树读取一次，
+        // 间隔内的变化在间隔结束后一并刷新
+        uint64_t generation = ConfigSnapshotCache::getInstance().getGeneration();
+        auto now = std::chrono::steady_clock::now();
+        auto sinceRefresh = now - lastRefresh_;
+        int fallbackMs = propertyEventsSeen_ ? EVENT_FALLBACK_REFRESH_MS : FALLBACK_REFRESH_MS;
+        bool due = first || sinceRefresh >= std::chrono::milliseconds(fallbackMs) ||
+                   (generation != lastGeneration_ && sinceRefresh >= std::chrono::milliseconds(FALLBACK_REFRESH_MS));
+        // 相机忙时refresh不读取，下一轮再试
+        if (due && refresh()) {
+            first = false;
+            lastGeneration_ = generation;
+            lastRefresh_ = now;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(TICK_MS));
+    }
+
+    OH_LOG_PrintMsg(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "状态监视结束");
+}
+
+void StatusMonitor::drainEvents() {
+    // 联机会话在监听事件，属性变化由它转发，这里不抢事件
+    if (TetherSession::getInstance().isRunning()) {
+        return;
+    }
+    // 相机正忙（下载、取实时取景等）时跳过本轮，不排队等锁
+    std::unique_lock<std::recursive_mutex> lock(GetCameraIoMutex(), std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+    Camera* camera = g_camera;
+    GPContext* context = g_context;
+    if (!camera || !context) {
+        return;
+    }
+
+    for (int i = 0; i < MAX_EVENTS_PER_TICK; i++) {
+        CameraEventType eventType = GP_EVENT_TIMEOUT;
+        void* eventData = nullptr;
+        // 超时为0：只取已经排队的事件，不阻塞
+        if (gp_camera_wait_for_event(camera, 0, &eventType, &eventData, context) != GP_OK) {
+            free(eventData);
+            break;
+        }
+        if (eventType == GP_EVENT_UNKNOWN && eventData &&
+            strstr(static_cast<const char*>(eventData), "Property") != nullptr) {
+            notifyPropertyChanged();
+        } else if (eventType == GP_EVENT_FILE_ADDED && eventData) {
+            // 机身快门拍摄的新文件：同步给扫描器，照片列表不必重新扫描
+            CameraFilePath* path = static_cast<CameraFilePath*>(eventData);
+            NotifyCameraFileAdded(path->folder, path->name);
+        }
+        free(eventData);
+        if (eventType == GP_EVENT_TIMEOUT) {
+            break;
+        }
+    }
+}
+
+bool StatusMonitor::refresh() {
+    // 相机正忙（下载、取实时取景等）时跳过，不排队等锁。联机会话运行时例外：事件循环每次等待后
+    // 都会短暂释放IO锁，try_lock几乎抢不到，而拨盘改参数正需要推送，此时排队等锁（最多一次等待时长）
+    CameraInfo info;
+    {
+        std::unique_lock<std::recursive_mutex> lock(GetCameraIoMutex(), std::defer_lock);
+        if (TetherSession::getInstance().isRunning()) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            return false;
+        }
+        info = InternalGetCameraInfo();
+    }
+    if (!info.isSuccess) {
+        return true;
+    }
+    // 借用刚取到的快照校验配置结构缓存（每次连接只做一次）
+    RevalidateConfigSchema();
+
+    std::vector<StatusField> fields = CollectStatusFields(info);
+    std::vector<StatusField> changed;
+    for (size_t i = 0; i < fields.size(); i++) {
+        if (last_.size() != fields.size() || !SameField(last_[i], fields[i])) {
+            changed.push_back(fields[i]);
+        }
+    }
+    last_ = std::move(fields);
+    if (changed.empty()) {
+        return true;
+    }
+
+    OH_LOG_Print(LOG_APP, LOG_DEBUG, LOG_DOMAIN, LOG_TAG, "相机状态变化%{public}zu项", changed.size());
+    if (callback_) {
+        callback_(changed);
+    }
+    return true;
+}
+
+void NotifyCameraPropertyChanged() {
+    StatusMonitor::getInstance().notifyPropertyChanged();
+}
@@ -0,0 +1,101 @@
+// StatusMonitor.h
+// Created on 2026/1/26.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef STATUS_MONITOR_H
+#define STATUS_MONITOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 相机状态字段（字段名与GetCameraStatus返回的属性名一致）
+ */
+struct StatusField {
+    std::string key;        // 字段名（如"aperture"）
+    std::string text;       // 文本值（numeric为false时有效）
+    long long number;       // 数值（numeric为true时有效）
+    bool numeric;           // 是否数值字段（freeSpaceBytes、remainingPictures）
+};
+
+/**
+ * @brief 相机状态监视器
+ * @details 代替ArkTS定时调用GetCameraStatus：后台线程只在相机状态可能变化时才重新读取状态，
+ *          与上一次结果比较后只推送变化的字段，相机空闲时几乎没有额外通信。
+ *          状态可能变化的依据是配置快照被作废（机身属性变化事件、本机写入参数、开关实时取景），
+ *          由快照作废计数判断。联机会话运行时由它监听事件并转发属性变化；未运行时监视器自己
+ *          非阻塞地取事件。机身从未上报属性变化事件时按较短间隔兜底刷新，上报过则只做低频兜底。
+ *          快照作废触发的刷新按较短的兜底间隔去抖；相机正忙时跳过本轮刷新，不排队等锁
+ *          （联机会话运行时除外，会话的事件循环在两次等待之间让出IO锁）。
+ *          全局唯一：ArkTS只注册一个状态回调，多个监视器只会重复读同一台相机。
+ */
+class StatusMonitor {
+public:
+    using ChangeCallback = std::function<void(const std::vector<StatusField>&)>;
+
+    static StatusMonitor& getInstance();
+
+    StatusMonitor(const StatusMonitor&) = delete;
+    StatusMonitor& operator=(const StatusMonitor&) = delete;
+
+    /**
+     * @brief 启动监视（已在运行时先停止），启动后第一次推送全部字段
+     * @param callback 变化回调（在后台线程调用）
+     * @return 相机未连接时返回false
+     */
+    bool start(ChangeCallback callback);
+
+    /**
+     * @brief 停止监视（等待后台线程退出）
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+
+    /**
+     * @brief 相机上报了属性变化事件（作废配置快照，并记住该机身会上报属性事件）
+     */
+    void notifyPropertyChanged();
+
+private:
+    StatusMonitor() = default;
+    ~StatusMonitor();
+
+    void monitorLoop();
+    void drainEvents();
+
+    /**
+     * @brief 读取状态并推送变化的字段
+     * @return 相机正忙、本轮没有读取时返回false
+     */
+    bool refresh();
+
+private:
+    ChangeCallback callback_;                       // 变化回调
+    std::thread thread_;                            // 监视线程
+    std::atomic<bool> running_{false};              // 是否运行中
+    std::atomic<bool> stopRequested_{false};        // 是否请求停止
+    std::atomic<bool> propertyEventsSeen_{false};   // 本次连接是否收到过属性变化事件
+    std::vector<StatusField> last_;                 // 上一次推送后的完整状态
+    uint64_t lastGeneration_ = 0;                   // 上一次刷新时的快照作废计数
+    std::chrono::steady_clock::time_point lastRefresh_;
+
+    static constexpr int TICK_MS = 250;                    // 检查间隔（毫秒），决定状态变化的推送延迟
+    static constexpr int FALLBACK_REFRESH_MS = 2000;       // 机身不上报属性事件时的兜底刷新间隔
+    static constexpr int EVENT_FALLBACK_REFRESH_MS = 15000; // 机身上报属性事件时的兜底刷新间隔
+    static constexpr int MAX_EVENTS_PER_TICK = 16;         // 每次最多取的事件数，避免长时间占用相机
+};
+
+/**
+ * @brief 相机上报属性变化事件时调用（联机会话的事件循环使用）
+ */
+void NotifyCameraPropertyChanged();
+
+#endif // STATUS_MONITOR_H
@@ -5,13 +5,23 @@
 // please include "napi/native_api.h".
 
 #include "../../Common/native_common.h"
+#include <cmath>
+#include <cstring>
 #include <map>
+#include <mutex>
 #include <unistd.h>
 #include <vector>
 #include <napi/native_api.h>
 #include "Camera/Common/Constants.h"
 #include "hilog/log.h"
 #include "camera_config.h"
+#include "ConfigSnapshot.h"
+#include "SingleConfig.h"
+#include "ConfigWriteQueue.h"
+#include "StatusMonitor.h"
+#include "PtpPropertyDecoder.h"
+#include "ConfigSchemaCache.h"
+#include "ExposureMath.h"
 #include <Camera/Core/Device/NapiDeviceInterface.h>
 
 
@@ -25,43 +35,15 @@
 
 
 
-// 定义全局变量（包含相机所有可选配置的），简言之这个变量就是配置树
-std::vector<ConfigItem> g_allConfigItems;
+// 已发布的配置项集合（包含相机所有可选配置），只通过std::atomic_load/atomic_store访问
+static std::shared_ptr<const ConfigItemSet> g_configItems;
 
-// 全局回调函数指针（需在camera_config.h中声明）
-ParamCallback g_paramCallback = nullptr;
+// 参数可选值推送回调（RegisterParamCallback注册），g_paramOptionsMutex保护
+static napi_threadsafe_function g_paramOptionsTsfn = nullptr;
+static std::mutex g_paramOptionsMutex;
 
 
-// 定义结构体保存回调需要的状态（env和ArkTS回调的引用）
-struct CallbackState {
-    napi_env env;         // NAPI环境
-    napi_ref callbackRef; // ArkTS层回调函数的引用
-};
-
-// 全局变量保存状态（简单处理，实际项目可考虑更安全的管理方式）
-static CallbackState g_callbackState;
-
-
-
-// 标准快门档位（单位：秒），按从小到大排序
-const float standardShutterSpeeds[] = {
-    1 / 8000.0f, 1 / 6400.0f, 1 / 5000.0f, 1 / 4000.0f, 1 / 3200.0f, 1 / 2500.0f, 1 / 2000.0f, 1 / 1600.0f, 1 / 1250.0f,
-    1 / 1000.0f, 1 / 800.0f,  1 / 640.0f,  1 / 500.0f,  1 / 400.0f,  1 / 320.0f,  1 / 250.0f,  1 / 200.0f,  1 / 160.0f,
-    1 / 125.0f,  1 / 100.0f,  1 / 80.0f,   1 / 60.0f,   1 / 50.0f,   1 / 40.0f,   1 / 30.0f,   1 / 25.0f,   1 / 20.0f,
-    1 / 15.0f,   1 / 12.5f,   1 / 10.0f,   0.125f,      0.166f,      0.2f,        0.25f,       0.3f,        0.4f,
-    0.5f,        0.6f,        0.8f,        1.0f,        1.3f,        1.6f,        2.0f,        2.5f,        3.2f,
-    4.0f,        5.0f,        6.0f,        8.0f,        10.0f};
 
-// 对应的分数显示（与上面的档位一一对应）
-const char *standardShutterLabels[] = {
-    "1/8000s", "1/6400s", "1/5000s", "1/4000s", "1/3200s", "1/2500s", "1/2000s", "1/1600s", "1/1250s", "1/1000s",
-    "1/800s",  "1/640s",  "1/500s",  "1/400s",  "1/320s",  "1/250s",  "1/200s",  "1/160s",  "1/125s",  "1/100s",
-    "1/80s",   "1/60s",   "1/50s",   "1/40s",   "1/30s",   "1/25s",   "1/20s",   "1/15s",   "1/12.5s", "1/10s",
-    "1/8s",    "1/6s",    "1/5s",    "1/4s",    "1/3s",    "1/2.5s",  "1/2s",    "0.6s",    "0.8s",    "1s",
-    "1.3s",    "1.6s",    "2s",      "2.5s",    "3.2s",    "4s",      "5s",      "6s",      "8s",      "10s"};
-
-// 标准档位数量（需与上面数组长度一致）
-const int numStandardShutters = sizeof(standardShutterSpeeds) / sizeof(standardShutterSpeeds[0]);
 
 
 
@@ -226,36 +208,22 @@ static void TraverseConfigTree(CameraWidget* widget, std::vector<ConfigItem>& it
  */
 std::unordered_map<std::string, std::vector<std::string>> ExtractParamOptions(const std::vector<std::string>& paramNames) {
     std::unordered_map<std::string, std::vector<std::string>> result;
-    if (g_allConfigItems.empty()) {
+    std::shared_ptr<const ConfigItemSet> configItems = GetConfigItems();
+    if (!configItems) {
         OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "配置树为空，无法提取可选值");
         return result;
     }
 
-    /*// 遍历配置树，匹配目标参数并提取可选值
-    for (const auto& item : g_allConfigItems) {
-        // 检查当前参数是否在需要提取的列表中
-        if (std::find(paramNames.begin(), paramNames.end(), item.name) != paramNames.end()) {
-            result[item.name] = item.choices; // 存储可选值数组
-            OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "提取参数[%{public}s]的可选值，共%{public}d项", 
-                        item.name.c_str(), (int)item.choices.size());
-        }
-    }*/
-    
-    // 遍历配置树，匹配目标参数并提取可选值
-    for (const auto& item : g_allConfigItems) {
-        // 检查当前参数是否在需要提取的列表中
-        if (std::find(paramNames.begin(), paramNames.end(), item.name) != paramNames.end()) {
-            result[item.name] = item.choices; // 存储可选值数组
+    // 按名查找目标参数并提取可选值
+    for (const auto& name : paramNames) {
+        const ConfigItem* item = configItems->find(name);
+        if (item) {
+            result[name] = item->choices; // 存储可选值数组
             OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "提取参数[%{public}s]的可选值，共%{public}d项",
-                item.name.c_str(), (int)item.choices.size());
-            // 新增：遍历并打印每个可选值
-            OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "参数[%{public}s]的可选值如下:", item.name.c_str());
-            for (const auto& choice : item.choices) {
-                OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, " - %{public}s", choice.c_str());
-            }
+                name.c_str(), (int)item->choices.size());
         }
     }
-    
+
     return result;
 }
 
@@ -264,41 +232,46 @@ std::unordered_map<std::string, std::vector<std::string>> ExtractParamOptions(co
 
 
 /**
- * 将提取的参数可选值转换为NAPI格式并推送
+ * @brief 在ArkTS线程中把参数可选值转换为JS对象（参数名 → 可选值数组）并调用回调
  */
-void PushParamOptionsToArkTS(const std::unordered_map<std::string, std::vector<std::string>>& options) {
-    napi_env env = g_callbackState.env;
-    if (!env || g_paramCallback == nullptr) {
-        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "环境或回调为空，无法推送参数选项");
-        return;
-    }
-
-    // 创建NAPI对象存储所有参数的可选值
-    napi_value resultObj;
-    napi_create_object(env, &resultObj);
-
-    // 遍历可选值map，转换为NAPI数组并设置到对象中
-    for (const auto& pair : options) {
-        const std::string& paramName = pair.first;
-        const std::vector<std::string>& choices = pair.second;
-
-        // 创建可选值数组
-        napi_value choicesArray;
-        napi_create_array(env, &choicesArray);
-        for (size_t i = 0; i < choices.size(); ++i) {
-            napi_value choiceStr = CreateNapiString(env, choices[i].c_str());
-            napi_set_element(env, choicesArray, i, choiceStr);
+static void CallParamOptionsJs(napi_env env, napi_value jsCallback, void* context, void* data) {
+    auto* options = static_cast<std::unordered_map<std::string, std::vector<std::string>>*>(data);
+    if (env != nullptr && jsCallback != nullptr) {
+        napi_value resultObj;
+        napi_create_object(env, &resultObj);
+        for (const auto& pair : *options) {
+            napi_value choicesArray;
+            napi_create_array(env, &choicesArray);
+            for (size_t i = 0; i < pair.second.size(); ++i) {
+                napi_set_element(env, choicesArray, i, CreateNapiString(env, pair.second[i].c_str()));
+            }
+            napi_set_named_property(env, resultObj, pair.first.c_str(), choicesArray);
         }
 
-        // 将数组绑定到参数名对应的属性
-        napi_value key = CreateNapiString(env, paramName.c_str());
-        napi_set_property(env, resultObj, key, choicesArray);
+        napi_value global;
+        napi_get_global(env, &global);
+        napi_call_function(env, global, jsCallback, 1, &resultObj, nullptr);
     }
+    delete options;
+}
 
-    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "准备推送参数选项到ArkTS");
+/**
+ * 将提取的参数可选值推送给ArkTS（在ArkTS线程中转换为NAPI对象）
+ */
+void PushParamOptionsToArkTS(const std::unordered_map<std::string, std::vector<std::string>>& options) {
+    std::lock_guard<std::mutex> lock(g_paramOptionsMutex);
+    if (g_paramOptionsTsfn == nullptr) {
+        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "未注册参数选项回调，跳过推送");
+        return;
+    }
 
-    // 通过回调推送给ArkTS（需确保回调能处理对象类型）
-    g_paramCallback(resultObj);
+    auto* data = new std::unordered_map<std::string, std::vector<std::string>>(options);
+    if (napi_call_threadsafe_function(g_paramOptionsTsfn, data, napi_tsfn_nonblocking) != napi_ok) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "参数选项推送失败");
+        delete data;
+        return;
+    }
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "已推送%{public}zu个参数的可选值到ArkTS", options.size());
 }
 
 
@@ -311,32 +284,75 @@ bool GetAllConfigItems(std::vector<ConfigItem>& items) {
         return false;
     }
 
-    // 2. 获取配置树根节点（核心资源）
-    CameraWidget* root = nullptr;
-    int ret = gp_camera_get_config(g_camera, &root, g_context);
-    if (ret != GP_OK ||!root) {
-        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "获取配置树失败：%s{public}", gp_result_as_string(ret));
+    // 2. 取配置树快照（缓存有效时不再访问相机）
+    std::shared_ptr<ConfigSnapshot> snapshot = ConfigSnapshotCache::getInstance().acquire();
+    if (!snapshot) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "获取配置树失败");
         return false;
     }
 
     // 3. 遍历配置树
-    TraverseConfigTree(root, items, "");
+    TraverseConfigTree(snapshot->getRoot(), items, "");
 
     // 确认配置树已填充
     if (items.empty()) {
         OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "配置树遍历后仍为空，可能存在问题");
-        gp_widget_free(root);
         return false;
     }
 
-    
+    // 4. 发布实时配置项，并用实时结构校验持久化的配置结构缓存
+    PublishConfigItems(items);
+    ConfigSchemaCache::getInstance().update(items);
 
-    // 4. 释放资源（确保无论成败都释放）
-    gp_widget_free(root);
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "配置树获取完成，共%{public}d个参数", (int)items.size());
     return true;
 }
 
+void RevalidateConfigSchema() {
+    ConfigSchemaCache& schema = ConfigSchemaCache::getInstance();
+    if (!schema.needsRevalidation()) {
+        return;
+    }
+    std::shared_ptr<ConfigSnapshot> snapshot = ConfigSnapshotCache::getInstance().peek();
+    if (!snapshot) {
+        return;
+    }
+    std::vector<ConfigItem> items;
+    TraverseConfigTree(snapshot->getRoot(), items, "");
+    if (items.empty()) {
+        return;
+    }
+    PublishConfigItems(items);
+    schema.update(items);
+}
+
+ConfigItemSet::ConfigItemSet(std::vector<ConfigItem> list) : items(std::move(list)) {
+    indexByName.reserve(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        // 同名配置项保留第一个（与按顺序查找的结果一致）
+        indexByName.emplace(items[i].name, i);
+    }
+}
+
+const ConfigItem* ConfigItemSet::find(const std::string& name) const {
+    auto it = indexByName.find(name);
+    return it == indexByName.end() ? nullptr : &items[it->second];
+}
+
+std::shared_ptr<const ConfigItemSet> GetConfigItems() {
+    return std::atomic_load(&g_configItems);
+}
+
+void PublishConfigItems(std::vector<ConfigItem> items) {
+    // 在锁外构造好整个集合，替换只是一次指针交换
+    std::shared_ptr<const ConfigItemSet> configItems = std::make_shared<const ConfigItemSet>(std::move(items));
+    std::atomic_store(&g_configItems, configItems);
+}
+
+void ClearConfigItems() {
+    std::atomic_store(&g_configItems, std::shared_ptr<const ConfigItemSet>());
+}
+
 
 
 /**
@@ -387,70 +403,14 @@ napi_value GetCameraConfig(napi_env env, napi_callback_info info) {
 
 
 
-// ###########################################################################
-// 新增：工具函数 - 递归查找配置树中的目标节点
-// ###########################################################################
 /**
- * @brief 递归遍历CameraWidget树，根据节点名查找目标Widget
- * @param root 配置树根节点
- * @param targetName 目标节点名（如"batterylevel"）
- * @param outWidget 输出参数：找到的目标节点（未找到则为nullptr）
+ * @brief 按当前厂商解码枚举类属性，写入中文标签；无法识别时保留原始值
  */
-static void RecursiveFindWidget(CameraWidget *root, const char *targetName, CameraWidget **outWidget,
-                                const char *parentPath) {
-    // 终止条件：当前节点为空，或已找到目标节点，直接返回
-    if (!root || *outWidget)
-        return;
-
-    const char *currentName = nullptr;
-    gp_widget_get_name(root, &currentName);
-    // 拼接当前节点的完整路径（父路径 + 当前节点名），方便日志定位
-    char currentPath[256] = {0};
-    snprintf(currentPath, sizeof(currentPath) - 1, "%s/%s", parentPath, currentName ? currentName : "null");
-
-    // 1. 打印当前节点信息（原逻辑保留）
-    CameraWidgetType type;
-    gp_widget_get_type(root, &type);
-    const char *valueStr = "N/A";
-    if (type == GP_WIDGET_TEXT) {
-        const char *val;
-        if (gp_widget_get_value(root, &val) == GP_OK)
-            valueStr = val;
-    } else if (type == GP_WIDGET_RADIO || type == GP_WIDGET_MENU) {
-        const char *val;
-        if (gp_widget_get_value(root, &val) == GP_OK)
-            valueStr = val;
-    } else if (type == GP_WIDGET_TOGGLE) {
-        int val;
-        if (gp_widget_get_value(root, &val) == GP_OK) {
-            static char buf[32];
-            snprintf(buf, sizeof(buf), "%d", val);
-            valueStr = buf;
-        }
-    }
-    /*OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG,
-                 "节点路径：%{public}s，名称：%{public}s，类型：%{public}d，值：%{public}s", currentPath, currentName,
-                 type, valueStr);*/
-
-    // 2. 关键补充：检查当前节点是否为目标节点（原逻辑可能缺失，需补充）
-    if (currentName && strcmp(currentName, targetName) == 0) {
-        *outWidget = root; // 找到目标节点，赋值给输出参数
-        return;            // 找到后直接返回，无需继续遍历
-    }
-
-    // 3. 关键补充：遍历当前节点的所有子节点（递归核心）
-    int childCount = gp_widget_count_children(root); // 获取子节点数量
-    for (int i = 0; i < childCount; i++) {           // 循环遍历每个子节点
-        CameraWidget *child = nullptr;
-        gp_widget_get_child(root, i, &child); // 获取第i个子节点
-        // 递归调用自身，处理子节点（父路径传入当前节点的完整路径）
-        RecursiveFindWidget(child, targetName, outWidget, currentPath);
-        if (*outWidget)
-            return; // 若子节点中已找到目标，直接返回
-    }
+static void CopyDecodedValue(char* dst, size_t size, StatusProperty property, const char* raw) {
+    const char* label = StatusValueLabel(DecodeStatusValue(property, raw));
+    strncpy(dst, label ? label : raw, size - 1);
 }
 
-
 /**
  * @brief 内部函数：获取相机所有状态和可调节参数
  * @return CameraInfo 存储所有信息的结构体
@@ -466,11 +426,10 @@ CameraInfo InternalGetCameraInfo() {
         return info;
     }
 
-    // 2. 获取配置树根节点（仅一次，后续所有参数查找基于此根节点）
-    CameraWidget *root = nullptr;
-    int ret = gp_camera_get_config(g_camera, &root, g_context);
-    if (ret != GP_OK || !root) {
-        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "获取配置树失败，错误码：%{public}d", ret);
+    // 2. 取配置树快照（一次取树，后续所有参数查找都是哈希查找）
+    std::shared_ptr<ConfigSnapshot> snapshot = ConfigSnapshotCache::getInstance().acquire();
+    if (!snapshot) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "获取配置树失败");
         return info;
     }
 
@@ -478,16 +437,15 @@ CameraInfo InternalGetCameraInfo() {
     // 工具函数：查找参数节点（文字节点优先，失败试数字节点）
     // ------------------------------
     auto FindParamWidget = [&](const std::string& textNodeName) -> CameraWidget* {
-        CameraWidget* widget = nullptr;
         // 1. 先查文字节点（如"f-number"）
-        RecursiveFindWidget(root, textNodeName.c_str(), &widget, "");
+        CameraWidget* widget = snapshot->find(textNodeName);
         if (widget) return widget;
 
         // 2. 文字节点查不到，试数字节点（如"5007"）
         auto it = COMMON_PARAM_NODE_MAP.find(textNodeName);
         if (it != COMMON_PARAM_NODE_MAP.end()) {
             const std::string& numNodeName = it->second;
-            RecursiveFindWidget(root, numNodeName.c_str(), &widget, "");
+            widget = snapshot->find(numNodeName);
             if (widget) {
                 OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "文字节点%{public}s未找到，使用数字节点%{public}s", 
                     textNodeName.c_str(), numNodeName.c_str());
@@ -529,12 +487,14 @@ CameraInfo InternalGetCameraInfo() {
         if (type == GP_WIDGET_RADIO || type == GP_WIDGET_MENU) {
             const char* apertureStr = nullptr;
             if (gp_widget_get_value(targetWidget, &apertureStr) == GP_OK && apertureStr) {
-                // 文字节点：直接用"f/4"；数字节点：400→f/4
+                // 文字节点：直接用"f/4"；数字节点等其他格式（如"400"、"F4"）解析后按f值显示
+                Rational fNumber;
                 if (strstr(apertureStr, "f/") != nullptr) { // 文字节点值（如"f/4"）
                     strncpy(info.aperture, apertureStr, sizeof(info.aperture)-1);
-                } else { // 数字节点值（如"400"→f/4）
-                    int apertureVal = atoi(apertureStr);
-                    snprintf(info.aperture, sizeof(info.aperture)-1, "f/%.1f", apertureVal / 100.0f);
+                } else if (ParseAperture(apertureStr, fNumber)) {
+                    snprintf(info.aperture, sizeof(info.aperture)-1, "f/%g", fNumber.value());
+                } else {
+                    strncpy(info.aperture, apertureStr, sizeof(info.aperture)-1);
                 }
             }
         }
@@ -553,23 +513,13 @@ CameraInfo InternalGetCameraInfo() {
                 if (strcmp(shutterStr, "Auto") == 0 || strcmp(shutterStr, "auto") == 0) {
                     strncpy(info.shutter, "Auto", sizeof(info.shutter)-1);
                 } else {
-                    // 解析原始值（如"0.0040s"→0.004秒→1/250s）
-                    char shutterValStr[32] = {0};
-                    if (strstr(shutterStr, "/") != nullptr) {
-                        strncpy(shutterValStr, shutterStr, strlen(shutterStr));
-                    } else {
-                        strncpy(shutterValStr, shutterStr, strlen(shutterStr)-1); // 去掉"s"
-                    }
-                    float shutterSec = atof(shutterValStr);
-                    if (shutterSec > 0) {
-                        // 匹配标准快门标签（如0.004→1/250s）
-                        int bestIdx = 0;
-                        float minDiff = fabsf(shutterSec - standardShutterSpeeds[0]);
-                        for (int i=1; i<numStandardShutters; i++) {
-                            float diff = fabsf(shutterSec - standardShutterSpeeds[i]);
-                            if (diff < minDiff) { minDiff = diff; bestIdx = i; }
-                        }
-                        strncpy(info.shutter, standardShutterLabels[bestIdx], sizeof(info.shutter)-1);
+                    // 解析原始值并对齐到1/3档（如"0.0040s"→1/250秒→1/250s）
+                    Rational seconds;
+                    Rational stop;
+                    char label[16] = {0};
+                    if (ParseShutterSpeed(shutterStr, seconds) &&
+                        NearestStop(ExposureKind::Shutter, seconds, StopStep::Third, stop, label, sizeof(label))) {
+                        snprintf(info.shutter, sizeof(info.shutter)-1, "%ss", label);
                     } else {
                         strncpy(info.shutter, "未知", sizeof(info.shutter)-1);
                     }
@@ -605,11 +555,12 @@ CameraInfo InternalGetCameraInfo() {
             const char* ecStr = nullptr;
             if (gp_widget_get_value(targetWidget, &ecStr) == GP_OK && ecStr) {
                 // 文字节点：如"0.333"→0.3档；数字节点：333→0.3档
-                float ecVal = atof(ecStr);
-                if (ecVal > 100 || ecVal < -100) { // 数字节点（千倍映射：333→0.333）
-                    ecVal /= 1000.0f;
+                Rational ev;
+                if (ParseCompensation(ecStr, ev)) {
+                    snprintf(info.exposureComp, sizeof(info.exposureComp)-1, "%.1f 档", ev.value());
+                } else {
+                    strncpy(info.exposureComp, "未知", sizeof(info.exposureComp)-1);
                 }
-                snprintf(info.exposureComp, sizeof(info.exposureComp)-1, "%.1f 档", ecVal);
             }
         }
     } else {
@@ -624,19 +575,7 @@ CameraInfo InternalGetCameraInfo() {
         if (type == GP_WIDGET_RADIO || type == GP_WIDGET_MENU) {
             const char* focusStr = nullptr;
             if (gp_widget_get_value(targetWidget, &focusStr) == GP_OK && focusStr) {
-                // 映射数字节点值→中文（如32785→AF-C）
-                std::map<std::string, std::string> focusMap = {
-                    {"1", "手动对焦（MF）"}, {"32784", "单次自动对焦（AF-S）"},
-                    {"32785", "连续自动对焦（AF-C）"}, {"32787", "自动自动对焦（AF-F）"},
-                    {"AF-S", "单次自动对焦（AF-S）"}, {"AF-C", "连续自动对焦（AF-C）"},
-                    {"AF-F", "自动自动对焦（AF-F）"}, {"Manual", "手动对焦（MF）"}
-                };
-                auto it = focusMap.find(focusStr);
-                if (it != focusMap.end()) {
-                    strncpy(info.focusMode, it->second.c_str(), sizeof(info.focusMode)-1);
-                } else {
-                    strncpy(info.focusMode, focusStr, sizeof(info.focusMode)-1);
-                }
+                CopyDecodedValue(info.focusMode, sizeof(info.focusMode), StatusProperty::FocusMode, focusStr);
             }
         }
     } else {
@@ -651,18 +590,8 @@ CameraInfo InternalGetCameraInfo() {
         if (type == GP_WIDGET_RADIO || type == GP_WIDGET_MENU) {
             const char* expProgStr = nullptr;
             if (gp_widget_get_value(targetWidget, &expProgStr) == GP_OK && expProgStr) {
-                std::map<std::string, std::string> expProgMap = {
-                    {"1", "M（手动）"}, {"2", "P（程序自动）"}, {"3", "A（光圈优先）"},
-                    {"4", "S（快门优先）"}, {"32784", "AUTO（自动）"},
-                    {"M", "M（手动）"}, {"P", "P（程序自动）"}, {"A", "A（光圈优先）"},
-                    {"S", "S（快门优先）"}, {"Auto", "AUTO（自动）"}
-                };
-                auto it = expProgMap.find(expProgStr);
-                if (it != expProgMap.end()) {
-                    strncpy(info.exposureProgram, it->second.c_str(), sizeof(info.exposureProgram)-1);
-                } else {
-                    strncpy(info.exposureProgram, expProgStr, sizeof(info.exposureProgram)-1);
-                }
+                CopyDecodedValue(info.exposureProgram, sizeof(info.exposureProgram),
+                                 StatusProperty::ExposureProgram, expProgStr);
             }
         }
     } else {
@@ -677,18 +606,8 @@ CameraInfo InternalGetCameraInfo() {
         if (type == GP_WIDGET_RADIO || type == GP_WIDGET_MENU) {
             const char* meterStr = nullptr;
             if (gp_widget_get_value(targetWidget, &meterStr) == GP_OK && meterStr) {
-                std::map<std::string, std::string> meterMap = {
-                    {"2", "中央重点测光"}, {"3", "多点测光"}, {"4", "点测光"},
-                    {"32784", "矩阵测光（Unknown 8010）"}, {"8010", "矩阵测光"},
-                    {"Center Weighted", "中央重点测光"}, {"Multi Spot", "多点测光"},
-                    {"Center Spot", "点测光"}, {"Unknown value 8010", "矩阵测光"}
-                };
-                auto it = meterMap.find(meterStr);
-                if (it != meterMap.end()) {
-                    strncpy(info.exposureMeterMode, it->second.c_str(), sizeof(info.exposureMeterMode)-1);
-                } else {
-                    strncpy(info.exposureMeterMode, meterStr, sizeof(info.exposureMeterMode)-1);
-                }
+                CopyDecodedValue(info.exposureMeterMode, sizeof(info.exposureMeterMode),
+                                 StatusProperty::MeteringMode, meterStr);
             }
         }
     } else {
@@ -703,20 +622,7 @@ CameraInfo InternalGetCameraInfo() {
         if (type == GP_WIDGET_RADIO || type == GP_WIDGET_MENU) {
             const char* wbStr = nullptr;
             if (gp_widget_get_value(targetWidget, &wbStr) == GP_OK && wbStr) {
-                std::map<std::string, std::string> wbMap = {
-                    {"2", "自动（Automatic）"}, {"4", "阴天（Cloudy）"}, {"5", "日光（Daylight）"},
-                    {"6", "钨丝灯（Tungsten）"}, {"7", "闪光灯（Flash）"},
-                    {"32784", "色温（Color Temperature）"}, {"32785", "预设（Preset）"},
-                    {"32786", "阴影（Shade）"}, {"32787", "荧光灯（Fluorescent）"},
-                    {"Automatic", "自动"}, {"Daylight", "日光"}, {"Cloudy", "阴天"},
-                    {"Tungsten", "钨丝灯"}, {"Flash", "闪光灯"}
-                };
-                auto it = wbMap.find(wbStr);
-                if (it != wbMap.end()) {
-                    strncpy(info.whiteBalance, it->second.c_str(), sizeof(info.whiteBalance)-1);
-                } else {
-                    strncpy(info.whiteBalance, wbStr, sizeof(info.whiteBalance)-1);
-                }
+                CopyDecodedValue(info.whiteBalance, sizeof(info.whiteBalance), StatusProperty::WhiteBalance, wbStr);
             }
         }
     } else {
@@ -731,18 +637,7 @@ CameraInfo InternalGetCameraInfo() {
         if (type == GP_WIDGET_RADIO || type == GP_WIDGET_MENU) {
             const char* modeStr = nullptr;
             if (gp_widget_get_value(targetWidget, &modeStr) == GP_OK && modeStr) {
-                std::map<std::string, std::string> modeMap = {
-                    {"1", "单拍（Single Shot）"}, {"2", "连拍（Burst）"},
-                    {"32784", "低速连拍（Continuous Low Speed）"}, {"32785", "定时（Timer）"},
-                    {"Single Shot", "单拍"}, {"Burst", "连拍"}, {"Continuous Low Speed", "低速连拍"},
-                    {"Timer", "定时"}
-                };
-                auto it = modeMap.find(modeStr);
-                if (it != modeMap.end()) {
-                    strncpy(info.captureMode, it->second.c_str(), sizeof(info.captureMode)-1);
-                } else {
-                    strncpy(info.captureMode, modeStr, sizeof(info.captureMode)-1);
-                }
+                CopyDecodedValue(info.captureMode, sizeof(info.captureMode), StatusProperty::DriveMode, modeStr);
             }
         }
     } else {
@@ -785,8 +680,7 @@ CameraInfo InternalGetCameraInfo() {
         }
     }
 
-    // 4. 资源释放+状态标记
-    gp_widget_free(root);
+    // 4. 状态标记（配置树由快照持有，这里不释放）
     info.isSuccess = true;
     return info;
 }
@@ -830,18 +724,39 @@ napi_value GetParamOptions(napi_env env, napi_callback_info info) {
     napi_value resultArray;
     napi_create_array(env, &resultArray);
 
-    // 遍历g_allConfigItems，找到指定参数的可选值
-    for (const auto& item : g_allConfigItems) {
-        if (item.name == paramName) {
-            for (size_t i=0; i<item.choices.size(); ++i) {
-                napi_set_element(env, resultArray, i, CreateNapiString(env, item.choices[i].c_str()));
-            }
-            break;
+    // 从已发布的配置项取（连接时已发布持久化的配置结构，不访问相机）
+    std::shared_ptr<const ConfigItemSet> configItems = GetConfigItems();
+    if (!configItems && g_connected) {
+        // 该型号还没有配置结构缓存：取一次配置树（同时发布并写入缓存）
+        std::vector<ConfigItem> items;
+        GetAllConfigItems(items);
+        configItems = GetConfigItems();
+    }
+    const ConfigItem* item = configItems ? configItems->find(paramName) : nullptr;
+    if (item) {
+        for (size_t i = 0; i < item->choices.size(); ++i) {
+            napi_set_element(env, resultArray, i, CreateNapiString(env, item->choices[i].c_str()));
         }
     }
     return resultArray;
 }
 
+napi_value SetConfigCacheDir(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    bool success = false;
+    if (argc >= 1) {
+        char dir[1024] = {0};
+        napi_get_value_string_utf8(env, args[0], dir, sizeof(dir), nullptr);
+        success = SetConfigSchemaDir(dir);
+    }
+    napi_value result;
+    napi_get_boolean(env, success, &result);
+    return result;
+}
+
 
 
 
@@ -893,6 +808,91 @@ napi_value GetCameraStatus(napi_env env, napi_callback_info info) {
 }
 
 
+// ###########################################################################
+// NAPI接口：相机状态监视（只推送变化的字段），经线程安全函数回到ArkTS线程
+// ###########################################################################
+static napi_threadsafe_function g_statusTsfn = nullptr;
+
+/**
+ * @brief 在ArkTS线程中把变化的字段转换为JS对象（只含变化的属性）并调用回调
+ */
+static void CallStatusCallbackJs(napi_env env, napi_value jsCallback, void* context, void* data) {
+    std::vector<StatusField>* changed = static_cast<std::vector<StatusField>*>(data);
+    if (env != nullptr && jsCallback != nullptr) {
+        napi_value statusObj;
+        napi_create_object(env, &statusObj);
+        for (const auto& field : *changed) {
+            napi_value value;
+            if (field.numeric) {
+                napi_create_int64(env, field.number, &value);
+            } else {
+                value = CreateNapiString(env, field.text.c_str());
+            }
+            napi_set_named_property(env, statusObj, field.key.c_str(), value);
+        }
+
+        napi_value global;
+        napi_get_global(env, &global);
+        napi_call_function(env, global, jsCallback, 1, &statusObj, nullptr);
+    }
+    delete changed;
+}
+
+void CleanupStatusMonitor() {
+    StatusMonitor::getInstance().stop();
+    if (g_statusTsfn) {
+        napi_release_threadsafe_function(g_statusTsfn, napi_tsfn_release);
+        g_statusTsfn = nullptr;
+    }
+}
+
+napi_value StartStatusMonitor(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    napi_value result;
+    if (argc < 1) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "StartStatusMonitor 参数错误：需要callback");
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+
+    // 重新启动时先停掉旧监视
+    CleanupStatusMonitor();
+
+    napi_value workName;
+    napi_create_string_utf8(env, "CameraStatusChanged", NAPI_AUTO_LENGTH, &workName);
+    napi_status status = napi_create_threadsafe_function(env, args[0], nullptr, workName, 0, 1, nullptr, nullptr,
+                                                         nullptr, CallStatusCallbackJs, &g_statusTsfn);
+    if (status != napi_ok) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "创建线程安全回调失败: %{public}d", status);
+        napi_get_boolean(env, false, &result);
+        return result;
+    }
+
+    napi_threadsafe_function tsfn = g_statusTsfn;
+    bool success = StatusMonitor::getInstance().start([tsfn](const std::vector<StatusField>& changed) {
+        napi_call_threadsafe_function(tsfn, new std::vector<StatusField>(changed), napi_tsfn_nonblocking);
+    });
+    if (!success) {
+        napi_release_threadsafe_function(g_statusTsfn, napi_tsfn_release);
+        g_statusTsfn = nullptr;
+    }
+
+    napi_get_boolean(env, success, &result);
+    return result;
+}
+
+napi_value StopStatusMonitor(napi_env env, napi_callback_info info) {
+    CleanupStatusMonitor();
+
+    napi_value result;
+    napi_get_undefined(env, &result);
+    return result;
+}
+
+
 
 
 
@@ -940,33 +940,11 @@ static bool SetConfig(const char *key, const char *value) {
     if (!g_connected)
         return false;
 
-    CameraWidget *root = nullptr;
-    if (gp_camera_get_config(g_camera, &root, g_context) != GP_OK) {
-        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "获取配置树失败");
-        return false;
-    }
-
-    CameraWidget *child = nullptr;
-    int ret = gp_widget_get_child_by_name(root, key, &child);
+    // 单项写入（一次PTP属性事务），camlib不支持时自动回退整树
+    int ret = WriteSingleConfig(key, value);
     if (ret != GP_OK) {
-        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "未找到参数: %{public}s", key);
-        gp_widget_free(root);
-        return false;
-    }
-
-    // 设置参数值（自动适配类型：选项/文本/开关等）
-    ret = gp_widget_set_value(child, value);
-    if (ret != GP_OK) {
-        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "设置参数值失败: %{public}s", gp_result_as_string(ret));
-        gp_widget_free(root);
-        return false;
-    }
-
-    // 应用配置到相机
-    ret = gp_camera_set_config(g_camera, root, g_context);
-    gp_widget_free(root);
-    if (ret != GP_OK) {
-        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "应用配置失败: %{public}s", gp_result_as_string(ret));
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "设置参数%{public}s失败: %{public}s", key,
+                     gp_result_as_string(ret));
         return false;
     }
 
@@ -1008,8 +986,151 @@ napi_value SetCameraParameter(napi_env env, napi_callback_info info) {
 }
 
 
+// ###########################################################################
+// NAPI接口：批量设置相机参数（一次异步调用，按项返回结果）
+// ###########################################################################
 
+/**
+ * @brief 批量设置的异步任务数据
+ */
+struct SetParamsTaskData {
+    std::vector<ConfigWrite> writes;
+    std::vector<std::string> reasons;   // 与writes一一对应，校验失败原因
+    bool rejected = false;              // 校验未通过，整批不下发
+    std::string errorMsg;
+    napi_ref callback = nullptr;
+};
 
+/**
+ * @brief ArkTS层传入{参数名: 值}，整批写入相机后回调每一项的结果
+ * @details 先按缓存的可选值校验，任一项不合法时整批不下发，避免相机停在一半的状态；
+ *          写入时整批只持一次相机I/O锁，不支持单项接口的参数合并为一次整树提交。
+ * @param info NAPI回调信息（2个参数：params、callback(err, results)）
+ */
+napi_value SetCameraParameters(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    napi_value undefined;
+    napi_get_undefined(env, &undefined);
+    if (argc < 2) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "SetCameraParameters 参数错误");
+        return undefined;
+    }
+    // 回调在完成函数里才调用，类型不对时那里已无法报错给调用方
+    napi_valuetype callbackType = napi_undefined;
+    napi_typeof(env, args[1], &callbackType);
+    if (callbackType != napi_function) {
+        napi_throw_type_error(env, nullptr, "SetCameraParameters 第2个参数必须是回调函数");
+        return undefined;
+    }
+
+    SetParamsTaskData* taskData = new SetParamsTaskData();
+    napi_value names;
+    uint32_t count = 0;
+    if (napi_get_property_names(env, args[0], &names) == napi_ok) {
+        napi_get_array_length(env, names, &count);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        napi_value keyValue;
+        napi_value itemValue;
+        napi_get_element(env, names, i, &keyValue);
+        napi_get_property(env, args[0], keyValue, &itemValue);
+
+        char key[128] = {0};
+        char value[128] = {0};
+        napi_get_value_string_utf8(env, keyValue, key, sizeof(key) - 1, nullptr);
+        napi_value valueString;
+        napi_coerce_to_string(env, itemValue, &valueString);
+        napi_get_value_string_utf8(env, valueString, value, sizeof(value) - 1, nullptr);
+
+        ConfigWrite write;
+        write.name = key;
+        write.value = value;
+        std::string reason;
+        if (!ValidateConfigValue(write.name, write.value, reason)) {
+            write.result = GP_ERROR_BAD_PARAMETERS;
+            taskData->rejected = true;
+            OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "参数%{public}s取值%{public}s不合法：%{public}s",
+                         key, value, reason.c_str());
+        }
+        taskData->writes.push_back(write);
+        taskData->reasons.push_back(reason);
+    }
+    napi_create_reference(env, args[1], 1, &taskData->callback);
+
+    OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "SetCameraParameters: %{public}zu 项，校验%{public}s",
+                 taskData->writes.size(), taskData->rejected ? "未通过" : "通过");
+
+    napi_value workName;
+    napi_create_string_utf8(env, "SetCameraParameters", NAPI_AUTO_LENGTH, &workName);
+    napi_async_work work;
+
+    // 工作函数（在后台线程执行）
+    auto executeWork = [](napi_env env, void* data) {
+        SetParamsTaskData* taskData = static_cast<SetParamsTaskData*>(data);
+        if (taskData->rejected || taskData->writes.empty()) {
+            return;
+        }
+        if (!g_connected) {
+            taskData->errorMsg = "相机未连接";
+            return;
+        }
+        WriteConfigBatch(taskData->writes);
+    };
+
+    // 完成函数（在主线程执行）
+    auto completeWork = [](napi_env env, napi_status status, void* data) {
+        SetParamsTaskData* taskData = static_cast<SetParamsTaskData*>(data);
+
+        napi_value callback;
+        napi_get_reference_value(env, taskData->callback, &callback);
+
+        napi_value args[2];
+        if (taskData->errorMsg.empty()) {
+            napi_get_null(env, &args[0]);
+            napi_create_array(env, &args[1]);
+            for (size_t i = 0; i < taskData->writes.size(); i++) {
+                const ConfigWrite& write = taskData->writes[i];
+                bool validated = taskData->reasons[i].empty();
+                bool success = !taskData->rejected && write.result == GP_OK;
+
+                napi_value resultObj;
+                napi_value field;
+                napi_create_object(env, &resultObj);
+                napi_create_string_utf8(env, write.name.c_str(), NAPI_AUTO_LENGTH, &field);
+                napi_set_named_property(env, resultObj, "name", field);
+                napi_create_string_utf8(env, write.value.c_str(), NAPI_AUTO_LENGTH, &field);
+                napi_set_named_property(env, resultObj, "value", field);
+                napi_get_boolean(env, success, &field);
+                napi_set_named_property(env, resultObj, "success", field);
+                if (!success) {
+                    // 校验失败给出原因；因其他项校验失败而未下发的标记为skipped
+                    const char* error = !validated ? taskData->reasons[i].c_str()
+                                        : taskData->rejected ? "skipped" : gp_result_as_string(write.result);
+                    napi_create_string_utf8(env, error, NAPI_AUTO_LENGTH, &field);
+                    napi_set_named_property(env, resultObj, "error", field);
+                }
+                napi_set_element(env, args[1], i, resultObj);
+            }
+        } else {
+            napi_create_string_utf8(env, taskData->errorMsg.c_str(), NAPI_AUTO_LENGTH, &args[0]);
+            napi_get_null(env, &args[1]);
+        }
+
+        napi_value global;
+        napi_get_global(env, &global);
+        napi_make_callback(env, nullptr, global, callback, 2, args, nullptr);
+
+        napi_delete_reference(env, taskData->callback);
+        delete taskData;
+    };
+
+    napi_create_async_work(env, nullptr, workName, executeWork, completeWork, taskData, &work);
+    napi_queue_async_work(env, work);
+    return undefined;
+}
 
 
 
@@ -1017,54 +1138,377 @@ napi_value SetCameraParameter(napi_env env, napi_callback_info info) {
 
 
 
-// 静态函数，符合ParamCallback的类型
-static void StaticParamCallback(napi_value params) {
-    // 从全局状态中获取env和callbackRef
-    napi_env env = g_callbackState.env;
-    napi_ref callbackRef = g_callbackState.callbackRef;
 
-    if (env == nullptr || callbackRef == nullptr) {
-        OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "回调状态无效，env或callbackRef为空");
-        return; // 状态无效，直接返回
+
+
+
+// ###########################################################################
+// NAPI接口：排队写入参数（滑块拖动时按参数只保留最新值），确认经线程安全函数回到ArkTS线程
+// ###########################################################################
+static napi_threadsafe_function g_paramAckTsfn = nullptr;
+
+/**
+ * @brief 在ArkTS线程中把ConfigWriteAck转换为JS对象并调用回调
+ */
+static void CallParamAckCallbackJs(napi_env env, napi_value jsCallback, void* context, void* data) {
+    ConfigWriteAck* ack = static_cast<ConfigWriteAck*>(data);
+    if (env != nullptr && jsCallback != nullptr) {
+        napi_value ackObj;
+        napi_value field;
+        napi_create_object(env, &ackObj);
+        napi_set_named_property(env, ackObj, "name", CreateNapiString(env, ack->name.c_str()));
+        napi_set_named_property(env, ackObj, "requested", CreateNapiString(env, ack->requested.c_str()));
+        napi_set_named_property(env, ackObj, "applied", CreateNapiString(env, ack->applied.c_str()));
+        napi_get_boolean(env, ack->success, &field);
+        napi_set_named_property(env, ackObj, "success", field);
+        napi_set_named_property(env, ackObj, "error", CreateNapiString(env, ack->error.c_str()));
+        napi_create_int32(env, ack->coalesced, &field);
+        napi_set_named_property(env, ackObj, "coalesced", field);
+        napi_create_int64(env, ack->latencyMs, &field);
+        napi_set_named_property(env, ackObj, "latencyMs", field);
+
+        napi_value global;
+        napi_get_global(env, &global);
+        napi_call_function(env, global, jsCallback, 1, &ackObj, nullptr);
+    }
+    delete ack;
+}
+
+void StartConfigWriteQueue() {
+    ConfigWriteQueue::getInstance().start();
+}
+
+void CleanupConfigWriteQueue() {
+    ConfigWriteQueue::getInstance().stop();
+}
+
+napi_value QueueCameraParameter(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    napi_value result;
+    if (argc < 2) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "QueueCameraParameter 参数错误：需要key、value");
+        napi_get_boolean(env, false, &result);
+        return result;
     }
-    
-    
 
-    // 调用ArkTS层的回调函数（与之前lambda中的逻辑一致）
-    napi_value callback;
-    napi_get_reference_value(env, callbackRef, &callback);
+    char key[128] = {0};
+    char value[128] = {0};
+    napi_get_value_string_utf8(env, args[0], key, sizeof(key) - 1, nullptr);
+    napi_get_value_string_utf8(env, args[1], value, sizeof(value) - 1, nullptr);
 
-    napi_value global;
-    napi_get_global(env, &global);
+    bool queued = ConfigWriteQueue::getInstance().enqueue(key, value);
+    napi_get_boolean(env, queued, &result);
+    return result;
+}
+
+napi_value RegisterParamAckCallback(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
 
     napi_value result;
-    napi_call_function(env, global, callback, 1, &params, &result);
+    napi_get_undefined(env, &result);
+
+    // 重复注册时先释放旧回调
+    ConfigWriteQueue::getInstance().setAckCallback(nullptr);
+    if (g_paramAckTsfn) {
+        napi_release_threadsafe_function(g_paramAckTsfn, napi_tsfn_release);
+        g_paramAckTsfn = nullptr;
+    }
+
+    napi_valuetype type = napi_undefined;
+    if (argc >= 1) {
+        napi_typeof(env, args[0], &type);
+    }
+    if (type != napi_function) {
+        return result;
+    }
+
+    napi_value workName;
+    napi_create_string_utf8(env, "ParamWriteAck", NAPI_AUTO_LENGTH, &workName);
+    napi_status status = napi_create_threadsafe_function(env, args[0], nullptr, workName, 0, 1, nullptr, nullptr,
+                                                         nullptr, CallParamAckCallbackJs, &g_paramAckTsfn);
+    if (status != napi_ok) {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "创建线程安全回调失败: %{public}d", status);
+        g_paramAckTsfn = nullptr;
+        return result;
+    }
+
+    napi_threadsafe_function tsfn = g_paramAckTsfn;
+    ConfigWriteQueue::getInstance().setAckCallback([tsfn](const ConfigWriteAck& ack) {
+        napi_call_threadsafe_function(tsfn, new ConfigWriteAck(ack), napi_tsfn_nonblocking);
+    });
+    return result;
 }
 
 
 
 
 
-// 实现注册回调：保存ArkTS层传递的回调函数
+// 实现注册回调：保存ArkTS层传递的回调函数（后台线程经线程安全函数投递到ArkTS线程）
 napi_value RegisterParamCallback(napi_env env, napi_callback_info info) {
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "进入RegisterParamCallback函数");
     size_t argc = 1;
     napi_value args[1];
     napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
-    
-    
 
-    // 创建ArkTS回调的引用（与之前一致）
-    napi_ref callbackRef;
-    napi_create_reference(env, args[0], 1, &callbackRef);
+    {
+        std::lock_guard<std::mutex> lock(g_paramOptionsMutex);
+        // 重复注册时先释放旧回调
+        if (g_paramOptionsTsfn) {
+            napi_release_threadsafe_function(g_paramOptionsTsfn, napi_tsfn_release);
+            g_paramOptionsTsfn = nullptr;
+        }
 
-    // 保存状态到全局结构体
-    g_callbackState.env = env;
-    g_callbackState.callbackRef = callbackRef;
+        napi_valuetype type = napi_undefined;
+        if (argc >= 1) {
+            napi_typeof(env, args[0], &type);
+        }
+        if (type != napi_function) {
+            return nullptr;
+        }
+
+        napi_value workName;
+        napi_create_string_utf8(env, "ParamOptions", NAPI_AUTO_LENGTH, &workName);
+        napi_status status = napi_create_threadsafe_function(env, args[0], nullptr, workName, 0, 1, nullptr, nullptr,
+                                                             nullptr, CallParamOptionsJs, &g_paramOptionsTsfn);
+        if (status != napi_ok) {
+            OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "创建线程安全回调失败: %{public}d", status);
+            g_paramOptionsTsfn = nullptr;
+            return nullptr;
+        }
+    }
 
-    // 赋值静态函数（符合ParamCallback类型）
-    g_paramCallback = StaticParamCallback;
-    
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "回调注册成功");
+    // 连接时的预取可能早于注册完成，已有配置项时补推一次
+    if (GetConfigItems()) {
+        PushParamOptionsToArkTS(ExtractParamOptions(DEFAULT_PARAMS_TO_EXTRACT));
+    }
     return nullptr;
-}
\ No newline at end of file
+}
+
+
+
+
+// ###########################################################################
+// 曝光计算NAPI接口：解析、最近档位、等效曝光、包围曝光
+// ###########################################################################
+
+/**
+ * @brief 读取曝光参数种类（"shutter"、"aperture"、"ec"）
+ */
+static bool GetExposureKindArg(napi_env env, napi_value value, ExposureKind& kind) {
+    char text[16] = {0};
+    if (napi_get_value_string_utf8(env, value, text, sizeof(text) - 1, nullptr) != napi_ok) {
+        return false;
+    }
+    if (strcmp(text, "shutter") == 0) {
+        kind = ExposureKind::Shutter;
+    } else if (strcmp(text, "aperture") == 0) {
+        kind = ExposureKind::Aperture;
+    } else if (strcmp(text, "ec") == 0) {
+        kind = ExposureKind::Compensation;
+    } else {
+        OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_TAG, "未知的曝光参数种类：%{public}s", text);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 读取字符串数组（相机可选值列表）
+ */
+static std::vector<std::string> GetStringArrayArg(napi_env env, napi_value array) {
+    std::vector<std::string> result;
+    bool isArray = false;
+    if (napi_is_array(env, array, &isArray) != napi_ok || !isArray) {
+        return result;
+    }
+    uint32_t length = 0;
+    napi_get_array_length(env, array, &length);
+    result.reserve(length);
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element;
+        char text[128] = {0};
+        if (napi_get_element(env, array, i, &element) == napi_ok &&
+            napi_get_value_string_utf8(env, element, text, sizeof(text) - 1, nullptr) == napi_ok) {
+            result.emplace_back(text);
+        }
+    }
+    return result;
+}
+
+napi_value ParseExposureValue(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    napi_value result;
+    napi_get_null(env, &result);
+    ExposureKind kind;
+    if (argc < 2 || !GetExposureKindArg(env, args[0], kind)) {
+        return result;
+    }
+    char text[64] = {0};
+    napi_get_value_string_utf8(env, args[1], text, sizeof(text) - 1, nullptr);
+    Rational value;
+    if (!ParseExposure(kind, text, value)) {
+        return result;
+    }
+
+    napi_value field;
+    napi_create_object(env, &result);
+    napi_create_int64(env, value.num, &field);
+    napi_set_named_property(env, result, "num", field);
+    napi_create_int64(env, value.den, &field);
+    napi_set_named_property(env, result, "den", field);
+    napi_create_double(env, value.value(), &field);
+    napi_set_named_property(env, result, "value", field);
+    if (kind != ExposureKind::Compensation) {
+        napi_create_double(env, ExposureStops(kind, value), &field);
+        napi_set_named_property(env, result, "stops", field);
+    }
+    return result;
+}
+
+napi_value NearestExposureStop(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    ExposureKind kind;
+    if (argc < 2 || !GetExposureKindArg(env, args[0], kind)) {
+        return CreateNapiString(env, "");
+    }
+    char text[64] = {0};
+    napi_get_value_string_utf8(env, args[1], text, sizeof(text) - 1, nullptr);
+    int32_t stepsPerStop = 3;
+    if (argc >= 3) {
+        napi_get_value_int32(env, args[2], &stepsPerStop);
+    }
+
+    Rational value;
+    Rational stop;
+    char label[16] = {0};
+    StopStep step = stepsPerStop == 2 ? StopStep::Half : StopStep::Third;
+    if (!ParseExposure(kind, text, value) || !NearestStop(kind, value, step, stop, label, sizeof(label))) {
+        return CreateNapiString(env, "");
+    }
+    return CreateNapiString(env, label);
+}
+
+napi_value MatchExposureChoice(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    ExposureKind kind;
+    if (argc < 3 || !GetExposureKindArg(env, args[0], kind)) {
+        return CreateNapiString(env, "");
+    }
+    char text[64] = {0};
+    napi_get_value_string_utf8(env, args[1], text, sizeof(text) - 1, nullptr);
+    std::vector<std::string> choices = GetStringArrayArg(env, args[2]);
+
+    Rational value;
+    int index = ParseExposure(kind, text, value) ? NearestChoice(kind, value, choices) : -1;
+    return CreateNapiString(env, index >= 0 ? choices[index].c_str() : "");
+}
+
+napi_value GetEquivalentExposures(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    napi_value resultArray;
+    napi_create_array(env, &resultArray);
+    if (argc < 3) {
+        return resultArray;
+    }
+    char apertureText[64] = {0};
+    char shutterText[64] = {0};
+    napi_get_value_string_utf8(env, args[0], apertureText, sizeof(apertureText) - 1, nullptr);
+    napi_get_value_string_utf8(env, args[1], shutterText, sizeof(shutterText) - 1, nullptr);
+    Rational fNumber;
+    Rational seconds;
+    if (!ParseAperture(apertureText, fNumber) || !ParseShutterSpeed(shutterText, seconds)) {
+        return resultArray;
+    }
+
+    // 候选光圈保留相机的原始字符串，结果里原样返回，便于直接写回相机
+    std::vector<std::string> apertureChoices = GetStringArrayArg(env, args[2]);
+    std::vector<Rational> apertures;
+    std::vector<const std::string*> apertureLabels;
+    for (const auto& choice : apertureChoices) {
+        Rational aperture;
+        if (ParseAperture(choice.c_str(), aperture)) {
+            apertures.push_back(aperture);
+            apertureLabels.push_back(&choice);
+        }
+    }
+
+    std::vector<EquivalentExposure> exposures = EquivalentExposures(fNumber, seconds, apertures, StopStep::Third);
+    uint32_t index = 0;
+    for (const auto& exposure : exposures) {
+        napi_value obj;
+        napi_create_object(env, &obj);
+        napi_set_named_property(env, obj, "aperture",
+                                CreateNapiString(env, apertureLabels[exposure.apertureIndex]->c_str()));
+        napi_set_named_property(env, obj, "shutter", CreateNapiString(env, exposure.shutterLabel));
+        napi_set_element(env, resultArray, index++, obj);
+    }
+    return resultArray;
+}
+
+napi_value GetBracketingSet(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value args[4];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    napi_value resultArray;
+    napi_create_array(env, &resultArray);
+    if (argc < 3) {
+        return resultArray;
+    }
+    char centerText[64] = {0};
+    char stepText[64] = {0};
+    int32_t frames = 0;
+    napi_get_value_string_utf8(env, args[0], centerText, sizeof(centerText) - 1, nullptr);
+    napi_get_value_int32(env, args[1], &frames);
+    napi_get_value_string_utf8(env, args[2], stepText, sizeof(stepText) - 1, nullptr);
+    std::vector<std::string> choices = argc >= 4 ? GetStringArrayArg(env, args[3]) : std::vector<std::string>();
+
+    // 张数来自ArkTS，未检查的大数会在BracketingSet里分配巨大的数组
+    if (frames <= 0 || frames > MAX_BRACKETING_FRAMES) {
+        OH_LOG_Print(LOG_APP, LOG_WARN, LOG_DOMAIN, LOG_TAG, "包围曝光张数超出范围：%{public}d", frames);
+        frames = std::max(1, std::min(frames, MAX_BRACKETING_FRAMES));
+    }
+
+    Rational center;
+    Rational step;
+    if (!ParseCompensation(centerText, center) || !ParseCompensation(stepText, step) || step.num <= 0) {
+        return resultArray;
+    }
+
+    uint32_t index = 0;
+    for (const auto& ev : BracketingSet(center, frames, step)) {
+        if (choices.empty()) {
+            Rational stop;
+            char label[16] = {0};
+            NearestStop(ExposureKind::Compensation, ev, StopStep::Third, stop, label, sizeof(label));
+            napi_set_element(env, resultArray, index++, CreateNapiString(env, label));
+            continue;
+        }
+        // 映射到相机的可选值；超出相机补偿范围的档位不返回
+        int choice = NearestChoice(ExposureKind::Compensation, ev, choices);
+        Rational matched;
+        if (choice >= 0 && ParseCompensation(choices[choice].c_str(), matched) &&
+            std::fabs(matched.value() - ev.value()) < 1.0 / 6.0) {
+            napi_set_element(env, resultArray, index++, CreateNapiString(env, choices[choice].c_str()));
+        }
+    }
+    return resultArray;
+}
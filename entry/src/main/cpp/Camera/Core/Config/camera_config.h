@@ -8,6 +8,9 @@
 #define PHOTOSEND_CAMERA_CONFIG_H
 #include "../../Common/native_common.h"
 #include <napi/native_api.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -38,23 +41,42 @@ typedef struct {
 
 
 
-// 仅声明（不初始化）
-extern const float standardShutterSpeeds[];
-extern const char* standardShutterLabels[];
-extern const int numStandardShutters;
 
 
 // 在camera_config.h中添加
 extern const std::vector<std::string> DEFAULT_PARAMS_TO_EXTRACT;
 
-// 定义回调函数类型：接收napi_value类型的参数（推送的参数可选值对象）
-typedef void (*ParamCallback)(napi_value);  // 关键：补充类型定义
+/**
+ * @brief 已发布的配置项集合（只读）
+ * @details 配置项整体替换发布：写者构造新集合后原子地替换指针，读者取得shared_ptr后
+ *          无需加锁即可遍历或按名查找，旧集合在最后一个读者释放后销毁，读写互不阻塞。
+ */
+struct ConfigItemSet {
+    std::vector<ConfigItem> items;                         // 配置项（按配置树遍历顺序）
+    std::unordered_map<std::string, size_t> indexByName;   // 配置项名 → items下标
+
+    explicit ConfigItemSet(std::vector<ConfigItem> list);
+
+    /**
+     * @brief 按名查找配置项，不存在时返回nullptr
+     */
+    const ConfigItem* find(const std::string& name) const;
+};
 
-// 之后再声明全局回调指针
-extern ParamCallback g_paramCallback;
+/**
+ * @brief 取当前发布的配置项集合（未发布时为nullptr），任意线程可调用
+ */
+extern std::shared_ptr<const ConfigItemSet> GetConfigItems();
 
-//  声明储存所有配置信息的全局变量
-extern std::vector<ConfigItem> g_allConfigItems;
+/**
+ * @brief 发布新的配置项集合（实时配置树或持久化的配置结构），任意线程可调用
+ */
+extern void PublishConfigItems(std::vector<ConfigItem> items);
+
+/**
+ * @brief 清空已发布的配置项集合（断开连接时调用）
+ */
+extern void ClearConfigItems();
 
 /**
  * @brief 内部函数：获取相机所有状态和可调节参数
@@ -62,6 +84,12 @@ extern std::vector<ConfigItem> g_allConfigItems;
  */
 extern CameraInfo InternalGetCameraInfo();
 
+/**
+ * @brief 本次连接第一次有实时配置树快照时，用它校验持久化的配置结构缓存（状态监视刷新后调用）
+ * @details 只使用已缓存的快照，不为校验额外读取配置树
+ */
+extern void RevalidateConfigSchema();
+
 
 
 /**
@@ -72,6 +100,23 @@ extern CameraInfo InternalGetCameraInfo();
  */
 extern napi_value GetCameraStatus(napi_env env, napi_callback_info info);
 
+/**
+ * @brief 启动相机状态监视，ArkTS传入回调(changed)，changed只含变化的属性（属性名同GetCameraStatus）
+ * @details 启动后第一次回调包含全部属性；之后只在机身属性变化、写入参数或兜底刷新发现变化时回调
+ * @return napi_value 返回布尔值（相机未连接时为false）
+ */
+extern napi_value StartStatusMonitor(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 停止相机状态监视
+ */
+extern napi_value StopStatusMonitor(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 停止状态监视并释放回调（断开连接时调用）
+ */
+extern void CleanupStatusMonitor();
+
 
 /**
  * @brief ArkTS层调用此函数，传入参数名和值，设置相机配置
@@ -81,12 +126,44 @@ extern napi_value GetCameraStatus(napi_env env, napi_callback_info info);
  */
 extern napi_value SetCameraParameter(napi_env env, napi_callback_info info);
 
+/**
+ * @brief 批量设置相机参数（异步），ArkTS传入{参数名: 值}和回调(err, results)
+ * @details 任一项不在可选值中时整批不下发；results按项给出name/value/success/error
+ */
+extern napi_value SetCameraParameters(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 把参数写入排队（不阻塞），同一参数未写入的旧值被新值替换，适合滑块拖动
+ * @details ArkTS传入key、value，返回是否入队（相机未连接时为false）；写入结果通过RegisterParamAckCallback回调
+ */
+extern napi_value QueueCameraParameter(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 注册排队写入的确认回调，回调参数为{name, requested, applied, success, error, coalesced, latencyMs}
+ */
+extern napi_value RegisterParamAckCallback(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 允许排队写入（连接成功后调用）
+ */
+extern void StartConfigWriteQueue();
+
+/**
+ * @brief 停止排队写入，未写入的值以失败确认后丢弃（断开连接时调用，确认回调保留到下次连接）
+ */
+extern void CleanupConfigWriteQueue();
+
 
 
 
 
 extern napi_value GetParamOptions(napi_env env, napi_callback_info info);
 
+/**
+ * @brief 设置配置结构缓存的保存目录（应用文件目录），ArkTS传入dir，返回是否可用
+ */
+extern napi_value SetConfigCacheDir(napi_env env, napi_callback_info info);
+
 
 // 声明注册回调的NAPI接口
 extern napi_value RegisterParamCallback(napi_env env, napi_callback_info info);
@@ -106,6 +183,35 @@ std::unordered_map<std::string, std::vector<std::string>> ExtractParamOptions(co
 
 
 
+/**
+ * @brief 解析曝光参数字符串，ArkTS传入种类（"shutter"/"aperture"/"ec"）和字符串
+ * @return {num, den, value, stops}（stops为档数，曝光补偿没有），无法解析时返回null
+ */
+extern napi_value ParseExposureValue(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 最近的标准档位标签，ArkTS传入种类、字符串和每档级数（3或2，默认3），无法解析时返回空串
+ */
+extern napi_value NearestExposureStop(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 在相机可选值中找与给定值最接近（按档数）的一项，ArkTS传入种类、字符串和可选值数组
+ */
+extern napi_value MatchExposureChoice(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 等效曝光组合，ArkTS传入当前光圈、快门和候选光圈数组，返回[{aperture, shutter}]
+ */
+extern napi_value GetEquivalentExposures(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 包围曝光的补偿序列，ArkTS传入中心补偿、张数、间隔和相机可选值（可为空数组）
+ */
+extern napi_value GetBracketingSet(napi_env env, napi_callback_info info);
+
+/**
+ * @brief 把参数可选值推送给RegisterParamCallback注册的回调（经线程安全函数投递，任意线程可调用）
+ */
 void PushParamOptionsToArkTS(const std::unordered_map<std::string, std::vector<std::string>>& options);
 
 #endif //PHOTOSEND_CAMERA_CONFIG_H
@@ -10,6 +10,13 @@
 #include <hilog/log.h>
 #include <ltdl.h>
 #include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/Core/Capture/camera_capture.h"
+#include "Camera/Core/Config/ConfigSnapshot.h"
+#include "Camera/Core/Config/camera_config.h"
+#include "Camera/Core/Config/PtpPropertyDecoder.h"
+#include "Camera/Core/Config/ConfigSchemaCache.h"
+#include "Camera/Core/Config/ConfigPrefetcher.h"
+#include "Camera/Core/Config/SingleConfig.h"
 #include <cstring>
 #include <chrono>
 #include <thread>
@@ -243,11 +250,19 @@ bool ConnectionManager::connect(const std::string& model, const std::string& pat
         g_connected = true;*/
         
         SetCameraInstance(camera_, context_, true);  // 使用统一的接口
+        SelectPtpVendor(model);                      // 按型号选定厂商属性解码表
+        OpenConfigSchema(model);                     // 加载该型号+固件的配置结构缓存
         
         // 初始化CameraDownloadKit模块
         InitCameraDownloadModules();
         OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, 
                      "CameraDownloadKit模块已初始化");
+
+        // 上次断开时停止的参数写入队列重新接受写入
+        StartConfigWriteQueue();
+
+        // 后台预取常用参数的可选值，第一次打开参数对话框时无需等待
+        StartConfigPrefetch();
     }
     
     return true;
@@ -267,8 +282,17 @@ bool ConnectionManager::disconnect() {
     
     OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_TAG, "开始断开相机连接");
     
-    // 1. 先清理下载模块
+    // 1. 先停止配置预取、联机会话、状态监视和参数写入队列，再清理下载模块
+    CleanupConfigPrefetch();
+    CleanupTetherSession();
+    CleanupStatusMonitor();
+    CleanupConfigWriteQueue();
     CleanupCameraDownloadModules();
+    ClearConfigSnapshot();
+    SelectPtpVendor("");
+    CloseConfigSchema();
+    ClearConfigItems();
+    ClearSingleConfigFallback();
     
     // 2. 清理全局变量（如果其他模块使用了的话）
     /*extern Camera* g_camera;
@@ -283,8 +307,11 @@ bool ConnectionManager::disconnect() {
     
     // 3. 断开相机连接
     if (camera_) {
-        // 尝试优雅退出
-        gp_camera_exit(camera_, context_);
+        // 尝试优雅退出（等待仍在进行的相机操作结束）
+        {
+            std::lock_guard<std::recursive_mutex> lock(GetCameraIoMutex());
+            gp_camera_exit(camera_, context_);
+        }
         
         // 释放相机资源
         gp_camera_unref(camera_);
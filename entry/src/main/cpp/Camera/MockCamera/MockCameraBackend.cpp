@@ -0,0 +1,726 @@
+// MockCameraBackend.cpp
+// Created on 2026/1/21.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "MockCameraBackend.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+static const char* const OP_NAMES[] = {
+    "list", "info", "file", "read", "exif", "thumb", "config", "preview", "capture", "event"
+};
+
+static const char* const MOCK_MAKE = "NIKON CORPORATION";
+static const char* const MOCK_MODEL = "NIKON MOCK";
+static const time_t MOCK_BASE_TIME = 1767225600;    // 2026-01-01 00:00:00 UTC，生成目录的第一张
+static const int MAX_FOLDER_NUMBER = 999;
+static const int MAX_FILE_NUMBER = 9999;
+static const uint64_t OBJECT_INFO_BYTES = 256;      // 列目录时每个文件的对象信息大小（PTP ObjectInfo）
+static const uint64_t STORAGE_CAPACITY_KB = 128ULL * 1024 * 1024;
+static const size_t LIVE_FRAME_COUNT = 8;
+
+// 预编码图像尺寸
+static const int THUMB_WIDTH = 160;
+static const int THUMB_HEIGHT = 120;
+static const int IMAGE_WIDTH = 1920;
+static const int IMAGE_HEIGHT = 1280;
+static const int LIVE_WIDTH = 640;
+static const int LIVE_HEIGHT = 424;
+
+// 拍摄参数（按拍摄序号取值，同一张照片每次读取一致）
+static const uint16_t ISO_VALUES[] = {100, 200, 400, 800, 1600, 3200, 6400};
+static const uint32_t SHUTTER_DENOMINATORS[] = {4000, 1000, 500, 250, 125, 60, 30};
+static const uint32_t FNUMBER_X10[] = {18, 20, 28, 40, 56, 80, 110};
+static const uint32_t FOCAL_LENGTHS[] = {24, 35, 40, 50, 85};
+
+template <typename T, size_t N>
+static T PickByShot(const T (&values)[N], uint32_t shot, uint32_t salt) {
+    return values[((shot * 2654435761u) ^ salt) % N];
+}
+
+static int ParseInt(const std::string& text, int fallback) {
+    char* end = nullptr;
+    long value = strtol(text.c_str(), &end, 10);
+    return (end && *end == '\0' && !text.empty()) ? static_cast<int>(value) : fallback;
+}
+
+static std::string ParentPath(const std::string& path) {
+    size_t slash = path.rfind('/');
+    return (slash == 0 || slash == std::string::npos) ? "/" : path.substr(0, slash);
+}
+
+static std::string BaseName(const std::string& path) {
+    size_t slash = path.rfind('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+static std::string StorageRoot(int storage) {
+    char root[32];
+    snprintf(root, sizeof(root), "/store_%04d0001", storage);
+    return root;
+}
+
+static const char* MimeOf(MockFileKind kind) {
+    switch (kind) {
+        case MockFileKind::Jpeg: return GP_MIME_JPEG;
+        case MockFileKind::Raw: return GP_MIME_NEF;
+        default: return GP_MIME_QUICKTIME;
+    }
+}
+
+MockCameraOptions MockCameraOptions::Parse(const char* spec) {
+    MockCameraOptions options;
+    if (!spec) {
+        return options;
+    }
+
+    std::string text = spec;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string item = text.substr(start, end - start);
+        start = end + 1;
+
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) {
+            continue;
+        }
+        std::string key = item.substr(0, eq);
+        std::string value = item.substr(eq + 1);
+
+        if (key == "shots") options.shots = ParseInt(value, options.shots);
+        else if (key == "raw") options.rawPercent = ParseInt(value, options.rawPercent);
+        else if (key == "pair") options.pairPercent = ParseInt(value, options.pairPercent);
+        else if (key == "video") options.videoPercent = ParseInt(value, options.videoPercent);
+        else if (key == "per_folder") options.shotsPerFolder = ParseInt(value, options.shotsPerFolder);
+        else if (key == "storages") options.storages = ParseInt(value, options.storages);
+        else if (key == "backup") options.backup = ParseInt(value, 0) != 0;
+        else if (key == "jpeg_kb") options.jpegKb = ParseInt(value, options.jpegKb);
+        else if (key == "raw_kb") options.rawKb = ParseInt(value, options.rawKb);
+        else if (key == "video_kb") options.videoKb = ParseInt(value, options.videoKb);
+        else if (key == "bandwidth_kbps") options.bandwidthKbps = ParseInt(value, options.bandwidthKbps);
+        else if (key == "shoot_interval_ms") options.shootIntervalMs = ParseInt(value, options.shootIntervalMs);
+        else if (key == "seed") options.seed = static_cast<uint32_t>(ParseInt(value, options.seed));
+        else if (key == "samples") options.sampleDir = value;
+        else {
+            // <op>_ms / <op>_fail
+            for (int op = 0; op < static_cast<int>(MockOp::Count); op++) {
+                std::string name = OP_NAMES[op];
+                if (key == name + "_ms") {
+                    options.latencyMs[op] = ParseInt(value, 0);
+                } else if (key == name + "_fail") {
+                    options.failPercent[op] = ParseInt(value, 0);
+                }
+            }
+        }
+    }
+
+    options.shots = std::max(0, options.shots);
+    options.shotsPerFolder = std::max(1, options.shotsPerFolder);
+    options.storages = std::min(2, std::max(1, options.storages));
+    return options;
+}
+
+MockCameraBackend::MockCameraBackend(const MockCameraOptions& options)
+    : options_(options)
+    , model_(MOCK_MODEL)
+    , liveFrameIndex_(0)
+    , nextShot_(0)
+    , lastShotTime_(MOCK_BASE_TIME)
+    , random_(options.seed) {
+    char serial[32];
+    snprintf(serial, sizeof(serial), "MOCK%08u", options.seed);
+    serial_ = serial;
+}
+
+uint32_t MockCameraBackend::NextRandomLocked() {
+    random_ = random_ * 1103515245u + 12345u;
+    return random_ >> 16;
+}
+
+bool MockCameraBackend::Init() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // 1. 预编码缩略图、图像主体和预览帧
+    thumbnail_ = MockCameraPayload::EncodeJpeg(THUMB_WIDTH, THUMB_HEIGHT, 0, 75);
+    image_ = MockCameraPayload::EncodeJpeg(IMAGE_WIDTH, IMAGE_HEIGHT, 0, 85);
+    for (size_t i = 0; i < LIVE_FRAME_COUNT; i++) {
+        liveFrames_.push_back(MockCameraPayload::EncodeJpeg(LIVE_WIDTH, LIVE_HEIGHT, static_cast<int>(i), 70));
+    }
+    if (thumbnail_.empty() || image_.empty() || liveFrames_.back().empty()) {
+        return false;
+    }
+
+    // 2. 样本文件（可选）
+    if (!options_.sampleDir.empty()) {
+        MockCameraPayload::ReadWholeFile(options_.sampleDir + "/sample.jpg", sampleJpeg_);
+        if (!MockCameraPayload::ReadWholeFile(options_.sampleDir + "/sample.nef", sampleRaw_)) {
+            MockCameraPayload::ReadWholeFile(options_.sampleDir + "/sample.NEF", sampleRaw_);
+        }
+    }
+
+    // 3. 目录树：/store_xxxx/DCIM/100NIKON...
+    AddFolderLocked("/");
+    for (int storage = 1; storage <= options_.storages; storage++) {
+        AddFolderLocked(StorageRoot(storage) + "/DCIM");
+    }
+
+    time_t mtime = MOCK_BASE_TIME;
+    for (int i = 0; i < options_.shots; i++) {
+        // 拍摄间隔：大多为连拍（1秒），部分间隔几分钟，偶尔隔几天
+        uint32_t gapRoll = NextRandomLocked() % 100;
+        if (i > 0) {
+            if (gapRoll < 70) {
+                mtime += 1;
+            } else if (gapRoll < 95) {
+                mtime += 30 + NextRandomLocked() % 600;
+            } else {
+                mtime += 86400 + NextRandomLocked() % (2 * 86400);
+            }
+        }
+
+        int roll = static_cast<int>(NextRandomLocked() % 100);
+        bool raw = roll < options_.rawPercent + options_.pairPercent;
+        bool jpeg = roll >= options_.rawPercent;
+        bool video = roll >= options_.rawPercent + options_.pairPercent &&
+                     roll < options_.rawPercent + options_.pairPercent + options_.videoPercent;
+        if (video) {
+            raw = false;
+            jpeg = false;
+        }
+
+        ShotSpec spec = MakeShotLocked(nextShot_++, mtime, jpeg, raw, video);
+        if (options_.storages == 2 && options_.backup) {
+            PlaceShotLocked(spec, 1, nullptr);
+            PlaceShotLocked(spec, 2, nullptr);
+        } else {
+            // 双卡顺序记录：前一半在卡1，后一半在卡2
+            PlaceShotLocked(spec, (options_.storages == 2 && i >= options_.shots / 2) ? 2 : 1, nullptr);
+        }
+    }
+    lastShotTime_ = mtime;
+
+    InitSettings();
+    nextAutoShot_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.shootIntervalMs);
+    return true;
+}
+
+void MockCameraBackend::InitSettings() {
+    auto radio = [this](const char* section, const char* name, const char* label,
+                        std::vector<std::string> choices, const char* value) {
+        settings_.push_back({section, name, label, GP_WIDGET_RADIO, std::move(choices), value, false});
+    };
+    auto text = [this](const char* section, const char* name, const char* label, const std::string& value) {
+        settings_.push_back({section, name, label, GP_WIDGET_TEXT, {}, value, true});
+    };
+    auto toggle = [this](const char* section, const char* name, const char* label) {
+        settings_.push_back({section, name, label, GP_WIDGET_TOGGLE, {}, "0", false});
+    };
+
+    // 名称与ptp2驱动的尼康机型一致
+    toggle("actions", "viewfinder", "Nikon Viewfinder");
+    toggle("actions", "autofocusdrive", "Drive Nikon DSLR Autofocus");
+    radio("settings", "capturetarget", "Capture Target", {"Internal RAM", "Memory card"}, "Memory card");
+    text("status", "serialnumber", "Serial Number", serial_);
+    text("status", "manufacturer", "Camera Manufacturer", "Nikon Corporation");
+    text("status", "cameramodel", "Camera Model", model_);
+    text("status", "lensname", "Lens Name", "NIKKOR Z 40mm f/2");
+    text("status", "batterylevel", "Battery Level", "85%");
+    radio("imgsettings", "imagequality", "Image Quality",
+          {"JPEG Basic", "JPEG Normal", "JPEG Fine", "NEF (Raw)", "NEF+Basic", "NEF+Normal", "NEF+Fine"},
+          "NEF+Fine");
+    radio("imgsettings", "iso", "ISO Speed",
+          {"Auto", "100", "200", "400", "800", "1600", "3200", "6400", "12800", "25600"}, "Auto");
+    radio("imgsettings", "whitebalance", "White Balance",
+          {"Automatic", "Daylight", "Fluorescent", "Tungsten", "Flash", "Cloudy", "Shade", "Preset"}, "Automatic");
+    radio("capturesettings", "f-number", "F-Number",
+          {"f/2", "f/2.8", "f/4", "f/5.6", "f/8", "f/11", "f/16"}, "f/4");
+    radio("capturesettings", "shutterspeed", "Shutter Speed",
+          {"1/4000", "1/2000", "1/1000", "1/500", "1/250", "1/125", "1/60", "1/30", "1/15", "1/8", "1/4",
+           "1/2", "1", "2", "4", "8", "15", "30", "Bulb"}, "1/125");
+    radio("capturesettings", "exposurecompensation", "Exposure Compensation",
+          {"-3", "-2.666", "-2.333", "-2", "-1.666", "-1.333", "-1", "-0.666", "-0.333", "0",
+           "0.333", "0.666", "1", "1.333", "1.666", "2", "2.333", "2.666", "3"}, "0");
+    radio("capturesettings", "focusmode", "Focus Mode", {"Manual", "AF-S", "AF-C", "AF-A"}, "AF-S");
+    radio("capturesettings", "expprogram", "Exposure Program", {"M", "P", "A", "S", "Auto"}, "A");
+    radio("capturesettings", "exposuremetermode", "Exposure Metering Mode",
+          {"Center Weighted", "Multi Spot", "Center Spot", "Highlight Weighted"}, "Multi Spot");
+    radio("capturesettings", "capturemode", "Still Capture Mode",
+          {"Single Shot", "Continuous Low Speed", "Continuous High Speed", "Self-timer", "Quiet Release"},
+          "Single Shot");
+}
+
+void MockCameraBackend::AddFolderLocked(const std::string& path) {
+    if (folderIndex_.count(path)) {
+        return;
+    }
+    if (path != "/") {
+        std::string parent = ParentPath(path);
+        AddFolderLocked(parent);
+        childFolders_[parent].push_back(BaseName(path));
+    }
+    folderIndex_[path] = folders_.size();
+    MockFolder folder;
+    folder.path = path;
+    folders_.push_back(std::move(folder));
+}
+
+void MockCameraBackend::AddFileLocked(const std::string& folder, const MockFile& file) {
+    AddFolderLocked(folder);
+    MockFolder& target = folders_[folderIndex_[folder]];
+    target.indexByName[file.name] = target.files.size();
+    target.files.push_back(file);
+}
+
+const MockFile* MockCameraBackend::FindFileLocked(const std::string& folder, const std::string& name) const {
+    auto folderIt = folderIndex_.find(folder);
+    if (folderIt == folderIndex_.end()) {
+        return nullptr;
+    }
+    const MockFolder& target = folders_[folderIt->second];
+    auto fileIt = target.indexByName.find(name);
+    return fileIt == target.indexByName.end() ? nullptr : &target.files[fileIt->second];
+}
+
+uint64_t MockCameraBackend::JitterSizeLocked(int nominalKb, uint64_t minimum) {
+    // 名义大小±10%，且不小于文件头部
+    uint64_t nominal = static_cast<uint64_t>(std::max(nominalKb, 1)) * 1024;
+    uint64_t jitter = nominal / 10;
+    uint64_t size = nominal - jitter + (jitter > 0 ? NextRandomLocked() % (2 * jitter) : 0);
+    return std::max(size, minimum);
+}
+
+MockCameraBackend::ShotSpec MockCameraBackend::MakeShotLocked(uint32_t shot, time_t mtime,
+                                                              bool jpeg, bool raw, bool video) {
+    // 头部上限：EXIF（含缩略图）+ 图像主体，留出余量
+    uint64_t headRoom = image_.size() + thumbnail_.size() + 4096;
+    ShotSpec spec = {shot, mtime, jpeg, raw, video, 0, 0, 0};
+    if (jpeg) {
+        spec.jpegSize = sampleJpeg_.empty() ? JitterSizeLocked(options_.jpegKb, headRoom) : sampleJpeg_.size();
+    }
+    if (raw) {
+        spec.rawSize = sampleRaw_.empty() ? JitterSizeLocked(options_.rawKb, headRoom) : sampleRaw_.size();
+    }
+    if (video) {
+        spec.videoSize = JitterSizeLocked(options_.videoKb, 64);
+    }
+    return spec;
+}
+
+void MockCameraBackend::PlaceShotLocked(const ShotSpec& spec, int storage, std::vector<CameraFilePath>* added) {
+    int folderNumber = std::min(MAX_FOLDER_NUMBER, 100 + static_cast<int>(spec.shot) / options_.shotsPerFolder);
+    char folderName[16];
+    snprintf(folderName, sizeof(folderName), "%03dNIKON", folderNumber);
+    std::string folder = StorageRoot(storage) + "/DCIM/" + folderName;
+
+    char stem[16];
+    snprintf(stem, sizeof(stem), "DSC_%04u", spec.shot % MAX_FILE_NUMBER + 1);
+
+    auto add = [&](MockFileKind kind, const char* ext, uint64_t size) {
+        MockFile file = {std::string(stem) + ext, kind, size, spec.mtime, spec.shot};
+        AddFileLocked(folder, file);
+        if (added) {
+            CameraFilePath path;
+            memset(&path, 0, sizeof(path));
+            snprintf(path.folder, sizeof(path.folder), "%s", folder.c_str());
+            snprintf(path.name, sizeof(path.name), "%s", file.name.c_str());
+            added->push_back(path);
+        }
+    };
+    if (spec.jpeg) {
+        add(MockFileKind::Jpeg, ".JPG", spec.jpegSize);
+    }
+    if (spec.raw) {
+        add(MockFileKind::Raw, ".NEF", spec.rawSize);
+    }
+    if (spec.video) {
+        add(MockFileKind::Video, ".MOV", spec.videoSize);
+    }
+}
+
+MockExifFields MockCameraBackend::MakeExifLocked(const MockFile& file) const {
+    MockExifFields fields;
+    fields.make = MOCK_MAKE;
+    fields.model = model_;
+    fields.captureTime = file.mtime;
+    fields.exposureNum = 1;
+    fields.exposureDen = PickByShot(SHUTTER_DENOMINATORS, file.shot, 0x5a);
+    fields.fNumberX10 = PickByShot(FNUMBER_X10, file.shot, 0x3c);
+    fields.iso = PickByShot(ISO_VALUES, file.shot, 0x17);
+    fields.focalLengthMm = PickByShot(FOCAL_LENGTHS, file.shot, 0x71);
+    return fields;
+}
+
+const std::vector<uint8_t>& MockCameraBackend::GetHeadLocked(const std::string& folder, const MockFile& file) {
+    std::string key = folder + "/" + file.name;
+    if (key == headKey_) {
+        return head_;
+    }
+    headKey_ = key;
+    switch (file.kind) {
+        case MockFileKind::Jpeg:
+            head_ = !sampleJpeg_.empty() ? sampleJpeg_ :
+                MockCameraPayload::BuildJpegHead(MockCameraPayload::BuildExifBlob(MakeExifLocked(file), thumbnail_),
+                                                 image_);
+            break;
+        case MockFileKind::Raw:
+            head_ = !sampleRaw_.empty() ? sampleRaw_ :
+                MockCameraPayload::BuildRawHead(MakeExifLocked(file), thumbnail_, image_);
+            break;
+        default:
+            head_ = MockCameraPayload::BuildVideoHead();
+            break;
+    }
+    return head_;
+}
+
+std::string MockCameraBackend::SettingValueLocked(const std::string& name) const {
+    for (const auto& setting : settings_) {
+        if (setting.name == name) {
+            return setting.value;
+        }
+    }
+    return "";
+}
+
+int MockCameraBackend::Simulate(MockOp op, uint64_t bytes, int repeat) {
+    int index = static_cast<int>(op);
+    bool failed = false;
+    if (options_.failPercent[index] > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed = static_cast<int>(NextRandomLocked() % 100) < options_.failPercent[index];
+    }
+
+    uint64_t delayUs = static_cast<uint64_t>(std::max(0, options_.latencyMs[index])) * 1000 * repeat;
+    if (options_.bandwidthKbps > 0) {
+        delayUs += bytes * 1000000 / (static_cast<uint64_t>(options_.bandwidthKbps) * 1024);
+    }
+    if (delayUs > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+    }
+    return failed ? GP_ERROR_IO : GP_OK;
+}
+
+// ======================== 文件系统 ========================
+
+int MockCameraBackend::ListFolders(const std::string& folder, std::vector<std::string>& out) {
+    out.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!folderIndex_.count(folder)) {
+            return GP_ERROR_DIRECTORY_NOT_FOUND;
+        }
+        auto it = childFolders_.find(folder);
+        if (it != childFolders_.end()) {
+            out = it->second;
+        }
+    }
+    int ret = Simulate(MockOp::List, out.size() * OBJECT_INFO_BYTES);
+    if (ret != GP_OK) {
+        out.clear();
+    }
+    return ret;
+}
+
+int MockCameraBackend::ListFiles(const std::string& folder, std::vector<std::string>& out) {
+    out.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = folderIndex_.find(folder);
+        if (it == folderIndex_.end()) {
+            return GP_ERROR_DIRECTORY_NOT_FOUND;
+        }
+        const MockFolder& target = folders_[it->second];
+        out.reserve(target.files.size());
+        for (const auto& file : target.files) {
+            out.push_back(file.name);
+        }
+    }
+    int ret = Simulate(MockOp::List, out.size() * OBJECT_INFO_BYTES);
+    if (ret != GP_OK) {
+        out.clear();
+    }
+    return ret;
+}
+
+int MockCameraBackend::GetInfo(const std::string& folder, const std::string& name, CameraFileInfo& info) {
+    memset(&info, 0, sizeof(info));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const MockFile* file = FindFileLocked(folder, name);
+        if (!file) {
+            return GP_ERROR_FILE_NOT_FOUND;
+        }
+        info.file.fields = static_cast<CameraFileInfoFields>(GP_FILE_INFO_TYPE | GP_FILE_INFO_SIZE |
+                                                             GP_FILE_INFO_MTIME | GP_FILE_INFO_PERMISSIONS);
+        info.file.status = GP_FILE_STATUS_NOT_DOWNLOADED;
+        info.file.size = file->size;
+        info.file.mtime = file->mtime;
+        info.file.permissions = static_cast<CameraFilePermissions>(GP_FILE_PERM_READ | GP_FILE_PERM_DELETE);
+        snprintf(info.file.type, sizeof(info.file.type), "%s", MimeOf(file->kind));
+    }
+    return Simulate(MockOp::Info, OBJECT_INFO_BYTES);
+}
+
+int MockCameraBackend::GetFile(const std::string& folder, const std::string& name, CameraFileType type,
+                               std::vector<uint8_t>& out, std::string& mimeType) {
+    out.clear();
+    MockOp op;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const MockFile* file = FindFileLocked(folder, name);
+        if (!file) {
+            return GP_ERROR_FILE_NOT_FOUND;
+        }
+        switch (type) {
+            case GP_FILE_TYPE_NORMAL: {
+                // 头部之后补零到名义大小
+                const std::vector<uint8_t>& head = GetHeadLocked(folder, *file);
+                out.assign(std::max<uint64_t>(file->size, head.size()), 0);
+                std::copy(head.begin(), head.end(), out.begin());
+                mimeType = MimeOf(file->kind);
+                op = MockOp::File;
+                break;
+            }
+            case GP_FILE_TYPE_PREVIEW:
+                out = thumbnail_;
+                mimeType = GP_MIME_JPEG;
+                op = MockOp::Thumb;
+                break;
+            case GP_FILE_TYPE_EXIF:
+                if (file->kind == MockFileKind::Video) {
+                    return GP_ERROR_NOT_SUPPORTED;
+                }
+                out = MockCameraPayload::BuildExifBlob(MakeExifLocked(*file), thumbnail_);
+                mimeType = GP_MIME_EXIF;
+                op = MockOp::Exif;
+                break;
+            default:
+                return GP_ERROR_NOT_SUPPORTED;
+        }
+    }
+    int ret = Simulate(op, out.size());
+    if (ret != GP_OK) {
+        out.clear();
+    }
+    return ret;
+}
+
+int MockCameraBackend::ReadFile(const std::string& folder, const std::string& name, uint64_t offset,
+                                char* buf, uint64_t& size) {
+    uint64_t copied = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const MockFile* file = FindFileLocked(folder, name);
+        if (!file) {
+            size = 0;
+            return GP_ERROR_FILE_NOT_FOUND;
+        }
+        const std::vector<uint8_t>& head = GetHeadLocked(folder, *file);
+        uint64_t total = std::max<uint64_t>(file->size, head.size());
+        if (offset < total) {
+            copied = std::min(size, total - offset);
+            uint64_t fromHead = offset < head.size() ? std::min<uint64_t>(copied, head.size() - offset) : 0;
+            if (fromHead > 0) {
+                memcpy(buf, head.data() + offset, fromHead);
+            }
+            memset(buf + fromHead, 0, copied - fromHead);
+        }
+    }
+    size = copied;
+    int ret = Simulate(MockOp::Read, copied);
+    if (ret != GP_OK) {
+        size = 0;
+    }
+    return ret;
+}
+
+int MockCameraBackend::GetStorageInfo(std::vector<CameraStorageInformation>& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int storage = 1; storage <= options_.storages; storage++) {
+        std::string root = StorageRoot(storage);
+        uint64_t usedKb = 0;
+        for (const auto& folder : folders_) {
+            if (folder.path.compare(0, root.size(), root) == 0) {
+                for (const auto& file : folder.files) {
+                    usedKb += file.size / 1024;
+                }
+            }
+        }
+
+        CameraStorageInformation info;
+        memset(&info, 0, sizeof(info));
+        info.fields = static_cast<CameraStorageInfoFields>(
+            GP_STORAGEINFO_BASE | GP_STORAGEINFO_LABEL | GP_STORAGEINFO_DESCRIPTION | GP_STORAGEINFO_ACCESS |
+            GP_STORAGEINFO_STORAGETYPE | GP_STORAGEINFO_FILESYSTEMTYPE | GP_STORAGEINFO_MAXCAPACITY |
+            GP_STORAGEINFO_FREESPACEKBYTES | GP_STORAGEINFO_FREESPACEIMAGES);
+        snprintf(info.basedir, sizeof(info.basedir), "%s", root.c_str());
+        snprintf(info.label, sizeof(info.label), "%s [Slot %d]", model_.c_str(), storage);
+        snprintf(info.description, sizeof(info.description), "SD");
+        info.type = GP_STORAGEINFO_ST_REMOVABLE_RAM;
+        info.fstype = GP_STORAGEINFO_FST_DCF;
+        info.access = GP_STORAGEINFO_AC_READWRITE;
+        info.capacitykbytes = STORAGE_CAPACITY_KB;
+        info.freekbytes = usedKb < STORAGE_CAPACITY_KB ? STORAGE_CAPACITY_KB - usedKb : 0;
+        info.freeimages = info.freekbytes / std::max(1, options_.rawKb + options_.jpegKb);
+        out.push_back(info);
+    }
+    return GP_OK;
+}
+
+// ======================== 配置 ========================
+
+int MockCameraBackend::ReadSettings(const std::string& name, std::vector<MockSetting>& out) {
+    out.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& setting : settings_) {
+            if (name.empty() || setting.name == name) {
+                out.push_back(setting);
+            }
+        }
+    }
+    if (out.empty()) {
+        return GP_ERROR_BAD_PARAMETERS;
+    }
+    // 真实相机逐项读取属性描述，整棵配置树的耗时与配置项个数成正比
+    int ret = Simulate(MockOp::Config, 0, static_cast<int>(out.size()));
+    if (ret != GP_OK) {
+        out.clear();
+    }
+    return ret;
+}
+
+int MockCameraBackend::WriteSetting(const std::string& name, const std::string& value) {
+    int ret = Simulate(MockOp::Config, 0);
+    if (ret != GP_OK) {
+        return ret;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& setting : settings_) {
+        if (setting.name != name) {
+            continue;
+        }
+        if (setting.readOnly) {
+            return GP_ERROR_NOT_SUPPORTED;
+        }
+        if (setting.type == GP_WIDGET_RADIO &&
+            std::find(setting.choices.begin(), setting.choices.end(), value) == setting.choices.end()) {
+            return GP_ERROR_BAD_PARAMETERS;
+        }
+        setting.value = setting.type == GP_WIDGET_TOGGLE ? (value == "0" ? "0" : "1") : value;
+        return GP_OK;
+    }
+    return GP_ERROR_BAD_PARAMETERS;
+}
+
+std::vector<MockSetting> MockCameraBackend::ListSettings() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return settings_;
+}
+
+// ======================== 拍摄与事件 ========================
+
+int MockCameraBackend::CapturePreview(std::vector<uint8_t>& frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frame = liveFrames_[liveFrameIndex_];
+        liveFrameIndex_ = (liveFrameIndex_ + 1) % liveFrames_.size();
+    }
+    int ret = Simulate(MockOp::Preview, frame.size());
+    if (ret != GP_OK) {
+        frame.clear();
+    }
+    return ret;
+}
+
+std::vector<CameraFilePath> MockCameraBackend::ShootLocked() {
+    std::string quality = SettingValueLocked("imagequality");
+    bool raw = quality.find("NEF") != std::string::npos;
+    bool jpeg = quality.find("JPEG") != std::string::npos || quality.find('+') != std::string::npos;
+
+    time_t now = time(nullptr);
+    lastShotTime_ = std::max(now, lastShotTime_ + 1);
+    ShotSpec spec = MakeShotLocked(nextShot_++, lastShotTime_, jpeg, raw, false);
+
+    // 双卡顺序记录时新照片写入卡2，备份模式两张卡都写（只上报主卡）
+    std::vector<CameraFilePath> added;
+    bool overflow = options_.storages == 2 && !options_.backup;
+    PlaceShotLocked(spec, overflow ? 2 : 1, &added);
+    if (options_.storages == 2 && options_.backup) {
+        PlaceShotLocked(spec, 2, nullptr);
+    }
+    return added;
+}
+
+int MockCameraBackend::Capture(CameraFilePath& path) {
+    int ret = Simulate(MockOp::Capture, 0);
+    if (ret != GP_OK) {
+        return ret;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<CameraFilePath> added = ShootLocked();
+    if (added.empty()) {
+        return GP_ERROR;
+    }
+    path = added.front();
+    events_.insert(events_.end(), added.begin() + 1, added.end());
+    eventCv_.notify_all();
+    return GP_OK;
+}
+
+int MockCameraBackend::TriggerCapture() {
+    int ret = Simulate(MockOp::Capture, 0);
+    if (ret != GP_OK) {
+        return ret;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<CameraFilePath> added = ShootLocked();
+    events_.insert(events_.end(), added.begin(), added.end());
+    eventCv_.notify_all();
+    return GP_OK;
+}
+
+int MockCameraBackend::WaitForEvent(int timeoutMs, CameraFilePath& path, bool& fileAdded) {
+    fileAdded = false;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(0, timeoutMs));
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            if (!events_.empty()) {
+                path = events_.front();
+                events_.pop_front();
+                fileAdded = true;
+                break;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (options_.shootIntervalMs > 0 && now >= nextAutoShot_) {
+                std::vector<CameraFilePath> added = ShootLocked();
+                events_.insert(events_.end(), added.begin(), added.end());
+                nextAutoShot_ = now + std::chrono::milliseconds(options_.shootIntervalMs);
+                continue;
+            }
+            if (now >= deadline) {
+                return GP_OK;
+            }
+            auto wakeAt = deadline;
+            if (options_.shootIntervalMs > 0) {
+                wakeAt = std::min(wakeAt, nextAutoShot_);
+            }
+            eventCv_.wait_until(lock, wakeAt);
+        }
+    }
+    return Simulate(MockOp::Event, 0);
+}
@@ -0,0 +1,257 @@
+// MockCameraBackend.h
+// Created on 2026/1/21.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef MOCK_CAMERA_BACKEND_H
+#define MOCK_CAMERA_BACKEND_H
+
+#include "MockCameraPayload.h"
+#include <gphoto2/gphoto2.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 可注入延迟/失败的操作类型
+ */
+enum class MockOp {
+    List = 0,   // 列目录
+    Info,       // 文件信息
+    File,       // 整文件下载
+    Read,       // 分块读取（每块）
+    Exif,       // EXIF数据块
+    Thumb,      // 缩略图
+    Config,     // 配置（每个配置项）
+    Preview,    // 实时预览帧
+    Capture,    // 拍摄
+    Event,      // 事件投递
+    Count
+};
+
+/**
+ * @brief 模拟相机参数
+ * @details 由环境变量PHOTOSEND_MOCKCAM解析，格式为逗号分隔的key=value，例如：
+ *          "shots=5000,raw=30,pair=40,bandwidth_kbps=4096,read_ms=8,list_ms=40,file_fail=2"
+ *          shoot_interval_ms>0时相机每隔该时间自动"拍摄"一张，通过wait_for_event投递。
+ *          每种操作都有 <op>_ms（固定延迟）和 <op>_fail（失败百分比）两个键，
+ *          op取 list/info/file/read/exif/thumb/config/preview/capture/event。
+ */
+struct MockCameraOptions {
+    int shots = 2000;               // 拍摄张数（RAW+JPEG算一张）
+    int rawPercent = 30;            // 单RAW
+    int pairPercent = 40;           // RAW+JPEG
+    int videoPercent = 2;           // 视频，其余为单JPEG
+    int shotsPerFolder = 999;       // 每个DCIM子目录的张数
+    int storages = 1;               // 存储卡数量（1或2）
+    bool backup = false;            // 双卡时第二张卡是否为备份（与第一张相同）
+    int jpegKb = 8192;              // 名义文件大小
+    int rawKb = 24576;
+    int videoKb = 204800;
+    int bandwidthKbps = 0;          // 传输带宽（KB/s），0表示不限
+    int shootIntervalMs = 0;        // 自动拍摄间隔（联机事件），0表示不自动拍摄
+    uint32_t seed = 1;              // 随机种子（目录内容、失败注入均由它决定）
+    std::string sampleDir;          // 样本目录：sample.jpg / sample.nef 存在时作为对应类型的文件内容
+    int latencyMs[static_cast<int>(MockOp::Count)] = {};
+    int failPercent[static_cast<int>(MockOp::Count)] = {};
+
+    /**
+     * @brief 解析参数字符串（未知键忽略，spec为空时全部取默认值）
+     */
+    static MockCameraOptions Parse(const char* spec);
+};
+
+/**
+ * @brief 模拟相机的文件类型
+ */
+enum class MockFileKind {
+    Jpeg,
+    Raw,
+    Video
+};
+
+/**
+ * @brief 模拟相机的一个文件
+ */
+struct MockFile {
+    std::string name;
+    MockFileKind kind;
+    uint64_t size;
+    time_t mtime;
+    uint32_t shot;      // 拍摄序号（决定EXIF参数）
+};
+
+/**
+ * @brief 模拟相机的一个配置项
+ */
+struct MockSetting {
+    std::string section;               // 所属分组（actions/settings/status/imgsettings/capturesettings）
+    std::string name;
+    std::string label;
+    CameraWidgetType type;             // GP_WIDGET_RADIO / GP_WIDGET_TEXT / GP_WIDGET_TOGGLE
+    std::vector<std::string> choices;
+    std::string value;                 // 开关类型为"0"/"1"
+    bool readOnly;
+};
+
+/**
+ * @brief 模拟相机后端（libgphoto2 camlib之下的设备模型）
+ * @details 在内存中生成DCIM目录树，按需生成文件内容，并按参数注入延迟、带宽限制和失败。
+ *          不依赖鸿蒙系统库，可在普通Linux上与libgphoto2配合使用。所有接口线程安全，
+ *          返回值为libgphoto2错误码。
+ */
+class MockCameraBackend {
+public:
+    explicit MockCameraBackend(const MockCameraOptions& options);
+
+    /**
+     * @brief 生成目录树和预编码图像
+     */
+    bool Init();
+
+    // ======================== 文件系统 ========================
+
+    int ListFolders(const std::string& folder, std::vector<std::string>& out);
+    int ListFiles(const std::string& folder, std::vector<std::string>& out);
+    int GetInfo(const std::string& folder, const std::string& name, CameraFileInfo& info);
+
+    /**
+     * @brief 取整个文件（NORMAL/PREVIEW/EXIF）
+     */
+    int GetFile(const std::string& folder, const std::string& name, CameraFileType type,
+                std::vector<uint8_t>& out, std::string& mimeType);
+
+    /**
+     * @brief 分块读取文件（仅NORMAL）
+     * @param size 输入为缓冲区大小，输出为实际读取字节数（到达文件末尾时为0）
+     */
+    int ReadFile(const std::string& folder, const std::string& name, uint64_t offset, char* buf, uint64_t& size);
+
+    int GetStorageInfo(std::vector<CameraStorageInformation>& out);
+
+    // ======================== 配置 ========================
+
+    /**
+     * @brief 读取配置项
+     * @param name 配置项名，为空时读取全部（延迟按配置项个数累计）
+     */
+    int ReadSettings(const std::string& name, std::vector<MockSetting>& out);
+
+    /**
+     * @brief 写入配置项（选项类型会校验取值）
+     */
+    int WriteSetting(const std::string& name, const std::string& value);
+
+    /**
+     * @brief 配置项定义（不产生延迟，供set_config遍历控件树）
+     */
+    std::vector<MockSetting> ListSettings() const;
+
+    // ======================== 拍摄与事件 ========================
+
+    int CapturePreview(std::vector<uint8_t>& frame);
+
+    /**
+     * @brief 拍摄一张（按imagequality生成JPEG和/或RAW），返回第一个文件，其余进入事件队列
+     */
+    int Capture(CameraFilePath& path);
+
+    /**
+     * @brief 触发拍摄，新文件全部通过事件投递
+     */
+    int TriggerCapture();
+
+    /**
+     * @brief 等待事件
+     * @param fileAdded 输出：是否为新文件事件（否则为超时）
+     */
+    int WaitForEvent(int timeoutMs, CameraFilePath& path, bool& fileAdded);
+
+    std::string GetModel() const { return model_; }
+    std::string GetSerial() const { return serial_; }
+
+private:
+    struct MockFolder {
+        std::string path;
+        std::vector<MockFile> files;
+        std::unordered_map<std::string, size_t> indexByName;
+    };
+
+    /**
+     * @brief 模拟一次操作：按参数判定失败，再按固定延迟+字节数/带宽休眠（不持锁）
+     */
+    int Simulate(MockOp op, uint64_t bytes, int repeat = 1);
+
+    uint32_t NextRandomLocked();
+    void InitSettings();
+    void AddFolderLocked(const std::string& path);
+    void AddFileLocked(const std::string& folder, const MockFile& file);
+    const MockFile* FindFileLocked(const std::string& folder, const std::string& name) const;
+    MockExifFields MakeExifLocked(const MockFile& file) const;
+    const std::vector<uint8_t>& GetHeadLocked(const std::string& folder, const MockFile& file);
+    std::string SettingValueLocked(const std::string& name) const;
+
+    /**
+     * @brief 一次拍摄的内容（双卡备份时两张卡写入相同的文件）
+     */
+    struct ShotSpec {
+        uint32_t shot;
+        time_t mtime;
+        bool jpeg;
+        bool raw;
+        bool video;
+        uint64_t jpegSize;
+        uint64_t rawSize;
+        uint64_t videoSize;
+    };
+
+    ShotSpec MakeShotLocked(uint32_t shot, time_t mtime, bool jpeg, bool raw, bool video);
+    void PlaceShotLocked(const ShotSpec& spec, int storage, std::vector<CameraFilePath>* added);
+    uint64_t JitterSizeLocked(int nominalKb, uint64_t minimum);
+
+    /**
+     * @brief 按当前画质生成一次拍摄的文件并加入目录树
+     * @return 新文件路径（可能有两个：JPEG和RAW）
+     */
+    std::vector<CameraFilePath> ShootLocked();
+
+private:
+    MockCameraOptions options_;
+    std::string model_;
+    std::string serial_;
+
+    std::vector<MockFolder> folders_;
+    std::unordered_map<std::string, size_t> folderIndex_;           // 路径 -> folders_下标
+    std::map<std::string, std::vector<std::string>> childFolders_;  // 路径 -> 子目录名
+    std::vector<MockSetting> settings_;
+
+    // 预编码图像
+    std::vector<uint8_t> thumbnail_;       // 160x120
+    std::vector<uint8_t> image_;           // JPEG图像主体/RAW内嵌大预览
+    std::vector<std::vector<uint8_t>> liveFrames_;
+    size_t liveFrameIndex_;
+    std::vector<uint8_t> sampleJpeg_;
+    std::vector<uint8_t> sampleRaw_;
+
+    // 最近一次生成的文件头部（分块读取时避免重复生成）
+    std::string headKey_;
+    std::vector<uint8_t> head_;
+
+    uint32_t nextShot_;
+    time_t lastShotTime_;
+    uint32_t random_;
+
+    std::deque<CameraFilePath> events_;
+    std::chrono::steady_clock::time_point nextAutoShot_;
+    std::condition_variable eventCv_;
+    mutable std::mutex mutex_;
+};
+
+#endif // MOCK_CAMERA_BACKEND_H
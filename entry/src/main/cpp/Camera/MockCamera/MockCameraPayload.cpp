@@ -0,0 +1,337 @@
+// MockCameraPayload.cpp
+// Created on 2026/1/21.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "MockCameraPayload.h"
+#include <csetjmp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <jpeglib.h>
+
+// TIFF字段类型与标签
+static const uint16_t TIFF_ASCII = 2;
+static const uint16_t TIFF_SHORT = 3;
+static const uint16_t TIFF_LONG = 4;
+static const uint16_t TIFF_RATIONAL = 5;
+
+static const uint16_t TAG_NEW_SUBFILE_TYPE = 0x00FE;
+static const uint16_t TAG_IMAGE_WIDTH = 0x0100;
+static const uint16_t TAG_IMAGE_LENGTH = 0x0101;
+static const uint16_t TAG_COMPRESSION = 0x0103;
+static const uint16_t TAG_MAKE = 0x010F;
+static const uint16_t TAG_MODEL = 0x0110;
+static const uint16_t TAG_ORIENTATION = 0x0112;
+static const uint16_t TAG_DATE_TIME = 0x0132;
+static const uint16_t TAG_SUB_IFDS = 0x014A;
+static const uint16_t TAG_JPEG_IF_OFFSET = 0x0201;
+static const uint16_t TAG_JPEG_IF_LENGTH = 0x0202;
+static const uint16_t TAG_EXPOSURE_TIME = 0x829A;
+static const uint16_t TAG_FNUMBER = 0x829D;
+static const uint16_t TAG_EXIF_IFD = 0x8769;
+static const uint16_t TAG_ISO = 0x8827;
+static const uint16_t TAG_DATE_TIME_ORIGINAL = 0x9003;
+static const uint16_t TAG_FOCAL_LENGTH = 0x920A;
+
+static const uint16_t COMPRESSION_OJPEG = 6;
+static const size_t TIFF_HEADER_SIZE = 8;
+static const size_t MAX_APP1_PAYLOAD = 65533;  // 段长度字段上限减去自身2字节
+
+/**
+ * @brief TIFF目录条目（值不超过4字节时内联，否则放在目录之后）
+ */
+struct TiffEntry {
+    uint16_t tag;
+    uint16_t type;
+    uint32_t count;
+    std::vector<uint8_t> data;
+};
+
+static void PutU16(std::vector<uint8_t>& buf, size_t pos, uint16_t value) {
+    buf[pos] = static_cast<uint8_t>(value & 0xFF);
+    buf[pos + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+static void PutU32(std::vector<uint8_t>& buf, size_t pos, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        buf[pos + i] = static_cast<uint8_t>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+static TiffEntry ShortEntry(uint16_t tag, uint16_t value) {
+    return {tag, TIFF_SHORT, 1, {static_cast<uint8_t>(value & 0xFF), static_cast<uint8_t>(value >> 8)}};
+}
+
+static TiffEntry LongEntry(uint16_t tag, uint32_t value) {
+    TiffEntry entry = {tag, TIFF_LONG, 1, std::vector<uint8_t>(4)};
+    PutU32(entry.data, 0, value);
+    return entry;
+}
+
+static TiffEntry AsciiEntry(uint16_t tag, const std::string& text) {
+    TiffEntry entry = {tag, TIFF_ASCII, static_cast<uint32_t>(text.size() + 1),
+                       std::vector<uint8_t>(text.begin(), text.end())};
+    entry.data.push_back(0);
+    return entry;
+}
+
+static TiffEntry RationalEntry(uint16_t tag, uint32_t numerator, uint32_t denominator) {
+    TiffEntry entry = {tag, TIFF_RATIONAL, 1, std::vector<uint8_t>(8)};
+    PutU32(entry.data, 0, numerator);
+    PutU32(entry.data, 4, denominator);
+    return entry;
+}
+
+static std::vector<uint8_t> NewTiff() {
+    std::vector<uint8_t> tiff = {'I', 'I', 42, 0, 0, 0, 0, 0};
+    PutU32(tiff, 4, TIFF_HEADER_SIZE);
+    return tiff;
+}
+
+/**
+ * @brief 在tiff末尾写入一个IFD（条目需按标签升序）
+ * @param valuePos 输出每个条目值的位置（内联值为条目内位置），用于回填偏移
+ * @return IFD偏移
+ */
+static size_t WriteIfd(std::vector<uint8_t>& tiff, const std::vector<TiffEntry>& entries,
+                       std::vector<size_t>& valuePos) {
+    size_t ifdOffset = tiff.size();
+    tiff.resize(ifdOffset + 2 + entries.size() * 12 + 4, 0);
+    PutU16(tiff, ifdOffset, static_cast<uint16_t>(entries.size()));
+    valuePos.assign(entries.size(), 0);
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        const TiffEntry& entry = entries[i];
+        size_t pos = ifdOffset + 2 + i * 12;
+        PutU16(tiff, pos, entry.tag);
+        PutU16(tiff, pos + 2, entry.type);
+        PutU32(tiff, pos + 4, entry.count);
+        if (entry.data.size() <= 4) {
+            memcpy(tiff.data() + pos + 8, entry.data.data(), entry.data.size());
+            valuePos[i] = pos + 8;
+        } else {
+            if (tiff.size() & 1) {
+                tiff.push_back(0);  // 值按字对齐
+            }
+            valuePos[i] = tiff.size();
+            PutU32(tiff, pos + 8, static_cast<uint32_t>(tiff.size()));
+            tiff.insert(tiff.end(), entry.data.begin(), entry.data.end());
+        }
+    }
+    return ifdOffset;
+}
+
+static size_t NextIfdPos(size_t ifdOffset, size_t entryCount) {
+    return ifdOffset + 2 + entryCount * 12;
+}
+
+static std::string FormatExifTime(time_t captureTime) {
+    struct tm tmValue;
+    gmtime_r(&captureTime, &tmValue);
+    char text[32];
+    snprintf(text, sizeof(text), "%04d:%02d:%02d %02d:%02d:%02d", tmValue.tm_year + 1900, tmValue.tm_mon + 1,
+             tmValue.tm_mday, tmValue.tm_hour, tmValue.tm_min, tmValue.tm_sec);
+    return text;
+}
+
+/**
+ * @brief 写入ExifIFD（拍摄参数）
+ * @return IFD偏移
+ */
+static size_t WriteExifIfd(std::vector<uint8_t>& tiff, const MockExifFields& fields) {
+    std::vector<TiffEntry> entries = {
+        RationalEntry(TAG_EXPOSURE_TIME, fields.exposureNum, fields.exposureDen),
+        RationalEntry(TAG_FNUMBER, fields.fNumberX10, 10),
+        ShortEntry(TAG_ISO, fields.iso),
+        AsciiEntry(TAG_DATE_TIME_ORIGINAL, FormatExifTime(fields.captureTime)),
+        RationalEntry(TAG_FOCAL_LENGTH, fields.focalLengthMm, 1),
+    };
+    std::vector<size_t> valuePos;
+    return WriteIfd(tiff, entries, valuePos);
+}
+
+struct JpegErrorManager {
+    jpeg_error_mgr base;
+    jmp_buf jump;
+};
+
+static void OnJpegError(j_common_ptr cinfo) {
+    JpegErrorManager* manager = reinterpret_cast<JpegErrorManager*>(cinfo->err);
+    longjmp(manager->jump, 1);
+}
+
+std::vector<uint8_t> MockCameraPayload::EncodeJpeg(int width, int height, int phase, int quality) {
+    std::vector<uint8_t> result;
+    if (width <= 0 || height <= 0) {
+        return result;
+    }
+
+    // 生成RGB画面：横向红色渐变、纵向绿色渐变，叠加一条随相位移动的白色竖条
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+    int barWidth = width / 16 + 1;
+    int barStart = (phase * barWidth) % width;
+    for (int y = 0; y < height; y++) {
+        uint8_t* row = pixels.data() + static_cast<size_t>(y) * width * 3;
+        for (int x = 0; x < width; x++) {
+            bool inBar = x >= barStart && x < barStart + barWidth;
+            row[x * 3] = inBar ? 255 : static_cast<uint8_t>(x * 255 / width);
+            row[x * 3 + 1] = inBar ? 255 : static_cast<uint8_t>(y * 255 / height);
+            row[x * 3 + 2] = inBar ? 255 : static_cast<uint8_t>(96 + (phase * 16) % 128);
+        }
+    }
+
+    jpeg_compress_struct cinfo;
+    JpegErrorManager errorManager;
+    unsigned char* outBuffer = nullptr;
+    unsigned long outSize = 0;
+    cinfo.err = jpeg_std_error(&errorManager.base);
+    errorManager.base.error_exit = OnJpegError;
+    if (setjmp(errorManager.jump)) {
+        jpeg_destroy_compress(&cinfo);
+        free(outBuffer);
+        return result;
+    }
+
+    jpeg_create_compress(&cinfo);
+    jpeg_mem_dest(&cinfo, &outBuffer, &outSize);
+    cinfo.image_width = width;
+    cinfo.image_height = height;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height) {
+        JSAMPROW row = pixels.data() + static_cast<size_t>(cinfo.next_scanline) * width * 3;
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    result.assign(outBuffer, outBuffer + outSize);
+    jpeg_destroy_compress(&cinfo);
+    free(outBuffer);
+    return result;
+}
+
+std::vector<uint8_t> MockCameraPayload::BuildExifBlob(const MockExifFields& fields,
+                                                      const std::vector<uint8_t>& thumbnail) {
+    std::vector<uint8_t> tiff = NewTiff();
+
+    // IFD0：厂商、型号、时间，以及ExifIFD指针（稍后回填）
+    std::vector<TiffEntry> ifd0 = {
+        AsciiEntry(TAG_MAKE, fields.make),
+        AsciiEntry(TAG_MODEL, fields.model),
+        ShortEntry(TAG_ORIENTATION, 1),
+        AsciiEntry(TAG_DATE_TIME, FormatExifTime(fields.captureTime)),
+        LongEntry(TAG_EXIF_IFD, 0),
+    };
+    std::vector<size_t> ifd0Pos;
+    size_t ifd0Offset = WriteIfd(tiff, ifd0, ifd0Pos);
+    PutU32(tiff, ifd0Pos[4], static_cast<uint32_t>(WriteExifIfd(tiff, fields)));
+
+    // IFD1：缩略图
+    if (!thumbnail.empty()) {
+        std::vector<TiffEntry> ifd1 = {
+            ShortEntry(TAG_COMPRESSION, COMPRESSION_OJPEG),
+            LongEntry(TAG_JPEG_IF_OFFSET, 0),
+            LongEntry(TAG_JPEG_IF_LENGTH, static_cast<uint32_t>(thumbnail.size())),
+        };
+        std::vector<size_t> ifd1Pos;
+        size_t ifd1Offset = WriteIfd(tiff, ifd1, ifd1Pos);
+        PutU32(tiff, NextIfdPos(ifd0Offset, ifd0.size()), static_cast<uint32_t>(ifd1Offset));
+        PutU32(tiff, ifd1Pos[1], static_cast<uint32_t>(tiff.size()));
+        tiff.insert(tiff.end(), thumbnail.begin(), thumbnail.end());
+    }
+
+    std::vector<uint8_t> blob = {'E', 'x', 'i', 'f', 0, 0};
+    blob.insert(blob.end(), tiff.begin(), tiff.end());
+    return blob;
+}
+
+std::vector<uint8_t> MockCameraPayload::BuildJpegHead(const std::vector<uint8_t>& exifBlob,
+                                                      const std::vector<uint8_t>& image) {
+    if (image.size() < 4 || image[0] != 0xFF || image[1] != 0xD8 || exifBlob.size() > MAX_APP1_PAYLOAD) {
+        return image;
+    }
+
+    // 跳过libjpeg写入的APP0(JFIF)，让APP1(Exif)紧跟SOI，与相机输出一致
+    size_t bodyStart = 2;
+    if (image[2] == 0xFF && image[3] == 0xE0 && image.size() > 6) {
+        bodyStart = 4 + ((image[4] << 8) | image[5]);
+        if (bodyStart > image.size()) {
+            bodyStart = 2;
+        }
+    }
+
+    std::vector<uint8_t> head;
+    head.reserve(4 + exifBlob.size() + image.size());
+    size_t segmentLength = exifBlob.size() + 2;
+    head.insert(head.end(), {0xFF, 0xD8, 0xFF, 0xE1, static_cast<uint8_t>(segmentLength >> 8),
+                             static_cast<uint8_t>(segmentLength & 0xFF)});
+    head.insert(head.end(), exifBlob.begin(), exifBlob.end());
+    head.insert(head.end(), image.begin() + bodyStart, image.end());
+    return head;
+}
+
+std::vector<uint8_t> MockCameraPayload::BuildRawHead(const MockExifFields& fields,
+                                                     const std::vector<uint8_t>& thumbnail,
+                                                     const std::vector<uint8_t>& preview) {
+    std::vector<uint8_t> tiff = NewTiff();
+
+    // IFD0：缩略图 + 基本信息，SubIFD/ExifIFD/缩略图偏移稍后回填
+    std::vector<TiffEntry> ifd0 = {
+        LongEntry(TAG_NEW_SUBFILE_TYPE, 1),
+        ShortEntry(TAG_IMAGE_WIDTH, 160),
+        ShortEntry(TAG_IMAGE_LENGTH, 120),
+        ShortEntry(TAG_COMPRESSION, COMPRESSION_OJPEG),
+        AsciiEntry(TAG_MAKE, fields.make),
+        AsciiEntry(TAG_MODEL, fields.model),
+        ShortEntry(TAG_ORIENTATION, 1),
+        AsciiEntry(TAG_DATE_TIME, FormatExifTime(fields.captureTime)),
+        LongEntry(TAG_SUB_IFDS, 0),
+        LongEntry(TAG_JPEG_IF_OFFSET, 0),
+        LongEntry(TAG_JPEG_IF_LENGTH, static_cast<uint32_t>(thumbnail.size())),
+        LongEntry(TAG_EXIF_IFD, 0),
+    };
+    std::vector<size_t> ifd0Pos;
+    WriteIfd(tiff, ifd0, ifd0Pos);
+
+    // SubIFD：大预览
+    std::vector<TiffEntry> subIfd = {
+        LongEntry(TAG_NEW_SUBFILE_TYPE, 1),
+        ShortEntry(TAG_COMPRESSION, COMPRESSION_OJPEG),
+        LongEntry(TAG_JPEG_IF_OFFSET, 0),
+        LongEntry(TAG_JPEG_IF_LENGTH, static_cast<uint32_t>(preview.size())),
+    };
+    std::vector<size_t> subPos;
+    PutU32(tiff, ifd0Pos[8], static_cast<uint32_t>(WriteIfd(tiff, subIfd, subPos)));
+    PutU32(tiff, ifd0Pos[11], static_cast<uint32_t>(WriteExifIfd(tiff, fields)));
+
+    PutU32(tiff, ifd0Pos[9], static_cast<uint32_t>(tiff.size()));
+    tiff.insert(tiff.end(), thumbnail.begin(), thumbnail.end());
+    PutU32(tiff, subPos[2], static_cast<uint32_t>(tiff.size()));
+    tiff.insert(tiff.end(), preview.begin(), preview.end());
+    return tiff;
+}
+
+std::vector<uint8_t> MockCameraPayload::BuildVideoHead() {
+    // ftyp(qt) + 延伸到文件末尾的mdat
+    return {0, 0, 0, 20, 'f', 't', 'y', 'p', 'q', 't', ' ', ' ', 0, 0, 2, 0, 'q', 't', ' ', ' ',
+            0, 0, 0, 0, 'm', 'd', 'a', 't'};
+}
+
+bool MockCameraPayload::ReadWholeFile(const std::string& path, std::vector<uint8_t>& out) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    out.clear();
+    uint8_t buffer[64 * 1024];
+    size_t readSize = 0;
+    while ((readSize = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        out.insert(out.end(), buffer, buffer + readSize);
+    }
+    fclose(file);
+    return !out.empty();
+}
@@ -0,0 +1,77 @@
+// MockCameraPayload.h
+// Created on 2026/1/21.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef MOCK_CAMERA_PAYLOAD_H
+#define MOCK_CAMERA_PAYLOAD_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 模拟文件的EXIF字段
+ */
+struct MockExifFields {
+    std::string make;
+    std::string model;
+    time_t captureTime = 0;
+    uint32_t exposureNum = 1;     // 快门（分子/分母，秒）
+    uint32_t exposureDen = 125;
+    uint32_t fNumberX10 = 40;     // 光圈×10
+    uint16_t iso = 100;
+    uint32_t focalLengthMm = 40;
+};
+
+/**
+ * @brief 模拟相机的文件内容生成
+ * @details 只生成文件"头部"（EXIF、内嵌预览等有意义的部分），其后按名义大小补零。
+ *          格式与真实相机一致，RawPreviewExtractor、libexif可以正常解析：
+ *          - JPEG：SOI + APP1(Exif，含160x120缩略图) + 图像数据
+ *          - RAW：小端TIFF，IFD0内嵌缩略图，SubIFD内嵌大预览，ExifIFD记录拍摄参数
+ *          - 视频：QuickTime ftyp头
+ */
+class MockCameraPayload {
+public:
+    /**
+     * @brief 用libjpeg编码一张合成图（渐变底色+随phase移动的竖条）
+     * @param phase 画面相位，不同相位得到不同画面（用于预览帧）
+     * @return JPEG数据，失败返回空
+     */
+    static std::vector<uint8_t> EncodeJpeg(int width, int height, int phase, int quality);
+
+    /**
+     * @brief 生成EXIF数据块（"Exif\0\0" + TIFF），与GP_FILE_TYPE_EXIF返回格式一致
+     * @param thumbnail 写入IFD1的缩略图（可为空）
+     */
+    static std::vector<uint8_t> BuildExifBlob(const MockExifFields& fields, const std::vector<uint8_t>& thumbnail);
+
+    /**
+     * @brief 生成JPEG文件头部：插入APP1后接图像数据（去掉原有APP0）
+     */
+    static std::vector<uint8_t> BuildJpegHead(const std::vector<uint8_t>& exifBlob, const std::vector<uint8_t>& image);
+
+    /**
+     * @brief 生成RAW（NEF风格TIFF）文件头部
+     * @param thumbnail IFD0内嵌缩略图
+     * @param preview SubIFD内嵌大预览
+     */
+    static std::vector<uint8_t> BuildRawHead(const MockExifFields& fields, const std::vector<uint8_t>& thumbnail,
+                                             const std::vector<uint8_t>& preview);
+
+    /**
+     * @brief 生成视频文件头部
+     */
+    static std::vector<uint8_t> BuildVideoHead();
+
+    /**
+     * @brief 读取整个文件（样本文件）
+     * @return 是否读取成功
+     */
+    static bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& out);
+};
+
+#endif // MOCK_CAMERA_PAYLOAD_H
@@ -0,0 +1,763 @@
+// PtpIpEmulator.cpp
+// Created on 2026/1/22.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "PtpIpEmulator.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t MAX_PACKET_SIZE = 64 * 1024 * 1024;   // 防止异常长度字段耗尽内存
+constexpr int ACCEPT_POLL_MS = 500;
+constexpr int EVENT_CONNECT_TIMEOUT_MS = 5000;
+constexpr int EVENT_RESCAN_MS = 1000;                    // 会话期间重新扫描目录的间隔
+constexpr size_t LIVEVIEW_HEADER_SIZE = 384;             // 尼康LiveView数据头，JPEG紧随其后
+constexpr uint8_t PTP_DPFF_NONE = 0x00;
+constexpr uint8_t PTP_DPFF_ENUMERATION = 0x02;
+constexpr uint16_t PTP_VENDOR_NIKON = 0x000A;
+constexpr uint16_t PTP_EC_OBJECT_ADDED = 0x4002;
+constexpr uint16_t PTP_DPC_NIKON_LIVE_VIEW_STATUS = 0xD1A2;
+constexpr uint8_t EMULATOR_GUID[16] = {0x50, 0x68, 0x6F, 0x74, 0x6F, 0x53, 0x65, 0x6E,
+                                       0x64, 0x45, 0x6D, 0x75, 0x00, 0x00, 0x00, 0x01};
+
+std::string FormatPtpTime(time_t value) {
+    struct tm tmValue;
+    localtime_r(&value, &tmValue);
+    char text[32];
+    strftime(text, sizeof(text), "%Y%m%dT%H%M%S", &tmValue);
+    return text;
+}
+
+bool ReadFully(int fd, uint8_t* buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t got = recv(fd, buffer + done, size - done, 0);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(got);
+    }
+    return true;
+}
+
+bool WriteFully(int fd, const uint8_t* buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t sent = send(fd, buffer + done, size - done, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        done += static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+void SetNoDelay(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+} // namespace
+
+PtpIpEmulator::PtpIpEmulator(const PtpIpEmulatorOptions& options)
+    : options_(options), liveViewOn_(false), sessionOpen_(false), random_(options.shaping.seed),
+      listenFd_(-1), running_(false) {
+    if (options_.shaping.chunkKb <= 0) {
+        options_.shaping.chunkKb = 64;
+    }
+    InitDeviceProps();
+}
+
+PtpIpEmulator::~PtpIpEmulator() {
+    if (listenFd_ >= 0) {
+        close(listenFd_);
+    }
+}
+
+bool PtpIpEmulator::Start() {
+    if (!store_.Scan(options_.rootDir)) {
+        fprintf(stderr, "目录不存在: %s\n", options_.rootDir.c_str());
+        return false;
+    }
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        perror("socket");
+        return false;
+    }
+    int one = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(options_.port));
+    if (inet_pton(AF_INET, options_.bindAddress.c_str(), &addr.sin_addr) != 1) {
+        fprintf(stderr, "无效的监听地址: %s\n", options_.bindAddress.c_str());
+        return false;
+    }
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd_, 2) != 0) {
+        perror("bind/listen");
+        return false;
+    }
+    running_ = true;
+    printf("PTP/IP模拟器监听 %s:%d，%zu个对象，共%.1f MB\n", options_.bindAddress.c_str(), options_.port,
+           store_.Count(), store_.TotalBytes() / 1048576.0);
+    printf("整形: rtt=%dms throughput=%dKB/s loss=%d%% rto=%dms chunk=%dKB\n", options_.shaping.rttMs,
+           options_.shaping.throughputKbps, options_.shaping.lossPercent, options_.shaping.rtoMs,
+           options_.shaping.chunkKb);
+    fflush(stdout);
+    return true;
+}
+
+void PtpIpEmulator::Stop() {
+    running_ = false;
+}
+
+void PtpIpEmulator::Run() {
+    while (running_) {
+        pollfd pfd{listenFd_, POLLIN, 0};
+        int ready = poll(&pfd, 1, ACCEPT_POLL_MS);
+        if (ready <= 0) {
+            continue;
+        }
+        int commandFd = accept(listenFd_, nullptr, nullptr);
+        if (commandFd < 0) {
+            continue;
+        }
+        SetNoDelay(commandFd);
+        int eventFd = -1;
+        if (Handshake(commandFd, eventFd)) {
+            ServeSession(commandFd, eventFd);
+        }
+        if (eventFd >= 0) {
+            close(eventFd);
+        }
+        close(commandFd);
+    }
+}
+
+bool PtpIpEmulator::Handshake(int commandFd, int& eventFd) {
+    uint32_t type = 0;
+    std::vector<uint8_t> payload;
+    if (!ReadPacket(commandFd, type, payload) || type != PTPIP_INIT_COMMAND_REQUEST) {
+        fprintf(stderr, "命令通道握手失败，包类型: %u\n", type);
+        return false;
+    }
+
+    PtpBuffer ack;
+    ack.PutU32(1);      // 连接号，事件通道用它关联
+    ack.PutBytes(EMULATOR_GUID, sizeof(EMULATOR_GUID));
+    ack.PutWideName(options_.model);
+    ack.PutU32(PTPIP_PROTOCOL_VERSION);
+    if (!SendPacket(commandFd, PTPIP_INIT_COMMAND_ACK, ack.Data().data(), ack.Size())) {
+        return false;
+    }
+
+    // 客户端收到命令确认后才连事件通道
+    pollfd pfd{listenFd_, POLLIN, 0};
+    if (poll(&pfd, 1, EVENT_CONNECT_TIMEOUT_MS) <= 0) {
+        fprintf(stderr, "等待事件通道超时\n");
+        return false;
+    }
+    eventFd = accept(listenFd_, nullptr, nullptr);
+    if (eventFd < 0) {
+        return false;
+    }
+    SetNoDelay(eventFd);
+    if (!ReadPacket(eventFd, type, payload) || type != PTPIP_INIT_EVENT_REQUEST) {
+        fprintf(stderr, "事件通道握手失败，包类型: %u\n", type);
+        return false;
+    }
+    return SendPacket(eventFd, PTPIP_INIT_EVENT_ACK, nullptr, 0);
+}
+
+void PtpIpEmulator::ServeSession(int commandFd, int eventFd) {
+    stats_ = SessionStats();
+    stats_.begin = std::chrono::steady_clock::now();
+    paceClock_ = stats_.begin;
+    sessionOpen_ = false;
+    liveViewOn_ = false;
+    printf("客户端已连接\n");
+    fflush(stdout);
+
+    std::thread eventThread(&PtpIpEmulator::EventLoop, this, eventFd);
+
+    uint32_t type = 0;
+    std::vector<uint8_t> payload;
+    while (running_ && ReadPacket(commandFd, type, payload)) {
+        if (type == PTPIP_PROBE_REQUEST) {
+            SendPacket(commandFd, PTPIP_PROBE_RESPONSE, nullptr, 0);
+            continue;
+        }
+        if (type != PTPIP_CMD_REQUEST || payload.size() < 10) {
+            fprintf(stderr, "忽略未知包，类型: %u\n", type);
+            continue;
+        }
+        Request request{};
+        request.dataPhase = PtpGetU32(payload.data());
+        request.code = PtpGetU16(payload.data() + 4);
+        request.transactionId = PtpGetU32(payload.data() + 6);
+        request.paramCount = static_cast<int>(std::min<size_t>((payload.size() - 10) / 4, 5));
+        for (int i = 0; i < request.paramCount; i++) {
+            request.params[i] = PtpGetU32(payload.data() + 10 + i * 4);
+        }
+        stats_.operations++;
+        if (!HandleRequest(commandFd, request)) {
+            break;
+        }
+    }
+
+    // 关闭事件通道读端，让事件线程退出
+    shutdown(eventFd, SHUT_RDWR);
+    eventThread.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - stats_.begin).count();
+    double megabytes = stats_.bytesSent / 1048576.0;
+    printf("客户端断开: %llu个操作，发送%.1f MB，用时%.2fs，平均%.2f MB/s，模拟丢包%llu次\n",
+           static_cast<unsigned long long>(stats_.operations), megabytes, seconds,
+           seconds > 0 ? megabytes / seconds : 0.0, static_cast<unsigned long long>(stats_.stalls));
+    fflush(stdout);
+}
+
+void PtpIpEmulator::EventLoop(int eventFd) {
+    // 应答探测包；空闲时重新扫描目录，新文件以ObjectAdded事件通知客户端
+    uint32_t type = 0;
+    std::vector<uint8_t> payload;
+    while (running_) {
+        struct pollfd pfd = {eventFd, POLLIN, 0};
+        int ready = poll(&pfd, 1, EVENT_RESCAN_MS);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready < 0) {
+            break;
+        }
+        if (ready == 0) {
+            if (!SendObjectAddedEvents(eventFd)) {
+                break;
+            }
+            continue;
+        }
+        if (!ReadPacket(eventFd, type, payload)) {
+            break;
+        }
+        if (type == PTPIP_PROBE_REQUEST) {
+            SendPacket(eventFd, PTPIP_PROBE_RESPONSE, nullptr, 0);
+        }
+    }
+}
+
+bool PtpIpEmulator::SendObjectAddedEvents(int eventFd) {
+    if (!sessionOpen_) {
+        return true;
+    }
+    std::vector<uint32_t> added;
+    {
+        // 命令线程正在处理（可能是长时间的传输）时跳过本轮，下一轮再扫
+        std::unique_lock<std::mutex> lock(storeMutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return true;
+        }
+        store_.Scan(options_.rootDir, &added);
+    }
+    for (uint32_t handle : added) {
+        PtpBuffer event;
+        event.PutU16(PTP_EC_OBJECT_ADDED);
+        event.PutU32(0);    // 事件不属于任何事务
+        event.PutU32(handle);
+        if (!SendPacket(eventFd, PTPIP_EVENT, event.Data().data(), event.Size())) {
+            return false;
+        }
+    }
+    if (!added.empty()) {
+        printf("新增%zu个对象，已发送ObjectAdded事件\n", added.size());
+        fflush(stdout);
+    }
+    return true;
+}
+
+// ======================== 操作处理 ========================
+
+bool PtpIpEmulator::HandleRequest(int fd, const Request& request) {
+    std::vector<uint8_t> dataIn;
+    if (request.dataPhase == PTPIP_DATA_PHASE_OUT && !ReceiveData(fd, dataIn)) {
+        return false;
+    }
+    DelayRoundTrip();
+    // 整个操作期间持有，事件线程的重新扫描不会让正在传输的对象失效
+    std::lock_guard<std::mutex> storeLock(storeMutex_);
+
+    uint32_t tid = request.transactionId;
+    if (!sessionOpen_ && request.code != PTP_OC_GET_DEVICE_INFO && request.code != PTP_OC_OPEN_SESSION) {
+        return SendResponse(fd, PTP_RC_SESSION_NOT_OPEN, tid);
+    }
+
+    switch (request.code) {
+        case PTP_OC_GET_DEVICE_INFO: {
+            PtpBuffer info;
+            BuildDeviceInfo(info);
+            return SendData(fd, tid, info.Data()) && SendResponse(fd, PTP_RC_OK, tid);
+        }
+        case PTP_OC_OPEN_SESSION:
+            // 开会话时重新扫描；会话期间的新文件由事件线程扫描并发送ObjectAdded
+            store_.Scan(options_.rootDir);
+            sessionOpen_ = true;
+            return SendResponse(fd, PTP_RC_OK, tid);
+        case PTP_OC_CLOSE_SESSION:
+            sessionOpen_ = false;
+            return SendResponse(fd, PTP_RC_OK, tid);
+        case PTP_OC_GET_STORAGE_IDS: {
+            PtpBuffer ids;
+            ids.PutU32Array({PTP_STORAGE_ID});
+            return SendData(fd, tid, ids.Data()) && SendResponse(fd, PTP_RC_OK, tid);
+        }
+        case PTP_OC_GET_STORAGE_INFO: {
+            if (request.paramCount < 1 || request.params[0] != PTP_STORAGE_ID) {
+                return SendResponse(fd, PTP_RC_INVALID_STORAGE_ID, tid);
+            }
+            PtpBuffer info;
+            BuildStorageInfo(info);
+            return SendData(fd, tid, info.Data()) && SendResponse(fd, PTP_RC_OK, tid);
+        }
+        case PTP_OC_GET_NUM_OBJECTS:
+        case PTP_OC_GET_OBJECT_HANDLES: {
+            uint32_t storage = request.paramCount > 0 ? request.params[0] : PTP_ALL_STORAGES;
+            if (storage != PTP_STORAGE_ID && storage != PTP_ALL_STORAGES) {
+                return SendResponse(fd, PTP_RC_INVALID_STORAGE_ID, tid);
+            }
+            uint16_t format = request.paramCount > 1 ? static_cast<uint16_t>(request.params[1]) : 0;
+            uint32_t parent = request.paramCount > 2 ? request.params[2] : 0;
+            std::vector<uint32_t> handles = store_.GetHandles(format, parent);
+            if (request.code == PTP_OC_GET_NUM_OBJECTS) {
+                return SendResponse(fd, PTP_RC_OK, tid, {static_cast<uint32_t>(handles.size())});
+            }
+            PtpBuffer list;
+            list.PutU32Array(handles);
+            return SendData(fd, tid, list.Data()) && SendResponse(fd, PTP_RC_OK, tid);
+        }
+        case PTP_OC_GET_OBJECT_INFO: {
+            const PtpObject* object = request.paramCount > 0 ? store_.Find(request.params[0]) : nullptr;
+            if (object == nullptr) {
+                return SendResponse(fd, PTP_RC_INVALID_OBJECT_HANDLE, tid);
+            }
+            PtpBuffer info;
+            BuildObjectInfo(*object, info);
+            return SendData(fd, tid, info.Data()) && SendResponse(fd, PTP_RC_OK, tid);
+        }
+        case PTP_OC_GET_OBJECT:
+        case PTP_OC_GET_PARTIAL_OBJECT:
+        case PTP_OC_GET_THUMB:
+            return HandleObjectData(fd, request);
+        case PTP_OC_GET_DEVICE_PROP_DESC:
+        case PTP_OC_GET_DEVICE_PROP_VALUE:
+        case PTP_OC_SET_DEVICE_PROP_VALUE:
+            return HandlePropRequest(fd, request, dataIn);
+        case PTP_OC_NIKON_DEVICE_READY:
+            return SendResponse(fd, PTP_RC_OK, tid);
+        case PTP_OC_NIKON_START_LIVE_VIEW:
+        case PTP_OC_NIKON_END_LIVE_VIEW:
+        case PTP_OC_NIKON_GET_LIVE_VIEW_IMAGE:
+            return HandleLiveView(fd, request);
+        default:
+            return SendResponse(fd, PTP_RC_OPERATION_NOT_SUPPORTED, tid);
+    }
+}
+
+bool PtpIpEmulator::HandleObjectData(int fd, const Request& request) {
+    uint32_t tid = request.transactionId;
+    const PtpObject* object = request.paramCount > 0 ? store_.Find(request.params[0]) : nullptr;
+    if (object == nullptr || object->isFolder) {
+        return SendResponse(fd, PTP_RC_INVALID_OBJECT_HANDLE, tid);
+    }
+
+    if (request.code == PTP_OC_GET_THUMB) {
+        std::vector<uint8_t> thumb;
+        if (!store_.ReadThumbnail(*object, thumb)) {
+            return SendResponse(fd, PTP_RC_NO_THUMBNAIL_PRESENT, tid);
+        }
+        return SendData(fd, tid, thumb) && SendResponse(fd, PTP_RC_OK, tid);
+    }
+
+    if (request.code == PTP_OC_GET_OBJECT) {
+        return SendObjectRange(fd, tid, *object, 0, object->size) && SendResponse(fd, PTP_RC_OK, tid);
+    }
+
+    // GetPartialObject(handle, offset, maxBytes)，响应参数为实际字节数
+    if (request.paramCount < 3) {
+        return SendResponse(fd, PTP_RC_INVALID_PARAMETER, tid);
+    }
+    uint64_t offset = request.params[1];
+    uint64_t length = offset < object->size ? std::min<uint64_t>(request.params[2], object->size - offset) : 0;
+    return SendObjectRange(fd, tid, *object, offset, length) &&
+           SendResponse(fd, PTP_RC_OK, tid, {static_cast<uint32_t>(length)});
+}
+
+bool PtpIpEmulator::HandlePropRequest(int fd, const Request& request, const std::vector<uint8_t>& dataIn) {
+    uint32_t tid = request.transactionId;
+    uint16_t code = request.paramCount > 0 ? static_cast<uint16_t>(request.params[0]) : 0;
+    auto it = props_.find(code);
+    if (it == props_.end()) {
+        return SendResponse(fd, PTP_RC_DEVICE_PROP_NOT_SUPPORTED, tid);
+    }
+    DeviceProp& prop = it->second;
+    if (code == PTP_DPC_NIKON_LIVE_VIEW_STATUS) {
+        prop.current = liveViewOn_ ? 1 : 0;
+    }
+
+    if (request.code == PTP_OC_GET_DEVICE_PROP_VALUE) {
+        PtpBuffer value;
+        PutPropValue(value, prop.dataType, prop.current);
+        return SendData(fd, tid, value.Data()) && SendResponse(fd, PTP_RC_OK, tid);
+    }
+
+    if (request.code == PTP_OC_GET_DEVICE_PROP_DESC) {
+        PtpBuffer desc;
+        desc.PutU16(code);
+        desc.PutU16(prop.dataType);
+        desc.PutU8(prop.writable ? 1 : 0);
+        PutPropValue(desc, prop.dataType, prop.factory);
+        PutPropValue(desc, prop.dataType, prop.current);
+        if (prop.choices.empty()) {
+            desc.PutU8(PTP_DPFF_NONE);
+        } else {
+            desc.PutU8(PTP_DPFF_ENUMERATION);
+            desc.PutU16(static_cast<uint16_t>(prop.choices.size()));
+            for (uint32_t choice : prop.choices) {
+                PutPropValue(desc, prop.dataType, choice);
+            }
+        }
+        return SendData(fd, tid, desc.Data()) && SendResponse(fd, PTP_RC_OK, tid);
+    }
+
+    // SetDevicePropValue
+    if (!prop.writable) {
+        return SendResponse(fd, PTP_RC_INVALID_DEVICE_PROP_VALUE, tid);
+    }
+    uint32_t value = 0;
+    switch (prop.dataType) {
+        case PTP_DTC_UINT8:
+            value = dataIn.size() >= 1 ? dataIn[0] : 0;
+            break;
+        case PTP_DTC_UINT32:
+            value = dataIn.size() >= 4 ? PtpGetU32(dataIn.data()) : 0;
+            break;
+        default:
+            value = dataIn.size() >= 2 ? PtpGetU16(dataIn.data()) : 0;
+            break;
+    }
+    if (!prop.choices.empty() && std::find(prop.choices.begin(), prop.choices.end(), value) == prop.choices.end()) {
+        return SendResponse(fd, PTP_RC_INVALID_DEVICE_PROP_VALUE, tid);
+    }
+    prop.current = value;
+    return SendResponse(fd, PTP_RC_OK, tid);
+}
+
+bool PtpIpEmulator::HandleLiveView(int fd, const Request& request) {
+    uint32_t tid = request.transactionId;
+    if (request.code == PTP_OC_NIKON_START_LIVE_VIEW) {
+        liveViewOn_ = true;
+        return SendResponse(fd, PTP_RC_OK, tid);
+    }
+    if (request.code == PTP_OC_NIKON_END_LIVE_VIEW) {
+        liveViewOn_ = false;
+        return SendResponse(fd, PTP_RC_OK, tid);
+    }
+    if (!liveViewOn_) {
+        return SendResponse(fd, PTP_RC_NIKON_NOT_LIVE_VIEW, tid);
+    }
+    const std::vector<uint8_t>& frame = LiveViewFrame();
+    if (frame.empty()) {
+        return SendResponse(fd, PTP_RC_GENERAL_ERROR, tid);
+    }
+    // ptp2在数据里查找JPEG SOI，头部内容保持为0即可
+    std::vector<uint8_t> data(LIVEVIEW_HEADER_SIZE, 0);
+    data.insert(data.end(), frame.begin(), frame.end());
+    return SendData(fd, tid, data) && SendResponse(fd, PTP_RC_OK, tid);
+}
+
+const std::vector<uint8_t>& PtpIpEmulator::LiveViewFrame() {
+    if (!liveFrame_.empty()) {
+        return liveFrame_;
+    }
+    if (!options_.liveviewFile.empty()) {
+        PtpObject file{};
+        file.path = options_.liveviewFile;
+        FILE* probe = fopen(file.path.c_str(), "rb");
+        if (probe != nullptr) {
+            fseeko(probe, 0, SEEK_END);
+            file.size = static_cast<uint64_t>(ftello(probe));
+            fclose(probe);
+            store_.ReadRange(file, 0, file.size, liveFrame_);
+        }
+        return liveFrame_;
+    }
+    for (uint32_t handle : store_.GetHandles(PTP_OFC_EXIF_JPEG, 0)) {
+        const PtpObject* object = store_.Find(handle);
+        if (object != nullptr && store_.ReadThumbnail(*object, liveFrame_)) {
+            break;
+        }
+    }
+    return liveFrame_;
+}
+
+// ======================== 数据集 ========================
+
+void PtpIpEmulator::InitDeviceProps() {
+    // 与camera_config中的属性码对应，取值为PTP标准编码
+    props_[0x5001] = {PTP_DTC_UINT8, false, 100, 80, {}};                                   // BatteryLevel
+    props_[0x5005] = {PTP_DTC_UINT16, true, 2, 2, {2, 4, 5, 6, 7}};                         // WhiteBalance
+    props_[0x5007] = {PTP_DTC_UINT16, true, 400, 400, {180, 280, 400, 560, 800, 1100, 1600}}; // FNumber
+    props_[0x500A] = {PTP_DTC_UINT16, true, 0x8010, 0x8010, {1, 0x8010, 0x8011}};          // FocusMode
+    props_[0x500B] = {PTP_DTC_UINT16, true, 3, 3, {2, 3, 4}};                               // ExposureMeteringMode
+    props_[0x500D] = {PTP_DTC_UINT32, true, 80, 80, {40, 80, 100, 167, 333, 10000}};       // ExposureTime
+    props_[0x500E] = {PTP_DTC_UINT16, true, 2, 2, {1, 2, 3, 4}};                            // ExposureProgramMode
+    props_[0x500F] = {PTP_DTC_UINT16, true, 400, 400, {100, 200, 400, 800, 1600, 3200, 6400}}; // ExposureIndex
+    props_[0x5010] = {PTP_DTC_INT16, true, 0, 0,                                            // ExposureBias
+                      {0xFC18, 0xFD65, 0xFEB3, 0, 333, 667, 1000}};
+    props_[0x5013] = {PTP_DTC_UINT16, true, 1, 1, {1, 2}};                                  // StillCaptureMode
+    props_[PTP_DPC_NIKON_LIVE_VIEW_STATUS] = {PTP_DTC_UINT8, false, 0, 0, {}};
+}
+
+void PtpIpEmulator::PutPropValue(PtpBuffer& out, uint16_t dataType, uint32_t value) {
+    switch (dataType) {
+        case PTP_DTC_UINT8:
+            out.PutU8(static_cast<uint8_t>(value));
+            break;
+        case PTP_DTC_UINT32:
+            out.PutU32(value);
+            break;
+        default:
+            out.PutU16(static_cast<uint16_t>(value));
+            break;
+    }
+}
+
+void PtpIpEmulator::BuildDeviceInfo(PtpBuffer& out) const {
+    std::vector<uint16_t> props;
+    for (const auto& item : props_) {
+        props.push_back(item.first);
+    }
+    out.PutU16(100);                    // StandardVersion
+    out.PutU32(PTP_VENDOR_NIKON);       // VendorExtensionID
+    out.PutU16(100);                    // VendorExtensionVersion
+    out.PutString("microsoft.com: 1.0");
+    out.PutU16(0);                      // FunctionalMode
+    out.PutU16Array({PTP_OC_GET_DEVICE_INFO, PTP_OC_OPEN_SESSION, PTP_OC_CLOSE_SESSION, PTP_OC_GET_STORAGE_IDS,
+                     PTP_OC_GET_STORAGE_INFO, PTP_OC_GET_NUM_OBJECTS, PTP_OC_GET_OBJECT_HANDLES,
+                     PTP_OC_GET_OBJECT_INFO, PTP_OC_GET_OBJECT, PTP_OC_GET_THUMB, PTP_OC_GET_DEVICE_PROP_DESC,
+                     PTP_OC_GET_DEVICE_PROP_VALUE, PTP_OC_SET_DEVICE_PROP_VALUE, PTP_OC_GET_PARTIAL_OBJECT,
+                     PTP_OC_NIKON_DEVICE_READY, PTP_OC_NIKON_START_LIVE_VIEW, PTP_OC_NIKON_END_LIVE_VIEW,
+                     PTP_OC_NIKON_GET_LIVE_VIEW_IMAGE});
+    out.PutU16Array({PTP_EC_OBJECT_ADDED});
+    out.PutU16Array(props);
+    out.PutU16Array({PTP_OFC_EXIF_JPEG});
+    out.PutU16Array({PTP_OFC_EXIF_JPEG, PTP_OFC_TIFF, PTP_OFC_UNDEFINED, PTP_OFC_QUICKTIME, PTP_OFC_ASSOCIATION});
+    out.PutString(options_.manufacturer);
+    out.PutString(options_.model);
+    out.PutString("V1.00");
+    out.PutString(options_.serial);
+}
+
+void PtpIpEmulator::BuildStorageInfo(PtpBuffer& out) const {
+    constexpr uint64_t capacity = 128ULL * 1024 * 1024 * 1024;
+    uint64_t used = std::min(store_.TotalBytes(), capacity);
+    out.PutU16(0x0004);                 // RemovableRAM
+    out.PutU16(0x0003);                 // DCF
+    out.PutU16(0x0000);                 // ReadWrite
+    out.PutU64(capacity);
+    out.PutU64(capacity - used);
+    out.PutU32(0xFFFFFFFF);             // FreeSpaceInImages：未知
+    out.PutString("SD");
+    out.PutString("NIKON Z");
+}
+
+void PtpIpEmulator::BuildObjectInfo(const PtpObject& object, PtpBuffer& out) const {
+    out.PutU32(PTP_STORAGE_ID);
+    out.PutU16(object.format);
+    out.PutU16(0);                      // ProtectionStatus
+    out.PutU32(object.size > 0xFFFFFFFFULL ? 0xFFFFFFFF : static_cast<uint32_t>(object.size));
+    out.PutU16(object.isFolder ? 0 : PTP_OFC_EXIF_JPEG);    // ThumbFormat
+    out.PutU32(0);                      // ThumbCompressedSize：取缩略图时才解析
+    out.PutU32(object.isFolder ? 0 : 160);
+    out.PutU32(object.isFolder ? 0 : 120);
+    out.PutU32(0);                      // ImagePixWidth
+    out.PutU32(0);                      // ImagePixHeight
+    out.PutU32(0);                      // ImageBitDepth
+    out.PutU32(object.parent);
+    out.PutU16(object.isFolder ? PTP_AT_GENERIC_FOLDER : 0);
+    out.PutU32(0);                      // AssociationDesc
+    out.PutU32(0);                      // SequenceNumber
+    out.PutString(object.name);
+    std::string timeText = FormatPtpTime(object.mtime);
+    out.PutString(timeText);            // CaptureDate
+    out.PutString(timeText);            // ModificationDate
+    out.PutString("");                  // Keywords
+}
+
+// ======================== 收发 ========================
+
+bool PtpIpEmulator::ReadPacket(int fd, uint32_t& type, std::vector<uint8_t>& payload) {
+    uint8_t header[PTPIP_HEADER_SIZE];
+    if (!ReadFully(fd, header, sizeof(header))) {
+        return false;
+    }
+    uint32_t length = PtpGetU32(header);
+    type = PtpGetU32(header + 4);
+    if (length < PTPIP_HEADER_SIZE || length > MAX_PACKET_SIZE) {
+        return false;
+    }
+    payload.resize(length - PTPIP_HEADER_SIZE);
+    return payload.empty() || ReadFully(fd, payload.data(), payload.size());
+}
+
+bool PtpIpEmulator::SendPacket(int fd, uint32_t type, const uint8_t* payload, size_t size) {
+    PtpBuffer packet;
+    packet.PutU32(static_cast<uint32_t>(PTPIP_HEADER_SIZE + size));
+    packet.PutU32(type);
+    if (size > 0) {
+        packet.PutBytes(payload, size);
+    }
+    return WriteFully(fd, packet.Data().data(), packet.Size());
+}
+
+bool PtpIpEmulator::SendResponse(int fd, uint16_t code, uint32_t transactionId, const std::vector<uint32_t>& params) {
+    PtpBuffer response;
+    response.PutU16(code);
+    response.PutU32(transactionId);
+    for (uint32_t param : params) {
+        response.PutU32(param);
+    }
+    return SendPacket(fd, PTPIP_CMD_RESPONSE, response.Data().data(), response.Size());
+}
+
+bool PtpIpEmulator::SendChunk(int fd, uint32_t type, uint32_t transactionId, const uint8_t* bytes, size_t size) {
+    PaceChunk(size);
+    uint8_t header[PTPIP_HEADER_SIZE + 4];
+    PtpBuffer prefix;
+    prefix.PutU32(static_cast<uint32_t>(sizeof(header) + size));
+    prefix.PutU32(type);
+    prefix.PutU32(transactionId);
+    memcpy(header, prefix.Data().data(), sizeof(header));
+    if (!WriteFully(fd, header, sizeof(header)) || (size > 0 && !WriteFully(fd, bytes, size))) {
+        return false;
+    }
+    stats_.bytesSent += size;
+    return true;
+}
+
+bool PtpIpEmulator::SendData(int fd, uint32_t transactionId, const std::vector<uint8_t>& data) {
+    PtpBuffer start;
+    start.PutU32(transactionId);
+    start.PutU64(data.size());
+    if (!SendPacket(fd, PTPIP_START_DATA_PACKET, start.Data().data(), start.Size())) {
+        return false;
+    }
+    size_t chunk = static_cast<size_t>(options_.shaping.chunkKb) * 1024;
+    size_t offset = 0;
+    do {
+        size_t size = std::min(chunk, data.size() - offset);
+        bool last = offset + size >= data.size();
+        if (!SendChunk(fd, last ? PTPIP_END_DATA_PACKET : PTPIP_DATA_PACKET, transactionId,
+                       data.data() + offset, size)) {
+            return false;
+        }
+        offset += size;
+    } while (offset < data.size());
+    return true;
+}
+
+bool PtpIpEmulator::SendObjectRange(int fd, uint32_t transactionId, const PtpObject& object, uint64_t offset,
+                                    uint64_t length) {
+    PtpBuffer start;
+    start.PutU32(transactionId);
+    start.PutU64(length);
+    if (!SendPacket(fd, PTPIP_START_DATA_PACKET, start.Data().data(), start.Size())) {
+        return false;
+    }
+    uint64_t chunk = static_cast<uint64_t>(options_.shaping.chunkKb) * 1024;
+    uint64_t sent = 0;
+    std::vector<uint8_t> buffer;
+    do {
+        uint64_t size = std::min(chunk, length - sent);
+        if (!store_.ReadRange(object, offset + sent, size, buffer) || buffer.size() != size) {
+            // 文件在传输中被改动：补0保持长度一致，避免客户端解析错位
+            buffer.resize(static_cast<size_t>(size), 0);
+        }
+        bool last = sent + size >= length;
+        if (!SendChunk(fd, last ? PTPIP_END_DATA_PACKET : PTPIP_DATA_PACKET, transactionId, buffer.data(),
+                       buffer.size())) {
+            return false;
+        }
+        sent += size;
+    } while (sent < length);
+    return true;
+}
+
+bool PtpIpEmulator::ReceiveData(int fd, std::vector<uint8_t>& data) {
+    data.clear();
+    uint32_t type = 0;
+    std::vector<uint8_t> payload;
+    if (!ReadPacket(fd, type, payload) || type != PTPIP_START_DATA_PACKET) {
+        return false;
+    }
+    while (ReadPacket(fd, type, payload)) {
+        if (type != PTPIP_DATA_PACKET && type != PTPIP_END_DATA_PACKET) {
+            return false;
+        }
+        if (payload.size() > 4) {
+            data.insert(data.end(), payload.begin() + 4, payload.end());
+        }
+        if (type == PTPIP_END_DATA_PACKET) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ======================== 链路整形 ========================
+
+void PtpIpEmulator::DelayRoundTrip() const {
+    if (options_.shaping.rttMs > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(options_.shaping.rttMs));
+    }
+}
+
+void PtpIpEmulator::PaceChunk(size_t bytes) {
+    const PtpIpShaping& shaping = options_.shaping;
+    if (shaping.lossPercent > 0 && NextRandom() % 100 < static_cast<uint32_t>(shaping.lossPercent)) {
+        stats_.stalls++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(shaping.rtoMs));
+    }
+    if (shaping.throughputKbps <= 0) {
+        return;
+    }
+    // 令牌桶：按累计字节数推进发送时钟，空闲期不积攒额度
+    auto now = std::chrono::steady_clock::now();
+    if (paceClock_ < now) {
+        paceClock_ = now;
+    }
+    paceClock_ += std::chrono::microseconds(static_cast<int64_t>(bytes) * 1000000 / (shaping.throughputKbps * 1024LL));
+    std::this_thread::sleep_until(paceClock_);
+}
+
+uint32_t PtpIpEmulator::NextRandom() {
+    random_ = random_ * 1664525u + 1013904223u;
+    return random_ >> 8;
+}
@@ -0,0 +1,164 @@
+// PtpIpEmulator.h
+// Created on 2026/1/22.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef PTPIP_EMULATOR_H
+#define PTPIP_EMULATOR_H
+
+#include "PtpIpProtocol.h"
+#include "PtpObjectStore.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 链路整形参数
+ * @details TCP本身不会丢包，丢包以"重传超时"的形式体现：每个数据包按lossPercent概率额外停顿rtoMs。
+ */
+struct PtpIpShaping {
+    int rttMs = 0;                  // 每个操作的往返延迟
+    int throughputKbps = 0;         // 数据阶段吞吐（KB/s），0表示不限
+    int lossPercent = 0;            // 数据包"丢失"概率
+    int rtoMs = 200;                // 丢包后的重传等待
+    int chunkKb = 64;               // 数据包大小
+    uint32_t seed = 1;
+};
+
+/**
+ * @brief 模拟器参数
+ */
+struct PtpIpEmulatorOptions {
+    std::string rootDir;                    // 作为存储卡内容的本地目录
+    std::string bindAddress = "127.0.0.1";
+    int port = 15740;
+    std::string manufacturer = "Nikon Corporation";
+    std::string model = "Z f";
+    std::string serial = "PTPIP0001";
+    std::string liveviewFile;               // 实时预览帧（JPEG），为空时使用第一张JPEG的缩略图
+    PtpIpShaping shaping;
+};
+
+/**
+ * @brief 本地PTP/IP相机模拟器
+ * @details 在TCP端口上实现PTP/IP响应端：命令/事件通道握手、会话、存储与对象枚举、
+ *          GetObject/GetPartialObject/GetThumb、设备属性以及尼康实时预览操作。
+ *          开会话时扫描目录；会话期间事件线程定期重新扫描，新放进目录的文件以ObjectAdded
+ *          事件通知客户端（模拟联机拍摄），命令处理中的传输不会被扫描打断。
+ *          只依赖POSIX socket，供真实的ptp2 camlib在Linux上做端到端传输基准测试。
+ *          同一时间只服务一个客户端（与真实机身一致），断开后继续等待下一个连接。
+ */
+class PtpIpEmulator {
+public:
+    explicit PtpIpEmulator(const PtpIpEmulatorOptions& options);
+    ~PtpIpEmulator();
+
+    /**
+     * @brief 扫描目录并开始监听
+     */
+    bool Start();
+
+    /**
+     * @brief 接受并服务客户端，直到Stop()
+     */
+    void Run();
+
+    void Stop();
+
+private:
+    /**
+     * @brief 设备属性（数值统一存为uint32，按数据类型编码）
+     */
+    struct DeviceProp {
+        uint16_t dataType;
+        bool writable;
+        uint32_t factory;
+        uint32_t current;
+        std::vector<uint32_t> choices;      // 为空表示无枚举约束
+    };
+
+    /**
+     * @brief 单个会话的传输统计
+     */
+    struct SessionStats {
+        uint64_t operations = 0;
+        uint64_t bytesSent = 0;
+        uint64_t stalls = 0;                // 模拟丢包次数
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    struct Request {
+        uint32_t dataPhase;
+        uint16_t code;
+        uint32_t transactionId;
+        uint32_t params[5];
+        int paramCount;
+    };
+
+    bool Handshake(int commandFd, int& eventFd);
+    void ServeSession(int commandFd, int eventFd);
+    void EventLoop(int eventFd);
+    bool SendObjectAddedEvents(int eventFd);
+
+    /**
+     * @return false表示连接已不可用
+     */
+    bool HandleRequest(int fd, const Request& request);
+    bool HandleObjectData(int fd, const Request& request);
+    bool HandlePropRequest(int fd, const Request& request, const std::vector<uint8_t>& dataIn);
+    bool HandleLiveView(int fd, const Request& request);
+
+    void InitDeviceProps();
+    void BuildDeviceInfo(PtpBuffer& out) const;
+    void BuildStorageInfo(PtpBuffer& out) const;
+    void BuildObjectInfo(const PtpObject& object, PtpBuffer& out) const;
+    static void PutPropValue(PtpBuffer& out, uint16_t dataType, uint32_t value);
+    const std::vector<uint8_t>& LiveViewFrame();
+
+    // ======================== 收发 ========================
+
+    bool ReadPacket(int fd, uint32_t& type, std::vector<uint8_t>& payload);
+    bool SendPacket(int fd, uint32_t type, const uint8_t* payload, size_t size);
+    bool SendResponse(int fd, uint16_t code, uint32_t transactionId, const std::vector<uint32_t>& params = {});
+
+    /**
+     * @brief 数据阶段（设备→主机）：Start_Data + Data* + End_Data，按整形参数分包
+     */
+    bool SendData(int fd, uint32_t transactionId, const std::vector<uint8_t>& data);
+
+    /**
+     * @brief 从文件流式发送一段数据，避免大文件整读进内存
+     */
+    bool SendObjectRange(int fd, uint32_t transactionId, const PtpObject& object, uint64_t offset, uint64_t length);
+
+    /**
+     * @brief 数据阶段（主机→设备）
+     */
+    bool ReceiveData(int fd, std::vector<uint8_t>& data);
+
+    bool SendChunk(int fd, uint32_t type, uint32_t transactionId, const uint8_t* bytes, size_t size);
+    void DelayRoundTrip() const;
+    void PaceChunk(size_t bytes);
+    uint32_t NextRandom();
+
+private:
+    PtpIpEmulatorOptions options_;
+    PtpObjectStore store_;
+    std::mutex storeMutex_;                 // 命令处理与事件线程的重新扫描互斥
+    std::map<uint16_t, DeviceProp> props_;
+    std::vector<uint8_t> liveFrame_;
+    bool liveViewOn_;
+    std::atomic<bool> sessionOpen_;
+    SessionStats stats_;
+    std::chrono::steady_clock::time_point paceClock_;
+    uint32_t random_;
+    int listenFd_;
+    std::atomic<bool> running_;
+};
+
+#endif // PTPIP_EMULATOR_H
@@ -0,0 +1,167 @@
+// PtpIpProtocol.h
+// Created on 2026/1/22.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef PTPIP_PROTOCOL_H
+#define PTPIP_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// PTP/IP包类型（CIPA DC-005）
+constexpr uint32_t PTPIP_INIT_COMMAND_REQUEST = 1;
+constexpr uint32_t PTPIP_INIT_COMMAND_ACK = 2;
+constexpr uint32_t PTPIP_INIT_EVENT_REQUEST = 3;
+constexpr uint32_t PTPIP_INIT_EVENT_ACK = 4;
+constexpr uint32_t PTPIP_INIT_FAIL = 5;
+constexpr uint32_t PTPIP_CMD_REQUEST = 6;
+constexpr uint32_t PTPIP_CMD_RESPONSE = 7;
+constexpr uint32_t PTPIP_EVENT = 8;
+constexpr uint32_t PTPIP_START_DATA_PACKET = 9;
+constexpr uint32_t PTPIP_DATA_PACKET = 10;
+constexpr uint32_t PTPIP_CANCEL_TRANSACTION = 11;
+constexpr uint32_t PTPIP_END_DATA_PACKET = 12;
+constexpr uint32_t PTPIP_PROBE_REQUEST = 13;
+constexpr uint32_t PTPIP_PROBE_RESPONSE = 14;
+
+constexpr uint32_t PTPIP_HEADER_SIZE = 8;              // 长度 + 类型
+constexpr uint32_t PTPIP_PROTOCOL_VERSION = 0x00010000;
+constexpr uint32_t PTPIP_DATA_PHASE_OUT = 2;           // 操作请求带主机→设备数据
+
+// 操作码
+constexpr uint16_t PTP_OC_GET_DEVICE_INFO = 0x1001;
+constexpr uint16_t PTP_OC_OPEN_SESSION = 0x1002;
+constexpr uint16_t PTP_OC_CLOSE_SESSION = 0x1003;
+constexpr uint16_t PTP_OC_GET_STORAGE_IDS = 0x1004;
+constexpr uint16_t PTP_OC_GET_STORAGE_INFO = 0x1005;
+constexpr uint16_t PTP_OC_GET_NUM_OBJECTS = 0x1006;
+constexpr uint16_t PTP_OC_GET_OBJECT_HANDLES = 0x1007;
+constexpr uint16_t PTP_OC_GET_OBJECT_INFO = 0x1008;
+constexpr uint16_t PTP_OC_GET_OBJECT = 0x1009;
+constexpr uint16_t PTP_OC_GET_THUMB = 0x100A;
+constexpr uint16_t PTP_OC_GET_DEVICE_PROP_DESC = 0x1014;
+constexpr uint16_t PTP_OC_GET_DEVICE_PROP_VALUE = 0x1015;
+constexpr uint16_t PTP_OC_SET_DEVICE_PROP_VALUE = 0x1016;
+constexpr uint16_t PTP_OC_GET_PARTIAL_OBJECT = 0x101B;
+constexpr uint16_t PTP_OC_NIKON_DEVICE_READY = 0x90C8;
+constexpr uint16_t PTP_OC_NIKON_START_LIVE_VIEW = 0x9201;
+constexpr uint16_t PTP_OC_NIKON_END_LIVE_VIEW = 0x9202;
+constexpr uint16_t PTP_OC_NIKON_GET_LIVE_VIEW_IMAGE = 0x9203;
+
+// 响应码
+constexpr uint16_t PTP_RC_OK = 0x2001;
+constexpr uint16_t PTP_RC_GENERAL_ERROR = 0x2002;
+constexpr uint16_t PTP_RC_SESSION_NOT_OPEN = 0x2003;
+constexpr uint16_t PTP_RC_OPERATION_NOT_SUPPORTED = 0x2005;
+constexpr uint16_t PTP_RC_INVALID_STORAGE_ID = 0x2008;
+constexpr uint16_t PTP_RC_INVALID_OBJECT_HANDLE = 0x2009;
+constexpr uint16_t PTP_RC_DEVICE_PROP_NOT_SUPPORTED = 0x200A;
+constexpr uint16_t PTP_RC_NO_THUMBNAIL_PRESENT = 0x2010;
+constexpr uint16_t PTP_RC_INVALID_PARAMETER = 0x201D;
+constexpr uint16_t PTP_RC_INVALID_DEVICE_PROP_VALUE = 0x201C;
+constexpr uint16_t PTP_RC_NIKON_NOT_LIVE_VIEW = 0xA00B;
+
+// 对象格式
+constexpr uint16_t PTP_OFC_UNDEFINED = 0x3000;
+constexpr uint16_t PTP_OFC_ASSOCIATION = 0x3001;
+constexpr uint16_t PTP_OFC_QUICKTIME = 0x300D;
+constexpr uint16_t PTP_OFC_EXIF_JPEG = 0x3801;
+constexpr uint16_t PTP_OFC_TIFF = 0x380D;
+constexpr uint16_t PTP_AT_GENERIC_FOLDER = 0x0001;
+
+// 属性数据类型
+constexpr uint16_t PTP_DTC_UINT8 = 0x0002;
+constexpr uint16_t PTP_DTC_INT16 = 0x0003;
+constexpr uint16_t PTP_DTC_UINT16 = 0x0004;
+constexpr uint16_t PTP_DTC_UINT32 = 0x0006;
+
+constexpr uint32_t PTP_STORAGE_ID = 0x00010001;
+constexpr uint32_t PTP_ALL_STORAGES = 0xFFFFFFFF;
+constexpr uint32_t PTP_ROOT_PARENT = 0xFFFFFFFF;       // GetObjectHandles：只列根目录
+
+/**
+ * @brief PTP数据集/PTP-IP包的小端序列化
+ */
+class PtpBuffer {
+public:
+    void PutU8(uint8_t value) { data_.push_back(value); }
+
+    void PutU16(uint16_t value) {
+        data_.push_back(static_cast<uint8_t>(value & 0xFF));
+        data_.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void PutU32(uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            data_.push_back(static_cast<uint8_t>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void PutU64(uint64_t value) {
+        PutU32(static_cast<uint32_t>(value & 0xFFFFFFFF));
+        PutU32(static_cast<uint32_t>(value >> 32));
+    }
+
+    /**
+     * @brief PTP字符串：1字节字符数（含结尾0）+ UTF-16LE，空串只写一个0
+     */
+    void PutString(const std::string& text) {
+        if (text.empty()) {
+            PutU8(0);
+            return;
+        }
+        size_t length = text.size() < 254 ? text.size() : 254;
+        PutU8(static_cast<uint8_t>(length + 1));
+        for (size_t i = 0; i < length; i++) {
+            PutU16(static_cast<uint8_t>(text[i]));
+        }
+        PutU16(0);
+    }
+
+    /**
+     * @brief PTP-IP初始化包里的名称：UTF-16LE，以0结尾，无长度前缀
+     */
+    void PutWideName(const std::string& text) {
+        for (char c : text) {
+            PutU16(static_cast<uint8_t>(c));
+        }
+        PutU16(0);
+    }
+
+    void PutU16Array(const std::vector<uint16_t>& values) {
+        PutU32(static_cast<uint32_t>(values.size()));
+        for (uint16_t value : values) {
+            PutU16(value);
+        }
+    }
+
+    void PutU32Array(const std::vector<uint32_t>& values) {
+        PutU32(static_cast<uint32_t>(values.size()));
+        for (uint32_t value : values) {
+            PutU32(value);
+        }
+    }
+
+    void PutBytes(const uint8_t* bytes, size_t size) { data_.insert(data_.end(), bytes, bytes + size); }
+
+    const std::vector<uint8_t>& Data() const { return data_; }
+    size_t Size() const { return data_.size(); }
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+inline uint16_t PtpGetU16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+inline uint32_t PtpGetU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+#endif // PTPIP_PROTOCOL_H
@@ -0,0 +1,322 @@
+// PtpObjectStore.cpp
+// Created on 2026/1/22.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "PtpObjectStore.h"
+#include "PtpIpProtocol.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+
+namespace {
+
+constexpr size_t THUMB_PROBE_SIZE = 256 * 1024;   // 读取文件头部查找EXIF/TIFF缩略图
+constexpr uint16_t TIFF_TAG_SUB_IFDS = 0x014A;
+constexpr uint16_t TIFF_TAG_JPEG_OFFSET = 0x0201;
+constexpr uint16_t TIFF_TAG_JPEG_LENGTH = 0x0202;
+constexpr uint16_t TIFF_TYPE_LONG = 4;
+
+std::string ToLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+/**
+ * @brief 只读TIFF解析器，用于定位内嵌JPEG（与RawPreviewExtractor的思路一致，这里只需偏移和长度）
+ */
+class TiffThumbLocator {
+public:
+    TiffThumbLocator(const uint8_t* tiff, size_t size) : tiff_(tiff), size_(size), bigEndian_(false) {}
+
+    /**
+     * @brief 在IFD0、IFD1以及IFD0的SubIFD里找最小的内嵌JPEG
+     * @param offset 输出：相对TIFF头的偏移
+     */
+    bool Locate(uint32_t& offset, uint32_t& length) {
+        if (size_ < 8) {
+            return false;
+        }
+        if (tiff_[0] == 'I' && tiff_[1] == 'I') {
+            bigEndian_ = false;
+        } else if (tiff_[0] == 'M' && tiff_[1] == 'M') {
+            bigEndian_ = true;
+        } else {
+            return false;
+        }
+        offset = 0;
+        length = 0;
+        uint32_t ifd0 = U32(4);
+        uint32_t ifd1 = VisitIfd(ifd0, true, offset, length);
+        if (ifd1 != 0) {
+            VisitIfd(ifd1, false, offset, length);
+        }
+        return length > 0;
+    }
+
+private:
+    /**
+     * @return 下一个IFD的偏移
+     */
+    uint32_t VisitIfd(uint32_t ifd, bool followSubIfds, uint32_t& bestOffset, uint32_t& bestLength) {
+        if (ifd == 0 || ifd + 2 > size_) {
+            return 0;
+        }
+        uint16_t count = U16(ifd);
+        if (ifd + 2 + count * 12u + 4 > size_) {
+            return 0;
+        }
+        uint32_t jpegOffset = 0;
+        uint32_t jpegLength = 0;
+        for (uint16_t i = 0; i < count; i++) {
+            uint32_t entry = ifd + 2 + i * 12u;
+            uint16_t tag = U16(entry);
+            if (tag == TIFF_TAG_JPEG_OFFSET) {
+                jpegOffset = U32(entry + 8);
+            } else if (tag == TIFF_TAG_JPEG_LENGTH) {
+                jpegLength = U32(entry + 8);
+            } else if (tag == TIFF_TAG_SUB_IFDS && followSubIfds && U16(entry + 2) == TIFF_TYPE_LONG) {
+                uint32_t subCount = U32(entry + 4);
+                uint32_t list = subCount == 1 ? entry + 8 : U32(entry + 8);
+                for (uint32_t s = 0; s < subCount && list + s * 4 + 4 <= size_; s++) {
+                    VisitIfd(U32(list + s * 4), false, bestOffset, bestLength);
+                }
+            }
+        }
+        if (jpegLength > 0 && (bestLength == 0 || jpegLength < bestLength)) {
+            bestOffset = jpegOffset;
+            bestLength = jpegLength;
+        }
+        return U32(ifd + 2 + count * 12u);
+    }
+
+    uint16_t U16(uint32_t pos) const {
+        if (pos + 2 > size_) {
+            return 0;
+        }
+        return bigEndian_ ? static_cast<uint16_t>((tiff_[pos] << 8) | tiff_[pos + 1])
+                          : static_cast<uint16_t>(tiff_[pos] | (tiff_[pos + 1] << 8));
+    }
+
+    uint32_t U32(uint32_t pos) const {
+        if (pos + 4 > size_) {
+            return 0;
+        }
+        if (bigEndian_) {
+            return (static_cast<uint32_t>(tiff_[pos]) << 24) | (static_cast<uint32_t>(tiff_[pos + 1]) << 16) |
+                   (static_cast<uint32_t>(tiff_[pos + 2]) << 8) | tiff_[pos + 3];
+        }
+        return PtpGetU32(tiff_ + pos);
+    }
+
+private:
+    const uint8_t* tiff_;
+    size_t size_;
+    bool bigEndian_;
+};
+
+/**
+ * @brief 在JPEG头部找APP1 EXIF段，返回TIFF头在文件中的偏移
+ */
+bool FindExifTiff(const std::vector<uint8_t>& head, size_t& tiffStart) {
+    if (head.size() < 4 || head[0] != 0xFF || head[1] != 0xD8) {
+        return false;
+    }
+    size_t pos = 2;
+    while (pos + 4 <= head.size() && head[pos] == 0xFF) {
+        uint8_t marker = head[pos + 1];
+        size_t segmentLength = (static_cast<size_t>(head[pos + 2]) << 8) | head[pos + 3];
+        if (marker == 0xDA || segmentLength < 2) {
+            break;
+        }
+        if (marker == 0xE1 && pos + 10 <= head.size() && memcmp(&head[pos + 4], "Exif\0\0", 6) == 0) {
+            tiffStart = pos + 10;
+            return true;
+        }
+        pos += 2 + segmentLength;
+    }
+    return false;
+}
+
+} // namespace
+
+PtpObjectStore::PtpObjectStore() : nextHandle_(1) {}
+
+bool PtpObjectStore::Scan(const std::string& rootDir, std::vector<uint32_t>* added) {
+    struct stat st;
+    if (stat(rootDir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return false;
+    }
+    std::map<uint32_t, PtpObject> scanned;
+    ScanFolder(rootDir, 0, scanned);
+    if (added != nullptr) {
+        // 句柄按路径保持稳定，上次没有的句柄就是新对象（父目录先于其中的文件）
+        for (const auto& item : scanned) {
+            if (objects_.count(item.first) == 0) {
+                added->push_back(item.first);
+            }
+        }
+    }
+    objects_.swap(scanned);
+    return true;
+}
+
+void PtpObjectStore::ScanFolder(const std::string& dir, uint32_t parent, std::map<uint32_t, PtpObject>& scanned) {
+    DIR* handle = opendir(dir.c_str());
+    if (handle == nullptr) {
+        return;
+    }
+    std::vector<std::string> names;
+    while (struct dirent* entry = readdir(handle)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        names.emplace_back(entry->d_name);
+    }
+    closedir(handle);
+    // 按文件名排序，保证首次扫描的句柄顺序与相机一致（DSC_0001在DSC_0002之前）
+    std::sort(names.begin(), names.end());
+
+    for (const auto& name : names) {
+        std::string path = dir + "/" + name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) {
+            continue;
+        }
+        bool isFolder = S_ISDIR(st.st_mode);
+        if (!isFolder && !S_ISREG(st.st_mode)) {
+            continue;
+        }
+        PtpObject object;
+        object.handle = HandleFor(path);
+        object.parent = parent;
+        object.path = path;
+        object.name = name;
+        object.isFolder = isFolder;
+        object.format = isFolder ? PTP_OFC_ASSOCIATION : FormatOf(name);
+        object.size = isFolder ? 0 : static_cast<uint64_t>(st.st_size);
+        object.mtime = st.st_mtime;
+        scanned[object.handle] = object;
+        if (isFolder) {
+            ScanFolder(path, object.handle, scanned);
+        }
+    }
+}
+
+uint32_t PtpObjectStore::HandleFor(const std::string& path) {
+    auto it = handleByPath_.find(path);
+    if (it != handleByPath_.end()) {
+        return it->second;
+    }
+    uint32_t handle = nextHandle_++;
+    handleByPath_[path] = handle;
+    return handle;
+}
+
+std::vector<uint32_t> PtpObjectStore::GetHandles(uint16_t format, uint32_t parent) const {
+    std::vector<uint32_t> handles;
+    for (const auto& item : objects_) {
+        const PtpObject& object = item.second;
+        if (format != 0 && object.format != format) {
+            continue;
+        }
+        if (parent == PTP_ROOT_PARENT) {
+            if (object.parent != 0) {
+                continue;
+            }
+        } else if (parent != 0 && object.parent != parent) {
+            continue;
+        }
+        handles.push_back(object.handle);
+    }
+    return handles;
+}
+
+const PtpObject* PtpObjectStore::Find(uint32_t handle) const {
+    auto it = objects_.find(handle);
+    return it == objects_.end() ? nullptr : &it->second;
+}
+
+bool PtpObjectStore::ReadRange(const PtpObject& object, uint64_t offset, uint64_t length,
+                               std::vector<uint8_t>& out) const {
+    out.clear();
+    if (object.isFolder) {
+        return false;
+    }
+    FILE* file = fopen(object.path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = true;
+    if (offset < object.size) {
+        uint64_t available = std::min(length, object.size - offset);
+        out.resize(static_cast<size_t>(available));
+        if (fseeko(file, static_cast<off_t>(offset), SEEK_SET) != 0) {
+            ok = false;
+        } else {
+            size_t got = fread(out.data(), 1, out.size(), file);
+            out.resize(got);
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
+bool PtpObjectStore::ReadThumbnail(const PtpObject& object, std::vector<uint8_t>& out) const {
+    out.clear();
+    std::vector<uint8_t> head;
+    if (!ReadRange(object, 0, THUMB_PROBE_SIZE, head) || head.size() < 8) {
+        return false;
+    }
+    size_t tiffStart = 0;
+    if (!FindExifTiff(head, tiffStart)) {
+        bool isTiff = (head[0] == 'I' && head[1] == 'I') || (head[0] == 'M' && head[1] == 'M');
+        if (!isTiff) {
+            return false;
+        }
+    }
+    uint32_t offset = 0;
+    uint32_t length = 0;
+    TiffThumbLocator locator(head.data() + tiffStart, head.size() - tiffStart);
+    if (!locator.Locate(offset, length)) {
+        return false;
+    }
+    // 缩略图可能超出探测范围（RAW的SubIFD预览），超出时再从文件读取
+    uint64_t absolute = tiffStart + static_cast<uint64_t>(offset);
+    if (absolute + length <= head.size()) {
+        out.assign(head.begin() + static_cast<long>(absolute), head.begin() + static_cast<long>(absolute + length));
+    } else if (!ReadRange(object, absolute, length, out) || out.size() != length) {
+        out.clear();
+        return false;
+    }
+    return out.size() >= 2 && out[0] == 0xFF && out[1] == 0xD8;
+}
+
+uint64_t PtpObjectStore::TotalBytes() const {
+    uint64_t total = 0;
+    for (const auto& item : objects_) {
+        total += item.second.size;
+    }
+    return total;
+}
+
+uint16_t PtpObjectStore::FormatOf(const std::string& name) {
+    size_t dot = name.rfind('.');
+    std::string ext = dot == std::string::npos ? "" : ToLower(name.substr(dot + 1));
+    if (ext == "jpg" || ext == "jpeg") {
+        return PTP_OFC_EXIF_JPEG;
+    }
+    if (ext == "tif" || ext == "tiff") {
+        return PTP_OFC_TIFF;
+    }
+    if (ext == "mov" || ext == "mp4") {
+        return PTP_OFC_QUICKTIME;
+    }
+    // 尼康机身把NEF/NRW报告为Undefined格式，由扩展名区分
+    return PTP_OFC_UNDEFINED;
+}
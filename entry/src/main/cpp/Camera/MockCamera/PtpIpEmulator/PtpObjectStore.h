@@ -0,0 +1,81 @@
+// PtpObjectStore.h
+// Created on 2026/1/22.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef PTP_OBJECT_STORE_H
+#define PTP_OBJECT_STORE_H
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 模拟存储卡上的一个对象（文件或目录）
+ */
+struct PtpObject {
+    uint32_t handle;
+    uint32_t parent;        // 父目录句柄，根目录下为0
+    std::string path;       // 本地绝对路径
+    std::string name;
+    bool isFolder;
+    uint16_t format;
+    uint64_t size;
+    time_t mtime;
+};
+
+/**
+ * @brief 把本地目录映射为一张PTP存储卡
+ * @details 目录结构原样作为存储卡结构（通常指向包含DCIM的目录）。
+ *          重新扫描时同一路径保持原句柄，新文件分配新句柄。
+ */
+class PtpObjectStore {
+public:
+    PtpObjectStore();
+
+    /**
+     * @brief 扫描目录
+     * @param added 输出：本次新出现的对象句柄（可为nullptr）
+     * @return 目录不存在时返回false
+     */
+    bool Scan(const std::string& rootDir, std::vector<uint32_t>* added = nullptr);
+
+    /**
+     * @brief 按GetObjectHandles语义列出句柄
+     * @param format 格式过滤，0表示不过滤
+     * @param parent 0表示全部对象，0xFFFFFFFF表示根目录，其余为目录句柄
+     */
+    std::vector<uint32_t> GetHandles(uint16_t format, uint32_t parent) const;
+
+    const PtpObject* Find(uint32_t handle) const;
+
+    /**
+     * @brief 读取文件的一段
+     * @return 实际读取的字节（到文件末尾时可能少于length）
+     */
+    bool ReadRange(const PtpObject& object, uint64_t offset, uint64_t length, std::vector<uint8_t>& out) const;
+
+    /**
+     * @brief 提取缩略图：JPEG取EXIF IFD1，RAW(TIFF)取IFD0/IFD1/SubIFD中最小的内嵌JPEG
+     */
+    bool ReadThumbnail(const PtpObject& object, std::vector<uint8_t>& out) const;
+
+    uint64_t TotalBytes() const;
+    size_t Count() const { return objects_.size(); }
+
+    static uint16_t FormatOf(const std::string& name);
+
+private:
+    void ScanFolder(const std::string& dir, uint32_t parent, std::map<uint32_t, PtpObject>& scanned);
+    uint32_t HandleFor(const std::string& path);
+
+private:
+    std::map<uint32_t, PtpObject> objects_;          // 句柄 -> 对象（按句柄有序）
+    std::map<std::string, uint32_t> handleByPath_;   // 本地路径 -> 句柄（跨扫描保持稳定）
+    uint32_t nextHandle_;
+};
+
+#endif // PTP_OBJECT_STORE_H
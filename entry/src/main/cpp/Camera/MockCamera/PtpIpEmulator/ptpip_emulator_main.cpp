@@ -0,0 +1,98 @@
+// ptpip_emulator_main.cpp
+// Created on 2026/1/22.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "PtpIpEmulator.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+PtpIpEmulator* g_emulator = nullptr;
+
+void HandleSignal(int) {
+    if (g_emulator != nullptr) {
+        g_emulator->Stop();
+    }
+}
+
+void PrintUsage(const char* program) {
+    printf("用法: %s --dir <目录> [选项]\n"
+           "  --bind <地址>            监听地址，默认127.0.0.1\n"
+           "  --port <端口>            默认15740\n"
+           "  --model <型号>           DeviceInfo中的型号，默认\"Z f\"\n"
+           "  --liveview <jpg>         实时预览帧，默认取第一张JPEG的缩略图\n"
+           "  --rtt-ms <毫秒>          每个操作的往返延迟\n"
+           "  --throughput-kbps <KB/s> 数据阶段吞吐上限\n"
+           "  --loss <百分比>          每个数据包的丢包（重传停顿）概率\n"
+           "  --rto-ms <毫秒>          丢包后的重传等待，默认200\n"
+           "  --chunk-kb <KB>          数据包大小，默认64\n"
+           "  --seed <整数>            丢包随机种子\n"
+           "客户端示例: gphoto2 --port ptpip:127.0.0.1 --camera \"PTP/IP Camera\" -L\n",
+           program);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    PtpIpEmulatorOptions options;
+    for (int i = 1; i < argc; i++) {
+        const char* key = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(key, "--help") == 0 || strcmp(key, "-h") == 0) {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+        if (value == nullptr) {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        i++;
+        if (strcmp(key, "--dir") == 0) {
+            options.rootDir = value;
+        } else if (strcmp(key, "--bind") == 0) {
+            options.bindAddress = value;
+        } else if (strcmp(key, "--port") == 0) {
+            options.port = atoi(value);
+        } else if (strcmp(key, "--model") == 0) {
+            options.model = value;
+        } else if (strcmp(key, "--liveview") == 0) {
+            options.liveviewFile = value;
+        } else if (strcmp(key, "--rtt-ms") == 0) {
+            options.shaping.rttMs = atoi(value);
+        } else if (strcmp(key, "--throughput-kbps") == 0) {
+            options.shaping.throughputKbps = atoi(value);
+        } else if (strcmp(key, "--loss") == 0) {
+            options.shaping.lossPercent = atoi(value);
+        } else if (strcmp(key, "--rto-ms") == 0) {
+            options.shaping.rtoMs = atoi(value);
+        } else if (strcmp(key, "--chunk-kb") == 0) {
+            options.shaping.chunkKb = atoi(value);
+        } else if (strcmp(key, "--seed") == 0) {
+            options.shaping.seed = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else {
+            fprintf(stderr, "未知参数: %s\n", key);
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.rootDir.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    PtpIpEmulator emulator(options);
+    if (!emulator.Start()) {
+        return 1;
+    }
+    g_emulator = &emulator;
+    signal(SIGINT, HandleSignal);
+    signal(SIGTERM, HandleSignal);
+    emulator.Run();
+    g_emulator = nullptr;
+    return 0;
+}
@@ -0,0 +1,351 @@
+// mockcam_library.cpp
+// Created on 2026/1/21.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+//
+// 模拟相机的libgphoto2驱动（camlib）入口。编译为mockcam.so后放入CAMLIBS目录，
+// 以型号"Nikon Mock Camera"、端口"ptpip:"连接即可；应用代码走的仍是真实的gp_camera_*调用。
+// 参数见MockCameraOptions（环境变量PHOTOSEND_MOCKCAM）。本文件只依赖libgphoto2和libjpeg，
+// 日志走gp_log，不依赖鸿蒙系统库。
+
+#include "MockCameraBackend.h"
+#include <gphoto2/gphoto2-library.h>
+#include <gphoto2/gphoto2-port-log.h>
+#include <cstdlib>
+#include <cstring>
+
+static const char* const MOCK_CAMERA_MODEL = "Nikon Mock Camera";
+static const char* const MOCK_OPTIONS_ENV = "PHOTOSEND_MOCKCAM";
+static const char* const LOG_DOMAIN_MOCK = "mockcam";
+
+struct _CameraPrivateLibrary {
+    MockCameraBackend* backend;
+};
+
+static MockCameraBackend* GetBackend(Camera* camera) {
+    return (camera && camera->pl) ? camera->pl->backend : nullptr;
+}
+
+static MockCameraBackend* GetBackend(void* data) {
+    return GetBackend(static_cast<Camera*>(data));
+}
+
+static int SetFileData(CameraFile* file, const std::vector<uint8_t>& data, const char* mimeType) {
+    // gp_file_set_data_and_size接管malloc出的缓冲区
+    char* buffer = static_cast<char*>(malloc(data.empty() ? 1 : data.size()));
+    if (!buffer) {
+        return GP_ERROR_NO_MEMORY;
+    }
+    if (!data.empty()) {
+        memcpy(buffer, data.data(), data.size());
+    }
+    int ret = gp_file_set_data_and_size(file, buffer, data.size());
+    if (ret != GP_OK) {
+        free(buffer);
+        return ret;
+    }
+    return gp_file_set_mime_type(file, mimeType);
+}
+
+// ======================== 文件系统回调 ========================
+
+static int FolderListFunc(CameraFilesystem*, const char* folder, CameraList* list, void* data, GPContext*) {
+    std::vector<std::string> names;
+    int ret = GetBackend(data)->ListFolders(folder, names);
+    for (const auto& name : names) {
+        gp_list_append(list, name.c_str(), nullptr);
+    }
+    return ret;
+}
+
+static int FileListFunc(CameraFilesystem*, const char* folder, CameraList* list, void* data, GPContext*) {
+    std::vector<std::string> names;
+    int ret = GetBackend(data)->ListFiles(folder, names);
+    for (const auto& name : names) {
+        gp_list_append(list, name.c_str(), nullptr);
+    }
+    return ret;
+}
+
+static int GetInfoFunc(CameraFilesystem*, const char* folder, const char* filename, CameraFileInfo* info,
+                       void* data, GPContext*) {
+    return GetBackend(data)->GetInfo(folder, filename, *info);
+}
+
+static int GetFileFunc(CameraFilesystem*, const char* folder, const char* filename, CameraFileType type,
+                       CameraFile* file, void* data, GPContext*) {
+    std::vector<uint8_t> content;
+    std::string mimeType;
+    int ret = GetBackend(data)->GetFile(folder, filename, type, content, mimeType);
+    if (ret != GP_OK) {
+        return ret;
+    }
+    return SetFileData(file, content, mimeType.c_str());
+}
+
+static int ReadFileFunc(CameraFilesystem*, const char* folder, const char* filename, CameraFileType type,
+                        uint64_t offset, char* buf, uint64_t* size, void* data, GPContext*) {
+    if (type != GP_FILE_TYPE_NORMAL) {
+        return GP_ERROR_NOT_SUPPORTED;
+    }
+    return GetBackend(data)->ReadFile(folder, filename, offset, buf, *size);
+}
+
+static int StorageInfoFunc(CameraFilesystem*, CameraStorageInformation** sinfos, int* nrofsinfos,
+                           void* data, GPContext*) {
+    std::vector<CameraStorageInformation> storages;
+    int ret = GetBackend(data)->GetStorageInfo(storages);
+    if (ret != GP_OK) {
+        return ret;
+    }
+    // 由libgphoto2释放
+    *sinfos = static_cast<CameraStorageInformation*>(malloc(sizeof(CameraStorageInformation) * storages.size()));
+    if (!*sinfos) {
+        return GP_ERROR_NO_MEMORY;
+    }
+    memcpy(*sinfos, storages.data(), sizeof(CameraStorageInformation) * storages.size());
+    *nrofsinfos = static_cast<int>(storages.size());
+    return GP_OK;
+}
+
+static CameraFilesystemFuncs* GetFilesystemFuncs() {
+    static CameraFilesystemFuncs funcs;
+    static bool initialized = false;
+    if (!initialized) {
+        memset(&funcs, 0, sizeof(funcs));
+        funcs.folder_list_func = FolderListFunc;
+        funcs.file_list_func = FileListFunc;
+        funcs.get_info_func = GetInfoFunc;
+        funcs.get_file_func = GetFileFunc;
+        funcs.read_file_func = ReadFileFunc;
+        funcs.storage_info_func = StorageInfoFunc;
+        initialized = true;
+    }
+    return &funcs;
+}
+
+// ======================== 配置回调 ========================
+
+static int NewSettingWidget(const MockSetting& setting, CameraWidget** widget) {
+    int ret = gp_widget_new(setting.type, setting.label.c_str(), widget);
+    if (ret != GP_OK) {
+        return ret;
+    }
+    gp_widget_set_name(*widget, setting.name.c_str());
+    if (setting.type == GP_WIDGET_TOGGLE) {
+        int value = setting.value == "1" ? 1 : 0;
+        gp_widget_set_value(*widget, &value);
+    } else {
+        for (const auto& choice : setting.choices) {
+            gp_widget_add_choice(*widget, choice.c_str());
+        }
+        gp_widget_set_value(*widget, setting.value.c_str());
+    }
+    gp_widget_set_readonly(*widget, setting.readOnly ? 1 : 0);
+    gp_widget_set_changed(*widget, 0);
+    return GP_OK;
+}
+
+static std::string GetWidgetValue(CameraWidget* widget, CameraWidgetType type) {
+    if (type == GP_WIDGET_TOGGLE) {
+        int value = 0;
+        gp_widget_get_value(widget, &value);
+        return value ? "1" : "0";
+    }
+    const char* value = nullptr;
+    gp_widget_get_value(widget, &value);
+    return value ? value : "";
+}
+
+static int MockGetConfig(Camera* camera, CameraWidget** window, GPContext*) {
+    std::vector<MockSetting> settings;
+    int ret = GetBackend(camera)->ReadSettings("", settings);
+    if (ret != GP_OK) {
+        return ret;
+    }
+
+    gp_widget_new(GP_WIDGET_WINDOW, "Camera and Driver Configuration", window);
+    gp_widget_set_name(*window, "main");
+    CameraWidget* section = nullptr;
+    std::string sectionName;
+    for (const auto& setting : settings) {
+        if (!section || setting.section != sectionName) {
+            sectionName = setting.section;
+            gp_widget_new(GP_WIDGET_SECTION, sectionName.c_str(), &section);
+            gp_widget_set_name(section, sectionName.c_str());
+            gp_widget_append(*window, section);
+        }
+        CameraWidget* child = nullptr;
+        if (NewSettingWidget(setting, &child) == GP_OK) {
+            gp_widget_append(section, child);
+        }
+    }
+    return GP_OK;
+}
+
+static int MockSetConfig(Camera* camera, CameraWidget* window, GPContext*) {
+    MockCameraBackend* backend = GetBackend(camera);
+    for (const auto& setting : backend->ListSettings()) {
+        CameraWidget* child = nullptr;
+        if (gp_widget_get_child_by_name(window, setting.name.c_str(), &child) != GP_OK ||
+            !gp_widget_changed(child)) {
+            continue;
+        }
+        int ret = backend->WriteSetting(setting.name, GetWidgetValue(child, setting.type));
+        if (ret != GP_OK) {
+            return ret;
+        }
+    }
+    return GP_OK;
+}
+
+static int MockListConfig(Camera* camera, CameraList* list, GPContext*) {
+    for (const auto& setting : GetBackend(camera)->ListSettings()) {
+        std::string path = "/main/" + setting.section + "/" + setting.name;
+        gp_list_append(list, path.c_str(), nullptr);
+    }
+    return GP_OK;
+}
+
+static int MockGetSingleConfig(Camera* camera, const char* name, CameraWidget** widget, GPContext*) {
+    std::vector<MockSetting> settings;
+    int ret = GetBackend(camera)->ReadSettings(name ? name : "", settings);
+    if (ret != GP_OK || settings.size() != 1) {
+        return ret != GP_OK ? ret : GP_ERROR_BAD_PARAMETERS;
+    }
+    return NewSettingWidget(settings.front(), widget);
+}
+
+static int MockSetSingleConfig(Camera* camera, const char* name, CameraWidget* widget, GPContext*) {
+    CameraWidgetType type;
+    gp_widget_get_type(widget, &type);
+    return GetBackend(camera)->WriteSetting(name ? name : "", GetWidgetValue(widget, type));
+}
+
+// ======================== 拍摄与事件回调 ========================
+
+static int MockCapture(Camera* camera, CameraCaptureType type, CameraFilePath* path, GPContext* context) {
+    if (type != GP_CAPTURE_IMAGE) {
+        return GP_ERROR_NOT_SUPPORTED;
+    }
+    int ret = GetBackend(camera)->Capture(*path);
+    if (ret == GP_OK) {
+        gp_filesystem_append(camera->fs, path->folder, path->name, context);
+    }
+    return ret;
+}
+
+static int MockTriggerCapture(Camera* camera, GPContext*) {
+    return GetBackend(camera)->TriggerCapture();
+}
+
+static int MockCapturePreview(Camera* camera, CameraFile* file, GPContext*) {
+    std::vector<uint8_t> frame;
+    int ret = GetBackend(camera)->CapturePreview(frame);
+    if (ret != GP_OK) {
+        return ret;
+    }
+    return SetFileData(file, frame, GP_MIME_JPEG);
+}
+
+static int MockWaitForEvent(Camera* camera, int timeout, CameraEventType* eventType, void** eventData,
+                              GPContext* context) {
+    *eventType = GP_EVENT_TIMEOUT;
+    *eventData = nullptr;
+
+    CameraFilePath path;
+    bool fileAdded = false;
+    int ret = GetBackend(camera)->WaitForEvent(timeout, path, fileAdded);
+    if (ret != GP_OK || !fileAdded) {
+        return ret;
+    }
+
+    // 与ptp2一致：新文件先登记到文件系统缓存，再交给调用者（由调用者free）
+    gp_filesystem_append(camera->fs, path.folder, path.name, context);
+    CameraFilePath* added = static_cast<CameraFilePath*>(malloc(sizeof(CameraFilePath)));
+    if (!added) {
+        return GP_ERROR_NO_MEMORY;
+    }
+    *added = path;
+    *eventType = GP_EVENT_FILE_ADDED;
+    *eventData = added;
+    return GP_OK;
+}
+
+static int MockSummary(Camera* camera, CameraText* summary, GPContext*) {
+    MockCameraBackend* backend = GetBackend(camera);
+    snprintf(summary->text, sizeof(summary->text),
+             "Manufacturer: Nikon Corporation (mock)\nModel: %s\nSerial Number: %s\n",
+             backend->GetModel().c_str(), backend->GetSerial().c_str());
+    return GP_OK;
+}
+
+static int MockAbout(Camera*, CameraText* about, GPContext*) {
+    snprintf(about->text, sizeof(about->text),
+             "PhotoSend mock camera driver.\nOptions are read from the %s environment variable.\n",
+             MOCK_OPTIONS_ENV);
+    return GP_OK;
+}
+
+static int MockExit(Camera* camera, GPContext*) {
+    if (camera->pl) {
+        delete camera->pl->backend;
+        delete camera->pl;
+        camera->pl = nullptr;
+    }
+    return GP_OK;
+}
+
+// ======================== camlib入口 ========================
+
+int camera_id(CameraText* id) {
+    snprintf(id->text, sizeof(id->text), "mockcam");
+    return GP_OK;
+}
+
+int camera_abilities(CameraAbilitiesList* list) {
+    CameraAbilities abilities;
+    memset(&abilities, 0, sizeof(abilities));
+    snprintf(abilities.model, sizeof(abilities.model), "%s", MOCK_CAMERA_MODEL);
+    abilities.status = GP_DRIVER_STATUS_TESTING;
+    abilities.port = GP_PORT_PTPIP;
+    abilities.operations = static_cast<CameraOperation>(GP_OPERATION_CONFIG | GP_OPERATION_CAPTURE_IMAGE |
+                                                        GP_OPERATION_CAPTURE_PREVIEW |
+                                                        GP_OPERATION_TRIGGER_CAPTURE);
+    abilities.file_operations = static_cast<CameraFileOperation>(GP_FILE_OPERATION_PREVIEW |
+                                                                 GP_FILE_OPERATION_EXIF);
+    abilities.folder_operations = GP_FOLDER_OPERATION_NONE;
+    abilities.device_type = GP_DEVICE_STILL_CAMERA;
+    return gp_abilities_list_append(list, abilities);
+}
+
+int camera_init(Camera* camera, GPContext* context) {
+    MockCameraOptions options = MockCameraOptions::Parse(getenv(MOCK_OPTIONS_ENV));
+    MockCameraBackend* backend = new MockCameraBackend(options);
+    if (!backend->Init()) {
+        delete backend;
+        gp_context_error(context, "mockcam: failed to prepare payloads");
+        return GP_ERROR;
+    }
+    gp_log(GP_LOG_DEBUG, LOG_DOMAIN_MOCK, "mock camera ready: %d shots, %d storage(s), bandwidth %d KB/s",
+           options.shots, options.storages, options.bandwidthKbps);
+
+    camera->pl = new CameraPrivateLibrary;
+    camera->pl->backend = backend;
+
+    camera->functions->exit = MockExit;
+    camera->functions->get_config = MockGetConfig;
+    camera->functions->set_config = MockSetConfig;
+    camera->functions->list_config = MockListConfig;
+    camera->functions->get_single_config = MockGetSingleConfig;
+    camera->functions->set_single_config = MockSetSingleConfig;
+    camera->functions->capture = MockCapture;
+    camera->functions->trigger_capture = MockTriggerCapture;
+    camera->functions->capture_preview = MockCapturePreview;
+    camera->functions->wait_for_event = MockWaitForEvent;
+    camera->functions->summary = MockSummary;
+    camera->functions->about = MockAbout;
+
+    return gp_filesystem_set_funcs(camera->fs, GetFilesystemFuncs(), camera);
+}
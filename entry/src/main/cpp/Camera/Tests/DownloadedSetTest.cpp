@@ -0,0 +1,88 @@
+// DownloadedSetTest.cpp
+// Created on 2026/1/31.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "NativeTest.h"
+#include "TestUtils.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/CameraDownloadKit/ImportManifest/DownloadedSet.h"
+#include "Camera/CameraDownloadKit/PhotoScanner/PhotoScanner.h"
+
+static const char* TEST_FOLDER = "/store_00010001/DCIM/100NIKON";
+
+// 按文件名查找条目的扫描下标（离线扫描没有相机，GetPhotoTotalCount不可用，一页取完）
+static uint32_t FindScanIndex(PhotoScanner& scanner, const std::string& fileName) {
+    for (const auto& meta : scanner.GetPhotoMetaList(0, 1000)) {
+        if (meta.fileName == fileName) {
+            return meta.scanIndex;
+        }
+    }
+    return UINT32_MAX;
+}
+
+// 扫描完成后联机拍摄新增的文件，标记下载后位图能查到
+NATIVE_TEST(DownloadedSetCoversFileAddedAfterScan) {
+    TestUtils::TempDir dir;
+    DownloadedSet downloadedSet;
+    EXPECT_TRUE(downloadedSet.Open(dir.Path(), "TEST0001", nullptr));
+
+    PhotoScanner scanner;
+    scanner.SetScanCompleteCallback([&downloadedSet](const std::vector<PhotoMeta>& scanList) {
+        downloadedSet.BindIndex(scanList);
+    });
+    scanner.SetFileAddedCallback([&downloadedSet](const PhotoMeta& meta) {
+        downloadedSet.AddIndex(meta);
+    });
+    TestUtils::ScanFolders(scanner, {{TEST_FOLDER, {"DSC_0001.JPG", "DSC_0002.JPG"}}});
+
+    EXPECT_TRUE(scanner.AddFile(TEST_FOLDER, "DSC_0003.JPG"));
+    uint32_t scanIndex = FindScanIndex(scanner, "DSC_0003.JPG");
+    EXPECT_EQ(scanIndex, 2u);
+    EXPECT_FALSE(downloadedSet.IsDownloaded(scanIndex));
+
+    downloadedSet.MarkDownloaded(TEST_FOLDER, "DSC_0003.JPG");
+    EXPECT_TRUE(downloadedSet.IsDownloaded(scanIndex));
+    EXPECT_FALSE(downloadedSet.IsDownloaded(FindScanIndex(scanner, "DSC_0001.JPG")));
+
+    // 补上配对的RAW后，按RAW文件名标记同样命中该条目
+    EXPECT_TRUE(scanner.AddFile(TEST_FOLDER, "DSC_0004.JPG"));
+    EXPECT_TRUE(scanner.AddFile(TEST_FOLDER, "DSC_0004.NEF"));
+    uint32_t pairIndex = FindScanIndex(scanner, "DSC_0004.JPG");
+    downloadedSet.MarkDownloaded(TEST_FOLDER, "DSC_0004.NEF");
+    EXPECT_TRUE(downloadedSet.IsDownloaded(pairIndex));
+
+    downloadedSet.Close();
+}
+
+// 重新打开后，新增文件的标记仍保留在布隆过滤器中，重新扫描时恢复到位图
+NATIVE_TEST(DownloadedSetRestoresAddedFileAfterRescan) {
+    TestUtils::TempDir dir;
+    {
+        DownloadedSet downloadedSet;
+        EXPECT_TRUE(downloadedSet.Open(dir.Path(), "TEST0001", nullptr));
+        PhotoScanner scanner;
+        scanner.SetScanCompleteCallback([&downloadedSet](const std::vector<PhotoMeta>& scanList) {
+            downloadedSet.BindIndex(scanList);
+        });
+        scanner.SetFileAddedCallback([&downloadedSet](const PhotoMeta& meta) {
+            downloadedSet.AddIndex(meta);
+        });
+        TestUtils::ScanFolders(scanner, {{TEST_FOLDER, {"DSC_0001.JPG"}}});
+        EXPECT_TRUE(scanner.AddFile(TEST_FOLDER, "DSC_0002.JPG"));
+        downloadedSet.MarkDownloaded(TEST_FOLDER, "DSC_0002.JPG");
+        downloadedSet.Close();
+    }
+
+    DownloadedSet downloadedSet;
+    EXPECT_TRUE(downloadedSet.Open(dir.Path(), "TEST0001", nullptr));
+    PhotoScanner scanner;
+    scanner.SetScanCompleteCallback([&downloadedSet](const std::vector<PhotoMeta>& scanList) {
+        downloadedSet.BindIndex(scanList);
+    });
+    TestUtils::ScanFolders(scanner, {{TEST_FOLDER, {"DSC_0001.JPG", "DSC_0002.JPG"}}});
+    EXPECT_FALSE(downloadedSet.IsDownloaded(FindScanIndex(scanner, "DSC_0001.JPG")));
+    EXPECT_TRUE(downloadedSet.IsDownloaded(FindScanIndex(scanner, "DSC_0002.JPG")));
+    downloadedSet.Close();
+}
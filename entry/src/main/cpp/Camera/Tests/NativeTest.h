@@ -0,0 +1,64 @@
+// NativeTest.h
+// Created on 2026/1/31.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef NATIVE_TEST_H
+#define NATIVE_TEST_H
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief 原生单元测试的最小框架（不依赖第三方测试库，可在设备上经hdc直接运行）
+ * @details NATIVE_TEST定义并注册用例，EXPECT_*失败时打印位置并把当前用例记为失败，
+ *          photosend_native_tests依次运行全部用例，有失败时返回非0。
+ */
+namespace NativeTest {
+
+struct TestCase {
+    const char* name;
+    std::function<void()> body;
+};
+
+inline std::vector<TestCase>& Registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline bool& CurrentFailed() {
+    static bool failed = false;
+    return failed;
+}
+
+struct Registrar {
+    Registrar(const char* name, std::function<void()> body) {
+        Registry().push_back(TestCase{name, std::move(body)});
+    }
+};
+
+inline void ReportFailure(const char* file, int line, const char* expr) {
+    printf("  %s:%d: 断言失败: %s\n", file, line, expr);
+    CurrentFailed() = true;
+}
+
+} // namespace NativeTest
+
+#define NATIVE_TEST(name) \
+    static void name(); \
+    static NativeTest::Registrar name##_registrar(#name, name); \
+    static void name()
+
+#define EXPECT_TRUE(expr) \
+    do { \
+        if (!(expr)) { \
+            NativeTest::ReportFailure(__FILE__, __LINE__, #expr); \
+        } \
+    } while (0)
+
+#define EXPECT_FALSE(expr) EXPECT_TRUE(!(expr))
+#define EXPECT_EQ(a, b) EXPECT_TRUE((a) == (b))
+
+#endif // NATIVE_TEST_H
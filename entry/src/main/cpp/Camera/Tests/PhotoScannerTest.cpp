@@ -0,0 +1,122 @@
+// PhotoScannerTest.cpp
+// Created on 2026/1/31.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "NativeTest.h"
+#include "TestUtils.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/CameraDownloadKit/PhotoScanner/PhotoScanner.h"
+#include <cstring>
+#include <map>
+
+static const char* SLOT1_FOLDER = "/store_00010001/DCIM/100NIKON";
+static const char* SLOT2_FOLDER = "/store_00020001/DCIM/100NIKON";
+
+// 离线文件信息：目录/文件名 -> (大小, 修改时间)
+using FileInfoTable = std::map<std::string, std::pair<uint64_t, time_t>>;
+
+static void UseFileInfoTable(PhotoScanner& scanner, const FileInfoTable& table) {
+    scanner.SetFileInfoSource([table](const std::string& folder, const std::string& fileName, CameraFileInfo& info) {
+        auto it = table.find(folder + "/" + fileName);
+        if (it == table.end()) {
+            return false;
+        }
+        memset(&info, 0, sizeof(info));
+        info.file.fields = static_cast<CameraFileInfoFields>(GP_FILE_INFO_SIZE | GP_FILE_INFO_MTIME);
+        info.file.size = it->second.first;
+        info.file.mtime = it->second.second;
+        return true;
+    });
+}
+
+static const PhotoMeta* FindEntry(const std::vector<PhotoMeta>& list, const std::string& folder,
+                                  const std::string& fileName) {
+    for (const auto& meta : list) {
+        if (meta.folder == folder && meta.fileName == fileName) {
+            return &meta;
+        }
+    }
+    return nullptr;
+}
+
+// 两张卡上同名但拍摄时间不同的文件是两张照片，扫描时不合并
+NATIVE_TEST(ScanKeepsSameNameFilesWithDifferentTimes) {
+    PhotoScanner scanner;
+    scanner.SetMultiStorageScan(true, "");
+    UseFileInfoTable(scanner, {
+        {std::string(SLOT1_FOLDER) + "/DSC_0001.JPG", {4096, 1000}},
+        {std::string(SLOT2_FOLDER) + "/DSC_0001.JPG", {4096, 5000}},
+        {std::string(SLOT1_FOLDER) + "/DSC_0002.JPG", {8192, 2000}},
+        {std::string(SLOT2_FOLDER) + "/DSC_0002.JPG", {8192, 2001}},
+    });
+    TestUtils::ScanFolders(scanner, {
+        {SLOT1_FOLDER, {"DSC_0001.JPG", "DSC_0002.JPG"}},
+        {SLOT2_FOLDER, {"DSC_0001.JPG", "DSC_0002.JPG"}},
+    });
+
+    auto list = scanner.GetPhotoMetaList(0, 1000);
+    EXPECT_EQ(list.size(), static_cast<size_t>(3));
+    EXPECT_EQ(scanner.GetDuplicateCount(), 1);
+    EXPECT_TRUE(FindEntry(list, SLOT2_FOLDER, "DSC_0001.JPG") != nullptr);
+    const PhotoMeta* merged = FindEntry(list, SLOT1_FOLDER, "DSC_0002.JPG");
+    EXPECT_TRUE(merged != nullptr && merged->duplicateFolder == SLOT2_FOLDER);
+}
+
+// 联机拍摄时另一张卡新增的同名文件：时间不同时单独成条，时间一致时并入双卡备份
+NATIVE_TEST(AddFileMergesStorageCopyOnlyWhenTimesAgree) {
+    PhotoScanner scanner;
+    scanner.SetMultiStorageScan(true, "");
+    UseFileInfoTable(scanner, {
+        {std::string(SLOT1_FOLDER) + "/DSC_0010.JPG", {4096, 1000}},
+        {std::string(SLOT2_FOLDER) + "/DSC_0010.JPG", {4096, 9000}},
+        {std::string(SLOT1_FOLDER) + "/DSC_0011.JPG", {4096, 3000}},
+        {std::string(SLOT2_FOLDER) + "/DSC_0011.JPG", {4096, 3001}},
+        {std::string(SLOT1_FOLDER) + "/DSC_0011.NEF", {65536, 3000}},
+        {std::string(SLOT2_FOLDER) + "/DSC_0011.NEF", {65536, 3001}},
+    });
+    TestUtils::ScanFolders(scanner, {{SLOT1_FOLDER, {}}, {SLOT2_FOLDER, {}}});
+
+    EXPECT_TRUE(scanner.AddFile(SLOT1_FOLDER, "DSC_0010.JPG"));
+    EXPECT_TRUE(scanner.AddFile(SLOT2_FOLDER, "DSC_0010.JPG"));
+    auto list = scanner.GetPhotoMetaList(0, 1000);
+    EXPECT_EQ(list.size(), static_cast<size_t>(2));
+    EXPECT_EQ(scanner.GetDuplicateCount(), 0);
+
+    EXPECT_TRUE(scanner.AddFile(SLOT1_FOLDER, "DSC_0011.JPG"));
+    EXPECT_TRUE(scanner.AddFile(SLOT1_FOLDER, "DSC_0011.NEF"));
+    EXPECT_TRUE(scanner.AddFile(SLOT2_FOLDER, "DSC_0011.JPG"));
+    EXPECT_TRUE(scanner.AddFile(SLOT2_FOLDER, "DSC_0011.NEF"));
+    list = scanner.GetPhotoMetaList(0, 1000);
+    EXPECT_EQ(list.size(), static_cast<size_t>(3));
+    EXPECT_EQ(scanner.GetDuplicateCount(), 1);
+    const PhotoMeta* merged = FindEntry(list, SLOT1_FOLDER, "DSC_0011.JPG");
+    EXPECT_TRUE(merged != nullptr && merged->duplicateFolder == SLOT2_FOLDER &&
+                merged->pairedFileName == "DSC_0011.NEF");
+}
+
+// 同一张卡上编号回绕产生两个同名文件时，另一张卡上的副本要与对应的那一个合并，而不只比较第一个
+NATIVE_TEST(ScanMergesStorageCopyWithLaterSameNameFile) {
+    const char* slot1Next = "/store_00010001/DCIM/101NIKON";
+    PhotoScanner scanner;
+    scanner.SetMultiStorageScan(true, "");
+    UseFileInfoTable(scanner, {
+        {std::string(SLOT1_FOLDER) + "/DSC_0001.JPG", {4096, 1000}},
+        {std::string(slot1Next) + "/DSC_0001.JPG", {6144, 7000}},
+        {std::string(SLOT2_FOLDER) + "/DSC_0001.JPG", {6144, 7000}},
+    });
+    TestUtils::ScanFolders(scanner, {
+        {SLOT1_FOLDER, {"DSC_0001.JPG"}},
+        {slot1Next, {"DSC_0001.JPG"}},
+        {SLOT2_FOLDER, {"DSC_0001.JPG"}},
+    });
+
+    auto list = scanner.GetPhotoMetaList(0, 1000);
+    EXPECT_EQ(list.size(), static_cast<size_t>(2));
+    EXPECT_EQ(scanner.GetDuplicateCount(), 1);
+    const PhotoMeta* first = FindEntry(list, SLOT1_FOLDER, "DSC_0001.JPG");
+    EXPECT_TRUE(first != nullptr && first->duplicateFolder.empty());
+    const PhotoMeta* merged = FindEntry(list, slot1Next, "DSC_0001.JPG");
+    EXPECT_TRUE(merged != nullptr && merged->duplicateFolder == SLOT2_FOLDER);
+}
@@ -0,0 +1,57 @@
+// TestUtils.cpp
+// Created on 2026/1/31.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "TestUtils.h"
+#include "Camera/CameraDownloadKit/PhotoScanner/PhotoScanner.h"
+#include <dirent.h>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace TestUtils {
+
+TempDir::TempDir() {
+    char pattern[] = "./photosend_test_XXXXXX";
+    if (mkdtemp(pattern)) {
+        path_ = pattern;
+    }
+}
+
+TempDir::~TempDir() {
+    if (path_.empty()) {
+        return;
+    }
+    DIR* dir = opendir(path_.c_str());
+    if (dir) {
+        while (struct dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                unlink((path_ + "/" + name).c_str());
+            }
+        }
+        closedir(dir);
+    }
+    rmdir(path_.c_str());
+}
+
+bool ScanFolders(PhotoScanner& scanner, const std::vector<FolderListing>& folders) {
+    std::vector<std::pair<std::string, CameraList*>> listings;
+    for (const auto& folder : folders) {
+        CameraList* list = nullptr;
+        gp_list_new(&list);
+        for (const auto& fileName : folder.second) {
+            gp_list_append(list, fileName.c_str(), nullptr);
+        }
+        listings.emplace_back(folder.first, list);
+    }
+    bool scanned = scanner.ScanListings(listings);
+    for (auto& listing : listings) {
+        gp_list_free(listing.second);
+    }
+    return scanned;
+}
+
+} // namespace TestUtils
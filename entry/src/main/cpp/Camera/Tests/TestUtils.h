@@ -0,0 +1,40 @@
+// TestUtils.h
+// Created on 2026/1/31.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class PhotoScanner;
+
+namespace TestUtils {
+
+/**
+ * @brief 当前目录下的临时目录，析构时连同其中的文件一起删除
+ */
+class TempDir {
+public:
+    TempDir();
+    ~TempDir();
+    const std::string& Path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+using FolderListing = std::pair<std::string, std::vector<std::string>>;
+
+/**
+ * @brief 用给定的目录和文件名离线完成一次扫描（PhotoScanner::ScanListings）
+ */
+bool ScanFolders(PhotoScanner& scanner, const std::vector<FolderListing>& folders);
+
+} // namespace TestUtils
+
+#endif // TEST_UTILS_H
@@ -0,0 +1,61 @@
+// TimelineIndexTest.cpp
+// Created on 2026/1/31.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "NativeTest.h"
+#include "Camera/CameraDownloadKit/camera_download.h"
+#include "Camera/CameraDownloadKit/PhotoScanner/TimelineIndex.h"
+#include <cstdlib>
+#include <ctime>
+
+// 以东八区运行（与相机本地时间相差8小时），凌晨拍摄的照片真实时间戳落在前一天
+static void UseChinaTimeZone() {
+    setenv("TZ", "CST-8", 1);
+    tzset();
+}
+
+// EXIF拍摄时间与只有修改时间的照片使用同一时基：同一本地日期落在同一天桶
+NATIVE_TEST(TimelineMixesExifAndMtimeOnSameLocalDay) {
+    UseChinaTimeZone();
+
+    std::vector<PhotoMeta> photos(2);
+    // 带EXIF：本地时间 2026-01-10 06:30:00
+    photos[0].exif.loaded = true;
+    photos[0].exif.captureTime = TimelineIndex::WallClockFromExifText("2026:01:10 06:30:00");
+    // 只有修改时间：本地时间 2026-01-10 07:00:00 = UTC 2026-01-09 23:00:00
+    int64_t mtime = 1767999600;
+    photos[1].exif.loaded = true;
+    photos[1].exif.captureTime = TimelineIndex::WallClockFromEpoch(mtime);
+
+    TimelineIndex index;
+    index.Rebuild(photos, {0, 1});
+
+    auto days = index.GetBuckets(TimelineIndex::DAY_SECONDS);
+    EXPECT_EQ(days.size(), static_cast<size_t>(1));
+    if (!days.empty()) {
+        EXPECT_EQ(days[0].count, static_cast<size_t>(2));
+        EXPECT_EQ(days[0].start, TimelineIndex::WallClockFromExifText("2026:01:10 00:00:00"));
+    }
+
+    // 两张照片分在本地时间6点、7点两个小时桶
+    auto hours = index.GetBuckets(TimelineIndex::HOUR_SECONDS);
+    EXPECT_EQ(hours.size(), static_cast<size_t>(2));
+
+    // GetPageForDate传入的是真实时间戳：本地7:30应定位到修改时间那张
+    size_t position = 0;
+    EXPECT_TRUE(index.FindPosition(TimelineIndex::WallClockFromEpoch(mtime + 1800), position));
+    EXPECT_EQ(position, static_cast<size_t>(1));
+    // 本地6:45定位到EXIF那张
+    EXPECT_TRUE(index.FindPosition(TimelineIndex::WallClockFromEpoch(mtime - 900), position));
+    EXPECT_EQ(position, static_cast<size_t>(0));
+}
+
+NATIVE_TEST(TimelineWallClockKeepsUnknownTime) {
+    UseChinaTimeZone();
+    EXPECT_EQ(TimelineIndex::WallClockFromEpoch(0), 0);
+    EXPECT_EQ(TimelineIndex::WallClockFromExifText("0000:00:00"), 0);
+    EXPECT_EQ(TimelineIndex::WallClockFromExifText("2026:01:10 06:30:00") -
+              TimelineIndex::WallClockFromEpoch(1767997800), 0);
+}
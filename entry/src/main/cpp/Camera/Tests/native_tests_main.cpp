@@ -0,0 +1,20 @@
+// native_tests_main.cpp
+// Created on 2026/1/31.
+//
+// Node APIs are not fully supported. To solve the compilation error of the interface cannot be found,
+// please include "napi/native_api.h".
+
+#include "NativeTest.h"
+
+int main() {
+    int failed = 0;
+    for (const auto& testCase : NativeTest::Registry()) {
+        NativeTest::CurrentFailed() = false;
+        testCase.body();
+        bool ok = !NativeTest::CurrentFailed();
+        printf("[%s] %s\n", ok ? "PASS" : "FAIL", testCase.name);
+        failed += ok ? 0 : 1;
+    }
+    printf("%zu 个用例，%d 个失败\n", NativeTest::Registry().size(), failed);
+    return failed == 0 ? 0 : 1;
+}
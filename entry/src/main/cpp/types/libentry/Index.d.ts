@@ -96,6 +96,40 @@ interface PhotoMeta {
 
   /** 文件大小（单位：字节，可选） */
   size?: number;
+
+  /** 同目录同名的RAW文件（RAW+JPEG配对时filename为JPEG，可选） */
+  pairedFilename?: string;
+
+  /** 主文件媒体类型（jpeg/heif/rawNikon/rawCanon/rawSony/rawFuji/rawPanasonic/rawOlympus/rawPentax/rawDng/video） */
+  mediaType?: string;
+
+  /** 是否已下载到手机（RAW+JPEG任一已下载即为true，需先调用setImportManifestDir） */
+  downloaded?: boolean;
+
+  /** 双卡备份时另一张存储卡上同一照片所在目录（多卡扫描且有重复时返回） */
+  duplicateFolder?: string;
+
+  /** 以下字段在后台EXIF采集后才返回 */
+  /**
+   * 拍摄时间（挂钟秒数：相机本地日期时间按UTC换算，显示时用getUTC*读取）。
+   * 有EXIF时取DateTimeOriginal，无EXIF时为按本机时区转换的文件修改时间
+   */
+  captureTime?: number;
+
+  /** 曝光时间（秒） */
+  exposureTime?: number;
+
+  /** 光圈值 */
+  fNumber?: number;
+
+  /** ISO感光度 */
+  iso?: number;
+
+  /** 焦距（毫米） */
+  focalLength?: number;
+
+  /** EXIF方向（1-8） */
+  orientation?: number;
 }
 
 /**
@@ -148,6 +182,77 @@ export const GetAvailableCameras: () => string[];
  */
 export const GetCameraStatus: () => CameraStatus;
 
+/**
+ * 启动相机状态监视（代替定时调用GetCameraStatus）
+ * 第一次回调包含全部属性，之后只在状态变化时回调，且只包含变化的属性
+ * @param callback 状态变化回调
+ * @returns 启动成功返回true（相机未连接时为false）
+ */
+export const StartStatusMonitor: (callback: (changed: Partial<CameraStatus>) => void) => boolean;
+
+/**
+ * 停止相机状态监视
+ */
+export const StopStatusMonitor: () => void;
+
+/**
+ * 曝光参数种类：快门、光圈、曝光补偿
+ */
+export type ExposureKind = 'shutter' | 'aperture' | 'ec';
+
+/**
+ * 解析后的曝光参数（精确分数）
+ */
+export interface ExposureValue {
+  num: number;
+  den: number;
+  /** 数值（秒、f值或EV） */
+  value: number;
+  /** 档数：快门为log2(秒)，光圈为2*log2(f值)；曝光补偿没有此字段 */
+  stops?: number;
+}
+
+/**
+ * 等效曝光组合中的一项
+ */
+export interface EquivalentExposure {
+  /** 相机的光圈可选值（原样返回，可直接写回相机） */
+  aperture: string;
+  /** 对齐到1/3档的快门标签（如"1/250"） */
+  shutter: string;
+}
+
+/**
+ * 解析相机的快门/光圈/曝光补偿字符串（兼容各厂商格式，如"1/250"、"0.0040s"、"f/2.8"、"280"、"+1 1/3"）
+ * @returns 无法解析时返回null
+ */
+export const ParseExposureValue: (kind: ExposureKind, text: string) => ExposureValue | null;
+
+/**
+ * 最近的标准档位标签
+ * @param stepsPerStop 每档级数：3为1/3档（默认），2为1/2档
+ * @returns 无法解析时返回空串
+ */
+export const NearestExposureStop: (kind: ExposureKind, text: string, stepsPerStop?: number) => string;
+
+/**
+ * 在相机可选值中找与给定值最接近（按档数比较）的一项
+ * @returns 没有可解析的可选值时返回空串
+ */
+export const MatchExposureChoice: (kind: ExposureKind, text: string, choices: string[]) => string;
+
+/**
+ * 保持曝光量不变，为每个候选光圈计算对应的快门（超出快门范围的光圈不返回）
+ */
+export const GetEquivalentExposures: (aperture: string, shutter: string, apertures: string[]) => EquivalentExposure[];
+
+/**
+ * 包围曝光的补偿序列，按拍摄顺序：0、-1级、+1级……
+ * @param frames 张数，限定在1~15
+ * @param choices 相机的曝光补偿可选值，非空时结果映射为可选值（超出范围的档位不返回）
+ */
+export const GetBracketingSet: (center: string, frames: number, step: string, choices: string[]) => string[];
+
 /**
  * 设置 gphoto2 插件目录（相机驱动和端口驱动）
  * @param camlibDir 相机驱动目录
@@ -172,12 +277,108 @@ export const ConnectCamera: (cameraName: string, cameraPath: string) => boolean;
  */
 export const SetCameraParameter: (paramName: string, paramValue: string) => boolean;
 
+/**
+ * 批量设置参数的单项结果
+ */
+export interface ParamWriteResult {
+  name: string;
+  value: string;
+  success: boolean;
+  /** 失败原因：不合法取值的原因、"skipped"（其他项校验失败，整批未下发）或相机返回的错误 */
+  error?: string;
+}
+
+/**
+ * 批量设置相机参数（异步，一次调用完成）
+ * 任一项不在相机可选值中时整批不下发；不支持单项读写的参数合并为一次整树提交
+ * @param params 参数名到参数值的映射（如 { "iso": "400", "f-number": "f/5.6" }）
+ * @param callback 完成回调，results按项给出结果
+ */
+export const SetCameraParameters: (params: Record<string, string>,
+  callback: (err: string | null, results: ParamWriteResult[] | null) => void) => void;
+
+/**
+ * 排队写入的确认
+ */
+export interface ParamWriteAck {
+  name: string;
+  /** 最后一次请求的值 */
+  requested: string;
+  /** 写入后从相机读回的实际值（机身可能就近取值） */
+  applied: string;
+  success: boolean;
+  error: string;
+  /** 本次写入合并掉的中间值个数 */
+  coalesced: number;
+  /** 从最后一次请求到写入完成的耗时（毫秒） */
+  latencyMs: number;
+}
+
+/**
+ * 排队写入相机参数（不阻塞），同一参数未写入的旧值被新值替换，适合滑块拖动
+ * 后台按相机的处理速度写入最新值，结果通过RegisterParamAckCallback回调
+ * @returns 是否入队（相机未连接时为false）
+ */
+export const QueueCameraParameter: (paramName: string, paramValue: string) => boolean;
+
+/**
+ * 注册排队写入的确认回调（某参数写完且没有更新的值在排队时回调一次）
+ */
+export const RegisterParamAckCallback: (callback: (ack: ParamWriteAck) => void) => void;
+
 /**
  * 控制相机拍照
  * @returns 照片在相机内的存储路径信息，包含文件夹和文件名
  */
 export const TakePhoto: () => PhotoPathInfo;
 
+/**
+ * 联机会话事件
+ */
+export interface TetherEvent {
+  /**
+   * 事件类型：fileAdded=相机产生新文件，downloaded=已落盘，skipped=按策略跳过，error=出错，
+   * stopped=相机持续无响应（如已拔出），会话已自行结束（error为原因）
+   */
+  type: 'fileAdded' | 'downloaded' | 'skipped' | 'error' | 'stopped';
+
+  /** 照片在相机中的文件夹路径 */
+  folder: string;
+
+  /** 照片文件名 */
+  filename: string;
+
+  /** 本地保存路径（downloaded时有效） */
+  localPath: string;
+
+  /** 错误信息（error时有效） */
+  error: string;
+
+  /** 从收到新文件到落盘完成的耗时（毫秒） */
+  latencyMs: number;
+}
+
+/**
+ * 启动联机自动导入会话：机身或App触发的每张新照片都会在后台立即下载
+ * @param destDir 本地保存目录
+ * @param policy 导入策略："full"=完整文件，"jpeg"=仅JPEG，"preview"=仅内嵌预览图
+ * @param callback 会话事件回调
+ * @returns 启动成功返回true
+ */
+export const StartTetherSession: (destDir: string, policy: 'full' | 'jpeg' | 'preview',
+  callback: (event: TetherEvent) => void) => boolean;
+
+/**
+ * 停止联机自动导入会话
+ */
+export const StopTetherSession: () => void;
+
+/**
+ * 非阻塞拍摄（需先启动联机会话），新照片通过会话事件返回
+ * @returns 会话未运行时返回false
+ */
+export const TriggerCapture: () => boolean;
+
 /**
  * 获取相机实时预览画面
  * @returns Base64编码的预览图像数据字符串
@@ -212,6 +413,14 @@ export const IsCameraConnected: () => boolean;
  */
 export const GetParamOptions: (paramName: string) => string[];
 
+/**
+ * 设置配置结构缓存所在目录（应用沙箱目录，缓存放在其下的config_schema子目录），
+ * 连接时按型号+固件加载上次保存的配置结构，参数面板无需等待整树读取
+ * @param dir 应用文件目录（如context.filesDir）
+ * @returns 目录可用返回true
+ */
+export const SetConfigCacheDir: (dir: string) => boolean;
+
 /**
  * 注册参数回调函数
  * @param callback 回调函数，接收一个ParamOptions类型的参数
@@ -332,7 +541,253 @@ export const GetScanProgress: () => {
   total: number;
   cached: boolean;
   count?: number;
+  /** 各媒体类型文件数（只包含非零项，含sidecar附属文件） */
+  typeCounts?: Record<string, number>;
+  /** 合并的跨存储卡重复照片数（多卡扫描时） */
+  duplicates?: number;
+};
+
+/**
+ * 设置照片列表显示的媒体类型，立即生效无需重新扫描（默认只显示照片，不含视频）
+ * @param types 类型名数组，"raw"表示全部RAW，空数组恢复默认
+ */
+export const SetMediaTypeFilter: (types: string[]) => boolean;
+
+/**
+ * 启动后台EXIF采集（需扫描完成），只传输EXIF数据块，相机忙时自动让出
+ * @returns 启动成功返回true
+ */
+export const StartExifHarvest: () => boolean;
+
+/**
+ * 停止后台EXIF采集
+ */
+export const StopExifHarvest: () => void;
+
+/**
+ * 获取EXIF采集进度
+ */
+export const GetExifHarvestProgress: () => {
+  harvesting: boolean;
+  current: number;
+  total: number;
 };
 
+/**
+ * 设置照片列表排序方式，影响之后的GetPhotoMetaList分页结果（未采集EXIF的照片排在最后）
+ * @param key 排序字段
+ * @param ascending 是否升序，默认true
+ * @returns 字段有效返回true
+ */
+export const SetPhotoSortOrder: (
+  key: 'name' | 'captureTime' | 'exposureTime' | 'fNumber' | 'iso' | 'focalLength' | 'size',
+  ascending?: boolean
+) => boolean;
+
+/**
+ * 相机目录列表
+ */
+export interface CameraFolderListing {
+  /** 目录绝对路径 */
+  path: string;
+
+  /** 子目录名 */
+  folders: string[];
+
+  /** 文件名 */
+  files: string[];
+}
+
+/**
+ * 列出相机目录，结果按目录缓存（再次访问不经过相机），并在空闲时预取兄弟目录和子目录
+ * @param path 目录绝对路径，根目录为"/"
+ * @param refresh true=忽略缓存重新列出
+ * @param callback 完成回调（err, listing）
+ */
+export const ListCameraFolder: (
+  path: string,
+  refresh: boolean,
+  callback: (err: string | null, listing: CameraFolderListing | null) => void
+) => void;
+
+/**
+ * 指定照片扫描目录（如第二张卡的DCIM子目录），调用后需重新StartAsyncScan
+ * @param folder 目录绝对路径，空字符串恢复自动查找DCIM
+ */
+export const SetScanFolder: (folder: string) => boolean;
+
+/**
+ * 设置多卡扫描，调用后需重新StartAsyncScan
+ * 开启后扫描所有存储卡DCIM下的全部照片目录，双卡备份模式下两张卡上的同一张照片
+ * （同名、同大小、拍摄时间一致）合并为一条，批量导入只从优先存储卡下载一份
+ * @param enabled 是否扫描所有存储卡
+ * @param preferredStorage 重复照片优先的存储卡根目录（如"/store_00020001"），默认卡槽1
+ */
+export const SetMultiStorageScan: (enabled: boolean, preferredStorage?: string) => boolean;
+
+/**
+ * 时间轴桶
+ */
+export interface TimelineBucket {
+  /** 桶起始时间（挂钟秒数，与PhotoMeta.captureTime同一时基） */
+  start: number;
+
+  /** 该时间段内的照片数 */
+  count: number;
+
+  /** 该时间段照片在当前排序列表中的最小下标 */
+  position: number;
+}
+
+/**
+ * 获取时间轴桶列表（按时间升序，只包含已采集拍摄时间的照片，随EXIF采集增量更新）
+ * @param granularity 分桶粒度，默认"day"
+ */
+export const GetTimelineBuckets: (granularity?: 'day' | 'hour') => TimelineBucket[];
+
+/**
+ * 获取指定时间的照片所在页码，时间落在空档时定位到之前最近的照片
+ * @param timestamp 目标时间（真实时间戳，秒，如Date.getTime()/1000），按本机时区转换后查找
+ * @param pageSize 每页大小（与GetPhotoMetaList一致）
+ * @returns 页码，时间轴为空时返回-1
+ */
+export const GetPageForDate: (timestamp: number, pageSize: number) => number;
+
+/**
+ * 按文件名检索照片（不区分大小写，RAW+JPEG任一文件名匹配即命中，联机拍摄新增的文件实时可查）
+ * @param query 查询串（如"DSC_4821"）
+ * @param mode 匹配方式，默认"prefix"
+ * @param limit 最多返回条数，默认不限
+ * @returns 命中照片在当前列表（GetPhotoMetaList）中的下标，升序；页码 = 下标 / pageSize
+ */
+export const SearchPhotos: (query: string, mode?: 'prefix' | 'substring', limit?: number) => number[];
+
+/**
+ * 扫描基准测试参数（百分比按拍摄张数计，其余为单JPEG）
+ */
+interface ScanBenchmarkOptions {
+  /** 文件列表条目数，默认10000 */
+  fileCount?: number;
+  /** 单RAW比例，默认20 */
+  rawPercent?: number;
+  /** RAW+JPEG比例（每张两个文件），默认40 */
+  pairPercent?: number;
+  /** 视频比例，默认5 */
+  videoPercent?: number;
+  /** 附属文件比例，默认5 */
+  sidecarPercent?: number;
+  /** 每个DCIM子目录的文件数，默认9999 */
+  filesPerFolder?: number;
+  /** 分页大小，默认50 */
+  pageSize?: number;
+}
+
+/**
+ * 扫描基准测试结果（耗时单位见字段名，内存单位KB）
+ */
+interface ScanBenchmarkReport {
+  fileCount: number;
+  entryCount: number;
+  scanMs: number;
+  scanAllocs: number;
+  scanAllocBytes: number;
+  classifyNsPerFile: number;
+  pageCount: number;
+  pageAvgUs: number;
+  pageP50Us: number;
+  pageP99Us: number;
+  pageMaxUs: number;
+  pageAllocsAvg: number;
+  rssBeforeKb: number;
+  rssAfterKb: number;
+  peakRssKb: number;
+}
+
+/**
+ * 运行扫描基准测试：用合成的文件列表驱动独立的扫描器（不访问相机，不影响当前扫描缓存）
+ * 仅在以 -DPHOTOSEND_BENCHMARK=ON 编译的调试包中存在；在后台线程执行，参数无效时Promise被拒绝
+ */
+export const RunScanBenchmark: ((options?: ScanBenchmarkOptions) => Promise<ScanBenchmarkReport>) | undefined;
+
+/**
+ * 批量下载结果项
+ */
+export interface BatchDownloadResult {
+  /** 照片在相机中的文件夹路径 */
+  folder: string;
+
+  /** 照片文件名 */
+  filename: string;
+
+  /**
+   * 处理结果：downloaded=本次已下载，skipped=已导入未传输，
+   * reimported=已导入过但按skipImported=false重新下载（导入清单保留首次导入的记录），failed=失败
+   */
+  status: 'downloaded' | 'skipped' | 'reimported' | 'failed';
+
+  /** 本地文件路径（skipped时为上次导入的路径） */
+  localPath: string;
+
+  /** 导入清单中记录的路径（skipped、reimported时有） */
+  importedPath?: string;
+
+  /** 文件CRC32（下载时边传边算） */
+  crc32: number;
+
+  /** 失败原因 */
+  error?: string;
+}
+
+/**
+ * 设置导入清单所在目录（应用沙箱目录），并加载已导入记录
+ * @param dir 清单目录（如context.filesDir）
+ * @returns 加载成功返回true
+ */
+export const SetImportManifestDir: (dir: string) => boolean;
+
+/**
+ * 设置下载直接I/O阈值：不小于该大小的文件以O_DIRECT写入，绕过页缓存（适合超大RAW/视频）
+ * @param thresholdBytes 阈值（字节），0表示关闭
+ */
+export const SetDownloadDirectIoThreshold: (thresholdBytes: number) => void;
+
+/**
+ * 设置RAW+JPEG配对照片的批量导入策略
+ * @param policy "both"=两个都导入，"jpeg"=仅JPEG，"raw"=仅RAW，"rawIfProtected"=仅JPEG，机内已保护的照片额外导入RAW
+ * @returns 策略有效返回true
+ */
+export const SetPairImportPolicy: (policy: 'both' | 'jpeg' | 'raw' | 'rawIfProtected') => boolean;
+
+/**
+ * 查询照片是否已导入到手机（只查本地的已下载集合和导入清单，不访问相机）
+ */
+export const IsPhotoImported: (folder: string, filename: string) => boolean;
+
+/**
+ * 从RAW文件（NEF/CR2/ARW/DNG/RW2/ORF）中提取最大的内嵌JPEG，只传输文件头和JPEG部分
+ * @param folder 照片在相机中的文件夹路径
+ * @param filename RAW文件名
+ * @param callback 完成回调（err, jpeg数据）
+ */
+export const ExtractRawPreview: (
+  folder: string,
+  filename: string,
+  callback: (err: string | null, jpeg: ArrayBuffer | null) => void
+) => void;
+
+/**
+ * 批量下载照片到指定目录，导入清单中已存在的文件不再传输
+ * @param files 待下载的照片列表
+ * @param destDir 本地保存目录
+ * @param skipImported true=跳过已导入文件；false=仍然下载，结果为reimported并带上次导入的路径
+ * @param callback 完成回调（err, results）
+ */
+export const DownloadPhotoBatch: (
+  files: PhotoMeta[],
+  destDir: string,
+  skipImported: boolean,
+  callback: (err: string | null, results: BatchDownloadResult[] | null) => void
+) => void;
+
 // 断开连接函数
 export const DisconnectCamera: () => boolean;
\ No newline at end of file